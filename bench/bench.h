@@ -0,0 +1,122 @@
+/*============================
+  Phraglib benchmarks
+  bench.h
+=============================*/
+/* ==== USAGE: ====
+   - each bench_*.c is a whole PL app: it includes PL.c so it can reach the internal
+     kernels and dispatch table, runs Bench_Main from PL_Startup and exits
+   - "./build.sh bench" builds them into build/, run them with -headless
+   - exit code is the number of failed checks, timings are best of BENCH_RUNS
+*/
+#include "PL/PL.c"
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_RUNS 5
+
+static int Bench_Main(void);
+
+static int bench_failures;
+static volatile u64 bench_sink; // results go here so the timed work can't be optimised out
+
+void PL_Startup(void)
+{
+    PL_SystemInfo *info = PL_GetSystemInfo();
+    printf("cpu: sse2 %d avx2 %d neon %d, cache line %u, l3 %llu KB\n",
+           info->sse2, info->avx2, info->neon, info->cacheLineSize,
+           (unsigned long long)(info->l3Cache / KB(1)));
+    exit(Bench_Main() + bench_failures);
+}
+
+void PL_Frame(void)
+{
+}
+
+void PL_ErrorCallback(void)
+{
+    fprintf(stderr, "PL error: %s\n", PL_GetErrorString());
+}
+
+// keep the byte loops byte loops, gcc otherwise turns them into memset/memcpy/strlen calls
+#if defined(__GNUC__) && !defined(__clang__)
+#define BENCH_BYTELOOP __attribute__((noinline, optimize("no-tree-loop-distribute-patterns")))
+#else
+#define BENCH_BYTELOOP
+#endif
+
+// the kernel ISAs PL.c builds for this target, in dispatch order. a bench lists its kernels
+// once through BENCH_ISA_KERNELS with a macro turning the ISA suffix and name into an entry, eg:
+//   #define BENCH_MEM_KERNEL(isa, name) {name, PL_MemSet##isa, PL_MemCpy##isa}
+//   static Bench_MemKernel bench_memKernels[] = BENCH_ISA_KERNELS(BENCH_MEM_KERNEL);
+// and skips entry i when !Bench_IsaSupported(i)
+#if defined(PL_ARCH_X86)
+#define BENCH_ISA_KERNELS(KERNEL) {KERNEL(SSE2, "sse2"), KERNEL(AVX2, "avx2")}
+#elif defined(PL_ARCH_ARM64)
+#define BENCH_ISA_KERNELS(KERNEL) {KERNEL(NEON, "neon")}
+#else
+#define BENCH_ISA_KERNELS(KERNEL) {KERNEL(Scalar, "scalar")}
+#endif
+
+static inline b32 Bench_IsaSupported(u32 isa)
+{
+#if defined(PL_ARCH_X86)
+    PL_SystemInfo *info = PL_GetSystemInfo();
+    return (isa == 0) ? info->sse2 : info->avx2;
+#else
+    return 1;
+#endif
+}
+
+// ns per rep of body, best of BENCH_RUNS (body can use rep_)
+#define BENCH(nsPerRep, reps, body) \
+do { \
+    r64 best_ = 1e300; \
+    for(int run_ = 0; run_ < BENCH_RUNS; run_++) \
+    { \
+        u64 t0_ = PL_GetTicks(); \
+        for(u64 rep_ = 0; rep_ < (u64)(reps); rep_++) { body; } \
+        r64 ns_ = (r64)PL_TicksToNs(PL_GetTicks() - t0_) / (r64)(reps); \
+        if(ns_ < best_) best_ = ns_; \
+    } \
+    (nsPerRep) = best_; \
+} while(0)
+
+// counts a failed check and reports it, returns cond
+static b32 Bench_Check(b32 cond, const char *format, ...)
+{
+    if(!cond)
+    {
+        va_list args;
+        va_start(args, format);
+        fprintf(stderr, "FAIL: ");
+        vfprintf(stderr, format, args);
+        fprintf(stderr, "\n");
+        va_end(args);
+        bench_failures++;
+    }
+    
+    return cond;
+}
+
+// repeatable input that doesn't share the PL rand streams under test
+static inline u64 Bench_Rand(u64 *state)
+{
+    u64 z = (*state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static inline r32 Bench_RandR32(u64 *state, r32 min, r32 max)
+{
+    return min + (max - min) * ((r32)(Bench_Rand(state) >> 40) * (1.0f / 16777216.0f));
+}
+
+// "64B", "4KB", "1MB"
+static inline const char *Bench_SizeName(u64 size, char *buffer, u64 bufferSize)
+{
+    if(size >= MB(1) && !(size % MB(1))) snprintf(buffer, bufferSize, "%lluMB", (unsigned long long)(size / MB(1)));
+    else if(size >= KB(1) && !(size % KB(1))) snprintf(buffer, bufferSize, "%lluKB", (unsigned long long)(size / KB(1)));
+    else snprintf(buffer, bufferSize, "%lluB", (unsigned long long)size);
+    return buffer;
+}
@@ -0,0 +1,196 @@
+/*============================
+  PL_Map
+  random put/get/remove checked against a reference model in every configuration, then timed
+  (bench_map_swar builds this again with the 8 byte SWAR groups)
+=============================*/
+#include "bench.h"
+
+#define BENCH_MAP_OPS 1500000
+
+static char bench_strKeys[20000][16];
+
+// key i of a config, spread out so neighbouring ids don't hash alike by accident
+static u64 Bench_MapKey(PL_Map *map, u32 id)
+{
+    if(map->keyType == MAPKEY_STR) return (u64)(uintptr_t)bench_strKeys[id];
+    u64 state = id;
+    return Bench_Rand(&state);
+}
+
+#define BENCH_MAP_ID_BITS 20 // values carry the key id in their low bits, so iteration can find it
+
+// the reference: present[id] / values[id], a put that fails has to be a new key into a fixed map
+static void Bench_MapCheck(const char *name, PL_Map *map, u32 keyCount, u64 ops, u64 *seed)
+{
+    b8 *present = (b8*)PL_Alloc0(keyCount);
+    u64 *values = (u64*)PL_Alloc0(keyCount * sizeof(u64));
+    u64 count = 0, failedPuts = 0, emptiestFail = UINT64_MAX;
+    u32 failures = (u32)bench_failures;
+    
+    for(u64 op = 0; op < ops && bench_failures < (int)failures + 10; op++)
+    {
+        u32 id = (u32)(Bench_Rand(seed) % keyCount);
+        u64 key = Bench_MapKey(map, id);
+        u32 kind = (u32)(Bench_Rand(seed) % 10);
+        
+        if(kind < 5)
+        {
+            u64 value = (Bench_Rand(seed) << BENCH_MAP_ID_BITS) | id;
+            b32 put = (map->keyType == MAPKEY_STR) ? PL_MapPutStr(map, (const char*)(uintptr_t)key, value) :
+                                                     PL_MapPut(map, key, value);
+            if(put)
+            {
+                count += !present[id];
+                present[id] = 1;
+                values[id] = value;
+            }
+            else
+            {
+                failedPuts++;
+                if(count < emptiestFail) emptiestFail = count;
+                Bench_Check(map->fixed && !present[id], "%s put %u failed (fixed %d, present %d)",
+                            name, id, map->fixed, present[id]);
+            }
+        }
+        else if(kind < 8)
+        {
+            b32 removed = (map->keyType == MAPKEY_STR) ? PL_MapRemoveStr(map, (const char*)(uintptr_t)key) :
+                                                         PL_MapRemove(map, key);
+            Bench_Check(removed == present[id], "%s remove %u returned %d, present %d", name, id, removed, present[id]);
+            count -= present[id];
+            present[id] = 0;
+        }
+        else
+        {
+            u64 *value = (map->keyType == MAPKEY_STR) ? PL_MapGetStr(map, (const char*)(uintptr_t)key) :
+                                                        PL_MapGet(map, key);
+            Bench_Check(!value == !present[id], "%s get %u found %d, present %d", name, id, value != 0, present[id]);
+            if(value && present[id]) Bench_Check(*value == values[id], "%s get %u value mismatch", name, id);
+        }
+        
+        Bench_Check(map->count == count, "%s count %llu, expected %llu after op %llu", name,
+                    (unsigned long long)map->count, (unsigned long long)count, (unsigned long long)op);
+        
+        // every entry is in the model and nothing is left out
+        if(!(op & 0xffff) || op == ops - 1)
+        {
+            u64 seen = 0, k, v;
+            for(u64 it = 0; PL_MapNext(map, &it, &k, &v); seen++)
+            {
+                u32 entry = (u32)(v & ((1 << BENCH_MAP_ID_BITS) - 1));
+                Bench_Check(entry < keyCount && present[entry] && values[entry] == v && Bench_MapKey(map, entry) == k,
+                            "%s iterated an entry the model doesn't have", name);
+            }
+            Bench_Check(seen == count, "%s iterated %llu entries, count %llu", name,
+                        (unsigned long long)seen, (unsigned long long)count);
+        }
+    }
+    
+    printf("%-15s %7u keys, %llu ops, capacity %5llu, %llu failed puts", name, keyCount,
+           (unsigned long long)ops, (unsigned long long)map->capacity, (unsigned long long)failedPuts);
+    if(failedPuts) printf(" (the emptiest at %llu entries)", (unsigned long long)emptiestFail);
+    printf("\n");
+    PL_Free(present);
+    PL_Free(values);
+}
+
+static void Bench_MapConfigs(void)
+{
+    u64 seed = 11;
+    PL_Map map;
+    
+    PL_MapInit(&map, MAPKEY_INT, 0, 0);
+    Bench_MapCheck("growing", &map, 60000, BENCH_MAP_OPS, &seed);
+    PL_MapFree(&map);
+    
+    // heavy churn in a single group: tombstones and same size rehashes
+    PL_MapInit(&map, MAPKEY_INT, 0, 0);
+    Bench_MapCheck("tiny", &map, 24, BENCH_MAP_OPS, &seed);
+    PL_MapFree(&map);
+    
+    PL_Map zeroed = {0};
+    Bench_MapCheck("zeroed", &zeroed, 3000, BENCH_MAP_OPS, &seed);
+    PL_MapFree(&zeroed);
+    
+    PL_Arena arena;
+    PL_ArenaInit(&arena, PL_Alloc(MB(64)), MB(64));
+    PL_MapInit(&map, MAPKEY_INT, 16, &arena);
+    Bench_MapCheck("arena", &map, 20000, BENCH_MAP_OPS, &seed);
+    PL_Free(arena.base);
+    
+    // fixed: every key fits under the load limit, no put may fail
+    u64 fixedSize = PL_MapMemorySize(4000);
+    ptr fixedMemory = PL_Alloc(fixedSize + 1);
+    PL_MapInitFixed(&map, MAPKEY_INT, (u8*)fixedMemory + 1, fixedSize); // misaligned on purpose
+    Bench_MapCheck("fixed", &map, 4000, BENCH_MAP_OPS, &seed);
+    
+    // overfull fixed: 4x more keys than it can hold, puts of new keys fail when it's full
+    PL_MapInitFixed(&map, MAPKEY_INT, fixedMemory, PL_MapMemorySize(1000));
+    Bench_MapCheck("overfull fixed", &map, 4000, BENCH_MAP_OPS, &seed);
+    PL_Free(fixedMemory);
+    
+    for(u32 i = 0; i < PL_ArrayCount(bench_strKeys); i++) snprintf(bench_strKeys[i], 16, "key%u", i * 7919u);
+    PL_MapInit(&map, MAPKEY_STR, 0, 0);
+    Bench_MapCheck("string", &map, PL_ArrayCount(bench_strKeys), BENCH_MAP_OPS, &seed);
+    PL_MapFree(&map);
+}
+
+#define BENCH_MAP_KEYS 1000000
+
+static int Bench_Main(void)
+{
+    printf("%s groups of %d\n", (PL_MAP_GROUP == 8) ? "swar" : "simd", PL_MAP_GROUP);
+    Bench_MapConfigs();
+    
+    u64 *keys = (u64*)PL_Alloc(BENCH_MAP_KEYS * sizeof(u64));
+    u64 *missing = (u64*)PL_Alloc(BENCH_MAP_KEYS * sizeof(u64));
+    u64 seed = 13;
+    for(u32 i = 0; i < BENCH_MAP_KEYS; i++)
+    {
+        keys[i] = Bench_Rand(&seed);
+        missing[i] = Bench_Rand(&seed);
+    }
+    
+    r64 ns;
+    printf("\nns per op, %d random u64 keys\n", BENCH_MAP_KEYS);
+    
+    // each run frees the previous map first, a few us next to the puts
+    PL_Map map = {0};
+    BENCH(ns, 1, PL_MapFree(&map); PL_MapInit(&map, MAPKEY_INT, 0, 0);
+          for(u32 i = 0; i < BENCH_MAP_KEYS; i++) PL_MapPut(&map, keys[i], i));
+    printf("put, growing   %7.1f\n", ns / BENCH_MAP_KEYS);
+    
+    BENCH(ns, 1, PL_MapFree(&map); PL_MapInit(&map, MAPKEY_INT, BENCH_MAP_KEYS, 0);
+          for(u32 i = 0; i < BENCH_MAP_KEYS; i++) PL_MapPut(&map, keys[i], i));
+    printf("put, presized  %7.1f\n", ns / BENCH_MAP_KEYS);
+    
+    BENCH(ns, BENCH_MAP_KEYS, bench_sink += *PL_MapGet(&map, keys[rep_]));
+    printf("hit            %7.1f\n", ns);
+    
+    BENCH(ns, BENCH_MAP_KEYS, bench_sink += (PL_MapGet(&map, missing[rep_]) != 0));
+    printf("miss           %7.1f\n", ns);
+    
+    // refilled between runs, outside the timing
+    r64 best = 1e300;
+    for(u32 run = 0; run < BENCH_RUNS; run++)
+    {
+        for(u32 i = 0; i < BENCH_MAP_KEYS; i++) PL_MapPut(&map, keys[i], i);
+        u64 t0 = PL_GetTicks();
+        for(u32 i = 0; i < BENCH_MAP_KEYS; i++) PL_MapRemove(&map, keys[i]);
+        r64 runNs = (r64)PL_TicksToNs(PL_GetTicks() - t0);
+        if(runNs < best) best = runNs;
+    }
+    Bench_Check(map.count == 0, "map not empty after removing every key");
+    printf("remove         %7.1f\n", best / BENCH_MAP_KEYS);
+    PL_MapFree(&map);
+    
+    PL_MapInit(&map, MAPKEY_INT, 1000, 0);
+    for(u32 i = 0; i < 1000; i++) PL_MapPut(&map, keys[i], i);
+    BENCH(ns, 10000000, bench_sink += *PL_MapGet(&map, keys[rep_ % 1000]));
+    printf("hit, 1K map    %7.1f\n", ns);
+    PL_MapFree(&map);
+    
+    PL_Free(keys);
+    PL_Free(missing);
+    return 0;
+}
@@ -0,0 +1,5 @@
+/*============================
+  PL_Map with the 8 byte SWAR groups forced on, the path non x64/arm64 targets take
+=============================*/
+#define PL_MAP_SWAR
+#include "bench_map.c"
@@ -0,0 +1,114 @@
+/*============================
+  PL_MemZero / PL_MemSet / PL_MemCpy
+  against the old byte loops and libc, and every kernel checked against libc
+=============================*/
+#include "bench.h"
+
+// PL_MemSet and PL_MemCpy before the SIMD kernels
+BENCH_BYTELOOP static void Bench_OldMemSet(ptr mem, u8 value, u64 size)
+{
+    u8* byte = (u8*)(mem);
+    for(u64 i=0; i<size; i++)
+    {
+        *byte++ = value;
+    }
+}
+
+BENCH_BYTELOOP static void Bench_OldMemCpy(ptr src, ptr dst, u64 size)
+{
+    u8 *sb = (u8*)src;
+    u8 *db = (u8*)dst;
+    while(size)
+    {
+        *db++ = *sb++;
+        size--;
+    }
+}
+
+typedef struct
+{
+    const char *name;
+    PL_MemSetFn *memSet;
+    PL_MemCpyFn *memCpy;
+} Bench_MemKernel;
+
+#define BENCH_MEM_KERNEL(isa, name) {name, PL_MemSet##isa, PL_MemCpy##isa}
+static Bench_MemKernel bench_memKernels[] = BENCH_ISA_KERNELS(BENCH_MEM_KERNEL);
+
+#define BENCH_MEM_MAX MB(64)
+#define BENCH_MEM_CHECKS 100000
+
+static int Bench_Main(void)
+{
+    u8 *src = (u8*)PL_Alloc(BENCH_MEM_MAX + 128);
+    u8 *dst = (u8*)PL_Alloc(BENCH_MEM_MAX + 128);
+    u8 *ref = (u8*)PL_Alloc(BENCH_MEM_MAX + 128);
+    if(!src || !dst || !ref) return 1;
+    
+    u64 seed = 1;
+    for(u64 i = 0; i < BENCH_MEM_MAX + 128; i++) src[i] = (u8)Bench_Rand(&seed);
+    
+    // every kernel against libc: random sizes and misalignments, with the non-temporal
+    // threshold lowered so the streaming store path is covered too
+    u64 nonTemporalMin = pl_dispatch.nonTemporalMin;
+    pl_dispatch.nonTemporalMin = KB(64);
+    Bench_MemKernel *kernels = bench_memKernels;
+    u32 kernelCount = PL_ArrayCount(bench_memKernels);
+    for(u32 k = 0; k < kernelCount; k++)
+    {
+        if(!Bench_IsaSupported(k)) continue;
+        for(u32 i = 0; i <= BENCH_MEM_CHECKS; i++)
+        {
+            u64 size = (i < 300) ? i : (Bench_Rand(&seed) % ((i & 7) ? KB(4) : KB(256)));
+            if(i == BENCH_MEM_CHECKS) size = MB(3) + 77;
+            u64 srcOffset = Bench_Rand(&seed) & 63;
+            u64 dstOffset = Bench_Rand(&seed) & 63;
+            u64 span = size + 128 < KB(512) ? size + 128 : size + 64;
+            u8 value = (u8)Bench_Rand(&seed);
+            
+            memset(dst, 0xcd, span);
+            memset(ref, 0xcd, span);
+            kernels[k].memCpy(dst + dstOffset, src + srcOffset, size);
+            memcpy(ref + dstOffset, src + srcOffset, size);
+            if(!Bench_Check(!memcmp(dst, ref, span), "%s memcpy size %llu offsets %llu/%llu",
+                            kernels[k].name, (unsigned long long)size,
+                            (unsigned long long)srcOffset, (unsigned long long)dstOffset)) break;
+            
+            kernels[k].memSet(dst + dstOffset, value, size);
+            memset(ref + dstOffset, value, size);
+            if(!Bench_Check(!memcmp(dst, ref, span), "%s memset size %llu offset %llu",
+                            kernels[k].name, (unsigned long long)size, (unsigned long long)dstOffset)) break;
+        }
+        printf("%s: checked against libc memset/memcpy\n", kernels[k].name);
+    }
+    pl_dispatch.nonTemporalMin = nonTemporalMin;
+    
+    u64 sizes[] = {64, KB(4), MB(1), BENCH_MEM_MAX};
+    char name[32];
+    printf("\nGB/s (non-temporal from %s)\n", Bench_SizeName(nonTemporalMin, name, sizeof(name)));
+    printf("               old loop        PL      libc\n");
+    for(u32 s = 0; s < PL_ArrayCount(sizes); s++)
+    {
+        u64 size = sizes[s];
+        u64 reps = (GB(1) / size) < 1000000 ? (GB(1) / size) : 1000000;
+        if(size >= MB(1)) reps = (GB(1) / 4) / size + 1;
+        r64 nsOld, nsPL, nsLibc;
+        
+        BENCH(nsOld, reps / 8 + 1, Bench_OldMemSet(dst, 0, size));
+        BENCH(nsPL, reps, PL_MemZero(dst, size));
+        BENCH(nsLibc, reps, memset(dst, 0, size); bench_sink += dst[rep_ & 63]);
+        printf("zero %8s %11.1f %9.1f %9.1f\n", Bench_SizeName(size, name, sizeof(name)),
+               size / nsOld, size / nsPL, size / nsLibc);
+        
+        BENCH(nsOld, reps / 8 + 1, Bench_OldMemCpy(src, dst, size));
+        BENCH(nsPL, reps, PL_MemCpy(src, dst, size));
+        BENCH(nsLibc, reps, memcpy(dst, src, size); bench_sink += dst[rep_ & 63]);
+        printf("copy %8s %11.1f %9.1f %9.1f\n", Bench_SizeName(size, name, sizeof(name)),
+               size / nsOld, size / nsPL, size / nsLibc);
+    }
+    
+    PL_Free(src);
+    PL_Free(dst);
+    PL_Free(ref);
+    return 0;
+}
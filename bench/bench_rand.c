@@ -0,0 +1,120 @@
+/*============================
+  PL_RandFillU32 / R32 / Range
+  every kernel checked against the single stream generator, timed against PL_RandU32 loops
+=============================*/
+#include "bench.h"
+
+typedef struct
+{
+    const char *name;
+    PL_RandFillFn *randFill;
+    PL_RandToR32Fn *randToR32;
+    PL_RandToRangeFn *randToRange;
+} Bench_RandKernel;
+
+#define BENCH_RAND_KERNEL(isa, name) {name, PL_RandFill##isa, PL_RandToR32##isa, PL_RandToRange##isa}
+static Bench_RandKernel bench_randKernels[] = BENCH_ISA_KERNELS(BENCH_RAND_KERNEL);
+
+static void Bench_UseKernel(Bench_RandKernel *kernel)
+{
+    pl_dispatch.randFill = kernel->randFill;
+    pl_dispatch.randToR32 = kernel->randToR32;
+    pl_dispatch.randToRange = kernel->randToRange;
+}
+
+#define BENCH_RAND_COUNT (16 * 1024) // per call, stays in L1/L2 so it's the generator being timed
+#define BENCH_RAND_CHECK_STEPS 4096
+
+static u32 bench_u32[BENCH_RAND_COUNT];
+static u32 bench_refU32[BENCH_RAND_COUNT];
+static r32 bench_r32[BENCH_RAND_COUNT];
+static r32 bench_refR32[BENCH_RAND_COUNT];
+
+// each lane is its own xoshiro256** stream, so a fill must match PL_RandU64 stepped lane by lane
+static void Bench_CheckKernel(Bench_RandKernel *kernel, PL_RandLanes *start)
+{
+    PL_RandLanes lanes = *start;
+    PL_RandState streams[PL_RAND_LANES];
+    for(int lane = 0; lane < PL_RAND_LANES; lane++)
+    {
+        for(int w = 0; w < 4; w++) streams[lane].s[w] = start->s[w][lane];
+    }
+    
+    static u64 fill[BENCH_RAND_CHECK_STEPS * PL_RAND_LANES];
+    kernel->randFill(&lanes, (u8*)fill, BENCH_RAND_CHECK_STEPS);
+    u64 mismatches = 0;
+    for(u64 step = 0; step < BENCH_RAND_CHECK_STEPS; step++)
+    {
+        for(int lane = 0; lane < PL_RAND_LANES; lane++)
+        {
+            mismatches += (fill[step * PL_RAND_LANES + lane] != PL_RandU64(&streams[lane]));
+        }
+    }
+    for(int lane = 0; lane < PL_RAND_LANES; lane++)
+    {
+        for(int w = 0; w < 4; w++) mismatches += (lanes.s[w][lane] != streams[lane].s[w]);
+    }
+    Bench_Check(!mismatches, "%s fill: %llu words differ from PL_RandU64", kernel->name, (unsigned long long)mismatches);
+    
+    // conversions against the Small reference, odd counts so the tails run, and small
+    // ranges that reject often so the spare redraws are checked too
+    u64 seed = 5;
+    for(u32 i = 0; i < BENCH_RAND_COUNT; i++) bench_refU32[i] = (u32)Bench_Rand(&seed);
+    u32 ranges[] = {1, 3, 10, 1000, 0x80000001u, 0xffffffffu};
+    for(u32 r = 0; r < PL_ArrayCount(ranges); r++)
+    {
+        u64 count = BENCH_RAND_COUNT - 13 * r;
+        PL_RandState spare = start->spare;
+        PL_RandState refSpare = start->spare;
+        kernel->randToRange(bench_u32, bench_refU32, count, ranges[r], &spare);
+        static u32 expected[BENCH_RAND_COUNT];
+        PL_RandToRangeSmall(expected, bench_refU32, count, ranges[r], &refSpare);
+        Bench_Check(!memcmp(bench_u32, expected, count * sizeof(u32)) && !memcmp(&spare, &refSpare, sizeof(spare)),
+                    "%s range %u differs from the scalar reference", kernel->name, ranges[r]);
+    }
+    
+    kernel->randToR32(bench_r32, bench_refU32, BENCH_RAND_COUNT - 7);
+    PL_RandToR32Small(bench_refR32, bench_refU32, BENCH_RAND_COUNT - 7);
+    Bench_Check(!memcmp(bench_r32, bench_refR32, (BENCH_RAND_COUNT - 7) * sizeof(r32)),
+                "%s r32 differs from the scalar reference", kernel->name);
+    
+    printf("%s: fill checked against PL_RandU64 per lane, r32/range against the scalar reference\n", kernel->name);
+}
+
+static int Bench_Main(void)
+{
+    PL_Dispatch dispatch = pl_dispatch;
+    PL_RandState state;
+    PL_RandSeed(&state, 42);
+    PL_RandLanes lanes;
+    PL_RandLanesInit(&lanes, &state);
+    
+    Bench_RandKernel *kernels = bench_randKernels;
+    u32 kernelCount = PL_ArrayCount(bench_randKernels);
+    for(u32 k = 0; k < kernelCount; k++) if(Bench_IsaSupported(k)) Bench_CheckKernel(&kernels[k], &lanes);
+    
+    u64 reps = 2000;
+    printf("\nnumbers per ns, %u per call       u32    r32  range 1000\n", BENCH_RAND_COUNT);
+    
+    r64 nsU32, nsR32, nsRange;
+    BENCH(nsU32, reps, for(u32 i = 0; i < BENCH_RAND_COUNT; i++) bench_u32[i] = PL_RandU32(&state));
+    BENCH(nsR32, reps, for(u32 i = 0; i < BENCH_RAND_COUNT; i++) bench_r32[i] = PL_RandR32(&state));
+    BENCH(nsRange, reps, for(u32 i = 0; i < BENCH_RAND_COUNT; i++) bench_u32[i] = PL_RandRange(&state, 1000));
+    printf("PL_RandXxx loop               %7.2f %6.2f %11.2f\n",
+           BENCH_RAND_COUNT / nsU32, BENCH_RAND_COUNT / nsR32, BENCH_RAND_COUNT / nsRange);
+    
+    for(u32 k = 0; k < kernelCount; k++)
+    {
+        if(!Bench_IsaSupported(k)) continue;
+        Bench_UseKernel(&kernels[k]);
+        BENCH(nsU32, reps, PL_RandFillU32(&lanes, bench_u32, BENCH_RAND_COUNT));
+        BENCH(nsR32, reps, PL_RandFillR32(&lanes, bench_r32, BENCH_RAND_COUNT));
+        BENCH(nsRange, reps, PL_RandFillRange(&lanes, bench_u32, BENCH_RAND_COUNT, 1000));
+        printf("PL_RandFillXxx %-14s %7.2f %6.2f %11.2f\n", kernels[k].name,
+               BENCH_RAND_COUNT / nsU32, BENCH_RAND_COUNT / nsR32, BENCH_RAND_COUNT / nsRange);
+    }
+    pl_dispatch = dispatch;
+    
+    bench_sink += bench_u32[7] + (u64)bench_r32[9];
+    return 0;
+}
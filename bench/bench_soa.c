@@ -0,0 +1,193 @@
+/*============================
+  PL_V2ArrayIntegrate / Reflect / Overlap
+  over 1M entities, every kernel checked against the scalar reference, timed against an AoS loop
+=============================*/
+#include "bench.h"
+
+static void Bench_V2IntegrateSmall(r32 *xs, r32 *ys, const r32 *vxs, const r32 *vys, u64 n, r32 dt)
+{
+    PL_V2IntegrateSmall(xs, ys, vxs, vys, n, dt);
+}
+
+static void Bench_V2ReflectSmall(r32 *xs, r32 *ys, r32 *vxs, r32 *vys, u64 n, v2 min, v2 max)
+{
+    PL_V2ReflectSmall(xs, ys, vxs, vys, n, min, max);
+}
+
+static void Bench_V2OverlapSmall(u64 *mask, const r32 *xs, const r32 *ys, const r32 *hws, const r32 *hhs, u64 n, v2 min, v2 max)
+{
+    PL_V2OverlapSmall(mask, xs, ys, hws, hhs, n, min, max);
+}
+
+typedef struct
+{
+    const char *name;
+    PL_V2IntegrateFn *integrate;
+    PL_V2ReflectFn *reflect;
+    PL_V2OverlapFn *overlap;
+} Bench_SoAKernel;
+
+// the inline versions are the reference the kernels have to match bit for bit
+static Bench_SoAKernel bench_soaReference = {"inline", Bench_V2IntegrateSmall, Bench_V2ReflectSmall, Bench_V2OverlapSmall};
+#define BENCH_SOA_KERNEL(isa, name) {name, PL_V2Integrate##isa, PL_V2Reflect##isa, PL_V2Overlap##isa}
+static Bench_SoAKernel bench_soaKernels[] = BENCH_ISA_KERNELS(BENCH_SOA_KERNEL);
+
+// the LameBall style layout the kernels replace
+typedef struct
+{
+    v2 pos, vel, half;
+} Bench_Entity;
+
+typedef struct
+{
+    r32 *xs, *ys, *vxs, *vys, *hws, *hhs;
+} Bench_SoA;
+
+#define BENCH_SOA_ENTITIES (1024 * 1024)
+#define BENCH_SOA_STEPS 8
+
+static void Bench_SoAAlloc(Bench_SoA *soa)
+{
+    r32 **arrays[] = {&soa->xs, &soa->ys, &soa->vxs, &soa->vys, &soa->hws, &soa->hhs};
+    for(u32 i = 0; i < PL_ArrayCount(arrays); i++) *arrays[i] = (r32*)PL_Alloc(BENCH_SOA_ENTITIES * sizeof(r32));
+}
+
+static void Bench_SoAFree(Bench_SoA *soa)
+{
+    r32 *arrays[] = {soa->xs, soa->ys, soa->vxs, soa->vys, soa->hws, soa->hhs};
+    for(u32 i = 0; i < PL_ArrayCount(arrays); i++) PL_Free(arrays[i]);
+}
+
+static void Bench_SoACopy(Bench_SoA *dst, Bench_SoA *src, u64 n)
+{
+    memcpy(dst->xs, src->xs, n * sizeof(r32));
+    memcpy(dst->ys, src->ys, n * sizeof(r32));
+    memcpy(dst->vxs, src->vxs, n * sizeof(r32));
+    memcpy(dst->vys, src->vys, n * sizeof(r32));
+    memcpy(dst->hws, src->hws, n * sizeof(r32));
+    memcpy(dst->hhs, src->hhs, n * sizeof(r32));
+}
+
+static b32 Bench_SoAEqual(Bench_SoA *a, Bench_SoA *b, u64 n)
+{
+    return !memcmp(a->xs, b->xs, n * sizeof(r32)) && !memcmp(a->ys, b->ys, n * sizeof(r32)) &&
+        !memcmp(a->vxs, b->vxs, n * sizeof(r32)) && !memcmp(a->vys, b->vys, n * sizeof(r32));
+}
+
+// steps every kernel from the same start and wants the scalar reference bit for bit,
+// odd counts so the tails run and a few nans and far outliers in the mix
+static void Bench_CheckKernels(Bench_SoA *start, v2 min, v2 max)
+{
+    Bench_SoAKernel *reference = &bench_soaReference;
+    Bench_SoAKernel *kernels = bench_soaKernels;
+    Bench_SoA ref, test;
+    Bench_SoAAlloc(&ref);
+    Bench_SoAAlloc(&test);
+    u64 *refMask = (u64*)PL_Alloc((BENCH_SOA_ENTITIES / 64 + 1) * sizeof(u64));
+    u64 *testMask = (u64*)PL_Alloc((BENCH_SOA_ENTITIES / 64 + 1) * sizeof(u64));
+    u64 counts[] = {0, 1, 7, 9, 63, 65, 1000, BENCH_SOA_ENTITIES - 3};
+    v2 boxMin = v2r(300, 200), boxMax = v2r(700, 500);
+    
+    for(u32 c = 0; c < PL_ArrayCount(counts); c++)
+    {
+        u64 n = counts[c];
+        u64 words = (n + 63) / 64;
+        Bench_SoACopy(&ref, start, n);
+        for(u32 step = 0; step < BENCH_SOA_STEPS; step++)
+        {
+            reference->integrate(ref.xs, ref.ys, ref.vxs, ref.vys, n, 1.0f / 60.0f);
+            reference->reflect(ref.xs, ref.ys, ref.vxs, ref.vys, n, min, max);
+        }
+        reference->overlap(refMask, ref.xs, ref.ys, ref.hws, ref.hhs, n, boxMin, boxMax);
+        
+        for(u32 k = 0; k < PL_ArrayCount(bench_soaKernels); k++)
+        {
+            if(!Bench_IsaSupported(k)) continue;
+            Bench_SoACopy(&test, start, n);
+            for(u32 step = 0; step < BENCH_SOA_STEPS; step++)
+            {
+                kernels[k].integrate(test.xs, test.ys, test.vxs, test.vys, n, 1.0f / 60.0f);
+                kernels[k].reflect(test.xs, test.ys, test.vxs, test.vys, n, min, max);
+            }
+            Bench_Check(Bench_SoAEqual(&ref, &test, n), "%s integrate/reflect differs from scalar at n %llu",
+                        kernels[k].name, (unsigned long long)n);
+            
+            kernels[k].overlap(testMask, ref.xs, ref.ys, ref.hws, ref.hhs, n, boxMin, boxMax);
+            Bench_Check(!memcmp(refMask, testMask, words * sizeof(u64)), "%s overlap differs from scalar at n %llu",
+                        kernels[k].name, (unsigned long long)n);
+        }
+    }
+    
+    for(u32 k = 0; k < PL_ArrayCount(bench_soaKernels); k++)
+    {
+        if(Bench_IsaSupported(k)) printf("%s: bit identical to the scalar reference\n", kernels[k].name);
+    }
+    Bench_SoAFree(&ref);
+    Bench_SoAFree(&test);
+    PL_Free(refMask);
+    PL_Free(testMask);
+}
+
+static int Bench_Main(void)
+{
+    v2 min = v2r(0, 0), max = v2r(1280, 720);
+    Bench_SoA start;
+    Bench_SoAAlloc(&start);
+    Bench_Entity *entities = (Bench_Entity*)PL_Alloc(BENCH_SOA_ENTITIES * sizeof(Bench_Entity));
+    u64 *mask = (u64*)PL_Alloc((BENCH_SOA_ENTITIES / 64 + 1) * sizeof(u64));
+    
+    u64 seed = 21;
+    for(u64 i = 0; i < BENCH_SOA_ENTITIES; i++)
+    {
+        start.xs[i] = Bench_RandR32(&seed, -10, 1290);
+        start.ys[i] = Bench_RandR32(&seed, -10, 730);
+        start.vxs[i] = Bench_RandR32(&seed, -600, 600);
+        start.vys[i] = Bench_RandR32(&seed, -600, 600);
+        start.hws[i] = Bench_RandR32(&seed, 1, 16);
+        start.hhs[i] = Bench_RandR32(&seed, 1, 16);
+        if(!(i % 997)) start.xs[i] = NAN;
+        if(!(i % 1009)) start.ys[i] = -1e30f;
+        entities[i] = (Bench_Entity){{{start.xs[i], start.ys[i]}}, {{start.vxs[i], start.vys[i]}},
+                                     {{start.hws[i], start.hhs[i]}}};
+    }
+    
+    Bench_CheckKernels(&start, min, max);
+    
+    r32 dt = 1.0f / 60.0f;
+    v2 boxMin = v2r(300, 200), boxMax = v2r(700, 500);
+    u64 n = BENCH_SOA_ENTITIES;
+    u64 reps = 20;
+    r64 nsIntegrate, nsReflect, nsOverlap;
+    
+    printf("\nns per entity, %lluM entities   integrate reflect overlap\n", (unsigned long long)(n >> 20));
+    BENCH(nsIntegrate, reps, for(u64 i = 0; i < n; i++) entities[i].pos = v2add(entities[i].pos, v2mul(entities[i].vel, dt)));
+    BENCH(nsReflect, reps, for(u64 i = 0; i < n; i++)
+          {
+              PL_ReflectOne(&entities[i].pos.x, &entities[i].vel.x, min.x, max.x);
+              PL_ReflectOne(&entities[i].pos.y, &entities[i].vel.y, min.y, max.y);
+          });
+    BENCH(nsOverlap, reps, for(u64 i = 0; i < n; i++)
+          {
+              Bench_Entity *e = &entities[i];
+              bench_sink += (e->pos.x - e->half.x <= boxMax.x) & (e->pos.x + e->half.x >= boxMin.x) &
+                  (e->pos.y - e->half.y <= boxMax.y) & (e->pos.y + e->half.y >= boxMin.y);
+          });
+    printf("AoS v2 loop %25.3f %7.3f %7.3f\n", nsIntegrate / n, nsReflect / n, nsOverlap / n);
+    
+    // the reference, then the kernels
+    for(u32 k = 0; k <= PL_ArrayCount(bench_soaKernels); k++)
+    {
+        if(k && !Bench_IsaSupported(k - 1)) continue;
+        Bench_SoAKernel *kernel = k ? &bench_soaKernels[k - 1] : &bench_soaReference;
+        BENCH(nsIntegrate, reps, kernel->integrate(start.xs, start.ys, start.vxs, start.vys, n, dt));
+        BENCH(nsReflect, reps, kernel->reflect(start.xs, start.ys, start.vxs, start.vys, n, min, max));
+        BENCH(nsOverlap, reps, kernel->overlap(mask, start.xs, start.ys, start.hws, start.hhs, n, boxMin, boxMax));
+        printf("SoA %-8s %24.3f %7.3f %7.3f\n", kernel->name, nsIntegrate / n, nsReflect / n, nsOverlap / n);
+    }
+    
+    bench_sink += mask[3];
+    Bench_SoAFree(&start);
+    PL_Free(entities);
+    PL_Free(mask);
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*============================
+  PL_StrAppend* number formatting
+  checked against snprintf, timed against snprintf
+=============================*/
+#include "bench.h"
+
+#define BENCH_STR_CHECKS 2000000
+
+static char bench_pl[PL_FMT_BUFFER_SIZE * 2];
+static char bench_ref[PL_FMT_BUFFER_SIZE * 2];
+
+static b32 Bench_CheckR64(r64 value, u32 decimals)
+{
+    PL_Str str = PL_StrBuffer(bench_pl, sizeof(bench_pl));
+    PL_StrAppendR64(&str, value, decimals);
+    snprintf(bench_ref, sizeof(bench_ref), "%.*f", (int)decimals, value);
+    return Bench_Check(!strcmp(bench_pl, bench_ref), "r64 %.17g .%u: PL %s printf %s",
+                       value, decimals, bench_pl, bench_ref);
+}
+
+static void Bench_CheckFormats(void)
+{
+    u64 seed = 7;
+    u32 failures = (u32)bench_failures;
+    
+    for(u32 i = 0; i < BENCH_STR_CHECKS && bench_failures < (int)failures + 10; i++)
+    {
+        // random widths so small values are as common as large ones
+        u64 bits = Bench_Rand(&seed) >> (Bench_Rand(&seed) & 63);
+        PL_Str str = PL_StrBuffer(bench_pl, sizeof(bench_pl));
+        
+        PL_StrAppendU64(&str, bits);
+        snprintf(bench_ref, sizeof(bench_ref), "%llu", (unsigned long long)bits);
+        Bench_Check(!strcmp(bench_pl, bench_ref), "u64 %s vs %s", bench_pl, bench_ref);
+        
+        PL_StrClear(&str);
+        i64 signedValue = (i64)(bits ^ ((i & 1) ? 0x8000000000000000ULL : 0));
+        PL_StrAppendI64(&str, signedValue);
+        snprintf(bench_ref, sizeof(bench_ref), "%lld", (long long)signedValue);
+        Bench_Check(!strcmp(bench_pl, bench_ref), "i64 %s vs %s", bench_pl, bench_ref);
+        
+        u32 digits = (u32)(Bench_Rand(&seed) % 17);
+        PL_StrClear(&str);
+        PL_StrAppendHex(&str, bits, digits);
+        snprintf(bench_ref, sizeof(bench_ref), "%0*llx", (int)digits, (unsigned long long)bits);
+        Bench_Check(!strcmp(bench_pl, bench_ref), "hex %s vs %s", bench_pl, bench_ref);
+        
+        // random magnitudes from 1e-12 to 1e18
+        u32 decimals = (u32)(Bench_Rand(&seed) % 10);
+        r64 value = ldexp((r64)(Bench_Rand(&seed) >> 11), (int)(Bench_Rand(&seed) % 100) - 93);
+        if(value >= 1e18) value *= 1e-6;
+        Bench_CheckR64((i & 2) ? -value : value, decimals);
+        
+        // decimal ties k.5 / 10^decimals and their neighbours, where rounding goes wrong
+        decimals = (u32)(Bench_Rand(&seed) % 10);
+        r64 tie = ((r64)(Bench_Rand(&seed) % 100000000) + 0.5) / (r64)pl_pow10[decimals];
+        Bench_CheckR64(tie, decimals);
+        Bench_CheckR64(nextafter(tie, 0.0), decimals);
+        Bench_CheckR64(nextafter(tie, 1e300), decimals);
+        
+        // exact binary ties (x.5, x.25, x.125 ...)
+        u32 shift = 1 + (u32)(Bench_Rand(&seed) % 30);
+        r64 binaryTie = (r64)((Bench_Rand(&seed) >> 34) | 1) / (r64)(1ULL << shift);
+        Bench_CheckR64(binaryTie, (u32)(Bench_Rand(&seed) % 10));
+    }
+    
+    r64 special[] = {0.0, -0.0, -0.001, 0.15, 0.45, 2.5, 3.5, -2.5, 0.125, 1e17 + 0.5, 999999999.9999999995,
+                     9.9999999995, 1e18, -1e300, INFINITY, -INFINITY, NAN};
+    for(u32 i = 0; i < PL_ArrayCount(special); i++)
+    {
+        for(u32 decimals = 0; decimals <= PL_FMT_MAX_DECIMALS; decimals++) Bench_CheckR64(special[i], decimals);
+    }
+    
+    printf("u64/i64/hex/r64 checked against snprintf: %u values of each, %d mismatches\n",
+           BENCH_STR_CHECKS, bench_failures - (int)failures);
+}
+
+#define BENCH_STR_VALUES 4096
+
+static int Bench_Main(void)
+{
+    Bench_CheckFormats();
+    
+    static u64 ints[BENCH_STR_VALUES];
+    static r32 reals[BENCH_STR_VALUES];
+    u64 seed = 3;
+    for(u32 i = 0; i < BENCH_STR_VALUES; i++)
+    {
+        ints[i] = Bench_Rand(&seed) >> (Bench_Rand(&seed) & 63);
+        reals[i] = Bench_RandR32(&seed, 0.0f, 100.0f);
+    }
+    
+    char buffer[128];
+    PL_Str str = PL_StrBuffer(buffer, sizeof(buffer));
+    u32 mask = BENCH_STR_VALUES - 1;
+    u64 reps = 2000000;
+    r64 nsPrintf, nsPL;
+    
+    printf("\nns per call, including buffer setup   snprintf      PL\n");
+    BENCH(nsPrintf, reps, bench_sink += snprintf(buffer, sizeof(buffer), "%llu", (unsigned long long)ints[rep_ & mask]));
+    BENCH(nsPL, reps, PL_StrClear(&str); PL_StrAppendU64(&str, ints[rep_ & mask]); bench_sink += str.len);
+    printf("u64                                  %9.1f %7.1f\n", nsPrintf, nsPL);
+    
+    BENCH(nsPrintf, reps, bench_sink += snprintf(buffer, sizeof(buffer), "%08llx", (unsigned long long)ints[rep_ & mask]));
+    BENCH(nsPL, reps, PL_StrClear(&str); PL_StrAppendHex(&str, ints[rep_ & mask], 8); bench_sink += str.len);
+    printf("hex %%08llx                           %9.1f %7.1f\n", nsPrintf, nsPL);
+    
+    BENCH(nsPrintf, reps, bench_sink += snprintf(buffer, sizeof(buffer), "%.2f", reals[rep_ & mask]));
+    BENCH(nsPL, reps, PL_StrClear(&str); PL_StrAppendR32(&str, reals[rep_ & mask], 2); bench_sink += str.len);
+    printf("r32 %%.2f                             %9.1f %7.1f\n", nsPrintf, nsPL);
+    
+    // a HUD line
+    BENCH(nsPrintf, reps, bench_sink += snprintf(buffer, sizeof(buffer), "score %u  %.2f ms",
+                                                 (u32)ints[rep_ & mask], reals[rep_ & mask]));
+    BENCH(nsPL, reps, PL_StrClear(&str); PL_StrAppend(&str, "score "); PL_StrAppendU64(&str, (u32)ints[rep_ & mask]);
+          PL_StrAppend(&str, "  "); PL_StrAppendR32(&str, reals[rep_ & mask], 2); PL_StrAppend(&str, " ms");
+          bench_sink += str.len);
+    printf("\"score %%u  %%.2f ms\"                   %9.1f %7.1f\n", nsPrintf, nsPL);
+    
+    return 0;
+}
@@ -0,0 +1,122 @@
+/*============================
+  PL_StrLen / PL_StrNLen
+  every kernel checked next to an unmapped page, timed against the old byte loop and libc
+=============================*/
+#include "bench.h"
+#if !defined(PL_WINDOWS)
+#include <sys/mman.h>
+#endif
+
+// PL_StrLen before the kernels
+BENCH_BYTELOOP static u64 Bench_OldStrLen(cstr str)
+{
+    u64 result = 0;
+    for(cstr c = str; *c != 0; c++)
+    {
+        result++;
+    }
+    return result;
+}
+
+typedef struct
+{
+    const char *name;
+    PL_StrNLenFn *strNLen;
+} Bench_StrKernel;
+
+#define BENCH_STR_KERNEL(isa, name) {name, PL_StrNLen##isa}
+static Bench_StrKernel bench_strKernels[] = BENCH_ISA_KERNELS(BENCH_STR_KERNEL);
+
+// one readable page followed by one that faults on any access
+static char *Bench_GuardedPage(u64 pageSize)
+{
+#if defined(PL_WINDOWS)
+    char *pages = (char*)VirtualAlloc(0, pageSize * 2, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    DWORD oldProtect;
+    if(!pages || !VirtualProtect(pages + pageSize, pageSize, PAGE_NOACCESS, &oldProtect)) return 0;
+#else
+    char *pages = (char*)mmap(0, pageSize * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(pages == MAP_FAILED || mprotect(pages + pageSize, pageSize, PROT_NONE)) return 0;
+#endif
+    return pages;
+}
+
+#define BENCH_STRLEN_CHECKS 200000
+
+static int Bench_Main(void)
+{
+    u64 pageSize = PL_GetSystemInfo()->pageSize;
+    char *page = Bench_GuardedPage(pageSize);
+    if(!Bench_Check(page != 0, "couldn't map a guarded page")) return 1;
+    
+    Bench_StrKernel *kernels = bench_strKernels;
+    u32 kernelCount = PL_ArrayCount(bench_strKernels);
+    u64 seed = 5;
+    for(u32 k = 0; k < kernelCount; k++)
+    {
+        if(!Bench_IsaSupported(k)) continue;
+        u32 failures = (u32)bench_failures;
+        
+        // terminator in the last byte of the page, scanned from every start offset
+        memset(page, 'a', pageSize);
+        page[pageSize - 1] = 0;
+        for(u64 start = 0; start < pageSize && bench_failures < (int)failures + 10; start++)
+        {
+            u64 len = pageSize - 1 - start;
+            u64 got = kernels[k].strNLen(page + start, UINT64_MAX);
+            Bench_Check(got == len, "%s terminated at page end, start %llu: %llu, expected %llu",
+                        kernels[k].name, (unsigned long long)start, (unsigned long long)got, (unsigned long long)len);
+            got = kernels[k].strNLen(page + start, len + 1);
+            Bench_Check(got == len, "%s terminated at page end, start %llu max %llu: %llu",
+                        kernels[k].name, (unsigned long long)start, (unsigned long long)(len + 1),
+                        (unsigned long long)got);
+        }
+        
+        // no terminator, max stops exactly at the page edge
+        page[pageSize - 1] = 'a';
+        for(u64 start = 0; start < pageSize && bench_failures < (int)failures + 10; start++)
+        {
+            u64 max = pageSize - start;
+            u64 got = kernels[k].strNLen(page + start, max);
+            Bench_Check(got == max, "%s unterminated, start %llu max %llu: %llu",
+                        kernels[k].name, (unsigned long long)start, (unsigned long long)max, (unsigned long long)got);
+        }
+        
+        // random terminators and limits near the end of the page
+        for(u32 i = 0; i < BENCH_STRLEN_CHECKS && bench_failures < (int)failures + 10; i++)
+        {
+            memset(page + pageSize - 512, 'a', 512);
+            u64 start = pageSize - 1 - (Bench_Rand(&seed) % 511);
+            u64 end = start + Bench_Rand(&seed) % (pageSize - start);
+            page[end] = 0;
+            u64 max = Bench_Rand(&seed) % (end - start + 2);
+            u64 len = end - start;
+            u64 expected = len < max ? len : max;
+            u64 got = kernels[k].strNLen(page + start, max);
+            Bench_Check(got == expected, "%s start %llu len %llu max %llu: %llu",
+                        kernels[k].name, (unsigned long long)start, (unsigned long long)len,
+                        (unsigned long long)max, (unsigned long long)got);
+        }
+        
+        printf("%s: checked against a guard page, every start offset\n", kernels[k].name);
+    }
+    
+    u64 lengths[] = {8, 64, 1000, 4000};
+    printf("\nns per call      old loop        PL      libc\n");
+    for(u32 l = 0; l < PL_ArrayCount(lengths); l++)
+    {
+        // string ends at the guard page
+        char *str = page + pageSize - 1 - lengths[l];
+        memset(page, 'a', pageSize);
+        page[pageSize - 1] = 0;
+        u64 reps = 4000000 / (lengths[l] / 8 + 1) + 1000;
+        r64 nsOld, nsPL, nsLibc;
+        
+        BENCH(nsOld, reps, bench_sink += Bench_OldStrLen(str));
+        BENCH(nsPL, reps, bench_sink += PL_StrLen(str));
+        BENCH(nsLibc, reps, bench_sink += strlen(str));
+        printf("strlen %5llu %11.1f %9.1f %9.1f\n", (unsigned long long)lengths[l], nsOld, nsPL, nsLibc);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*============================
+  PL_sinFast / PL_cosFast / PL_atan2Fast and the array versions
+  accuracy against libm in double, every kernel checked against the scalar version, speed per value
+=============================*/
+#include "bench.h"
+
+typedef struct
+{
+    const char *name;
+    PL_SinCosFn *sinCos;
+    PL_Atan2Fn *atan2;
+} Bench_TrigKernel;
+
+#define BENCH_TRIG_KERNEL(isa, name) {name, PL_SinCos##isa, PL_Atan2##isa}
+static Bench_TrigKernel bench_trigKernels[] = BENCH_ISA_KERNELS(BENCH_TRIG_KERNEL);
+
+#define BENCH_TRIG_COUNT (1024 * 1024)
+#define BENCH_TRIG_SPECIALS 16
+
+static r32 bench_src[BENCH_TRIG_COUNT];
+static r32 bench_src2[BENCH_TRIG_COUNT];
+static r32 bench_dst[BENCH_TRIG_COUNT];
+static r32 bench_ref[BENCH_TRIG_COUNT];
+
+// the edges of atan2, checked against atan2f exactly (up to the polynomial error)
+static const r32 bench_atan2Specials[BENCH_TRIG_SPECIALS][2] =
+{
+    {INFINITY, INFINITY}, {INFINITY, -INFINITY}, {-INFINITY, INFINITY}, {-INFINITY, -INFINITY},
+    {1.0f, INFINITY}, {-1.0f, -INFINITY}, {INFINITY, 1.0f}, {-INFINITY, -1.0f},
+    {0.0f, 0.0f}, {-0.0f, 0.0f}, {0.0f, -0.0f}, {-0.0f, -0.0f},
+    {0.0f, -1.0f}, {-0.0f, -1.0f}, {1e-30f, 1e30f}, {1e30f, -1e-30f},
+};
+
+static int Bench_Main(void)
+{
+    u64 seed = 17;
+    
+    // max absolute error over growing ranges up to where the range reduction gives out,
+    // libm sinf alongside so the numbers have a scale
+    r32 ranges[] = {PL_PI_R32, 8192.0f, 100000.0f, 1e6f, 6.5e6f};
+    printf("max abs error vs double sin/cos   PL_sinFast  PL_cosFast   sinf\n");
+    for(u32 r = 0; r < PL_ArrayCount(ranges); r++)
+    {
+        r64 errSin = 0, errCos = 0, errLibm = 0;
+        for(u32 i = 0; i < BENCH_TRIG_COUNT; i++)
+        {
+            r32 a = Bench_RandR32(&seed, -ranges[r], ranges[r]);
+            errSin = fmax(errSin, fabs((r64)PL_sinFast(a) - sin((r64)a)));
+            errCos = fmax(errCos, fabs((r64)PL_cosFast(a) - cos((r64)a)));
+            errLibm = fmax(errLibm, fabs((r64)sinf(a) - sin((r64)a)));
+        }
+        printf("|a| <= %-12g %25.2e %11.2e %8.2e\n", ranges[r], errSin, errCos, errLibm);
+        r64 bound = (r < 2) ? 1e-7 : (r == 2) ? 1e-6 : (r == 3) ? 0.04 : 0.3;
+        Bench_Check(errSin < bound && errCos < bound,
+                    "sin/cos error %g/%g past the documented bound for |a| <= %g", errSin, errCos, ranges[r]);
+    }
+    
+    r64 errAtan2 = 0, errAtan2Libm = 0;
+    for(u32 i = 0; i < BENCH_TRIG_COUNT; i++)
+    {
+        // spread over magnitudes so every octant and ratio gets hit
+        r32 y = ldexpf(Bench_RandR32(&seed, -1, 1), (int)(Bench_Rand(&seed) % 40) - 20);
+        r32 x = ldexpf(Bench_RandR32(&seed, -1, 1), (int)(Bench_Rand(&seed) % 40) - 20);
+        errAtan2 = fmax(errAtan2, fabs((r64)PL_atan2Fast(y, x) - atan2((r64)y, (r64)x)));
+        errAtan2Libm = fmax(errAtan2Libm, fabs((r64)atan2f(y, x) - atan2((r64)y, (r64)x)));
+    }
+    printf("max abs error vs double atan2     PL_atan2Fast %.2e, atan2f %.2e\n", errAtan2, errAtan2Libm);
+    Bench_Check(errAtan2 < 3e-7, "atan2 error %g past the documented bound", errAtan2);
+    
+    for(u32 i = 0; i < BENCH_TRIG_SPECIALS; i++)
+    {
+        r32 y = bench_atan2Specials[i][0], x = bench_atan2Specials[i][1];
+        r32 result = PL_atan2Fast(y, x);
+        r32 expected = atan2f(y, x);
+        Bench_Check(fabsf(result - expected) < 3e-7f && signbit(result) == signbit(expected),
+                    "atan2(%g, %g) = %g, atan2f gives %g", y, x, result, expected);
+    }
+    printf("atan2 matches atan2f on infinities and signed zeros\n");
+    
+    // every kernel bit for bit against the scalar versions, odd count so the tails run,
+    // the atan2 edge cases at the front
+    u64 n = BENCH_TRIG_COUNT - 5;
+    for(u32 i = 0; i < BENCH_TRIG_COUNT; i++)
+    {
+        bench_src[i] = ldexpf(Bench_RandR32(&seed, -1, 1), (int)(Bench_Rand(&seed) % 44) - 20);
+        bench_src2[i] = ldexpf(Bench_RandR32(&seed, -1, 1), (int)(Bench_Rand(&seed) % 44) - 20);
+    }
+    for(u32 i = 0; i < BENCH_TRIG_SPECIALS; i++)
+    {
+        bench_src[i] = bench_atan2Specials[i][0];
+        bench_src2[i] = bench_atan2Specials[i][1];
+    }
+    Bench_TrigKernel *kernels = bench_trigKernels;
+    u32 kernelCount = PL_ArrayCount(bench_trigKernels);
+    for(u32 k = 0; k < kernelCount; k++)
+    {
+        if(!Bench_IsaSupported(k)) continue;
+        for(u32 quadrant = 0; quadrant < 2; quadrant++)
+        {
+            PL_SinCosSmall(bench_ref, bench_src, n, quadrant);
+            kernels[k].sinCos(bench_dst, bench_src, n, quadrant);
+            Bench_Check(!memcmp(bench_dst, bench_ref, n * sizeof(r32)), "%s %s differs from the scalar version",
+                        kernels[k].name, quadrant ? "cos" : "sin");
+        }
+        PL_Atan2Small(bench_ref, bench_src, bench_src2, n);
+        kernels[k].atan2(bench_dst, bench_src, bench_src2, n);
+        Bench_Check(!memcmp(bench_dst, bench_ref, n * sizeof(r32)), "%s atan2 differs from the scalar version", kernels[k].name);
+        printf("%s: bit identical to the scalar versions\n", kernels[k].name);
+    }
+    
+    // speed on angles a game would use
+    for(u32 i = 0; i < BENCH_TRIG_COUNT; i++)
+    {
+        bench_src[i] = Bench_RandR32(&seed, -100, 100);
+        bench_src2[i] = Bench_RandR32(&seed, -100, 100);
+    }
+    u64 reps = 20;
+    r64 nsSin, nsAtan2;
+    printf("\nns per value, %uK values        sin   atan2\n", BENCH_TRIG_COUNT / 1024);
+    BENCH(nsSin, reps, for(u32 i = 0; i < BENCH_TRIG_COUNT; i++) bench_dst[i] = sinf(bench_src[i]));
+    BENCH(nsAtan2, reps, for(u32 i = 0; i < BENCH_TRIG_COUNT; i++) bench_dst[i] = atan2f(bench_src[i], bench_src2[i]));
+    printf("libm loop %24.2f %7.2f\n", nsSin / BENCH_TRIG_COUNT, nsAtan2 / BENCH_TRIG_COUNT);
+    BENCH(nsSin, reps, for(u32 i = 0; i < BENCH_TRIG_COUNT; i++) bench_dst[i] = PL_sinFast(bench_src[i]));
+    BENCH(nsAtan2, reps, for(u32 i = 0; i < BENCH_TRIG_COUNT; i++) bench_dst[i] = PL_atan2Fast(bench_src[i], bench_src2[i]));
+    printf("PL_xxxFast loop %18.2f %7.2f\n", nsSin / BENCH_TRIG_COUNT, nsAtan2 / BENCH_TRIG_COUNT);
+    for(u32 k = 0; k < kernelCount; k++)
+    {
+        if(!Bench_IsaSupported(k)) continue;
+        BENCH(nsSin, reps, kernels[k].sinCos(bench_dst, bench_src, BENCH_TRIG_COUNT, 0));
+        BENCH(nsAtan2, reps, kernels[k].atan2(bench_dst, bench_src, bench_src2, BENCH_TRIG_COUNT));
+        printf("array %-8s %20.2f %7.2f\n", kernels[k].name, nsSin / BENCH_TRIG_COUNT, nsAtan2 / BENCH_TRIG_COUNT);
+    }
+    
+    bench_sink += (u64)bench_dst[5];
+    return 0;
+}
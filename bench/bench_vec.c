@@ -0,0 +1,114 @@
+/*============================
+  v2/v3/v4 maths
+  a per-entity update loop on the old out-of-line functions and on the inline PL.h ones
+=============================*/
+#include "bench.h"
+
+// the vector functions as they were in PL.c, noinline stands in for the call across
+// translation units every game file paid (v4dot/v4hadamard with their missing lanes fixed)
+#if defined(__GNUC__)
+#define BENCH_OUTOFLINE __attribute__((noinline))
+#else
+#define BENCH_OUTOFLINE __declspec(noinline)
+#endif
+
+BENCH_OUTOFLINE static v2 Bench_Oldv2add(v2 a, v2 b) {v2 result = {{a.i[0]+b.i[0], a.i[1]+b.i[1]}}; return result;}
+BENCH_OUTOFLINE static v2 Bench_Oldv2mul(v2 a, r32 v) {v2 result = {{a.i[0]*v, a.i[1]*v}}; return result;}
+BENCH_OUTOFLINE static r32 Bench_Oldv2dot(v2 a, v2 b) {return (a.i[0]*b.i[0]) + (a.i[1]*b.i[1]);}
+BENCH_OUTOFLINE static r32 Bench_Oldsqrt(r32 v) {return sqrtf(v);}
+BENCH_OUTOFLINE static r32 Bench_Oldv2length(v2 a) {return Bench_Oldsqrt(Bench_Oldv2dot(a, a));}
+BENCH_OUTOFLINE static v3 Bench_Oldv3add(v3 a, v3 b) {v3 result = {{a.i[0]+b.i[0], a.i[1]+b.i[1], a.i[2]+b.i[2]}}; return result;}
+BENCH_OUTOFLINE static v3 Bench_Oldv3mul(v3 a, r32 v) {v3 result = {{a.i[0]*v, a.i[1]*v, a.i[2]*v}}; return result;}
+BENCH_OUTOFLINE static r32 Bench_Oldv3dot(v3 a, v3 b) {return (a.i[0]*b.i[0]) + (a.i[1]*b.i[1]) + (a.i[2]*b.i[2]);}
+BENCH_OUTOFLINE static r32 Bench_Oldv3length(v3 a) {return Bench_Oldsqrt(Bench_Oldv3dot(a, a));}
+BENCH_OUTOFLINE static v4 Bench_Oldv4add(v4 a, v4 b) {v4 result = {{a.i[0]+b.i[0], a.i[1]+b.i[1], a.i[2]+b.i[2], a.i[3]+b.i[3]}}; return result;}
+BENCH_OUTOFLINE static v4 Bench_Oldv4mul(v4 a, r32 v) {v4 result = {{a.i[0]*v, a.i[1]*v, a.i[2]*v, a.i[3]*v}}; return result;}
+BENCH_OUTOFLINE static r32 Bench_Oldv4dot(v4 a, v4 b) {return (a.i[0]*b.i[0]) + (a.i[1]*b.i[1]) + (a.i[2]*b.i[2]) + (a.i[3]*b.i[3]);}
+
+typedef struct
+{
+    v2 pos, vel; // 2D sprite
+    v3 pos3, vel3; // 3D particle
+    v4 color, fade;
+    r32 brightness;
+} Bench_Entity;
+
+#define BENCH_VEC_ENTITIES 10000
+#define BENCH_VEC_MAX_SPEED 50.0f
+
+static Bench_Entity bench_old[BENCH_VEC_ENTITIES];
+static Bench_Entity bench_new[BENCH_VEC_ENTITIES];
+
+// the same update twice, one per set of functions
+#define BENCH_VEC_UPDATE(prefix, entities, dt) \
+for(u32 i = 0; i < BENCH_VEC_ENTITIES; i++) \
+{ \
+    Bench_Entity *e = &(entities)[i]; \
+    e->vel = prefix##v2add(e->vel, prefix##v2mul(gravity2, dt)); \
+    r32 speed = prefix##v2length(e->vel); \
+    if(speed > BENCH_VEC_MAX_SPEED) e->vel = prefix##v2mul(e->vel, BENCH_VEC_MAX_SPEED / speed); \
+    e->pos = prefix##v2add(e->pos, prefix##v2mul(e->vel, dt)); \
+    e->vel3 = prefix##v3add(e->vel3, prefix##v3mul(gravity3, dt)); \
+    r32 speed3 = prefix##v3length(e->vel3); \
+    if(speed3 > BENCH_VEC_MAX_SPEED) e->vel3 = prefix##v3mul(e->vel3, BENCH_VEC_MAX_SPEED / speed3); \
+    e->pos3 = prefix##v3add(e->pos3, prefix##v3mul(e->vel3, dt)); \
+    e->color = prefix##v4add(e->color, prefix##v4mul(e->fade, dt)); \
+    e->brightness = prefix##v4dot(e->color, luma); \
+}
+
+static void Bench_OldUpdate(Bench_Entity *entities, v2 gravity2, v3 gravity3, v4 luma, r32 dt)
+{
+    BENCH_VEC_UPDATE(Bench_Old, entities, dt)
+}
+
+static void Bench_NewUpdate(Bench_Entity *entities, v2 gravity2, v3 gravity3, v4 luma, r32 dt)
+{
+    BENCH_VEC_UPDATE(, entities, dt)
+}
+
+static int Bench_Main(void)
+{
+    u64 seed = 9;
+    for(u32 i = 0; i < BENCH_VEC_ENTITIES; i++)
+    {
+        Bench_Entity *e = &bench_old[i];
+        e->pos = v2r(Bench_RandR32(&seed, 0, 1280), Bench_RandR32(&seed, 0, 720));
+        e->vel = v2r(Bench_RandR32(&seed, -60, 60), Bench_RandR32(&seed, -60, 60));
+        e->pos3 = v3r(Bench_RandR32(&seed, -100, 100), Bench_RandR32(&seed, -100, 100), Bench_RandR32(&seed, -100, 100));
+        e->vel3 = v3r(Bench_RandR32(&seed, -60, 60), Bench_RandR32(&seed, -60, 60), Bench_RandR32(&seed, -60, 60));
+        e->color = v4r(Bench_RandR32(&seed, 0, 1), Bench_RandR32(&seed, 0, 1), Bench_RandR32(&seed, 0, 1), 1);
+        e->fade = v4r(0, 0, 0, -Bench_RandR32(&seed, 0, 0.5f));
+    }
+    memcpy(bench_new, bench_old, sizeof(bench_old));
+    
+    v2 gravity2 = v2r(0, -9.8f);
+    v3 gravity3 = v3r(0, -9.8f, 0);
+    v4 luma = v4r(0.299f, 0.587f, 0.114f, 0);
+    r32 dt = 1.0f / 60.0f;
+    
+    // the lane maths is the same, only v4dot's horizontal add order can differ in the last bit
+    u32 frames = 120;
+    for(u32 f = 0; f < frames; f++)
+    {
+        Bench_OldUpdate(bench_old, gravity2, gravity3, luma, dt);
+        Bench_NewUpdate(bench_new, gravity2, gravity3, luma, dt);
+    }
+    u32 mismatches = 0;
+    for(u32 i = 0; i < BENCH_VEC_ENTITIES; i++)
+    {
+        Bench_Entity *a = &bench_old[i], *b = &bench_new[i];
+        mismatches += memcmp(&a->pos, &b->pos, sizeof(a->pos)) || memcmp(&a->pos3, &b->pos3, sizeof(a->pos3)) ||
+            memcmp(&a->color, &b->color, sizeof(a->color)) || fabsf(a->brightness - b->brightness) > 1e-6f;
+    }
+    Bench_Check(!mismatches, "%u entities differ after %u frames", mismatches, frames);
+    printf("old and inline updates agree over %u entities, %u frames\n", BENCH_VEC_ENTITIES, frames);
+    
+    r64 nsOld, nsNew;
+    BENCH(nsOld, 200, Bench_OldUpdate(bench_old, gravity2, gravity3, luma, dt));
+    BENCH(nsNew, 200, Bench_NewUpdate(bench_new, gravity2, gravity3, luma, dt));
+    bench_sink += (u64)bench_old[1].brightness + (u64)bench_new[1].brightness;
+    
+    printf("\nns per entity update (v2 + v3 + v4)   old out-of-line  inline\n");
+    printf("%u entities %31.2f %7.2f\n", BENCH_VEC_ENTITIES, nsOld / BENCH_VEC_ENTITIES, nsNew / BENCH_VEC_ENTITIES);
+    return 0;
+}
@@ -0,0 +1,40 @@
+#!/bin/sh
+cd "$(dirname "$0")"
+
+mkdir -p build
+cd build
+
+OUTNAME=PhraglibTest
+DEBUG_BUILD=1
+SRC_NAME=lameball.c
+
+# -fcommon: PL.h defines the GL function pointers in every translation unit
+COPTS="-std=c11 -Wall -Wno-unused-parameter -Wno-missing-braces -Wno-pointer-sign -fcommon"
+LIBS="-lm -ldl"
+
+# ./build.sh bench: the benchmarks in bench/ (each includes PL.c itself), run them with -headless
+if [ "$1" = "bench" ]; then
+    for SRC in ../bench/bench_*.c; do
+        NAME=$(basename "$SRC" .c)
+        echo "$NAME"
+        cc -I../src -o "$NAME" -O2 $COPTS "$SRC" $LIBS || exit 1
+    done
+    exit 0
+fi
+
+if [ "$DEBUG_BUILD" = "1" ]; then
+    echo
+    echo "===== DEBUG ====="
+    echo
+    DBG_COPTS="-g -O0 $COPTS"
+    DBG_DEF="-DBUILD_DEBUG=1"
+    rm -f ./*
+    cc -I../src -o "$OUTNAME" $DBG_COPTS $DBG_DEF ../src/$SRC_NAME ../src/PL/PL.c $LIBS
+else
+    echo
+    echo "===== RELEASE ====="
+    echo
+    RLS_COPTS="-O2 $COPTS"
+    rm -f ./*
+    cc -I../src -o "$OUTNAME" $RLS_COPTS ../src/$SRC_NAME ../src/PL/PL.c $LIBS
+fi
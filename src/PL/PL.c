@@ -17,6 +17,10 @@ TODO:
 - macos
 */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // clock_gettime, localtime_r, malloc_usable_size
+#endif
+
 #include "PL.h"
 
 #include <stdlib.h>
@@ -29,3405 +33,9078 @@ TODO:
 #define PL_OPENGL_MAJ 4
 #define PL_OPENGL_MIN 5
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PL_ARCH_X86
+#if defined(PL_WINDOWS_MSVC)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define PL_ARCH_ARM64
+#include <arm_neon.h>
+#endif
+
+// linux gets the X11/GLX window when the headers are there, otherwise (or with
+// -DPL_NO_X11) it only runs headless
+#if defined(PL_LINUX) && !defined(PL_NO_X11)
+#if defined(__has_include)
+#if __has_include(<X11/Xlib.h>)
+#define PL_LINUX_X11
+#endif
+#else
+#define PL_LINUX_X11
+#endif
+#endif
+
+// count trailing zero bits (v != 0), count set bits
+#if defined(PL_WINDOWS_MSVC)
+static inline u32 PL_CTZ32(u32 v) {unsigned long i; _BitScanForward(&i, v); return (u32)i;}
+static inline u32 PL_CTZ64(u64 v) {unsigned long i; _BitScanForward64(&i, v); return (u32)i;}
+static inline u32 PL_POPCNT64(u64 v) // __popcnt64 needs a cpu check
+{
+    v -= (v >> 1) & 0x5555555555555555ULL;
+    v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+    v = (v + (v >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (u32)((v * 0x0101010101010101ULL) >> 56);
+}
+#else
+#define PL_CTZ32(v) ((u32)__builtin_ctz(v))
+#define PL_CTZ64(v) ((u32)__builtin_ctzll(v))
+#define PL_POPCNT64(v) ((u32)__builtin_popcountll(v))
+#endif
+
+static inline u64 PL_Min64(u64 a, u64 b) {return (a < b) ? a : b;}
+static inline u64 PL_Rotl64(u64 x, int k) {return (x << k) | (x >> (64 - k));}
+
+// functions using instructions above the compile target baseline (picked at runtime)
+#if defined(PL_ARCH_X86) && !defined(PL_WINDOWS_MSVC)
+#define PL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PL_TARGET(isa)
+#endif
+
+// kernels that deliberately read whole aligned blocks past the end of the data
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define PL_ASAN 1
+#endif
+#endif
+#if defined(PL_WINDOWS_MSVC) && defined(__SANITIZE_ADDRESS__)
+#define PL_NO_ASAN __declspec(no_sanitize_address)
+#elif defined(__SANITIZE_ADDRESS__) || defined(PL_ASAN)
+#define PL_NO_ASAN __attribute__((no_sanitize_address))
+#else
+#define PL_NO_ASAN
+#endif
+
 /*==========================
   Platform non-specific
 ==========================*/
 
-void PL_MemZero(ptr mem, u64 size)
+/*=========== CPU Features =============*/
+
+#if defined(PL_ARCH_X86)
+static void PL_CPUID(u32 leaf, u32 subleaf, u32 *regs)
+{
+#if defined(PL_WINDOWS_MSVC)
+    __cpuidex((int*)regs, (int)leaf, (int)subleaf);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// XCR0, which register states the OS saves on context switch
+static u64 PL_XGETBV(void)
 {
-    if(mem)
+#if defined(PL_WINDOWS_MSVC)
+    return _xgetbv(0);
+#else
+    u32 lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((u64)hi << 32) | lo;
+#endif
+}
+#endif
+
+// cpu type and instruction set extensions, the OS specific parts of PL_SystemInfo are filled by the platform
+static void PL_DetectCPUFeatures(PL_SystemInfo *info)
+{
+#if defined(PL_ARCH_X86)
+    info->cpu = (sizeof(ptr) == 8) ? CPU_AMD64 : CPU_I86;
+    
+    u32 regs[4] = {0};
+    PL_CPUID(0, 0, regs);
+    u32 maxLeaf = regs[0];
+    
+    PL_CPUID(1, 0, regs);
+    info->sse2 = (regs[3] >> 26) & 1;
+    info->sse42 = (regs[2] >> 20) & 1;
+    if(!info->cacheLineSize) info->cacheLineSize = ((regs[1] >> 8) & 0xff) * 8; // clflush line size
+    b32 osxsave = (regs[2] >> 27) & 1;
+    u64 xcr0 = osxsave ? PL_XGETBV() : 0;
+    b32 osymm = ((xcr0 & 0x06) == 0x06); // xmm, ymm state
+    b32 oszmm = ((xcr0 & 0xe6) == 0xe6); // + opmask, zmm state
+    info->avx = osymm && ((regs[2] >> 28) & 1);
+    info->fma = info->avx && ((regs[2] >> 12) & 1);
+    
+    if(maxLeaf >= 7)
     {
-        u8* byte = (u8*)(mem);
-        for(u64 i=0; i<size; i++)
-        {
-            *byte++ = 0;
-        }
+        PL_CPUID(7, 0, regs);
+        info->avx2 = info->avx && ((regs[1] >> 5) & 1);
+        info->avx512f = oszmm && ((regs[1] >> 16) & 1);
+    }
+    
+    PL_CPUID(0x80000000, 0, regs);
+    if(regs[0] >= 0x80000007)
+    {
+        PL_CPUID(0x80000007, 0, regs);
+        info->invariantTSC = (regs[3] >> 8) & 1;
     }
+#elif defined(PL_ARCH_ARM64)
+    info->cpu = CPU_ARM64;
+    info->neon = 1; // baseline on aarch64
+#if !defined(PL_WINDOWS_MSVC)
+    info->invariantTSC = 1; // generic timer, cntvct_el0 counts at the fixed cntfrq_el0
+#endif
+#elif defined(__arm__) || defined(_M_ARM)
+    info->cpu = CPU_ARM;
+#endif
+    
+    if(!info->cacheLineSize) info->cacheLineSize = 64;
 }
 
-ptr PL_MemSet(ptr mem, u8 value, u64 size)
+/*=========== Memory Kernels =============*/
+
+typedef void PL_MemSetFn(u8 *dst, u8 value, u64 size);
+typedef void PL_MemCpyFn(u8 *dst, const u8 *src, u64 size);
+typedef u64 PL_StrNLenFn(const char *str, u64 max);
+typedef void PL_RandFillFn(PL_RandLanes *lanes, u8 *dst, u64 steps);
+typedef void PL_RandToR32Fn(r32 *dst, const u32 *src, u64 count);
+typedef void PL_RandToRangeFn(u32 *dst, const u32 *src, u64 count, u32 range, PL_RandState *spare);
+typedef void PL_V2IntegrateFn(r32 *xs, r32 *ys, const r32 *vxs, const r32 *vys, u64 n, r32 dt);
+typedef void PL_V2ReflectFn(r32 *xs, r32 *ys, r32 *vxs, r32 *vys, u64 n, v2 min, v2 max);
+typedef void PL_V2OverlapFn(u64 *mask, const r32 *xs, const r32 *ys, const r32 *hws, const r32 *hhs, u64 n, v2 min, v2 max);
+typedef void PL_V4TransformFn(v4 *dst, const v4 *src, u64 n, const m4 *m);
+typedef void PL_SinCosFn(r32 *dst, const r32 *src, u64 n, u32 quadrant);
+typedef void PL_Atan2Fn(r32 *dst, const r32 *ys, const r32 *xs, u64 n);
+
+// kernels with a runtime choice of implementation, baseline versions until PL_InitDispatch
+typedef struct
 {
-    if(!mem || !size)
+    PL_MemSetFn *memSet;
+    PL_MemCpyFn *memCpy;
+    PL_StrNLenFn *strNLen;
+    PL_RandFillFn *randFill; // steps * PL_RAND_LANES u64s to dst
+    PL_RandToR32Fn *randToR32;
+    PL_RandToRangeFn *randToRange;
+    PL_V2IntegrateFn *v2Integrate;
+    PL_V2ReflectFn *v2Reflect;
+    PL_V2OverlapFn *v2Overlap; // (n+63)/64 mask words
+    PL_V4TransformFn *v4Transform;
+    PL_SinCosFn *sinCos; // quadrant 0 sin, 1 cos
+    PL_Atan2Fn *atan2;
+    // sizes from here up use non-temporal stores, the data won't fit in cache anyway
+    // so skipping the read-for-ownership and cache pollution wins
+    u64 nonTemporalMin;
+} PL_Dispatch;
+
+#if defined(PL_ARCH_X86) && (defined(__x86_64__) || defined(_M_X64)) // sse2 is baseline on x64
+static PL_MemSetFn PL_MemSetSSE2;
+static PL_MemCpyFn PL_MemCpySSE2;
+static PL_StrNLenFn PL_StrNLenSSE2;
+static PL_RandFillFn PL_RandFillSSE2;
+static PL_RandToR32Fn PL_RandToR32SSE2;
+static PL_RandToRangeFn PL_RandToRangeSSE2;
+static PL_V2IntegrateFn PL_V2IntegrateSSE2;
+static PL_V2ReflectFn PL_V2ReflectSSE2;
+static PL_V2OverlapFn PL_V2OverlapSSE2;
+static PL_V4TransformFn PL_V4TransformSSE2;
+static PL_SinCosFn PL_SinCosSSE2;
+static PL_Atan2Fn PL_Atan2SSE2;
+static PL_Dispatch pl_dispatch =
+{
+    PL_MemSetSSE2, PL_MemCpySSE2, PL_StrNLenSSE2,
+    PL_RandFillSSE2, PL_RandToR32SSE2, PL_RandToRangeSSE2,
+    PL_V2IntegrateSSE2, PL_V2ReflectSSE2, PL_V2OverlapSSE2, PL_V4TransformSSE2,
+    PL_SinCosSSE2, PL_Atan2SSE2, MB(8)
+};
+#elif defined(PL_ARCH_ARM64)
+static PL_MemSetFn PL_MemSetNEON;
+static PL_MemCpyFn PL_MemCpyNEON;
+static PL_StrNLenFn PL_StrNLenNEON;
+static PL_RandFillFn PL_RandFillNEON;
+static PL_RandToR32Fn PL_RandToR32NEON;
+static PL_RandToRangeFn PL_RandToRangeNEON;
+static PL_V2IntegrateFn PL_V2IntegrateNEON;
+static PL_V2ReflectFn PL_V2ReflectNEON;
+static PL_V2OverlapFn PL_V2OverlapNEON;
+static PL_V4TransformFn PL_V4TransformNEON;
+static PL_SinCosFn PL_SinCosNEON;
+static PL_Atan2Fn PL_Atan2NEON;
+static PL_Dispatch pl_dispatch =
+{
+    PL_MemSetNEON, PL_MemCpyNEON, PL_StrNLenNEON,
+    PL_RandFillNEON, PL_RandToR32NEON, PL_RandToRangeNEON,
+    PL_V2IntegrateNEON, PL_V2ReflectNEON, PL_V2OverlapNEON, PL_V4TransformNEON,
+    PL_SinCosNEON, PL_Atan2NEON, MB(8)
+};
+#else
+static PL_MemSetFn PL_MemSetScalar;
+static PL_MemCpyFn PL_MemCpyScalar;
+static PL_StrNLenFn PL_StrNLenScalar;
+static PL_RandFillFn PL_RandFillScalar;
+static PL_RandToR32Fn PL_RandToR32Scalar;
+static PL_RandToRangeFn PL_RandToRangeScalar;
+static PL_V2IntegrateFn PL_V2IntegrateScalar;
+static PL_V2ReflectFn PL_V2ReflectScalar;
+static PL_V2OverlapFn PL_V2OverlapScalar;
+static PL_V4TransformFn PL_V4TransformScalar;
+static PL_SinCosFn PL_SinCosScalar;
+static PL_Atan2Fn PL_Atan2Scalar;
+static PL_Dispatch pl_dispatch =
+{
+    PL_MemSetScalar, PL_MemCpyScalar, PL_StrNLenScalar,
+    PL_RandFillScalar, PL_RandToR32Scalar, PL_RandToRangeScalar,
+    PL_V2IntegrateScalar, PL_V2ReflectScalar, PL_V2OverlapScalar, PL_V4TransformScalar,
+    PL_SinCosScalar, PL_Atan2Scalar, MB(8)
+};
+#endif
+
+// under 16 bytes: overlapping word stores instead of a byte loop
+static inline void PL_MemSetSmall(u8 *dst, u8 value, u64 size)
+{
+    u64 v8 = 0x0101010101010101ULL * value;
+    
+    if(size >= 8)
     {
-        return 0;
+        memcpy(dst, &v8, 8);
+        memcpy(dst + size - 8, &v8, 8);
+    }
+    else if(size >= 4)
+    {
+        u32 v4 = (u32)v8;
+        memcpy(dst, &v4, 4);
+        memcpy(dst + size - 4, &v4, 4);
+    }
+    else
+    {
+        for(u64 i = 0; i < size; i++) dst[i] = value;
+    }
+}
+
+static inline void PL_MemCpySmall(u8 *dst, const u8 *src, u64 size)
+{
+    if(size >= 8)
+    {
+        u64 head, tail;
+        memcpy(&head, src, 8);
+        memcpy(&tail, src + size - 8, 8);
+        memcpy(dst, &head, 8);
+        memcpy(dst + size - 8, &tail, 8);
+    }
+    else if(size >= 4)
+    {
+        u32 head, tail;
+        memcpy(&head, src, 4);
+        memcpy(&tail, src + size - 4, 4);
+        memcpy(dst, &head, 4);
+        memcpy(dst + size - 4, &tail, 4);
+    }
+    else
+    {
+        for(u64 i = 0; i < size; i++) dst[i] = src[i];
+    }
+}
+
+#if !defined(__x86_64__) && !defined(_M_X64) && !defined(PL_ARCH_ARM64)
+// word at a time, for targets without a baseline vector path
+static void PL_MemSetScalar(u8 *dst, u8 value, u64 size)
+{
+    if(size < 16)
+    {
+        PL_MemSetSmall(dst, value, size);
+        return;
     }
     
-    u8* byte = (u8*)(mem);
-    for(u64 i=0; i<size; i++)
+    u64 v8 = 0x0101010101010101ULL * value;
+    u64 i = 0;
+    for(; i + 8 <= size; i += 8) memcpy(dst + i, &v8, 8);
+    memcpy(dst + size - 8, &v8, 8);
+}
+
+static void PL_MemCpyScalar(u8 *dst, const u8 *src, u64 size)
+{
+    if(size < 16)
     {
-        *byte++ = value;
+        PL_MemCpySmall(dst, src, size);
+        return;
     }
     
-    return byte;
+    u64 word;
+    for(u64 i = 0; i + 8 <= size; i += 8)
+    {
+        memcpy(&word, src + i, 8);
+        memcpy(dst + i, &word, 8);
+    }
+    memcpy(&word, src + size - 8, 8);
+    memcpy(dst + size - 8, &word, 8);
 }
+#endif
 
-u64 PL_MemCpy(ptr src, ptr dst, u64 size)
+#if defined(PL_ARCH_X86)
+// unaligned head and tail stores, aligned body in between
+PL_TARGET("sse2")
+static void PL_MemSetSSE2(u8 *dst, u8 value, u64 size)
 {
-    if(!src || !dst || !size)
+    if(size < 16)
     {
-        return 0;
+        PL_MemSetSmall(dst, value, size);
+        return;
     }
     
-    u64 result = 0;
-    u64 byteCount = size;
-    u8 *sb = (u8*)src;
-    u8 *db = (u8*)dst;
+    __m128i v = _mm_set1_epi8((char)value);
+    _mm_storeu_si128((__m128i*)dst, v);
+    _mm_storeu_si128((__m128i*)(dst + size - 16), v);
+    
+    u8 *at = (u8*)(((uintptr_t)dst + 16) & ~(uintptr_t)15);
+    u8 *end = dst + size - 16; // tail store covers the rest
     
-    while(byteCount)
+    if(size >= pl_dispatch.nonTemporalMin)
     {
-        *db++ = *sb++;
-        byteCount--;
-        result++;
+        for(; at + 64 <= end; at += 64)
+        {
+            _mm_stream_si128((__m128i*)(at + 0), v);
+            _mm_stream_si128((__m128i*)(at + 16), v);
+            _mm_stream_si128((__m128i*)(at + 32), v);
+            _mm_stream_si128((__m128i*)(at + 48), v);
+        }
+        _mm_sfence();
     }
     
-    return result;
+    for(; at + 64 <= end; at += 64)
+    {
+        _mm_store_si128((__m128i*)(at + 0), v);
+        _mm_store_si128((__m128i*)(at + 16), v);
+        _mm_store_si128((__m128i*)(at + 32), v);
+        _mm_store_si128((__m128i*)(at + 48), v);
+    }
+    for(; at < end; at += 16) _mm_store_si128((__m128i*)at, v);
 }
 
-u64 PL_StrLen(cstr str)
+PL_TARGET("sse2")
+static void PL_MemCpySSE2(u8 *dst, const u8 *src, u64 size)
 {
-    if(!str)
+    if(size < 16)
     {
-        return 0;
+        PL_MemCpySmall(dst, src, size);
+        return;
     }
     
-    u64 result = 0;
+    __m128i head = _mm_loadu_si128((const __m128i*)src);
+    __m128i tail = _mm_loadu_si128((const __m128i*)(src + size - 16));
     
-    for(cstr c = str;
-        *c != 0;
-        c++)
+    // body stores aligned to dst, head/tail written last cover the unaligned ends
+    u64 skew = 16 - ((uintptr_t)dst & 15);
+    u8 *d = dst + skew;
+    const u8 *s = src + skew;
+    u64 remaining = size - skew;
+    
+    if(size >= pl_dispatch.nonTemporalMin)
     {
-        result++;
+        for(; remaining > 64; remaining -= 64, d += 64, s += 64)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i*)(s + 0));
+            __m128i b = _mm_loadu_si128((const __m128i*)(s + 16));
+            __m128i c = _mm_loadu_si128((const __m128i*)(s + 32));
+            __m128i e = _mm_loadu_si128((const __m128i*)(s + 48));
+            _mm_stream_si128((__m128i*)(d + 0), a);
+            _mm_stream_si128((__m128i*)(d + 16), b);
+            _mm_stream_si128((__m128i*)(d + 32), c);
+            _mm_stream_si128((__m128i*)(d + 48), e);
+        }
+        _mm_sfence();
     }
     
-    return result;
+    for(; remaining > 64; remaining -= 64, d += 64, s += 64)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i*)(s + 0));
+        __m128i b = _mm_loadu_si128((const __m128i*)(s + 16));
+        __m128i c = _mm_loadu_si128((const __m128i*)(s + 32));
+        __m128i e = _mm_loadu_si128((const __m128i*)(s + 48));
+        _mm_store_si128((__m128i*)(d + 0), a);
+        _mm_store_si128((__m128i*)(d + 16), b);
+        _mm_store_si128((__m128i*)(d + 32), c);
+        _mm_store_si128((__m128i*)(d + 48), e);
+    }
+    for(; remaining > 16; remaining -= 16, d += 16, s += 16)
+    {
+        _mm_store_si128((__m128i*)d, _mm_loadu_si128((const __m128i*)s));
+    }
+    
+    _mm_storeu_si128((__m128i*)dst, head);
+    _mm_storeu_si128((__m128i*)(dst + size - 16), tail);
 }
 
-u64 PL_StrCpy(cstr src, cstr dst, u64 len)
+PL_TARGET("avx2")
+static void PL_MemSetAVX2(u8 *dst, u8 value, u64 size)
 {
-    if(!src || !dst || !len)
+    if(size < 32)
     {
-        return 0;
+        PL_MemSetSSE2(dst, value, size);
+        return;
     }
     
-    cstr sc = src;
-    cstr dc = dst;
-    u64 result = 0;
+    __m256i v = _mm256_set1_epi8((char)value);
+    _mm256_storeu_si256((__m256i*)dst, v);
+    _mm256_storeu_si256((__m256i*)(dst + size - 32), v);
     
-    for(result = 0;
-        result < (len);
-        result++)
+    u8 *at = (u8*)(((uintptr_t)dst + 32) & ~(uintptr_t)31);
+    u8 *end = dst + size - 32;
+    
+    if(size >= pl_dispatch.nonTemporalMin)
     {
-        if(*sc)
-        {
-            *dc++ = *sc++;
-        }
-        
-        else
+        for(; at + 128 <= end; at += 128)
         {
-            break;
+            _mm256_stream_si256((__m256i*)(at + 0), v);
+            _mm256_stream_si256((__m256i*)(at + 32), v);
+            _mm256_stream_si256((__m256i*)(at + 64), v);
+            _mm256_stream_si256((__m256i*)(at + 96), v);
         }
+        _mm_sfence();
     }
     
-    *dc = 0; // append \0 to end of string
-    return result;
+    for(; at + 128 <= end; at += 128)
+    {
+        _mm256_store_si256((__m256i*)(at + 0), v);
+        _mm256_store_si256((__m256i*)(at + 32), v);
+        _mm256_store_si256((__m256i*)(at + 64), v);
+        _mm256_store_si256((__m256i*)(at + 96), v);
+    }
+    for(; at < end; at += 32) _mm256_store_si256((__m256i*)at, v);
 }
 
-u64 PL_StrCat(cstr src, cstr dst, u64 len)
+PL_TARGET("avx2")
+static void PL_MemCpyAVX2(u8 *dst, const u8 *src, u64 size)
 {
-    if(!src || !dst || !len)
+    if(size < 32)
     {
-        return 0;
+        PL_MemCpySSE2(dst, src, size);
+        return;
     }
     
-    u64 result = 0;
-    cstr sc = src;
-    cstr dc = 0;
+    __m256i head = _mm256_loadu_si256((const __m256i*)src);
+    __m256i tail = _mm256_loadu_si256((const __m256i*)(src + size - 32));
     
-    for(dc = dst;
-        *dc != 0;
-        dc++)
+    u64 skew = 32 - ((uintptr_t)dst & 31);
+    u8 *d = dst + skew;
+    const u8 *s = src + skew;
+    u64 remaining = size - skew;
+    
+    if(size >= pl_dispatch.nonTemporalMin)
     {
-        if(result == len)
-        {
-            return result;
-        }
-        
-        else
+        for(; remaining > 128; remaining -= 128, d += 128, s += 128)
         {
-            result++;
+            __m256i a = _mm256_loadu_si256((const __m256i*)(s + 0));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(s + 32));
+            __m256i c = _mm256_loadu_si256((const __m256i*)(s + 64));
+            __m256i e = _mm256_loadu_si256((const __m256i*)(s + 96));
+            _mm256_stream_si256((__m256i*)(d + 0), a);
+            _mm256_stream_si256((__m256i*)(d + 32), b);
+            _mm256_stream_si256((__m256i*)(d + 64), c);
+            _mm256_stream_si256((__m256i*)(d + 96), e);
         }
+        _mm_sfence();
     }
     
-    for(;
-        result < (len);
-        result++)
+    for(; remaining > 128; remaining -= 128, d += 128, s += 128)
     {
-        if(*sc)
-        {
-            *dc++ = *sc++;
-        }
-        
-        else
-        {
-            break;
-        }
+        __m256i a = _mm256_loadu_si256((const __m256i*)(s + 0));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(s + 32));
+        __m256i c = _mm256_loadu_si256((const __m256i*)(s + 64));
+        __m256i e = _mm256_loadu_si256((const __m256i*)(s + 96));
+        _mm256_store_si256((__m256i*)(d + 0), a);
+        _mm256_store_si256((__m256i*)(d + 32), b);
+        _mm256_store_si256((__m256i*)(d + 64), c);
+        _mm256_store_si256((__m256i*)(d + 96), e);
+    }
+    for(; remaining > 32; remaining -= 32, d += 32, s += 32)
+    {
+        _mm256_store_si256((__m256i*)d, _mm256_loadu_si256((const __m256i*)s));
     }
     
-    *dc = 0; // append \0 to end of string
-    return result;
+    _mm256_storeu_si256((__m256i*)dst, head);
+    _mm256_storeu_si256((__m256i*)(dst + size - 32), tail);
 }
+#endif // PL_ARCH_X86
 
-void PL_StrVar(cstr dst, u64 maxlen,
-               const cstr format, ...)
+#if defined(PL_ARCH_ARM64)
+static void PL_MemSetNEON(u8 *dst, u8 value, u64 size)
 {
-    if(!dst || !maxlen || !format)
+    if(size < 16)
     {
+        PL_MemSetSmall(dst, value, size);
         return;
     }
     
-    va_list args;
-    va_start(args, format);
-    vsnprintf(dst, maxlen, format, args);
-    va_end(args);
+    uint8x16_t v = vdupq_n_u8(value);
+    vst1q_u8(dst, v);
+    vst1q_u8(dst + size - 16, v);
+    
+    u8 *at = (u8*)(((uintptr_t)dst + 16) & ~(uintptr_t)15);
+    u8 *end = dst + size - 16;
+    
+    for(; at + 64 <= end; at += 64)
+    {
+        vst1q_u8(at + 0, v);
+        vst1q_u8(at + 16, v);
+        vst1q_u8(at + 32, v);
+        vst1q_u8(at + 48, v);
+    }
+    for(; at < end; at += 16) vst1q_u8(at, v);
 }
 
-void PL_Print(cstr format, ...)
+static void PL_MemCpyNEON(u8 *dst, const u8 *src, u64 size)
 {
-    va_list args;
-    va_start(args, format);
-    vprintf(format, args);
-    va_end(args);
-    fflush(stdout);
+    if(size < 16)
+    {
+        PL_MemCpySmall(dst, src, size);
+        return;
+    }
+    
+    uint8x16_t head = vld1q_u8(src);
+    uint8x16_t tail = vld1q_u8(src + size - 16);
+    
+    u64 skew = 16 - ((uintptr_t)dst & 15);
+    u8 *d = dst + skew;
+    const u8 *s = src + skew;
+    u64 remaining = size - skew;
+    
+    for(; remaining > 64; remaining -= 64, d += 64, s += 64)
+    {
+        uint8x16_t a = vld1q_u8(s + 0);
+        uint8x16_t b = vld1q_u8(s + 16);
+        uint8x16_t c = vld1q_u8(s + 32);
+        uint8x16_t e = vld1q_u8(s + 48);
+        vst1q_u8(d + 0, a);
+        vst1q_u8(d + 16, b);
+        vst1q_u8(d + 32, c);
+        vst1q_u8(d + 48, e);
+    }
+    for(; remaining > 16; remaining -= 16, d += 16, s += 16)
+    {
+        vst1q_u8(d, vld1q_u8(s));
+    }
+    
+    vst1q_u8(dst, head);
+    vst1q_u8(dst + size - 16, tail);
 }
+#endif // PL_ARCH_ARM64
 
-void PL_PrintErr(cstr format, ...)
-{
-    va_list args;
-    va_start(args, format);
-    vfprintf(stderr, format, args);
-    va_end(args);
-    fflush(stderr);
-}
+/*=========== String Kernels =============*/
 
-// fwd decl for funcs to use this before it is defined
-void PL_SetErrorString(const cstr format, ...);
+// all string scans read whole aligned blocks (words/vectors). an aligned block never
+// crosses a page boundary, so reading past the terminator can't fault. it is still
+// outside the object as far as ASan is concerned, hence PL_NO_ASAN
 
-/*============= Maths Functions ==================*/
+#if !defined(__x86_64__) && !defined(_M_X64) && !defined(PL_ARCH_ARM64)
+#define PL_WORD_ONES 0x0101010101010101ULL
+#define PL_WORD_HIGHS 0x8080808080808080ULL
 
-i32 PL_sign(i32 v)
+// word at a time: the lowest zero byte gets its high bit set in the mask (little endian)
+PL_NO_ASAN static inline u64 PL_ZeroMaskWord(u64 word)
 {
-    return (v>=0)? 1 : -1;
+    return (word - PL_WORD_ONES) & ~word & PL_WORD_HIGHS;
 }
 
-r32 PL_abs(r32 v)
+PL_NO_ASAN static u64 PL_StrNLenScalar(const char *str, u64 max)
 {
-    return (r32)fabs(v);
+    const char *block = (const char*)((uintptr_t)str & ~(uintptr_t)7);
+    u64 skip = (u64)(str - block);
+    u64 word;
+    memcpy(&word, block, 8);
+    word |= skip ? (~0ULL >> (64 - skip * 8)) : 0; // bytes before str can't be the terminator
+    u64 mask = PL_ZeroMaskWord(word);
+    if(mask) return PL_Min64((PL_CTZ64(mask) >> 3) - skip, max);
+    block += 8;
+    
+    for(; (u64)(block - str) < max; block += 8)
+    {
+        memcpy(&word, block, 8);
+        mask = PL_ZeroMaskWord(word);
+        if(mask) return PL_Min64((u64)(block - str) + (PL_CTZ64(mask) >> 3), max);
+    }
+    
+    return max;
 }
+#endif
 
-i32 PL_round_i32(r32 v)
+#if defined(PL_ARCH_X86)
+PL_TARGET("sse2") PL_NO_ASAN
+static inline u32 PL_ZeroMaskSSE2(const char *block)
 {
-    return (i32)floorf(v);
+    __m128i bytes = _mm_load_si128((const __m128i*)block);
+    return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_setzero_si128()));
 }
 
-u32 PL_round_u32(r32 v)
+// first block masked to start at str, single blocks up to an unroll boundary,
+// then 64 (sse2) / 128 (avx2) bytes per iteration
+PL_TARGET("sse2") PL_NO_ASAN
+static u64 PL_StrNLenSSE2(const char *str, u64 max)
 {
-    return (u32)floorf(v);
+    const char *block = (const char*)((uintptr_t)str & ~(uintptr_t)15);
+    u32 mask = PL_ZeroMaskSSE2(block) >> (str - block);
+    if(mask) return PL_Min64(PL_CTZ32(mask), max);
+    block += 16;
+    
+    while(((uintptr_t)block & 63) && (u64)(block - str) < max)
+    {
+        mask = PL_ZeroMaskSSE2(block);
+        if(mask) return PL_Min64((u64)(block - str) + PL_CTZ32(mask), max);
+        block += 16;
+    }
+    
+    // the unsigned min of the 4 vectors has a zero byte when any of them does
+    for(; (u64)(block - str) < max; block += 64)
+    {
+        __m128i least = _mm_min_epu8(_mm_min_epu8(_mm_load_si128((const __m128i*)(block + 0)),
+                                                  _mm_load_si128((const __m128i*)(block + 16))),
+                                     _mm_min_epu8(_mm_load_si128((const __m128i*)(block + 32)),
+                                                  _mm_load_si128((const __m128i*)(block + 48))));
+        if(_mm_movemask_epi8(_mm_cmpeq_epi8(least, _mm_setzero_si128())))
+        {
+            u64 mask64 = ((u64)PL_ZeroMaskSSE2(block) |
+                          ((u64)PL_ZeroMaskSSE2(block + 16) << 16) |
+                          ((u64)PL_ZeroMaskSSE2(block + 32) << 32) |
+                          ((u64)PL_ZeroMaskSSE2(block + 48) << 48));
+            return PL_Min64((u64)(block - str) + PL_CTZ64(mask64), max);
+        }
+    }
+    
+    return max;
 }
 
-i32 PL_trunc_i32(r32 v)
+PL_TARGET("avx2") PL_NO_ASAN
+static inline u32 PL_ZeroMaskAVX2(const char *block)
 {
-    return (i32)v;
+    __m256i bytes = _mm256_load_si256((const __m256i*)block);
+    return (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_setzero_si256()));
 }
 
-i32 PL_floor_i32(r32 v)
+PL_TARGET("avx2") PL_NO_ASAN
+static u64 PL_StrNLenAVX2(const char *str, u64 max)
 {
-    return (i32)floorf(v);
+    const char *block = (const char*)((uintptr_t)str & ~(uintptr_t)31);
+    u32 mask = PL_ZeroMaskAVX2(block) >> (str - block);
+    if(mask) return PL_Min64(PL_CTZ32(mask), max);
+    block += 32;
+    
+    while(((uintptr_t)block & 127) && (u64)(block - str) < max)
+    {
+        mask = PL_ZeroMaskAVX2(block);
+        if(mask) return PL_Min64((u64)(block - str) + PL_CTZ32(mask), max);
+        block += 32;
+    }
+    
+    for(; (u64)(block - str) < max; block += 128)
+    {
+        __m256i least = _mm256_min_epu8(_mm256_min_epu8(_mm256_load_si256((const __m256i*)(block + 0)),
+                                                        _mm256_load_si256((const __m256i*)(block + 32))),
+                                        _mm256_min_epu8(_mm256_load_si256((const __m256i*)(block + 64)),
+                                                        _mm256_load_si256((const __m256i*)(block + 96))));
+        if(_mm256_movemask_epi8(_mm256_cmpeq_epi8(least, _mm256_setzero_si256())))
+        {
+            u64 mask64 = (u64)PL_ZeroMaskAVX2(block) | ((u64)PL_ZeroMaskAVX2(block + 32) << 32);
+            if(mask64) return PL_Min64((u64)(block - str) + PL_CTZ64(mask64), max);
+            mask64 = (u64)PL_ZeroMaskAVX2(block + 64) | ((u64)PL_ZeroMaskAVX2(block + 96) << 32);
+            return PL_Min64((u64)(block - str) + 64 + PL_CTZ64(mask64), max);
+        }
+    }
+    
+    return max;
 }
+#endif // PL_ARCH_X86
 
-i32 PL_ceil_i32(r32 v)
+#if defined(PL_ARCH_ARM64)
+// 4 bits per byte of the compare result packed into a u64
+PL_NO_ASAN static inline u64 PL_ZeroMaskNEON(const char *block)
 {
-    return (i32)ceilf(v);
+    uint8x16_t cmp = vceqq_u8(vld1q_u8((const u8*)block), vdupq_n_u8(0));
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4)), 0);
 }
 
-r32 PL_div(r32 n, r32 d)
+PL_NO_ASAN static u64 PL_StrNLenNEON(const char *str, u64 max)
 {
-    if(d != 0.0f)
+    const char *block = (const char*)((uintptr_t)str & ~(uintptr_t)15);
+    u64 mask = PL_ZeroMaskNEON(block) >> ((str - block) * 4);
+    if(mask) return PL_Min64(PL_CTZ64(mask) >> 2, max);
+    block += 16;
+    
+    for(; (u64)(block - str) < max; block += 16)
     {
-        return n/d;
+        mask = PL_ZeroMaskNEON(block);
+        if(mask) return PL_Min64((u64)(block - str) + (PL_CTZ64(mask) >> 2), max);
     }
     
-    return 0.0f;
+    return max;
 }
+#endif // PL_ARCH_ARM64
 
-r64 PL_norm64(r64 v, r64 min, r64 max)
+/*=========== Random Kernels =============*/
+
+// xoshiro256** over PL_RAND_LANES lanes, result = rotl(s1 * 5, 7) * 9 with the
+// multiplies done as shift+add (no 64 bit vector multiply below avx512)
+
+// top 24 bits fill an r32 mantissa exactly, so [0, 1) with no rounding up to 1
+#define PL_RAND_R32_SCALE (1.0f / 16777216.0f)
+
+static inline void PL_RandToR32Small(r32 *dst, const u32 *src, u64 count)
 {
-    return ((v-min) / (max-min));
+    for(u64 i = 0; i < count; i++)
+    {
+        dst[i] = (r32)(src[i] >> 8) * PL_RAND_R32_SCALE;
+    }
 }
 
-r32 PL_norm32(r32 v, r32 min, r32 max)
+// Lemire multiply-shift like PL_RandRange, rejected values are redrawn from spare
+// in index order so every kernel gives the same output
+static u32 PL_RandRangeOne(u32 x, u32 range, u32 threshold, PL_RandState *spare)
 {
-    return ((v-min) / (max-min));
+    u64 m = (u64)x * range;
+    while((u32)m < threshold)
+    {
+        m = (u64)PL_RandU32(spare) * range;
+    }
+    return (u32)(m >> 32);
 }
 
-r32 PL_clamp(r32 v, r32 min, r32 max)
+static inline void PL_RandToRangeSmall(u32 *dst, const u32 *src, u64 count, u32 range, PL_RandState *spare)
 {
-    return ((((v<min)?min:v)>max)?max:v);
+    u32 threshold = (0u - range) % range;
+    for(u64 i = 0; i < count; i++)
+    {
+        dst[i] = PL_RandRangeOne(src[i], range, threshold, spare);
+    }
 }
 
-r32 PL_clampMin(r32 v, r32 min)
+#if !defined(__x86_64__) && !defined(_M_X64) && !defined(PL_ARCH_ARM64)
+static void PL_RandToR32Scalar(r32 *dst, const u32 *src, u64 count)
 {
-    return ((v<min)?min:v);
+    PL_RandToR32Small(dst, src, count);
 }
 
-r32 PL_clampMax(r32 v, r32 max)
+static void PL_RandToRangeScalar(u32 *dst, const u32 *src, u64 count, u32 range, PL_RandState *spare)
 {
-    return ((v>max)?max:v);
+    PL_RandToRangeSmall(dst, src, count, range, spare);
 }
 
-r32 PL_clampNorm(r32 v)
+static void PL_RandFillScalar(PL_RandLanes *lanes, u8 *dst, u64 steps)
 {
-    return ((((v<0.0f)?0.0f:v)>1.0f)?1.0f:v);
+    u64 (*s)[PL_RAND_LANES] = lanes->s;
+    
+    for(u64 step = 0; step < steps; step++)
+    {
+        u64 out[PL_RAND_LANES];
+        for(int lane = 0; lane < PL_RAND_LANES; lane++)
+        {
+            out[lane] = PL_Rotl64(s[1][lane] * 5, 7) * 9;
+            u64 t = s[1][lane] << 17;
+            s[2][lane] ^= s[0][lane];
+            s[3][lane] ^= s[1][lane];
+            s[1][lane] ^= s[2][lane];
+            s[0][lane] ^= s[3][lane];
+            s[2][lane] ^= t;
+            s[3][lane] = PL_Rotl64(s[3][lane], 45);
+        }
+        memcpy(dst, out, sizeof(out));
+        dst += sizeof(out);
+    }
 }
+#endif
 
-u32 PL_rotl(u32 v, i32 s)
+#if defined(PL_ARCH_X86)
+
+#define PL_ROTL64_SSE2(x, k) _mm_or_si128(_mm_slli_epi64((x), (k)), _mm_srli_epi64((x), 64 - (k)))
+
+// 2 lanes
+PL_TARGET("sse2")
+static inline __m128i PL_RandStepSSE2(__m128i *s0, __m128i *s1, __m128i *s2, __m128i *s3)
 {
-    s &= 31;
-    return ((v<<s) | (v>>(32-s)));
+    __m128i x = _mm_add_epi64(*s1, _mm_slli_epi64(*s1, 2));
+    x = PL_ROTL64_SSE2(x, 7);
+    __m128i result = _mm_add_epi64(x, _mm_slli_epi64(x, 3));
+    __m128i t = _mm_slli_epi64(*s1, 17);
+    
+    *s2 = _mm_xor_si128(*s2, *s0);
+    *s3 = _mm_xor_si128(*s3, *s1);
+    *s1 = _mm_xor_si128(*s1, *s2);
+    *s0 = _mm_xor_si128(*s0, *s3);
+    *s2 = _mm_xor_si128(*s2, t);
+    *s3 = PL_ROTL64_SSE2(*s3, 45);
+    
+    return result;
 }
 
-u32 PL_rotr(u32 v, i32 s)
+PL_TARGET("sse2")
+static void PL_RandFillSSE2(PL_RandLanes *lanes, u8 *dst, u64 steps)
 {
-    s &= 31;
-    return ((v>>s) | (v<<(32-s)));
+    // a pair of lanes at a time keeps the state in registers (8 lanes x 4 words would spill),
+    // lane pairs are independent so each writes its own 16 byte column of every step
+    for(int lane = 0; lane < PL_RAND_LANES; lane += 2)
+    {
+        __m128i s0 = _mm_loadu_si128((__m128i*)&lanes->s[0][lane]);
+        __m128i s1 = _mm_loadu_si128((__m128i*)&lanes->s[1][lane]);
+        __m128i s2 = _mm_loadu_si128((__m128i*)&lanes->s[2][lane]);
+        __m128i s3 = _mm_loadu_si128((__m128i*)&lanes->s[3][lane]);
+        u8 *out = dst + lane * sizeof(u64);
+        
+        for(u64 step = 0; step < steps; step++)
+        {
+            _mm_storeu_si128((__m128i*)out, PL_RandStepSSE2(&s0, &s1, &s2, &s3));
+            out += PL_RAND_LANES * sizeof(u64);
+        }
+        
+        _mm_storeu_si128((__m128i*)&lanes->s[0][lane], s0);
+        _mm_storeu_si128((__m128i*)&lanes->s[1][lane], s1);
+        _mm_storeu_si128((__m128i*)&lanes->s[2][lane], s2);
+        _mm_storeu_si128((__m128i*)&lanes->s[3][lane], s3);
+    }
 }
 
-r32 PL_lerp(r32 a, r32 b, r32 t)
+PL_TARGET("sse2")
+static void PL_RandToR32SSE2(r32 *dst, const u32 *src, u64 count)
 {
-    return ((1.0f-t) *a) + (t*b);
+    __m128 scale = _mm_set1_ps(PL_RAND_R32_SCALE);
+    u64 i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        // after >> 8 the values are below 2^31 so the signed convert is exact
+        __m128i x = _mm_srli_epi32(_mm_loadu_si128((const __m128i*)(src + i)), 8);
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(x), scale));
+    }
+    PL_RandToR32Small(dst + i, src + i, count - i);
 }
 
-r32 PL_qlerp(r32 a, r32 b, r32 t)
+PL_TARGET("sse2")
+static void PL_RandToRangeSSE2(u32 *dst, const u32 *src, u64 count, u32 range, PL_RandState *spare)
 {
-    return a + t * (b - a);
+    u32 threshold = (0u - range) % range;
+    __m128i r = _mm_set1_epi32((int)range);
+    // unsigned low < threshold as a signed compare with the sign bits flipped
+    __m128i flip = _mm_set1_epi32((int)0x80000000);
+    __m128i t = _mm_xor_si128(_mm_set1_epi32((int)threshold), flip);
+    u64 i = 0;
+    
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i even = _mm_mul_epu32(x, r); // 64 bit products of lanes 0, 2
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), r); // lanes 1, 3
+        // high halves are the results, low halves decide rejection
+        __m128i hi = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_and_si128(odd, _mm_set_epi32(-1, 0, -1, 0)));
+        __m128i lo = _mm_or_si128(_mm_and_si128(even, _mm_set_epi32(0, -1, 0, -1)), _mm_slli_epi64(odd, 32));
+        _mm_storeu_si128((__m128i*)(dst + i), hi);
+        
+        int reject = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(_mm_xor_si128(lo, flip), t)));
+        while(reject)
+        {
+            u32 lane = PL_CTZ32((u32)reject);
+            dst[i + lane] = PL_RandRangeOne(src[i + lane], range, threshold, spare);
+            reject &= reject - 1;
+        }
+    }
+    PL_RandToRangeSmall(dst + i, src + i, count - i, range, spare);
 }
 
-r32 PL_sqrt(r32 v)
-{
-    return sqrtf(v);
-}
+#define PL_ROTL64_AVX2(x, k) _mm256_or_si256(_mm256_slli_epi64((x), (k)), _mm256_srli_epi64((x), 64 - (k)))
 
-r32 PL_square(r32 v)
+// 4 lanes
+PL_TARGET("avx2")
+static inline __m256i PL_RandStepAVX2(__m256i *s0, __m256i *s1, __m256i *s2, __m256i *s3)
 {
-    return v*v;
+    __m256i x = _mm256_add_epi64(*s1, _mm256_slli_epi64(*s1, 2));
+    x = PL_ROTL64_AVX2(x, 7);
+    __m256i result = _mm256_add_epi64(x, _mm256_slli_epi64(x, 3));
+    __m256i t = _mm256_slli_epi64(*s1, 17);
+    
+    *s2 = _mm256_xor_si256(*s2, *s0);
+    *s3 = _mm256_xor_si256(*s3, *s1);
+    *s1 = _mm256_xor_si256(*s1, *s2);
+    *s0 = _mm256_xor_si256(*s0, *s3);
+    *s2 = _mm256_xor_si256(*s2, t);
+    *s3 = PL_ROTL64_AVX2(*s3, 45);
+    
+    return result;
 }
 
-r32 PL_pow32(r32 v, r32 s)
+PL_TARGET("avx2")
+static void PL_RandFillAVX2(PL_RandLanes *lanes, u8 *dst, u64 steps)
 {
-    return powf(v,s);
+    // both halves of the lanes each step, two independent chains hide the latency
+    __m256i a0 = _mm256_loadu_si256((__m256i*)&lanes->s[0][0]);
+    __m256i a1 = _mm256_loadu_si256((__m256i*)&lanes->s[1][0]);
+    __m256i a2 = _mm256_loadu_si256((__m256i*)&lanes->s[2][0]);
+    __m256i a3 = _mm256_loadu_si256((__m256i*)&lanes->s[3][0]);
+    __m256i b0 = _mm256_loadu_si256((__m256i*)&lanes->s[0][4]);
+    __m256i b1 = _mm256_loadu_si256((__m256i*)&lanes->s[1][4]);
+    __m256i b2 = _mm256_loadu_si256((__m256i*)&lanes->s[2][4]);
+    __m256i b3 = _mm256_loadu_si256((__m256i*)&lanes->s[3][4]);
+    
+    for(u64 step = 0; step < steps; step++)
+    {
+        _mm256_storeu_si256((__m256i*)dst, PL_RandStepAVX2(&a0, &a1, &a2, &a3));
+        _mm256_storeu_si256((__m256i*)(dst + 32), PL_RandStepAVX2(&b0, &b1, &b2, &b3));
+        dst += PL_RAND_LANES * sizeof(u64);
+    }
+    
+    _mm256_storeu_si256((__m256i*)&lanes->s[0][0], a0);
+    _mm256_storeu_si256((__m256i*)&lanes->s[1][0], a1);
+    _mm256_storeu_si256((__m256i*)&lanes->s[2][0], a2);
+    _mm256_storeu_si256((__m256i*)&lanes->s[3][0], a3);
+    _mm256_storeu_si256((__m256i*)&lanes->s[0][4], b0);
+    _mm256_storeu_si256((__m256i*)&lanes->s[1][4], b1);
+    _mm256_storeu_si256((__m256i*)&lanes->s[2][4], b2);
+    _mm256_storeu_si256((__m256i*)&lanes->s[3][4], b3);
 }
 
-r64 PL_pi64(void)
+PL_TARGET("avx2")
+static void PL_RandToR32AVX2(r32 *dst, const u32 *src, u64 count)
 {
-    return (r64)3.141592653589793238462643383279502884L;
+    __m256 scale = _mm256_set1_ps(PL_RAND_R32_SCALE);
+    u64 i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m256i x = _mm256_srli_epi32(_mm256_loadu_si256((const __m256i*)(src + i)), 8);
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(x), scale));
+    }
+    PL_RandToR32Small(dst + i, src + i, count - i);
 }
 
-r32 PL_pi32(void)
+PL_TARGET("avx2")
+static void PL_RandToRangeAVX2(u32 *dst, const u32 *src, u64 count, u32 range, PL_RandState *spare)
 {
-    return (r32)3.141592653589793238463;
+    u32 threshold = (0u - range) % range;
+    __m256i r = _mm256_set1_epi32((int)range);
+    __m256i flip = _mm256_set1_epi32((int)0x80000000);
+    __m256i t = _mm256_xor_si256(_mm256_set1_epi32((int)threshold), flip);
+    __m256i oddMask = _mm256_set1_epi64x((i64)0xffffffff00000000ll);
+    u64 i = 0;
+    
+    for(; i + 8 <= count; i += 8)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i even = _mm256_mul_epu32(x, r);
+        __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), r);
+        __m256i hi = _mm256_blendv_epi8(_mm256_srli_epi64(even, 32), odd, oddMask);
+        __m256i lo = _mm256_blendv_epi8(even, _mm256_slli_epi64(odd, 32), oddMask);
+        _mm256_storeu_si256((__m256i*)(dst + i), hi);
+        
+        int reject = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(t, _mm256_xor_si256(lo, flip))));
+        while(reject)
+        {
+            u32 lane = PL_CTZ32((u32)reject);
+            dst[i + lane] = PL_RandRangeOne(src[i + lane], range, threshold, spare);
+            reject &= reject - 1;
+        }
+    }
+    PL_RandToRangeSmall(dst + i, src + i, count - i, range, spare);
 }
 
-r64 PL_tau64(void)
-{
-    return (r64)6.283185307179586476925286766559L;
-}
+#endif // PL_ARCH_X86
 
-r32 PL_tau32(void)
+#if defined(PL_ARCH_ARM64)
+
+static void PL_RandToR32NEON(r32 *dst, const u32 *src, u64 count)
 {
-    return (r32)6.2831853071795864769;
+    u64 i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        float32x4_t x = vcvtq_f32_u32(vshrq_n_u32(vld1q_u32(src + i), 8));
+        vst1q_f32(dst + i, vmulq_n_f32(x, PL_RAND_R32_SCALE));
+    }
+    PL_RandToR32Small(dst + i, src + i, count - i);
 }
 
-r32 PL_sin(r32 a)
+static void PL_RandToRangeNEON(u32 *dst, const u32 *src, u64 count, u32 range, PL_RandState *spare)
 {
-    return sinf(a);
+    u32 threshold = (0u - range) % range;
+    uint32x2_t r = vdup_n_u32(range);
+    uint32x4_t t = vdupq_n_u32(threshold);
+    u64 i = 0;
+    
+    for(; i + 4 <= count; i += 4)
+    {
+        uint32x4_t x = vld1q_u32(src + i);
+        uint64x2_t p0 = vmull_u32(vget_low_u32(x), r);
+        uint64x2_t p1 = vmull_u32(vget_high_u32(x), r);
+        vst1q_u32(dst + i, vcombine_u32(vshrn_n_u64(p0, 32), vshrn_n_u64(p1, 32)));
+        
+        uint32x4_t reject = vcltq_u32(vcombine_u32(vmovn_u64(p0), vmovn_u64(p1)), t);
+        if(vmaxvq_u32(reject))
+        {
+            for(u32 lane = 0; lane < 4; lane++)
+            {
+                dst[i + lane] = PL_RandRangeOne(src[i + lane], range, threshold, spare);
+            }
+        }
+    }
+    PL_RandToRangeSmall(dst + i, src + i, count - i, range, spare);
 }
 
-r32 PL_cos(r32 a)
+// 2 lanes
+static inline uint64x2_t PL_RandStepNEON(uint64x2_t *s0, uint64x2_t *s1, uint64x2_t *s2, uint64x2_t *s3)
 {
-    return cosf(a);
+    uint64x2_t x = vaddq_u64(*s1, vshlq_n_u64(*s1, 2));
+    x = vsriq_n_u64(vshlq_n_u64(x, 7), x, 57);
+    uint64x2_t result = vaddq_u64(x, vshlq_n_u64(x, 3));
+    uint64x2_t t = vshlq_n_u64(*s1, 17);
+    
+    *s2 = veorq_u64(*s2, *s0);
+    *s3 = veorq_u64(*s3, *s1);
+    *s1 = veorq_u64(*s1, *s2);
+    *s0 = veorq_u64(*s0, *s3);
+    *s2 = veorq_u64(*s2, t);
+    *s3 = vsriq_n_u64(vshlq_n_u64(*s3, 45), *s3, 19);
+    
+    return result;
 }
 
-r32 PL_atan2(r32 y, r32 x)
+static void PL_RandFillNEON(PL_RandLanes *lanes, u8 *dst, u64 steps)
 {
-    return atan2f(y,x);
+    // 32 vector registers hold all 8 lanes, 4 independent chains per step
+    uint64x2_t s[4][4];
+    for(int w = 0; w < 4; w++)
+    {
+        for(int v = 0; v < 4; v++) s[w][v] = vld1q_u64(&lanes->s[w][v * 2]);
+    }
+    
+    for(u64 step = 0; step < steps; step++)
+    {
+        for(int v = 0; v < 4; v++)
+        {
+            vst1q_u8(dst + v * 16, vreinterpretq_u8_u64(PL_RandStepNEON(&s[0][v], &s[1][v], &s[2][v], &s[3][v])));
+        }
+        dst += PL_RAND_LANES * sizeof(u64);
+    }
+    
+    for(int w = 0; w < 4; w++)
+    {
+        for(int v = 0; v < 4; v++) vst1q_u64(&lanes->s[w][v * 2], s[w][v]);
+    }
 }
 
-/*=========== Vectors =============*/
-// Thanks: Casey Muratori (Handmade Hero) for showing how to do vectors properly!
+#endif // PL_ARCH_ARM64
+
+/*=========== Vector Array Kernels =============*/
 
-// ------ v2 ------ //
+// structure of arrays, one array per component so a vector load is that component of 4/8 entities,
+// separate multiply and add (no fma) so the vector paths match the scalar tails
 
-// constructors
-v2 v2i(i32 a, i32 b)
+static inline void PL_V2IntegrateSmall(r32 *xs, r32 *ys, const r32 *vxs, const r32 *vys, u64 n, r32 dt)
 {
-    v2 result = {(r32)a, (r32)b};
-    return result;
+    for(u64 i = 0; i < n; i++)
+    {
+        xs[i] += vxs[i] * dt;
+        ys[i] += vys[i] * dt;
+    }
 }
-v2 v2u(u32 a, u32 b)
+
+// mirror back inside [min, max] and point the velocity inwards (|v| keeps its size)
+static inline void PL_ReflectOne(r32 *p, r32 *v, r32 min, r32 max)
 {
-    v2 result = {(r32)a, (r32)b};
-    return result;    
+    if(*p < min)
+    {
+        *p = (min + min) - *p;
+        *v = fabsf(*v);
+    }
+    else if(*p > max)
+    {
+        *p = (max + max) - *p;
+        *v = -fabsf(*v);
+    }
 }
-v2 v2r(r32 a, r32 b)
+
+static inline void PL_V2ReflectSmall(r32 *xs, r32 *ys, r32 *vxs, r32 *vys, u64 n, v2 min, v2 max)
 {
-    v2 result = {a, b};
-    return result;    
+    for(u64 i = 0; i < n; i++)
+    {
+        PL_ReflectOne(xs + i, vxs + i, min.x, max.x);
+        PL_ReflectOne(ys + i, vys + i, min.y, max.y);
+    }
 }
 
-// maths operators
-v2 v2add(v2 a, v2 b)
+// touching counts as overlapping, nan never does
+static inline void PL_V2OverlapSmall(u64 *mask, const r32 *xs, const r32 *ys, const r32 *hws, const r32 *hhs, u64 n, v2 min, v2 max)
 {
-    v2 result = {a.i[0]+b.i[0], a.i[1]+b.i[1]};
-    return result;
+    for(u64 base = 0; base < n; base += 64)
+    {
+        u64 word = 0;
+        u64 end = PL_Min64(n - base, 64);
+        for(u64 i = 0; i < end; i++)
+        {
+            u64 k = base + i;
+            u64 hit = (xs[k] - hws[k] <= max.x) & (xs[k] + hws[k] >= min.x) &
+                (ys[k] - hhs[k] <= max.y) & (ys[k] + hhs[k] >= min.y);
+            word |= hit << i;
+        }
+        mask[base / 64] = word;
+    }
 }
-v2 v2sub(v2 a, v2 b)
+
+// dst can be src, each v4 is read before it is written
+static inline void PL_V4TransformSmall(v4 *dst, const v4 *src, u64 n, const m4 *m)
 {
-    v2 result = {a.i[0]-b.i[0], a.i[1]-b.i[1]};
-    return result;
+    const r32 *e = m->e;
+    for(u64 i = 0; i < n; i++)
+    {
+        v4 v = src[i];
+        for(int k = 0; k < 4; k++)
+        {
+            dst[i].i[k] = e[k]*v.i[0] + e[4 + k]*v.i[1] + e[8 + k]*v.i[2] + e[12 + k]*v.i[3];
+        }
+    }
 }
-v2 v2mul(v2 a, r32 v)
+
+#if !defined(__x86_64__) && !defined(_M_X64) && !defined(PL_ARCH_ARM64)
+static void PL_V4TransformScalar(v4 *dst, const v4 *src, u64 n, const m4 *m)
 {
-    v2 result = {a.i[0]*v, a.i[1]*v};
-    return result;
+    PL_V4TransformSmall(dst, src, n, m);
 }
-v2 v2div(v2 a, r32 v)
+
+static void PL_V2IntegrateScalar(r32 *xs, r32 *ys, const r32 *vxs, const r32 *vys, u64 n, r32 dt)
 {
-    v2 result = {a.i[0]/v, a.i[1]/v};
-    return result;    
+    PL_V2IntegrateSmall(xs, ys, vxs, vys, n, dt);
 }
-v2 v2perp(v2 a)
+
+static void PL_V2ReflectScalar(r32 *xs, r32 *ys, r32 *vxs, r32 *vys, u64 n, v2 min, v2 max)
 {
-    v2 result = {-a.y, a.x};
-    return result;
+    PL_V2ReflectSmall(xs, ys, vxs, vys, n, min, max);
 }
-v2 v2hadamard(v2 a, v2 b)
+
+static void PL_V2OverlapScalar(u64 *mask, const r32 *xs, const r32 *ys, const r32 *hws, const r32 *hhs, u64 n, v2 min, v2 max)
 {
-    v2 result = {a.i[0]*b.i[0], a.i[1]*b.i[1]};
-    return result;
+    PL_V2OverlapSmall(mask, xs, ys, hws, hhs, n, min, max);
 }
-r32 v2dot(v2 a, v2 b)
+#endif
+
+#if defined(PL_ARCH_X86)
+
+PL_TARGET("sse2")
+static void PL_V2IntegrateSSE2(r32 *xs, r32 *ys, const r32 *vxs, const r32 *vys, u64 n, r32 dt)
 {
-    r32 result = (a.i[0]*b.i[0]) + (a.i[1]*b.i[1]);
-    return result;
+    __m128 t = _mm_set1_ps(dt);
+    u64 i = 0;
+    for(; i + 4 <= n; i += 4)
+    {
+        _mm_storeu_ps(xs + i, _mm_add_ps(_mm_loadu_ps(xs + i), _mm_mul_ps(_mm_loadu_ps(vxs + i), t)));
+        _mm_storeu_ps(ys + i, _mm_add_ps(_mm_loadu_ps(ys + i), _mm_mul_ps(_mm_loadu_ps(vys + i), t)));
+    }
+    PL_V2IntegrateSmall(xs + i, ys + i, vxs + i, vys + i, n - i, dt);
 }
-r32 v2lengthsq(v2 a)
+
+// one axis of 4 entities, lo and hi can't both be set (lo wins like PL_ReflectOne)
+PL_TARGET("sse2")
+static inline void PL_ReflectSSE2(r32 *ps, r32 *vs, __m128 min, __m128 max, __m128 min2, __m128 max2)
 {
-    r32 result = v2dot(a,a);
-    return result;
+    __m128 sign = _mm_set1_ps(-0.0f);
+    __m128 p = _mm_loadu_ps(ps);
+    __m128 v = _mm_loadu_ps(vs);
+    __m128 lo = _mm_cmplt_ps(p, min);
+    __m128 hi = _mm_andnot_ps(lo, _mm_cmpgt_ps(p, max));
+    __m128 out = _mm_or_ps(lo, hi);
+    __m128 speed = _mm_andnot_ps(sign, v);
+    
+    p = _mm_or_ps(_mm_andnot_ps(out, p), _mm_or_ps(_mm_and_ps(lo, _mm_sub_ps(min2, p)), _mm_and_ps(hi, _mm_sub_ps(max2, p))));
+    v = _mm_or_ps(_mm_andnot_ps(out, v), _mm_and_ps(out, _mm_or_ps(speed, _mm_and_ps(hi, sign))));
+    _mm_storeu_ps(ps, p);
+    _mm_storeu_ps(vs, v);
 }
-r32 v2length(v2 a)
+
+PL_TARGET("sse2")
+static void PL_V2ReflectSSE2(r32 *xs, r32 *ys, r32 *vxs, r32 *vys, u64 n, v2 min, v2 max)
 {
-    r32 result = PL_sqrt(v2lengthsq(a));
-    return result;
+    __m128 minX = _mm_set1_ps(min.x), maxX = _mm_set1_ps(max.x);
+    __m128 minY = _mm_set1_ps(min.y), maxY = _mm_set1_ps(max.y);
+    __m128 minX2 = _mm_set1_ps(min.x + min.x), maxX2 = _mm_set1_ps(max.x + max.x);
+    __m128 minY2 = _mm_set1_ps(min.y + min.y), maxY2 = _mm_set1_ps(max.y + max.y);
+    u64 i = 0;
+    for(; i + 4 <= n; i += 4)
+    {
+        PL_ReflectSSE2(xs + i, vxs + i, minX, maxX, minX2, maxX2);
+        PL_ReflectSSE2(ys + i, vys + i, minY, maxY, minY2, maxY2);
+    }
+    PL_V2ReflectSmall(xs + i, ys + i, vxs + i, vys + i, n - i, min, max);
 }
 
-// ------ v3 ------ //
-
-// constructors
-v3 v3i(i32 a, i32 b, i32 c)
+PL_TARGET("sse2")
+static void PL_V2OverlapSSE2(u64 *mask, const r32 *xs, const r32 *ys, const r32 *hws, const r32 *hhs, u64 n, v2 min, v2 max)
 {
-    v3 result = {(r32)a, (r32)b, (r32)c};
-    return result;
+    __m128 minX = _mm_set1_ps(min.x), maxX = _mm_set1_ps(max.x);
+    __m128 minY = _mm_set1_ps(min.y), maxY = _mm_set1_ps(max.y);
+    u64 i = 0;
+    for(; i + 64 <= n; i += 64)
+    {
+        u64 word = 0;
+        for(u64 j = 0; j < 64; j += 4)
+        {
+            __m128 x = _mm_loadu_ps(xs + i + j), hw = _mm_loadu_ps(hws + i + j);
+            __m128 y = _mm_loadu_ps(ys + i + j), hh = _mm_loadu_ps(hhs + i + j);
+            __m128 hit = _mm_and_ps(_mm_cmple_ps(_mm_sub_ps(x, hw), maxX), _mm_cmpge_ps(_mm_add_ps(x, hw), minX));
+            hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmple_ps(_mm_sub_ps(y, hh), maxY), _mm_cmpge_ps(_mm_add_ps(y, hh), minY)));
+            word |= (u64)_mm_movemask_ps(hit) << j;
+        }
+        mask[i / 64] = word;
+    }
+    PL_V2OverlapSmall(mask + i / 64, xs + i, ys + i, hws + i, hhs + i, n - i, min, max);
 }
-v3 v3u(u32 a, u32 b, u32 c)
+
+PL_TARGET("sse2")
+static void PL_V4TransformSSE2(v4 *dst, const v4 *src, u64 n, const m4 *m)
 {
-    v3 result = {(r32)a, (r32)b, (r32)c};
-    return result;    
+    __m128 c0 = _mm_loadu_ps(m->e), c1 = _mm_loadu_ps(m->e + 4);
+    __m128 c2 = _mm_loadu_ps(m->e + 8), c3 = _mm_loadu_ps(m->e + 12);
+    for(u64 i = 0; i < n; i++)
+    {
+        __m128 v = _mm_loadu_ps(src[i].i);
+        __m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(v, v, 0x00));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(v, v, 0x55)));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(v, v, 0xaa)));
+        r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_shuffle_ps(v, v, 0xff)));
+        _mm_storeu_ps(dst[i].i, r);
+    }
 }
-v3 v3r(r32 a, r32 b, r32 c)
+
+PL_TARGET("avx2")
+static void PL_V2IntegrateAVX2(r32 *xs, r32 *ys, const r32 *vxs, const r32 *vys, u64 n, r32 dt)
 {
-    v3 result = {a, b, c};
-    return result;    
+    __m256 t = _mm256_set1_ps(dt);
+    u64 i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(xs + i, _mm256_add_ps(_mm256_loadu_ps(xs + i), _mm256_mul_ps(_mm256_loadu_ps(vxs + i), t)));
+        _mm256_storeu_ps(ys + i, _mm256_add_ps(_mm256_loadu_ps(ys + i), _mm256_mul_ps(_mm256_loadu_ps(vys + i), t)));
+    }
+    PL_V2IntegrateSmall(xs + i, ys + i, vxs + i, vys + i, n - i, dt);
 }
 
-// maths operators
-v3 v3add(v3 a, v3 b)
+PL_TARGET("avx2")
+static inline void PL_ReflectAVX2(r32 *ps, r32 *vs, __m256 min, __m256 max, __m256 min2, __m256 max2)
 {
-    v3 result = {a.i[0]+b.i[0], a.i[1]+b.i[1], a.i[2]+b.i[2]};
-    return result;
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 p = _mm256_loadu_ps(ps);
+    __m256 v = _mm256_loadu_ps(vs);
+    __m256 lo = _mm256_cmp_ps(p, min, _CMP_LT_OQ);
+    __m256 hi = _mm256_cmp_ps(p, max, _CMP_GT_OQ);
+    __m256 speed = _mm256_andnot_ps(sign, v);
+    
+    p = _mm256_blendv_ps(_mm256_blendv_ps(p, _mm256_sub_ps(max2, p), hi), _mm256_sub_ps(min2, p), lo);
+    v = _mm256_blendv_ps(_mm256_blendv_ps(v, _mm256_or_ps(speed, sign), hi), speed, lo);
+    _mm256_storeu_ps(ps, p);
+    _mm256_storeu_ps(vs, v);
 }
-v3 v3sub(v3 a, v3 b)
+
+PL_TARGET("avx2")
+static void PL_V2ReflectAVX2(r32 *xs, r32 *ys, r32 *vxs, r32 *vys, u64 n, v2 min, v2 max)
 {
-    v3 result = {a.i[0]-b.i[0], a.i[1]-b.i[1], a.i[2]-b.i[2]};
-    return result;
+    __m256 minX = _mm256_set1_ps(min.x), maxX = _mm256_set1_ps(max.x);
+    __m256 minY = _mm256_set1_ps(min.y), maxY = _mm256_set1_ps(max.y);
+    __m256 minX2 = _mm256_set1_ps(min.x + min.x), maxX2 = _mm256_set1_ps(max.x + max.x);
+    __m256 minY2 = _mm256_set1_ps(min.y + min.y), maxY2 = _mm256_set1_ps(max.y + max.y);
+    u64 i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        PL_ReflectAVX2(xs + i, vxs + i, minX, maxX, minX2, maxX2);
+        PL_ReflectAVX2(ys + i, vys + i, minY, maxY, minY2, maxY2);
+    }
+    PL_V2ReflectSmall(xs + i, ys + i, vxs + i, vys + i, n - i, min, max);
 }
-v3 v3mul(v3 a, r32 v)
+
+PL_TARGET("avx2")
+static void PL_V2OverlapAVX2(u64 *mask, const r32 *xs, const r32 *ys, const r32 *hws, const r32 *hhs, u64 n, v2 min, v2 max)
 {
-    v3 result = {a.i[0]*v, a.i[1]*v, a.i[2]*v};
-    return result;
+    __m256 minX = _mm256_set1_ps(min.x), maxX = _mm256_set1_ps(max.x);
+    __m256 minY = _mm256_set1_ps(min.y), maxY = _mm256_set1_ps(max.y);
+    u64 i = 0;
+    for(; i + 64 <= n; i += 64)
+    {
+        u64 word = 0;
+        for(u64 j = 0; j < 64; j += 8)
+        {
+            __m256 x = _mm256_loadu_ps(xs + i + j), hw = _mm256_loadu_ps(hws + i + j);
+            __m256 y = _mm256_loadu_ps(ys + i + j), hh = _mm256_loadu_ps(hhs + i + j);
+            __m256 hit = _mm256_and_ps(_mm256_cmp_ps(_mm256_sub_ps(x, hw), maxX, _CMP_LE_OQ), _mm256_cmp_ps(_mm256_add_ps(x, hw), minX, _CMP_GE_OQ));
+            hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(_mm256_sub_ps(y, hh), maxY, _CMP_LE_OQ), _mm256_cmp_ps(_mm256_add_ps(y, hh), minY, _CMP_GE_OQ)));
+            word |= (u64)_mm256_movemask_ps(hit) << j;
+        }
+        mask[i / 64] = word;
+    }
+    PL_V2OverlapSmall(mask + i / 64, xs + i, ys + i, hws + i, hhs + i, n - i, min, max);
 }
-v3 v3div(v3 a, r32 v)
+
+// 2 v4s per register, the columns repeated in both halves
+PL_TARGET("avx2")
+static void PL_V4TransformAVX2(v4 *dst, const v4 *src, u64 n, const m4 *m)
 {
-    v3 result = {a.i[0]/v, a.i[1]/v, a.i[2]/v};
-    return result;    
+    __m256 c[4];
+    for(int k = 0; k < 4; k++)
+    {
+        __m128 col = _mm_loadu_ps(m->e + k*4);
+        c[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(col), col, 1);
+    }
+    
+    u64 i = 0;
+    for(; i + 2 <= n; i += 2)
+    {
+        __m256 v = _mm256_loadu_ps(src[i].i);
+        __m256 r = _mm256_mul_ps(c[0], _mm256_permute_ps(v, 0x00));
+        r = _mm256_add_ps(r, _mm256_mul_ps(c[1], _mm256_permute_ps(v, 0x55)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(c[2], _mm256_permute_ps(v, 0xaa)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(c[3], _mm256_permute_ps(v, 0xff)));
+        _mm256_storeu_ps(dst[i].i, r);
+    }
+    PL_V4TransformSmall(dst + i, src + i, n - i, m);
 }
-v3 v3hadamard(v3 a, v3 b)
+
+#endif // PL_ARCH_X86
+
+#if defined(PL_ARCH_ARM64)
+
+static void PL_V4TransformNEON(v4 *dst, const v4 *src, u64 n, const m4 *m)
 {
-    v3 result = {a.i[0]*b.i[0], a.i[1]*b.i[1], a.i[2]*b.i[2]};
-    return result;
+    float32x4_t c0 = vld1q_f32(m->e), c1 = vld1q_f32(m->e + 4);
+    float32x4_t c2 = vld1q_f32(m->e + 8), c3 = vld1q_f32(m->e + 12);
+    for(u64 i = 0; i < n; i++)
+    {
+        float32x4_t v = vld1q_f32(src[i].i);
+        float32x4_t r = vmulq_laneq_f32(c0, v, 0);
+        r = vmlaq_laneq_f32(r, c1, v, 1);
+        r = vmlaq_laneq_f32(r, c2, v, 2);
+        r = vmlaq_laneq_f32(r, c3, v, 3);
+        vst1q_f32(dst[i].i, r);
+    }
 }
-r32 v3dot(v3 a, v3 b)
+
+static void PL_V2IntegrateNEON(r32 *xs, r32 *ys, const r32 *vxs, const r32 *vys, u64 n, r32 dt)
 {
-    r32 result = (a.i[0]*b.i[0]) + (a.i[1]*b.i[1]) + (a.i[2]*b.i[2]);
-    return result;
+    u64 i = 0;
+    for(; i + 4 <= n; i += 4)
+    {
+        vst1q_f32(xs + i, vaddq_f32(vld1q_f32(xs + i), vmulq_n_f32(vld1q_f32(vxs + i), dt)));
+        vst1q_f32(ys + i, vaddq_f32(vld1q_f32(ys + i), vmulq_n_f32(vld1q_f32(vys + i), dt)));
+    }
+    PL_V2IntegrateSmall(xs + i, ys + i, vxs + i, vys + i, n - i, dt);
 }
-r32 v3lengthsq(v3 a)
+
+static inline void PL_ReflectNEON(r32 *ps, r32 *vs, r32 min, r32 max)
 {
-    r32 result = v3dot(a,a);
-    return result;
+    float32x4_t p = vld1q_f32(ps);
+    float32x4_t v = vld1q_f32(vs);
+    uint32x4_t lo = vcltq_f32(p, vdupq_n_f32(min));
+    uint32x4_t hi = vcgtq_f32(p, vdupq_n_f32(max));
+    float32x4_t speed = vabsq_f32(v);
+    
+    p = vbslq_f32(lo, vsubq_f32(vdupq_n_f32(min + min), p), vbslq_f32(hi, vsubq_f32(vdupq_n_f32(max + max), p), p));
+    v = vbslq_f32(lo, speed, vbslq_f32(hi, vnegq_f32(speed), v));
+    vst1q_f32(ps, p);
+    vst1q_f32(vs, v);
 }
-r32 v3length(v3 a)
+
+static void PL_V2ReflectNEON(r32 *xs, r32 *ys, r32 *vxs, r32 *vys, u64 n, v2 min, v2 max)
 {
-    r32 result = PL_sqrt(v3sq(a));
-    return result;
+    u64 i = 0;
+    for(; i + 4 <= n; i += 4)
+    {
+        PL_ReflectNEON(xs + i, vxs + i, min.x, max.x);
+        PL_ReflectNEON(ys + i, vys + i, min.y, max.y);
+    }
+    PL_V2ReflectSmall(xs + i, ys + i, vxs + i, vys + i, n - i, min, max);
 }
 
-// ------ v4 ------ //
-
-// constructors
-v4 v4i(i32 a, i32 b, i32 c, i32 d)
+static void PL_V2OverlapNEON(u64 *mask, const r32 *xs, const r32 *ys, const r32 *hws, const r32 *hhs, u64 n, v2 min, v2 max)
 {
-    v4 result = {(r32)a, (r32)b, (r32)c, (r32)d};
+    static const u32 laneBits[4] = {1, 2, 4, 8};
+    uint32x4_t bits = vld1q_u32(laneBits);
+    float32x4_t minX = vdupq_n_f32(min.x), maxX = vdupq_n_f32(max.x);
+    float32x4_t minY = vdupq_n_f32(min.y), maxY = vdupq_n_f32(max.y);
+    u64 i = 0;
+    for(; i + 64 <= n; i += 64)
+    {
+        u64 word = 0;
+        for(u64 j = 0; j < 64; j += 4)
+        {
+            float32x4_t x = vld1q_f32(xs + i + j), hw = vld1q_f32(hws + i + j);
+            float32x4_t y = vld1q_f32(ys + i + j), hh = vld1q_f32(hhs + i + j);
+            uint32x4_t hit = vandq_u32(vcleq_f32(vsubq_f32(x, hw), maxX), vcgeq_f32(vaddq_f32(x, hw), minX));
+            hit = vandq_u32(hit, vandq_u32(vcleq_f32(vsubq_f32(y, hh), maxY), vcgeq_f32(vaddq_f32(y, hh), minY)));
+            word |= (u64)vaddvq_u32(vandq_u32(hit, bits)) << j;
+        }
+        mask[i / 64] = word;
+    }
+    PL_V2OverlapSmall(mask + i / 64, xs + i, ys + i, hws + i, hhs + i, n - i, min, max);
+}
+
+#endif // PL_ARCH_ARM64
+
+/*=========== Trig Kernels =============*/
+
+// minimax polynomials (cephes sinf/cosf/atanf coefficients), written so the vector kernels do the
+// same operations in the same order as the scalar versions and give the same bits
+
+// sin and cos: a = k*pi/2 + r with |r| <= pi/4, pi/2 split in 3 so k*part is exact for |k| < 2^16
+#define PL_TWO_OVER_PI 0.636619772367581343f
+#define PL_PIO2_HI 1.5703125f
+#define PL_PIO2_MID 4.837512969970703125e-4f
+#define PL_PIO2_LO 7.54978995489188216e-8f
+// 1.5 * 2^23, adding it rounds to an integer that then sits in the low mantissa bits
+#define PL_ROUND_MAGIC 12582912.0f
+#define PL_SIN_C3 -1.6666654611e-1f
+#define PL_SIN_C5 8.3321608736e-3f
+#define PL_SIN_C7 -1.9515295891e-4f
+#define PL_COS_C4 4.166664568298827e-2f
+#define PL_COS_C6 -1.388731625493765e-3f
+#define PL_COS_C8 2.443315711809948e-5f
+
+// atan2: atan(t) for |t| <= tan(pi/8), bigger ratios use atan(a/b) = pi/4 + atan((a-b)/(a+b))
+#define PL_TAN_PI_8 0.414213562373095049f
+#define PL_ATAN_C3 -3.33329491539e-1f
+#define PL_ATAN_C5 1.99777106478e-1f
+#define PL_ATAN_C7 -1.38776856032e-1f
+#define PL_ATAN_C9 8.05374449538e-2f
+#define PL_PI_4_R32 0.785398163397448310f
+#define PL_PI_2_R32 1.57079632679489662f
+#define PL_PI_R32 3.14159265358979324f
+
+// mask ? a : b with mask all ones or zero, done on the bits because the conditions are random
+// for random input and branches would mispredict
+static inline r32 PL_SelectR32(u32 mask, r32 a, r32 b)
+{
+    u32 aBits, bBits;
+    memcpy(&aBits, &a, sizeof(aBits));
+    memcpy(&bBits, &b, sizeof(bBits));
+    u32 bits = (aBits & mask) | (bBits & ~mask);
+    r32 result;
+    memcpy(&result, &bits, sizeof(result));
     return result;
 }
-v4 v4u(u32 a, u32 b, u32 c, u32 d)
-{
-    v4 result = {(r32)a, (r32)b, (r32)c, (r32)d};
-    return result;    
-}
-v4 v4r(r32 a, r32 b, r32 c, r32 d)
+
+static inline u32 PL_R32Bits(r32 v)
 {
-    v4 result = {a, b, c, d};
-    return result;    
+    u32 bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return bits;
 }
 
-// maths operators
-v4 v4add(v4 a, v4 b)
+// quadrant 0 for sin, 1 for cos (cos(a) = sin(a + pi/2))
+static inline r32 PL_SinCosOne(r32 a, u32 quadrant)
 {
-    v4 result = {a.i[0]+b.i[0], a.i[1]+b.i[1], a.i[2]+b.i[2], a.i[3]+b.i[3]};
+    r32 t = a * PL_TWO_OVER_PI + PL_ROUND_MAGIC;
+    u32 q = PL_R32Bits(t) + quadrant;
+    r32 k = t - PL_ROUND_MAGIC;
+    r32 r = ((a - k * PL_PIO2_HI) - k * PL_PIO2_MID) - k * PL_PIO2_LO;
+    r32 z = r * r;
+    r32 s = ((PL_SIN_C7 * z + PL_SIN_C5) * z + PL_SIN_C3) * z * r + r;
+    r32 c = ((PL_COS_C8 * z + PL_COS_C6) * z + PL_COS_C4) * z * z - 0.5f * z + 1.0f;
+    u32 bits = PL_R32Bits(PL_SelectR32(0u - (q & 1), c, s)) ^ ((q & 2) << 30);
+    r32 result;
+    memcpy(&result, &bits, sizeof(result));
     return result;
 }
-v4 v4sub(v4 a, v4 b)
-{
-    v4 result = {a.i[0]-b.i[0], a.i[1]-b.i[1], a.i[2]-b.i[2], a.i[3]+b.i[3]};
-    return result;
+
+static inline r32 PL_Atan2One(r32 y, r32 x)
+{
+    r32 ax = fabsf(x);
+    r32 ay = fabsf(y);
+    // inf/inf is the diagonal, (1, 1) gives the same pi/4 or 3pi/4 without the nan from inf/inf
+    u32 bothInf = 0u - (u32)((ax == INFINITY) & (ay == INFINITY));
+    ax = PL_SelectR32(bothInf, 1.0f, ax);
+    ay = PL_SelectR32(bothInf, 1.0f, ay);
+    u32 swap = 0u - (u32)(ay > ax);
+    r32 a = PL_SelectR32(swap, ax, ay);
+    r32 b = PL_SelectR32(swap, ay, ax);
+    u32 big = 0u - (u32)(a > PL_TAN_PI_8 * b);
+    r32 num = PL_SelectR32(big, a - b, a);
+    r32 den = PL_SelectR32(big, a + b, b);
+    r32 t = PL_SelectR32(0u - (u32)(b != 0.0f), num / den, 0.0f);
+    r32 z = t * t;
+    r32 r = (((PL_ATAN_C9 * z + PL_ATAN_C7) * z + PL_ATAN_C5) * z + PL_ATAN_C3) * z * t + t;
+    r += PL_SelectR32(big, PL_PI_4_R32, 0.0f);
+    r = PL_SelectR32(swap, PL_PI_2_R32 - r, r);
+    r = PL_SelectR32(0u - (PL_R32Bits(x) >> 31), PL_PI_R32 - r, r);
+    return copysignf(r, y);
+}
+
+static inline void PL_SinCosSmall(r32 *dst, const r32 *src, u64 n, u32 quadrant)
+{
+    for(u64 i = 0; i < n; i++)
+    {
+        dst[i] = PL_SinCosOne(src[i], quadrant);
+    }
 }
-v4 v4mul(v4 a, r32 v)
+
+static inline void PL_Atan2Small(r32 *dst, const r32 *ys, const r32 *xs, u64 n)
 {
-    v4 result = {a.i[0]*v, a.i[1]*v, a.i[2]*v, a.i[3]*v};
-    return result;
+    for(u64 i = 0; i < n; i++)
+    {
+        dst[i] = PL_Atan2One(ys[i], xs[i]);
+    }
 }
-v4 v4div(v4 a, r32 v)
+
+#if !defined(__x86_64__) && !defined(_M_X64) && !defined(PL_ARCH_ARM64)
+static void PL_SinCosScalar(r32 *dst, const r32 *src, u64 n, u32 quadrant)
 {
-    v4 result = {a.i[0]/v, a.i[1]/v, a.i[2]/v, a.i[3]/v};
-    return result;    
+    PL_SinCosSmall(dst, src, n, quadrant);
 }
-v4 v4hadamard(v4 a, v4 b)
+
+static void PL_Atan2Scalar(r32 *dst, const r32 *ys, const r32 *xs, u64 n)
 {
-    v4 result = {a.i[0]*b.i[0], a.i[1]*b.i[1], a.i[2]*b.i[2]};
-    return result;
+    PL_Atan2Small(dst, ys, xs, n);
+}
+#endif
+
+#if defined(PL_ARCH_X86)
+
+// 4 lanes of PL_SinCosOne
+PL_TARGET("sse2")
+static inline __m128 PL_SinCosLanesSSE2(__m128 a, __m128i quadrant)
+{
+    __m128 magic = _mm_set1_ps(PL_ROUND_MAGIC);
+    __m128 t = _mm_add_ps(_mm_mul_ps(a, _mm_set1_ps(PL_TWO_OVER_PI)), magic);
+    __m128i q = _mm_add_epi32(_mm_castps_si128(t), quadrant);
+    __m128 k = _mm_sub_ps(t, magic);
+    __m128 r = _mm_sub_ps(a, _mm_mul_ps(k, _mm_set1_ps(PL_PIO2_HI)));
+    r = _mm_sub_ps(r, _mm_mul_ps(k, _mm_set1_ps(PL_PIO2_MID)));
+    r = _mm_sub_ps(r, _mm_mul_ps(k, _mm_set1_ps(PL_PIO2_LO)));
+    __m128 z = _mm_mul_ps(r, r);
+    
+    __m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(PL_SIN_C7), z), _mm_set1_ps(PL_SIN_C5));
+    s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(PL_SIN_C3));
+    s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, z), r), r);
+    __m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(PL_COS_C8), z), _mm_set1_ps(PL_COS_C6));
+    c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(PL_COS_C4));
+    c = _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(c, z), z), _mm_mul_ps(_mm_set1_ps(0.5f), z));
+    c = _mm_add_ps(c, _mm_set1_ps(1.0f));
+    
+    __m128 odd = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+    __m128 result = _mm_or_ps(_mm_and_ps(odd, c), _mm_andnot_ps(odd, s));
+    return _mm_xor_ps(result, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, _mm_set1_epi32(2)), 30)));
+}
+
+// 4 lanes of PL_Atan2One
+PL_TARGET("sse2")
+static inline __m128 PL_Atan2LanesSSE2(__m128 y, __m128 x)
+{
+    __m128 sign = _mm_set1_ps(-0.0f);
+    __m128 ax = _mm_andnot_ps(sign, x);
+    __m128 ay = _mm_andnot_ps(sign, y);
+    __m128 inf = _mm_set1_ps(INFINITY);
+    __m128 bothInf = _mm_and_ps(_mm_cmpeq_ps(ax, inf), _mm_cmpeq_ps(ay, inf));
+    ax = _mm_or_ps(_mm_and_ps(bothInf, _mm_set1_ps(1.0f)), _mm_andnot_ps(bothInf, ax));
+    ay = _mm_or_ps(_mm_and_ps(bothInf, _mm_set1_ps(1.0f)), _mm_andnot_ps(bothInf, ay));
+    __m128 a = _mm_min_ps(ax, ay);
+    __m128 b = _mm_max_ps(ay, ax);
+    __m128 big = _mm_cmpgt_ps(a, _mm_mul_ps(_mm_set1_ps(PL_TAN_PI_8), b));
+    __m128 num = _mm_or_ps(_mm_and_ps(big, _mm_sub_ps(a, b)), _mm_andnot_ps(big, a));
+    __m128 den = _mm_or_ps(_mm_and_ps(big, _mm_add_ps(a, b)), _mm_andnot_ps(big, b));
+    __m128 t = _mm_and_ps(_mm_div_ps(num, den), _mm_cmpneq_ps(b, _mm_setzero_ps()));
+    __m128 z = _mm_mul_ps(t, t);
+    
+    __m128 r = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(PL_ATAN_C9), z), _mm_set1_ps(PL_ATAN_C7));
+    r = _mm_add_ps(_mm_mul_ps(r, z), _mm_set1_ps(PL_ATAN_C5));
+    r = _mm_add_ps(_mm_mul_ps(r, z), _mm_set1_ps(PL_ATAN_C3));
+    r = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(r, z), t), t);
+    r = _mm_add_ps(r, _mm_and_ps(big, _mm_set1_ps(PL_PI_4_R32)));
+    
+    __m128 swap = _mm_cmpgt_ps(ay, ax);
+    r = _mm_or_ps(_mm_and_ps(swap, _mm_sub_ps(_mm_set1_ps(PL_PI_2_R32), r)), _mm_andnot_ps(swap, r));
+    __m128 xneg = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x), 31));
+    r = _mm_or_ps(_mm_and_ps(xneg, _mm_sub_ps(_mm_set1_ps(PL_PI_R32), r)), _mm_andnot_ps(xneg, r));
+    return _mm_or_ps(r, _mm_and_ps(y, sign));
+}
+
+// 8 at a time as two independent vectors
+PL_TARGET("sse2")
+static void PL_SinCosSSE2(r32 *dst, const r32 *src, u64 n, u32 quadrant)
+{
+    __m128i q = _mm_set1_epi32((int)quadrant);
+    u64 i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        __m128 a0 = PL_SinCosLanesSSE2(_mm_loadu_ps(src + i), q);
+        __m128 a1 = PL_SinCosLanesSSE2(_mm_loadu_ps(src + i + 4), q);
+        _mm_storeu_ps(dst + i, a0);
+        _mm_storeu_ps(dst + i + 4, a1);
+    }
+    PL_SinCosSmall(dst + i, src + i, n - i, quadrant);
 }
-r32 v4dot(v4 a, v4 b)
+
+PL_TARGET("sse2")
+static void PL_Atan2SSE2(r32 *dst, const r32 *ys, const r32 *xs, u64 n)
 {
-    r32 result = (a.i[0]*b.i[0]) + (a.i[1]*b.i[1]) + (a.i[2]*b.i[2]);
-    return result;
+    u64 i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        __m128 a0 = PL_Atan2LanesSSE2(_mm_loadu_ps(ys + i), _mm_loadu_ps(xs + i));
+        __m128 a1 = PL_Atan2LanesSSE2(_mm_loadu_ps(ys + i + 4), _mm_loadu_ps(xs + i + 4));
+        _mm_storeu_ps(dst + i, a0);
+        _mm_storeu_ps(dst + i + 4, a1);
+    }
+    PL_Atan2Small(dst + i, ys + i, xs + i, n - i);
+}
+
+PL_TARGET("avx2")
+static inline __m256 PL_SinCosLanesAVX2(__m256 a, __m256i quadrant)
+{
+    __m256 magic = _mm256_set1_ps(PL_ROUND_MAGIC);
+    __m256 t = _mm256_add_ps(_mm256_mul_ps(a, _mm256_set1_ps(PL_TWO_OVER_PI)), magic);
+    __m256i q = _mm256_add_epi32(_mm256_castps_si256(t), quadrant);
+    __m256 k = _mm256_sub_ps(t, magic);
+    __m256 r = _mm256_sub_ps(a, _mm256_mul_ps(k, _mm256_set1_ps(PL_PIO2_HI)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(k, _mm256_set1_ps(PL_PIO2_MID)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(k, _mm256_set1_ps(PL_PIO2_LO)));
+    __m256 z = _mm256_mul_ps(r, r);
+    
+    __m256 s = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(PL_SIN_C7), z), _mm256_set1_ps(PL_SIN_C5));
+    s = _mm256_add_ps(_mm256_mul_ps(s, z), _mm256_set1_ps(PL_SIN_C3));
+    s = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(s, z), r), r);
+    __m256 c = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(PL_COS_C8), z), _mm256_set1_ps(PL_COS_C6));
+    c = _mm256_add_ps(_mm256_mul_ps(c, z), _mm256_set1_ps(PL_COS_C4));
+    c = _mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(c, z), z), _mm256_mul_ps(_mm256_set1_ps(0.5f), z));
+    c = _mm256_add_ps(c, _mm256_set1_ps(1.0f));
+    
+    __m256 odd = _mm256_castsi256_ps(_mm256_slli_epi32(q, 31));
+    __m256 result = _mm256_blendv_ps(s, c, odd);
+    return _mm256_xor_ps(result, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(q, _mm256_set1_epi32(2)), 30)));
+}
+
+PL_TARGET("avx2")
+static inline __m256 PL_Atan2LanesAVX2(__m256 y, __m256 x)
+{
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 ax = _mm256_andnot_ps(sign, x);
+    __m256 ay = _mm256_andnot_ps(sign, y);
+    __m256 inf = _mm256_set1_ps(INFINITY);
+    __m256 bothInf = _mm256_and_ps(_mm256_cmp_ps(ax, inf, _CMP_EQ_OQ), _mm256_cmp_ps(ay, inf, _CMP_EQ_OQ));
+    ax = _mm256_blendv_ps(ax, _mm256_set1_ps(1.0f), bothInf);
+    ay = _mm256_blendv_ps(ay, _mm256_set1_ps(1.0f), bothInf);
+    __m256 a = _mm256_min_ps(ax, ay);
+    __m256 b = _mm256_max_ps(ay, ax);
+    __m256 big = _mm256_cmp_ps(a, _mm256_mul_ps(_mm256_set1_ps(PL_TAN_PI_8), b), _CMP_GT_OQ);
+    __m256 num = _mm256_blendv_ps(a, _mm256_sub_ps(a, b), big);
+    __m256 den = _mm256_blendv_ps(b, _mm256_add_ps(a, b), big);
+    __m256 t = _mm256_and_ps(_mm256_div_ps(num, den), _mm256_cmp_ps(b, _mm256_setzero_ps(), _CMP_NEQ_UQ));
+    __m256 z = _mm256_mul_ps(t, t);
+    
+    __m256 r = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(PL_ATAN_C9), z), _mm256_set1_ps(PL_ATAN_C7));
+    r = _mm256_add_ps(_mm256_mul_ps(r, z), _mm256_set1_ps(PL_ATAN_C5));
+    r = _mm256_add_ps(_mm256_mul_ps(r, z), _mm256_set1_ps(PL_ATAN_C3));
+    r = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(r, z), t), t);
+    r = _mm256_add_ps(r, _mm256_and_ps(big, _mm256_set1_ps(PL_PI_4_R32)));
+    
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(PL_PI_2_R32), r), _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(PL_PI_R32), r), x); // blend on the sign bit of x
+    return _mm256_or_ps(r, _mm256_and_ps(y, sign));
+}
+
+PL_TARGET("avx2")
+static void PL_SinCosAVX2(r32 *dst, const r32 *src, u64 n, u32 quadrant)
+{
+    __m256i q = _mm256_set1_epi32((int)quadrant);
+    u64 i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(dst + i, PL_SinCosLanesAVX2(_mm256_loadu_ps(src + i), q));
+    }
+    PL_SinCosSmall(dst + i, src + i, n - i, quadrant);
 }
-r32 v4lengthsq(v4 a)
+
+PL_TARGET("avx2")
+static void PL_Atan2AVX2(r32 *dst, const r32 *ys, const r32 *xs, u64 n)
 {
-    r32 result = v4dot(a,a);
-    return result;
+    u64 i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(dst + i, PL_Atan2LanesAVX2(_mm256_loadu_ps(ys + i), _mm256_loadu_ps(xs + i)));
+    }
+    PL_Atan2Small(dst + i, ys + i, xs + i, n - i);
+}
+
+#endif // PL_ARCH_X86
+
+#if defined(PL_ARCH_ARM64)
+
+static inline float32x4_t PL_SinCosLanesNEON(float32x4_t a, uint32x4_t quadrant)
+{
+    float32x4_t magic = vdupq_n_f32(PL_ROUND_MAGIC);
+    float32x4_t t = vaddq_f32(vmulq_n_f32(a, PL_TWO_OVER_PI), magic);
+    uint32x4_t q = vaddq_u32(vreinterpretq_u32_f32(t), quadrant);
+    float32x4_t k = vsubq_f32(t, magic);
+    float32x4_t r = vsubq_f32(a, vmulq_n_f32(k, PL_PIO2_HI));
+    r = vsubq_f32(r, vmulq_n_f32(k, PL_PIO2_MID));
+    r = vsubq_f32(r, vmulq_n_f32(k, PL_PIO2_LO));
+    float32x4_t z = vmulq_f32(r, r);
+    
+    float32x4_t s = vaddq_f32(vmulq_n_f32(z, PL_SIN_C7), vdupq_n_f32(PL_SIN_C5));
+    s = vaddq_f32(vmulq_f32(s, z), vdupq_n_f32(PL_SIN_C3));
+    s = vaddq_f32(vmulq_f32(vmulq_f32(s, z), r), r);
+    float32x4_t c = vaddq_f32(vmulq_n_f32(z, PL_COS_C8), vdupq_n_f32(PL_COS_C6));
+    c = vaddq_f32(vmulq_f32(c, z), vdupq_n_f32(PL_COS_C4));
+    c = vsubq_f32(vmulq_f32(vmulq_f32(c, z), z), vmulq_n_f32(z, 0.5f));
+    c = vaddq_f32(c, vdupq_n_f32(1.0f));
+    
+    uint32x4_t odd = vtstq_u32(q, vdupq_n_u32(1));
+    float32x4_t result = vbslq_f32(odd, c, s);
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(result), vshlq_n_u32(vandq_u32(q, vdupq_n_u32(2)), 30)));
+}
+
+static inline float32x4_t PL_Atan2LanesNEON(float32x4_t y, float32x4_t x)
+{
+    float32x4_t ax = vabsq_f32(x);
+    float32x4_t ay = vabsq_f32(y);
+    float32x4_t inf = vdupq_n_f32(INFINITY);
+    uint32x4_t bothInf = vandq_u32(vceqq_f32(ax, inf), vceqq_f32(ay, inf));
+    ax = vbslq_f32(bothInf, vdupq_n_f32(1.0f), ax);
+    ay = vbslq_f32(bothInf, vdupq_n_f32(1.0f), ay);
+    uint32x4_t swap = vcgtq_f32(ay, ax);
+    float32x4_t a = vbslq_f32(swap, ax, ay);
+    float32x4_t b = vbslq_f32(swap, ay, ax);
+    uint32x4_t big = vcgtq_f32(a, vmulq_n_f32(b, PL_TAN_PI_8));
+    float32x4_t num = vbslq_f32(big, vsubq_f32(a, b), a);
+    float32x4_t den = vbslq_f32(big, vaddq_f32(a, b), b);
+    uint32x4_t nonZero = vmvnq_u32(vceqq_f32(b, vdupq_n_f32(0.0f)));
+    float32x4_t t = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vdivq_f32(num, den)), nonZero));
+    float32x4_t z = vmulq_f32(t, t);
+    
+    float32x4_t r = vaddq_f32(vmulq_n_f32(z, PL_ATAN_C9), vdupq_n_f32(PL_ATAN_C7));
+    r = vaddq_f32(vmulq_f32(r, z), vdupq_n_f32(PL_ATAN_C5));
+    r = vaddq_f32(vmulq_f32(r, z), vdupq_n_f32(PL_ATAN_C3));
+    r = vaddq_f32(vmulq_f32(vmulq_f32(r, z), t), t);
+    r = vaddq_f32(r, vreinterpretq_f32_u32(vandq_u32(big, vreinterpretq_u32_f32(vdupq_n_f32(PL_PI_4_R32)))));
+    
+    r = vbslq_f32(swap, vsubq_f32(vdupq_n_f32(PL_PI_2_R32), r), r);
+    uint32x4_t xneg = vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_f32(x), 31));
+    r = vbslq_f32(xneg, vsubq_f32(vdupq_n_f32(PL_PI_R32), r), r);
+    uint32x4_t sign = vdupq_n_u32(0x80000000);
+    return vbslq_f32(sign, y, r);
+}
+
+static void PL_SinCosNEON(r32 *dst, const r32 *src, u64 n, u32 quadrant)
+{
+    uint32x4_t q = vdupq_n_u32(quadrant);
+    u64 i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        float32x4_t a0 = PL_SinCosLanesNEON(vld1q_f32(src + i), q);
+        float32x4_t a1 = PL_SinCosLanesNEON(vld1q_f32(src + i + 4), q);
+        vst1q_f32(dst + i, a0);
+        vst1q_f32(dst + i + 4, a1);
+    }
+    PL_SinCosSmall(dst + i, src + i, n - i, quadrant);
 }
-r32 v4length(v4 a)
+
+static void PL_Atan2NEON(r32 *dst, const r32 *ys, const r32 *xs, u64 n)
 {
-    r32 result = PL_sqrt(v4sq(a));
-    return result;
+    u64 i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        float32x4_t a0 = PL_Atan2LanesNEON(vld1q_f32(ys + i), vld1q_f32(xs + i));
+        float32x4_t a1 = PL_Atan2LanesNEON(vld1q_f32(ys + i + 4), vld1q_f32(xs + i + 4));
+        vst1q_f32(dst + i, a0);
+        vst1q_f32(dst + i + 4, a1);
+    }
+    PL_Atan2Small(dst + i, ys + i, xs + i, n - i);
 }
 
-/*=========== HASH =============*/
+#endif // PL_ARCH_ARM64
 
-// CREDIT: modified version from Paul Hsieh: www.azillionmonkeys.com/qed/hash.html
-// I won't pretend to understand the magic constants used here
-u32 PL_Hash32(ptr input, u64 inputSize)
+// picks the fastest kernels for this machine, called once by the platform at startup
+// after PL_SystemInfo is filled
+static void PL_InitDispatch(PL_SystemInfo *info)
 {
-    char placeholder[4] = {0};
-    for(u8 i=0;i<(u8)inputSize;i++)
+#if defined(PL_ARCH_X86)
+    if(info->sse2)
     {
-        i8 *p=(i8*)input;
-        p+=i;
-        placeholder[i]=*p;
+        pl_dispatch.memSet = PL_MemSetSSE2;
+        pl_dispatch.memCpy = PL_MemCpySSE2;
+        pl_dispatch.strNLen = PL_StrNLenSSE2;
+        pl_dispatch.randFill = PL_RandFillSSE2;
+        pl_dispatch.randToR32 = PL_RandToR32SSE2;
+        pl_dispatch.randToRange = PL_RandToRangeSSE2;
+        pl_dispatch.v2Integrate = PL_V2IntegrateSSE2;
+        pl_dispatch.v2Reflect = PL_V2ReflectSSE2;
+        pl_dispatch.v2Overlap = PL_V2OverlapSSE2;
+        pl_dispatch.v4Transform = PL_V4TransformSSE2;
+        pl_dispatch.sinCos = PL_SinCosSSE2;
+        pl_dispatch.atan2 = PL_Atan2SSE2;
     }
-    i8 *in = (i8*)input;
-    if(inputSize<4) in = placeholder;
-    u32 result = (u32)inputSize;
-    u32 tmp;
-    u64 len = inputSize;
-    int rlen;
-    
-    rlen = len & 3;
-    len >>= 2;
-    
-    while(len > 0)
+    if(info->avx2)
     {
-        result += PL_Reinterpret(u16, in);
-        tmp = (PL_Reinterpret(u16, in + 2) << 11) ^ result;
-        result = (result << 16) ^ tmp;
-        in += 2 * sizeof(u16);
-        result += result >> 11;
-        len--;
+        pl_dispatch.memSet = PL_MemSetAVX2;
+        pl_dispatch.memCpy = PL_MemCpyAVX2;
+        pl_dispatch.strNLen = PL_StrNLenAVX2;
+        pl_dispatch.randFill = PL_RandFillAVX2;
+        pl_dispatch.randToR32 = PL_RandToR32AVX2;
+        pl_dispatch.randToRange = PL_RandToRangeAVX2;
+        pl_dispatch.v2Integrate = PL_V2IntegrateAVX2;
+        pl_dispatch.v2Reflect = PL_V2ReflectAVX2;
+        pl_dispatch.v2Overlap = PL_V2OverlapAVX2;
+        pl_dispatch.v4Transform = PL_V4TransformAVX2;
+        pl_dispatch.sinCos = PL_SinCosAVX2;
+        pl_dispatch.atan2 = PL_Atan2AVX2;
     }
+#endif
     
-    switch (rlen)
+    if(info->l3Cache > pl_dispatch.nonTemporalMin)
     {
-        case 1:
-        {
-            result += *in;
-            result ^= result << 10;
-            result += result >> 1;
-        } break;
-        case 2:
-        {
-            result += PL_Reinterpret(u16, in);
-            result ^= result << 11;
-            result += result >> 17;
-        } break;
-        case 3:
-        {
-            result += PL_Reinterpret(u16, in);
-            result ^= result << 16;
-            result ^= (in[sizeof(u16)]) << 18;
-            result += result >> 11;
-        } break;
+        pl_dispatch.nonTemporalMin = info->l3Cache;
     }
-    
-    result ^= result << 3;
-    result += result >> 5;
-    result ^= result << 4;
-    result += result >> 17;
-    result ^= result << 25;
-    result += result >> 6;
-    
-    return result;
 }
 
-/*=========== RAND =================*/
-
-static b8 PL_RAND_IS_INIT;
-typedef union
+void PL_MemZero(ptr mem, u64 size)
 {
-    u8 rb[4];
-    u32 ru32;
-} PL_RAND_UNION;
+    if(mem && size)
+    {
+        pl_dispatch.memSet((u8*)mem, 0, size);
+    }
+}
 
-r32 PL_Rand(void)
+ptr PL_MemSet(ptr mem, u8 value, u64 size)
 {
-    if(!PL_RAND_IS_INIT)
+    if(!mem || !size)
     {
-        time_t t = time(0);
-        srand(PL_Hash32(&t, sizeof(time_t)));
-        PL_RAND_IS_INIT = 1;
+        return 0;
     }
     
-    PL_RAND_UNION ru;
-    for(int i=0;i<4;i++) {ru.rb[i] = (u8)(rand()%0xff);}
-    r32 result = PL_norm32((r32)ru.ru32, 0.0f, (r32)UINT32_MAX);
-    
-    return result;
+    pl_dispatch.memSet((u8*)mem, value, size);
+    return (u8*)mem + size;
 }
 
-void PL_SeedRand(ptr value, u64 valueSize)
+u64 PL_MemCpy(ptr src, ptr dst, u64 size)
 {
-    srand(PL_Hash32(value, valueSize));
-    PL_RAND_IS_INIT = 1;
+    if(!src || !dst || !size)
+    {
+        return 0;
+    }
+    
+    pl_dispatch.memCpy((u8*)dst, (const u8*)src, size);
+    return size;
 }
 
-/*======== OpenGL Helpers ==============*/
+u64 PL_StrLen(cstr str)
+{
+    if(!str)
+    {
+        return 0;
+    }
+    
+    return pl_dispatch.strNLen(str, UINT64_MAX);
+}
 
-r32 PL_GetGLVersion(void)
+u64 PL_StrNLen(cstr str, u64 max)
 {
-    return ((r32)PL_OPENGL_MAJ + ((r32)PL_OPENGL_MIN/10.0f));
+    if(!str || !max)
+    {
+        return 0;
+    }
+    
+    return pl_dispatch.strNLen(str, max);
 }
 
-u32 PL_GLCreateProgram(cstr vertexShaderSrc, cstr fragmentShaderSrc)
+u64 PL_StrCpy(cstr src, cstr dst, u64 len)
 {
-    u32 vertexShaderID = glCreateShader(GL_VERTEX_SHADER);
-    u32 fragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
-    u32 result = 0;
+    if(!src || !dst || !len)
+    {
+        return 0;
+    }
     
-    { // VertexShader compilation
-        glShaderSource(vertexShaderID, 1, &vertexShaderSrc, 0);
-        glCompileShader(vertexShaderID);
-        i32 success;
-        char infoLog[512] = {0};
-        glGetShaderiv(vertexShaderID, GL_COMPILE_STATUS, &success);
-        if(!success)
-        {
-            glGetShaderInfoLog(vertexShaderID, 512, 0, infoLog);
-            PL_SetErrorString("GLCreateProgram error: VertexShader failed to compile: %s", infoLog);
-            return 0;
-        }
+    u64 result = pl_dispatch.strNLen(src, len);
+    PL_MemCpy(src, dst, result);
+    dst[result] = 0; // append \0 to end of string
+    return result;
+}
+
+u64 PL_StrCat(cstr src, cstr dst, u64 len)
+{
+    if(!src || !dst || !len)
+    {
+        return 0;
     }
     
-    { // FragmentShader compilation
-        glShaderSource(fragmentShaderID, 1, &fragmentShaderSrc, 0);
-        glCompileShader(fragmentShaderID);
-        i32 success;
-        char infoLog[512] = {0};
-        glGetShaderiv(fragmentShaderID, GL_COMPILE_STATUS, &success);
-        if(!success)
-        {
-            glGetShaderInfoLog(fragmentShaderID, 512, 0, infoLog);
-            PL_SetErrorString("GLCreateProgram error: FragmentShader failed to compile: %s", infoLog);
-            return 0;
-        }
+    u64 result = pl_dispatch.strNLen(dst, len);
+    if(result == len)
+    {
+        return result;
     }
     
-    result = glCreateProgram();
-    glAttachShader(result, vertexShaderID);
-    glAttachShader(result, fragmentShaderID);
-    glLinkProgram(result);
-    { // program compilation
-        i32 success;
-        char infoLog[512] = {0};
-        glGetProgramiv(result, GL_LINK_STATUS, &success);
-        if(!success)
-        {
-            glGetProgramInfoLog(result, 512, 0, infoLog);
-            PL_SetErrorString("GLCreateProgram error: Program failed to compile: %s", infoLog);
-        }
+    u64 srcLen = pl_dispatch.strNLen(src, len - result);
+    PL_MemCpy(src, dst + result, srcLen);
+    result += srcLen;
+    dst[result] = 0; // append \0 to end of string
+    return result;
+}
+
+void PL_StrVar(cstr dst, u64 maxlen,
+               const cstr format, ...)
+{
+    if(!dst || !maxlen || !format)
+    {
+        return;
     }
     
-    glDeleteShader(vertexShaderID);
-    glDeleteShader(fragmentShaderID);
+    va_list args;
+    va_start(args, format);
+    vsnprintf(dst, maxlen, format, args);
+    va_end(args);
+}
+
+PL_Str PL_StrBuffer(cstr buffer, u64 size)
+{
+    PL_Str result = {0};
+    
+    if(buffer && size)
+    {
+        result.data = buffer;
+        result.cap = size;
+        buffer[0] = 0;
+    }
     
     return result;
 }
 
-/*==============================
-      PHRAGLIB WIN32
-      Windows Specific
-===============================*/
-#if defined(PL_WINDOWS)
-#include <windows.h>
-#include <xinput.h>
-#include <xaudio2.h>
+PL_Str PL_StrBufferAt(cstr buffer, u64 size)
+{
+    PL_Str result = {0};
+    
+    if(buffer && size)
+    {
+        result.data = buffer;
+        result.cap = size;
+        result.len = PL_StrNLen(buffer, size - 1);
+        buffer[result.len] = 0;
+    }
+    
+    return result;
+}
 
-/* ======= WIN32 LIB FUNCTIONS ======== */
+void PL_StrClear(PL_Str *str)
+{
+    if(str->cap)
+    {
+        str->len = 0;
+        str->data[0] = 0;
+    }
+}
 
-#define WIN32_LOAD_DLLFN(name) {name = (tfn_##name *)GetProcAddress(lib, #name ); if(!name) return 0;}
+b32 PL_StrAppendN(PL_Str *str, const char *src, u64 len)
+{
+    if(!str->cap) return !len;
+    
+    u64 room = str->cap - 1 - str->len;
+    u64 count = (len < room) ? len : room;
+    PL_MemCpy((ptr)src, str->data + str->len, count);
+    str->len += count;
+    str->data[str->len] = 0;
+    return (count == len);
+}
 
-/*============ USER32 ================*/
+b32 PL_StrAppend(PL_Str *str, const char *src)
+{
+    if(!src || !str->cap) return 1;
+    
+    // scan only as far as there is room for, plus one char to tell if src was cut off
+    u64 room = str->cap - 1 - str->len;
+    u64 len = pl_dispatch.strNLen(src, room + 1);
+    return PL_StrAppendN(str, src, len);
+}
 
-typedef BOOL tfn_TranslateMessage(const MSG *lpMsg);
-tfn_TranslateMessage *pfn_TranslateMessage;
-#define TranslateMessage pfn_TranslateMessage
+b32 PL_StrAppendChar(PL_Str *str, char c)
+{
+    if(!str->cap || str->len + 1 >= str->cap) return 0;
+    
+    str->data[str->len++] = c;
+    str->data[str->len] = 0;
+    return 1;
+}
 
-typedef LRESULT tfn_DispatchMessageA(const MSG *lpMsg);
-tfn_DispatchMessageA *pfn_DispatchMessageA;
-#define DispatchMessageA pfn_DispatchMessageA
+b32 PL_StrAppendV(PL_Str *str, const cstr format, va_list args)
+{
+    if(!str->cap || !format) return 0;
+    
+    u64 room = str->cap - str->len; // including the terminator
+    int written = vsnprintf(str->data + str->len, room, format, args);
+    if(written < 0)
+    {
+        str->data[str->len] = 0;
+        return 0;
+    }
+    
+    if((u64)written >= room)
+    {
+        str->len = str->cap - 1;
+        return 0;
+    }
+    
+    str->len += (u64)written;
+    return 1;
+}
 
-typedef BOOL tfn_PeekMessageA(LPMSG lpMsg, HWND hWnd, UINT wMsgFilterMin, UINT wMsgFilterMax, UINT wRemoveMsg);
-tfn_PeekMessageA *pfn_PeekMessageA;
-#define PeekMessageA pfn_PeekMessageA
+b32 PL_StrAppendF(PL_Str *str, const cstr format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    b32 result = PL_StrAppendV(str, format, args);
+    va_end(args);
+    return result;
+}
 
-typedef LRESULT tfn_DefWindowProcA(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam);
-tfn_DefWindowProcA *pfn_DefWindowProcA;
-#define DefWindowProcA pfn_DefWindowProcA
+PL_Str PL_StrArena(PL_Arena *arena, u64 size)
+{
+    return PL_StrBuffer((cstr)PL_ArenaPush(arena, size), size);
+}
 
-typedef ATOM tfn_RegisterClassA(const WNDCLASSA *lpWndClass);
-tfn_RegisterClassA *pfn_RegisterClassA;
-#define RegisterClassA pfn_RegisterClassA
+/*=========== Number Formatting =============*/
 
-typedef HWND tfn_CreateWindowExA(DWORD dwExStyle, LPCSTR lpClassName, LPCSTR lpWindowName, DWORD dwStyle,
-                                 int X, int Y, int nWidth, int nHeight,
-                                 HWND hWndParent, HMENU hMenu, HINSTANCE hInstance, LPVOID lpParam);
-tfn_CreateWindowExA *pfn_CreateWindowExA;
-#define CreateWindowExA pfn_CreateWindowExA
+// longest u64 (20 digits) + sign / a 9 digit fraction and point with headroom
+#define PL_FMT_BUFFER_SIZE 48
+#define PL_FMT_MAX_DECIMALS 9
+#define PL_FMT_TIE_WINDOW (1.0 / 4194304.0) // 2^-22, twice the rounding error of fraction * 1e9
 
-typedef BOOL tfn_DestroyWindow(HWND hWnd);
-tfn_DestroyWindow *pfn_DestroyWindow;
-#define DestroyWindow pfn_DestroyWindow
+static const char pl_digitPairs[201] =
+"00010203040506070809"
+"10111213141516171819"
+"20212223242526272829"
+"30313233343536373839"
+"40414243444546474849"
+"50515253545556575859"
+"60616263646566676869"
+"70717273747576777879"
+"80818283848586878889"
+"90919293949596979899";
 
-typedef BOOL tfn_MoveWindow(HWND hWnd, int X, int Y, int nWidth, int nHeight, BOOL bRepaint);
-tfn_MoveWindow *pfn_MoveWindow;
-#define MoveWindow pfn_MoveWindow
+static const u64 pl_pow10[PL_FMT_MAX_DECIMALS + 1] =
+{
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
 
-typedef BOOL tfn_SetWindowPos(HWND hWnd, HWND hWndInsertAfter, int X, int Y, int cx, int cy, UINT uFlags);
-tfn_SetWindowPos *pfn_SetWindowPos;
-#define SetWindowPos pfn_SetWindowPos
+// writes the digits of value so they end at end, two at a time, returns the first char
+static char *PL_FmtDecimal(char *end, u64 value)
+{
+    // 64 bit division is slow on some targets, drop to 32 bit as soon as it fits
+    while(value > 0xffffffff)
+    {
+        u64 pair = (value % 100) * 2;
+        value /= 100;
+        end -= 2;
+        end[0] = pl_digitPairs[pair];
+        end[1] = pl_digitPairs[pair + 1];
+    }
+    
+    u32 v = (u32)value;
+    while(v >= 100)
+    {
+        u32 pair = (v % 100) * 2;
+        v /= 100;
+        end -= 2;
+        end[0] = pl_digitPairs[pair];
+        end[1] = pl_digitPairs[pair + 1];
+    }
+    
+    if(v >= 10)
+    {
+        end -= 2;
+        end[0] = pl_digitPairs[v * 2];
+        end[1] = pl_digitPairs[v * 2 + 1];
+    }
+    else
+    {
+        *--end = (char)('0' + v);
+    }
+    
+    return end;
+}
 
-typedef BOOL tfn_GetWindowPlacement(HWND hWnd, WINDOWPLACEMENT *lpwndpl);
-tfn_GetWindowPlacement *pfn_GetWindowPlacement;
-#define GetWindowPlacement pfn_GetWindowPlacement
+b32 PL_StrAppendU64(PL_Str *str, u64 value)
+{
+    char buffer[PL_FMT_BUFFER_SIZE];
+    char *end = buffer + sizeof(buffer);
+    char *start = PL_FmtDecimal(end, value);
+    return PL_StrAppendN(str, start, (u64)(end - start));
+}
 
-typedef BOOL tfn_SetWindowPlacement(HWND hWnd, const WINDOWPLACEMENT *lpwndpl);
-tfn_SetWindowPlacement *pfn_SetWindowPlacement;
-#define SetWindowPlacement pfn_SetWindowPlacement
+b32 PL_StrAppendI64(PL_Str *str, i64 value)
+{
+    char buffer[PL_FMT_BUFFER_SIZE];
+    char *end = buffer + sizeof(buffer);
+    u64 magnitude = (value < 0) ? (0 - (u64)value) : (u64)value;
+    char *start = PL_FmtDecimal(end, magnitude);
+    if(value < 0) *--start = '-';
+    return PL_StrAppendN(str, start, (u64)(end - start));
+}
 
-typedef HDC tfn_GetDC(HWND hWnd);
-tfn_GetDC *pfn_GetDC;
-#define GetDC pfn_GetDC
+b32 PL_StrAppendHex(PL_Str *str, u64 value, u32 minDigits)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    char buffer[PL_FMT_BUFFER_SIZE];
+    char *end = buffer + sizeof(buffer);
+    char *start = end;
+    if(minDigits > 16) minDigits = 16;
+    
+    do
+    {
+        *--start = hexDigits[value & 0xf];
+        value >>= 4;
+    }
+    while(value || (u32)(end - start) < minDigits);
+    
+    return PL_StrAppendN(str, start, (u64)(end - start));
+}
 
-typedef int tfn_ReleaseDC(HWND hWnd, HDC  hDC);
-tfn_ReleaseDC *pfn_ReleaseDC;
-#define ReleaseDC pfn_ReleaseDC
+b32 PL_StrAppendR64(PL_Str *str, r64 value, u32 decimals)
+{
+    if(decimals > PL_FMT_MAX_DECIMALS) decimals = PL_FMT_MAX_DECIMALS;
+    
+    b32 negative = (signbit(value) != 0); // -0.0 prints a sign like printf
+    r64 magnitude = fabs(value);
+    if(!(magnitude < 1e18)) // also catches nan and inf
+    {
+        return PL_StrAppendF(str, "%.*f", (int)decimals, value);
+    }
+    
+    // below 1e18 the whole part is exact in a u64 and the fraction is exact in the r64,
+    // ties round to even like printf
+    u64 scale = pl_pow10[decimals];
+    u64 whole = (u64)magnitude;
+    r64 fraction = magnitude - (r64)whole;
+    r64 scaled = fraction * (r64)scale;
+    u64 frac = (u64)scaled;
+    r64 rest = scaled - (r64)frac;
+    b32 roundUp = (rest > 0.5);
+    
+    // scaled is within 2^-23 of the exact product, so only near a tie (or an integer it may
+    // have rounded up to) the exact remainder decides: fma rounds once and keeps its sign
+    if(rest == 0.0 || fabs(rest - 0.5) < PL_FMT_TIE_WINDOW)
+    {
+        if(fma(fraction, (r64)scale, -(r64)frac) < 0.0) frac--;
+        r64 tie = fma(fraction, (r64)scale, -((r64)frac + 0.5));
+        roundUp = (tie > 0.0 || (tie == 0.0 && ((decimals ? frac : whole) & 1)));
+    }
+    
+    if(roundUp)
+    {
+        frac++;
+    }
+    if(frac >= scale)
+    {
+        frac -= scale;
+        whole++;
+    }
+    
+    char buffer[PL_FMT_BUFFER_SIZE];
+    char *end = buffer + sizeof(buffer);
+    char *start = end;
+    
+    if(decimals)
+    {
+        for(u32 i = 0; i < decimals; i++)
+        {
+            *--start = (char)('0' + (frac % 10));
+            frac /= 10;
+        }
+        *--start = '.';
+    }
+    
+    start = PL_FmtDecimal(start, whole);
+    if(negative) *--start = '-';
+    return PL_StrAppendN(str, start, (u64)(end - start));
+}
 
-typedef BOOL tfn_SetWindowTextA(HWND hWnd, LPCSTR lpString);
-tfn_SetWindowTextA *pfn_SetWindowTextA;
-#define SetWindowTextA pfn_SetWindowTextA
-
-typedef int tfn_MessageBoxA(HWND hWnd, LPCSTR lpText, LPCSTR lpCaption, UINT uType);
-tfn_MessageBoxA *pfn_MessageBoxA;
-#define MessageBoxA pfn_MessageBoxA
-
-typedef BOOL tfn_GetCursorPos(LPPOINT lpPoint);
-tfn_GetCursorPos *pfn_GetCursorPos;
-#define GetCursorPos pfn_GetCursorPos
-
-typedef BOOL tfn_ScreenToClient(HWND hWnd, LPPOINT lpPoint);
-tfn_ScreenToClient *pfn_ScreenToClient;
-#define ScreenToClient pfn_ScreenToClient
-
-typedef LONG tfn_GetWindowLongA(HWND hWnd, int nIndex);
-tfn_GetWindowLongA *pfn_GetWindowLongA;
-#define GetWindowLongA pfn_GetWindowLongA
-
-typedef LONG tfn_SetWindowLongA(HWND hWnd, int nIndex, LONG dwNewLong);
-tfn_SetWindowLongA *pfn_SetWindowLongA;
-#define SetWindowLongA pfn_SetWindowLongA
-
-typedef HMONITOR tfn_MonitorFromWindow(HWND hwnd, DWORD dwFlags);
-tfn_MonitorFromWindow *pfn_MonitorFromWindow;
-#define MonitorFromWindow pfn_MonitorFromWindow
-
-typedef BOOL tfn_GetMonitorInfoA(HMONITOR hMonitor, LPMONITORINFO lpmi);
-tfn_GetMonitorInfoA *pfn_GetMonitorInfoA;
-#define GetMonitorInfoA pfn_GetMonitorInfoA
-
-typedef BOOL tfn_GetClientRect(HWND hWnd, LPRECT lpRect);
-tfn_GetClientRect *pfn_GetClientRect;
-#define GetClientRect pfn_GetClientRect
-
-typedef BOOL tfn_GetWindowRect(HWND hWnd, LPRECT lpRect);
-tfn_GetWindowRect *pfn_GetWindowRect;
-#define GetWindowRect pfn_GetWindowRect
-
-static b32 Win32_LoadUserLib()
+b32 PL_StrAppendR32(PL_Str *str, r32 value, u32 decimals)
 {
-    HMODULE lib = LoadLibraryA("user32.dll");
-    if(!lib) return 0;
-    
-    WIN32_LOAD_DLLFN(TranslateMessage);
-    WIN32_LOAD_DLLFN(DispatchMessageA);
-    WIN32_LOAD_DLLFN(PeekMessageA);
-    WIN32_LOAD_DLLFN(DefWindowProcA);
-    WIN32_LOAD_DLLFN(RegisterClassA);
-    WIN32_LOAD_DLLFN(CreateWindowExA);
-    WIN32_LOAD_DLLFN(DestroyWindow);
-    WIN32_LOAD_DLLFN(MoveWindow);
-    WIN32_LOAD_DLLFN(SetWindowPos);
-    WIN32_LOAD_DLLFN(GetWindowPlacement);
-    WIN32_LOAD_DLLFN(SetWindowPlacement);
-    WIN32_LOAD_DLLFN(GetDC);
-    WIN32_LOAD_DLLFN(ReleaseDC);
-    WIN32_LOAD_DLLFN(SetWindowTextA);
-    WIN32_LOAD_DLLFN(MessageBoxA);
-    WIN32_LOAD_DLLFN(GetCursorPos);
-    WIN32_LOAD_DLLFN(ScreenToClient);
-    WIN32_LOAD_DLLFN(GetWindowLongA);
-    WIN32_LOAD_DLLFN(SetWindowLongA);
-    WIN32_LOAD_DLLFN(MonitorFromWindow);
-    WIN32_LOAD_DLLFN(GetMonitorInfoA);
-    WIN32_LOAD_DLLFN(GetClientRect);
-    WIN32_LOAD_DLLFN(GetWindowRect);
-    
-    return 1;
+    return PL_StrAppendR64(str, (r64)value, decimals);
 }
 
-/*========== GDI32 =============*/
-
-typedef int tfn_ChoosePixelFormat(HDC hdc, const PIXELFORMATDESCRIPTOR *ppfd);
-tfn_ChoosePixelFormat *pfn_ChoosePixelFormat;
-#define ChoosePixelFormat pfn_ChoosePixelFormat
-
-typedef int tfn_DescribePixelFormat(HDC hdc, int iPixelFormat, UINT nBytes, LPPIXELFORMATDESCRIPTOR ppfd);
-tfn_DescribePixelFormat *pfn_DescribePixelFormat;
-#define DescribePixelFormat pfn_DescribePixelFormat
-
-typedef BOOL tfn_SetPixelFormat(HDC hdc, int format, const PIXELFORMATDESCRIPTOR *ppfd);
-tfn_SetPixelFormat *pfn_SetPixelFormat;
-#define SetPixelFormat pfn_SetPixelFormat
-
-typedef BOOL tfn_SwapBuffers(HDC unnamedParam1);
-tfn_SwapBuffers *pfn_SwapBuffers;
-#define SwapBuffers pfn_SwapBuffers
-
-static b32 Win32_LoadGDILib()
+// formats on the stack so the text goes out in one write of known length,
+// anything longer than the buffer is streamed through stdio instead
+#define PL_PRINT_BUFFER_SIZE 1024
+static void PL_PrintV(FILE *stream, const cstr format, va_list args)
 {
-    HMODULE lib = LoadLibraryA("gdi32.dll");
-    if(!lib) return 0;
+    char buffer[PL_PRINT_BUFFER_SIZE];
+    PL_Str str = PL_StrBuffer(buffer, sizeof(buffer));
+    va_list argsCopy;
+    va_copy(argsCopy, args);
     
-    WIN32_LOAD_DLLFN(ChoosePixelFormat);
-    WIN32_LOAD_DLLFN(DescribePixelFormat);
-    WIN32_LOAD_DLLFN(SetPixelFormat);
-    WIN32_LOAD_DLLFN(SwapBuffers);
+    if(PL_StrAppendV(&str, format, argsCopy))
+    {
+        fwrite(str.data, 1, str.len, stream);
+    }
+    else
+    {
+        vfprintf(stream, format, args);
+    }
     
-    return 1;
+    va_end(argsCopy);
 }
 
-/*=========== WGL ==============*/
-
-typedef HGLRC tfn_wglCreateContext(HDC unnamedParam1);
-tfn_wglCreateContext *pfn_wglCreateContext;
-#define wglCreateContext pfn_wglCreateContext
-
-typedef BOOL tfn_wglDeleteContext(HGLRC unnamedParam1);
-tfn_wglDeleteContext *pfn_wglDeleteContext;
-#define wglDeleteContext pfn_wglDeleteContext
-
-typedef PROC tfn_wglGetProcAddress(LPCSTR unnamedParam1);
-tfn_wglGetProcAddress *pfn_wglGetProcAddress;
-#define wglGetProcAddress pfn_wglGetProcAddress
-
-typedef BOOL tfn_wglMakeCurrent(HDC unnamedParam1, HGLRC unnamedParam2);
-tfn_wglMakeCurrent *pfn_wglMakeCurrent;
-#define wglMakeCurrent pfn_wglMakeCurrent
-
-static b32 Win32_LoadWGLLib(void)
+void PL_Print(cstr format, ...)
 {
-    HMODULE lib = LoadLibraryA("opengl32.dll");
-    if(!lib) return 0;
-    
-    WIN32_LOAD_DLLFN(wglCreateContext);
-    WIN32_LOAD_DLLFN(wglDeleteContext);
-    WIN32_LOAD_DLLFN(wglGetProcAddress);
-    WIN32_LOAD_DLLFN(wglMakeCurrent);
-    
-    return 1;
+    va_list args;
+    va_start(args, format);
+    PL_PrintV(stdout, format, args);
+    va_end(args);
+    fflush(stdout);
 }
 
-/*========= XINPUT =============*/
-
-typedef DWORD WINAPI tfn_XInputGetState(DWORD dwUserIndex, XINPUT_STATE *pState);
-typedef DWORD WINAPI tfn_XInputSetState(DWORD dwUserIndex, XINPUT_VIBRATION *pVibration);
-DWORD WINAPI sfn_XInputGetState(DWORD dwUserIndex, XINPUT_STATE *pState)
-{return ERROR_DEVICE_NOT_CONNECTED;}
-DWORD WINAPI sfn_XInputSetState(DWORD dwUserIndex, XINPUT_VIBRATION *pVibration)
-{return ERROR_DEVICE_NOT_CONNECTED;}
-
-typedef enum
-{
-    WIN32_XINPUT_NOT_LOADED = 0,
-    WIN32_XINPUT_1_4,
-    WIN32_XINPUT_9_1_0,
-    WIN32_XINPUT_1_3
-} WIN32_XINPUT_LOADED_VERSION;
-
-typedef struct
+void PL_PrintErr(cstr format, ...)
 {
-    WIN32_XINPUT_LOADED_VERSION version;
-    tfn_XInputGetState *GetState;
-    tfn_XInputSetState *SetState;
-} Win32_XInput;
+    va_list args;
+    va_start(args, format);
+    PL_PrintV(stderr, format, args);
+    va_end(args);
+    fflush(stderr);
+}
 
-/*============== XAUDIO2 ================*/
+// fwd decl for funcs to use this before it is defined
+void PL_SetErrorString(const cstr format, ...);
 
-typedef HRESULT tfn_XAudio2Create(IXAudio2 **ppXAudio2, UINT32 Flags, XAUDIO2_PROCESSOR XAudio2Processor);
-HRESULT sfn_XAudio2Create(IXAudio2 **ppXAudio2, UINT32 Flags, XAUDIO2_PROCESSOR XAudio2Processor)
-{return XAUDIO2_E_XAPO_CREATION_FAILED;}
+/*============= Arenas ==================*/
 
-typedef enum
+void PL_ArenaInit(PL_Arena *arena, ptr base, u64 size)
 {
-    WIN32_XAUDIO_NOT_LOADED = 0,
-    WIN32_XAUDIO_2_9,
-    WIN32_XAUDIO_2_9D,
-    WIN32_XAUDIO_2_8,
-    WIN32_XAUDIO_2_7
-} WIN32_XAUDIO_LOADED_VERSION;
+    arena->base = (u8*)base;
+    arena->size = base ? size : 0;
+    arena->used = 0;
+    arena->tempCount = 0;
+}
 
-typedef struct
+ptr PL_ArenaPushAligned(PL_Arena *arena, u64 size, u64 align)
 {
-    WIN32_XAUDIO_LOADED_VERSION version;
-    
-    IXAudio2 *handle;
-    IXAudio2MasteringVoice *masterVoice;
-    IXAudio2SourceVoice *srcVoice;
-    WAVEFORMATEX fmt;
-    XAUDIO2_BUFFER bufferHeader;
-    
-    tfn_XAudio2Create *Create;
-} Win32_XAudio;
+    PL_Assert(align && !(align & (align-1)));
 
+    u64 address = (u64)(uintptr_t)arena->base + arena->used;
+    u64 padding = (align - (address & (align-1))) & (align-1);
 
-/*====================
-// Windows GL
-====================*/
-// WGL DEFS
-#define WGL_SAMPLE_BUFFERS_ARB            0x2041
-#define WGL_SAMPLES_ARB                   0x2042
-#define WGL_DRAW_TO_WINDOW_ARB            0x2001
-#define WGL_SUPPORT_OPENGL_ARB            0x2010
-#define WGL_DOUBLE_BUFFER_ARB             0x2011
-#define WGL_PIXEL_TYPE_ARB                0x2013
-#define WGL_TYPE_RGBA_ARB                 0x202B
-#define WGL_ACCELERATION_ARB              0x2003
-#define WGL_FULL_ACCELERATION_ARB         0x2027
-#define WGL_COLOR_BITS_ARB                0x2014
-#define WGL_ALPHA_BITS_ARB                0x201B
-#define WGL_DEPTH_BITS_ARB                0x2022
-#define WGL_CONTEXT_MAJOR_VERSION_ARB     0x2091
-#define WGL_CONTEXT_MINOR_VERSION_ARB     0x2092
-#define WGL_CONTEXT_PROFILE_MASK_ARB      0x9126
-#define WGL_CONTEXT_CORE_PROFILE_BIT_ARB  0x00000001
-#define WGL_SWAP_EXCHANGE_ARB             0x2028
-#define WGL_SWAP_METHOD_ARB               0x2007
-#define WGL_SWAP_COPY_ARB                 0x2029
-
-typedef BOOL (WINAPI* pfn_wglChoosePixelFormatARB)(HDC hdc, const int *piAttribIList,
-                                                   const FLOAT *pfAttribFList,
-                                                   UINT nMaxFormats, int *piFormats,
-                                                   UINT *nNunFormats);
-typedef HGLRC (WINAPI* pfn_wglCreateContextAttribsARB)(HDC hDC, HGLRC hShareContext,
-                                                       const int *attribList);
-typedef BOOL (WINAPI* pfn_wglSwapIntervalEXT)(int interval);
+    if(size > arena->size - arena->used ||
+       padding > arena->size - arena->used - size)
+    {
+        PL_SetErrorString("PL_ArenaPush: out of memory (%llu requested, %llu of %llu used)",
+                          (unsigned long long)size, (unsigned long long)arena->used,
+                          (unsigned long long)arena->size);
+        return 0;
+    }
 
-pfn_wglChoosePixelFormatARB wglChoosePixelFormatARB;
-pfn_wglCreateContextAttribsARB wglCreateContextAttribsARB;
-pfn_wglSwapIntervalEXT wglSwapIntervalEXT;
+    ptr result = arena->base + arena->used + padding;
+    arena->used += padding + size;
+    return result;
+}
 
-//==============================
-// Memory Allocation Functions
-//==============================
+ptr PL_ArenaPush(PL_Arena *arena, u64 size)
+{
+    return PL_ArenaPushAligned(arena, size, PL_ARENA_DEFAULT_ALIGN);
+}
 
-ptr PL_Alloc(u64 size)
+ptr PL_ArenaPushZero(PL_Arena *arena, u64 size)
 {
-    ptr result = 0;
-    result = (ptr)HeapAlloc(GetProcessHeap(), 0, size);
+    ptr result = PL_ArenaPushAligned(arena, size, PL_ARENA_DEFAULT_ALIGN);
+    if(result) PL_MemZero(result, size);
     return result;
 }
 
-ptr PL_Alloc0(u64 size)
+PL_Arena PL_ArenaPushSub(PL_Arena *arena, u64 size)
 {
-    ptr result = 0;
-    result = (ptr)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, size);
+    PL_Arena result = {0};
+    PL_ArenaInit(&result, PL_ArenaPushAligned(arena, size, PL_ARENA_DEFAULT_ALIGN), size);
     return result;
 }
 
-ptr PL_ReAlloc(ptr oldMem, u64 newSize)
+void PL_ArenaReset(PL_Arena *arena)
 {
-    ptr result = 0;
-    result = (ptr)HeapReAlloc(GetProcessHeap(), 0, oldMem, newSize);
-    return result;
+    PL_Assert(!arena->tempCount);
+    arena->used = 0;
 }
 
-ptr PL_ReAlloc0(ptr oldMem, u64 newSize)
+u64 PL_ArenaRemaining(PL_Arena *arena)
 {
-    ptr result = 0;
-    result = (ptr)HeapReAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, oldMem, newSize);
-    return result;
+    return arena->size - arena->used;
 }
 
-b32 PL_Free(ptr mem)
+PL_ArenaTemp PL_ArenaBeginTemp(PL_Arena *arena)
 {
-    BOOL win32Result = HeapFree(GetProcessHeap(), 0, mem);
-    b32 result = (b32)((win32Result) ? 1 : 0);
+    PL_ArenaTemp result;
+    result.arena = arena;
+    result.used = arena->used;
+    arena->tempCount++;
     return result;
 }
 
-//===================
-// Files
-//===================
+void PL_ArenaEndTemp(PL_ArenaTemp temp)
+{
+    PL_Assert(temp.arena->tempCount && temp.used <= temp.arena->used);
+    temp.arena->used = temp.used;
+    temp.arena->tempCount--;
+}
 
-PL_File PL_FileOpen(const cstr path)
+/*============= Maths Functions ==================*/
+
+i32 PL_sign(i32 v)
 {
-    PL_File result = {0};
-    FILE *file = 0;
-    
-    if(fopen_s(&file, path, "a+"))
-    {
-        return result;
-    }
-    
-    fseek(file, 0, SEEK_END);
-    i64 size = _ftelli64(file);
-    fseek(file, 0, SEEK_SET);
-    
-    result.handle = (ptr)file;
-    result.size = size;
-    
-    return result;
+    return (v>=0)? 1 : -1;
 }
 
-void PL_FileClose(PL_File *file)
+r32 PL_abs(r32 v)
 {
-    if(file && file->handle)
-    {
-        fclose((FILE*)file->handle);
-        file->handle = 0;
-        file->size = 0;
-    }
+    return (r32)fabs(v);
 }
 
-u64 PL_FileRead(PL_File *file, u64 offset, ptr dst, u64 size)
+i32 PL_round_i32(r32 v)
 {
-    u64 result = 0;
-    
-    if(file && file->handle && dst)
-    {
-        _fseeki64((FILE*)file->handle, (i64)offset, SEEK_SET);
-        
-        if(!size)
-        {
-            result = fread(dst, 1, (u64)file->size - offset, (FILE*)file->handle);
-        }
-        else
-        {
-            result = fread(dst, 1, size - offset, (FILE*)file->handle);
-        }
-        
-        fseek(file->handle, 0, SEEK_SET);
-    }
-    else
-    {
-        return 0;
-    }
-    
-    return result;
+    return (i32)floorf(v);
 }
 
-u64 PL_FileWrite(PL_File *file, u64 offset, ptr src, u64 size)
+u32 PL_round_u32(r32 v)
 {
-    u64 result = 0;
-    
-    if(file && file->handle && src && size)
-    {
-        _fseeki64((FILE*)file->handle, (i64)offset, SEEK_SET);
-        result = fwrite(src, 1, size, (FILE*)file->handle);
-        fseek((FILE*)file->handle, 0, SEEK_SET);
-    }
-    else
-    {
-        return 0;
-    }
-    
-    return result;
+    return (u32)floorf(v);
 }
 
-u64 PL_FileWriteAppend(PL_File *file, ptr src, u64 size)
+i32 PL_trunc_i32(r32 v)
 {
-    u64 result = 0;
-    
-    if(file && file->handle && src && size)
-    {
-        fseek((FILE*)file->handle, 0, SEEK_END);
-        result = fwrite(src, 1, size, (FILE*)file->handle);
-        fseek((FILE*)file->handle, 0, SEEK_SET);
-    }
-    else
+    return (i32)v;
+}
+
+i32 PL_floor_i32(r32 v)
+{
+    return (i32)floorf(v);
+}
+
+i32 PL_ceil_i32(r32 v)
+{
+    return (i32)ceilf(v);
+}
+
+r32 PL_div(r32 n, r32 d)
+{
+    if(d != 0.0f)
     {
-        return 0;
+        return n/d;
     }
     
-    return result;
+    return 0.0f;
 }
 
-void PL_PrintFile(PL_File *file, u64 offset, cstr format, ...)
+r64 PL_norm64(r64 v, r64 min, r64 max)
 {
-    if(file && file->handle)
-    {
-        _fseeki64((FILE*)file->handle, (i64)offset, SEEK_SET);
-        va_list args;
-        va_start(args, format);
-        vfprintf((FILE*)file->handle, format, args);
-        va_end(args);
-        fseek((FILE*)file->handle, 0, SEEK_SET);
-    }
+    return ((v-min) / (max-min));
 }
 
-void PL_PrintFileAppend(PL_File *file, cstr format, ...)
+r32 PL_norm32(r32 v, r32 min, r32 max)
 {
-    if(file && file->handle)
-    {
-        fseek((FILE*)file->handle, 0, SEEK_END);
-        va_list args;
-        va_start(args, format);
-        vfprintf(stderr, format, args);
-        va_end(args);
-        fseek((FILE*)file->handle, 0, SEEK_SET);
-    }
+    return ((v-min) / (max-min));
 }
 
-void PL_MsgBox(const cstr title, cstr format, ...)
+r32 PL_clamp(r32 v, r32 min, r32 max)
 {
-    va_list args;
-    va_start(args, format);
-    char msg[1024] = {0};
-    vsnprintf(msg, 1024, format, args);
-    va_end(args);
-    MessageBoxA(0, msg, title, MB_OK);
+    return ((((v<min)?min:v)>max)?max:v);
 }
 
-void  PL_MsgBoxInfo(const cstr title, cstr format, ...)
+r32 PL_clampMin(r32 v, r32 min)
 {
-    va_list args;
-    va_start(args, format);
-    char msg[1024] = {0};
-    vsnprintf(msg, 1024, format, args);
-    va_end(args);
-    MessageBoxA(0, msg, title, MB_OK | MB_ICONINFORMATION);
+    return ((v<min)?min:v);
 }
 
-void PL_MsgBoxError(const cstr title, cstr format, ...)
+r32 PL_clampMax(r32 v, r32 max)
 {
-    va_list args;
-    va_start(args, format);
-    char msg[1024] = {0};
-    vsnprintf(msg, 1024, format, args);
-    va_end(args);
-    MessageBoxA(0, msg, title, MB_OK | MB_ICONSTOP);
+    return ((v>max)?max:v);
 }
 
-/*====================
-  Input Processing
-====================*/
+r32 PL_clampNorm(r32 v)
+{
+    return ((((v<0.0f)?0.0f:v)>1.0f)?1.0f:v);
+}
 
-static PL_KEYCODE Win32_WinKeyToPLKeycode(u32 key, LPARAM lParam)
+u32 PL_rotl(u32 v, i32 s)
 {
-    switch(key)
-    {
-        case VK_ESCAPE: return K_ESC;
-        case VK_PRINT: return K_PRTSC;
-        case VK_SCROLL: return K_SCRLK;
-        case VK_PAUSE: return K_PAUSE;
-        case VK_NUMLOCK: return K_NUM;
-        case VK_INSERT: return K_INS;
-        case VK_DELETE: return K_DEL;
-        case VK_HOME: return K_HOME;
-        case VK_END: return K_END;
-        case VK_PRIOR: return K_PGUP;
-        case VK_NEXT: return K_PGDN;
-        
-        case VK_F1: return K_F1;
-        case VK_F2: return K_F2;
-        case VK_F3: return K_F3;
-        case VK_F4: return K_F4;
-        case VK_F5: return K_F5;
-        case VK_F6: return K_F6;
-        case VK_F7: return K_F7;
-        case VK_F8: return K_F8;
-        case VK_F9: return K_F9;
-        case VK_F10: return K_F10;
-        case VK_F11: return K_F11;
-        case VK_F12: return K_F12;
-        
-        case VK_UP: return K_UP;
-        case VK_DOWN: return K_DOWN;
-        case VK_LEFT: return K_LEFT;
-        case VK_RIGHT: return K_RIGHT;
-        
-        case VK_CAPITAL: return K_CAPS;
-        case VK_BACK: return K_BACKSPACE;
-        case VK_LSHIFT: return K_LSHIFT;
-        case VK_RSHIFT: return K_RSHIFT;
-        case VK_LCONTROL: return K_LCTRL;
-        case VK_RCONTROL: return K_RCTRL;
-        case VK_LWIN: return K_LWIN;
-        case VK_RWIN: return K_RWIN;
-        case VK_APPS: return K_MENU;
-        
-        case VK_TAB: return K_TAB;
-        case VK_OEM_3: return K_TILDE;
-        case VK_OEM_MINUS: return K_MINUS;
-        case VK_OEM_PLUS: return K_EQUALS;
-        
-        case VK_RETURN:
-        {
-            if(!(lParam & (1<<24))) return K_RETURN;
-            else return KP_RETURN;
-        }
-        
-        case VK_SPACE: return K_SPACE;
-        case VK_OEM_4: return K_LBRACKET;
-        case VK_OEM_6: return K_RBRACKET;
-        case VK_OEM_1: return K_SEMICOLON;
-        case VK_OEM_7: return K_APOSTROPHE;
-        case VK_OEM_5: return K_BACKSLASH;
-        case VK_OEM_COMMA: return K_COMMA;
-        case VK_OEM_PERIOD: return K_PERIOD;
-        case VK_OEM_2: return K_SLASH;
-        
-        case 0x41: return K_A;
-        case 0x42: return K_B;
-        case 0x43: return K_C;
-        case 0x44: return K_D;
-        case 0x45: return K_E;
-        case 0x46: return K_F;
-        case 0x47: return K_G;
-        case 0x48: return K_H;
-        case 0x49: return K_I;
-        case 0x4a: return K_J;
-        case 0x4b: return K_K;
-        case 0x4c: return K_L;
-        case 0x4d: return K_M;
-        case 0x4e: return K_N;
-        case 0x4f: return K_O;
-        case 0x50: return K_P;
-        case 0x51: return K_Q;
-        case 0x52: return K_R;
-        case 0x53: return K_S;
-        case 0x54: return K_T;
-        case 0x55: return K_U;
-        case 0x56: return K_V;
-        case 0x57: return K_W;
-        case 0x58: return K_X;
-        case 0x59: return K_Y;
-        case 0x5a: return K_Z;
-        
-        case 0x31: return K_1;
-        case 0x32: return K_2;
-        case 0x33: return K_3;
-        case 0x34: return K_4;
-        case 0x35: return K_5;
-        case 0x36: return K_6;
-        case 0x37: return K_7;
-        case 0x38: return K_8;
-        case 0x39: return K_9;
-        case 0x30: return K_0;
-        
-        case VK_DIVIDE: return KP_SLASH;
-        case VK_MULTIPLY: return KP_MULTIPLY;
-        case VK_SUBTRACT: return KP_MINUS;
-        case VK_ADD: return KP_PLUS;
-        case VK_DECIMAL: return KP_PERIOD;
-        
-        case VK_NUMPAD0: return KP_0;
-        case VK_NUMPAD1: return KP_1;
-        case VK_NUMPAD2: return KP_2;
-        case VK_NUMPAD3: return KP_3;
-        case VK_NUMPAD4: return KP_4;
-        case VK_NUMPAD5: return KP_5;
-        case VK_NUMPAD6: return KP_6;
-        case VK_NUMPAD7: return KP_7;
-        case VK_NUMPAD8: return KP_8;
-        case VK_NUMPAD9: return KP_9;
-        
-        case VK_VOLUME_MUTE: return KM_MUTE;
-        case VK_VOLUME_DOWN: return KM_VOLDOWN;
-        case VK_VOLUME_UP: return KM_VOLUP;
-        case VK_MEDIA_PLAY_PAUSE: return KM_PLAYPAUSE;
-        case VK_MEDIA_STOP: return KM_STOP;
-        case VK_MEDIA_PREV_TRACK: return KM_PREV;
-        case VK_MEDIA_NEXT_TRACK: return KM_NEXT;
-        
-        default: return K_NONE;
-    }
+    s &= 31;
+    return ((v<<s) | (v>>(32-s)));
 }
 
-/*======= State Components =========*/
+u32 PL_rotr(u32 v, i32 s)
+{
+    s &= 31;
+    return ((v>>s) | (v<<(32-s)));
+}
 
-typedef struct
+r32 PL_lerp(r32 a, r32 b, r32 t)
 {
-    PL_Window window;
-    
-    b32 init;
-    WNDCLASSA wndclass;
-    DWORD style;
-    WINDOWPLACEMENT wp;
-    HWND handle;
-    HDC dc;
-    HGLRC rc;
-} Win32_Window;
+    return ((1.0f-t) *a) + (t*b);
+}
 
-typedef struct
+r32 PL_qlerp(r32 a, r32 b, r32 t)
 {
-    PL_Timer timer;
-    u64 perfFreq;
-    u64 lastFramePerf;
-} Win32_Timer;
+    return a + t * (b - a);
+}
 
-typedef enum
+r32 PL_sqrt(r32 v)
 {
-    CPU_UNKNOWN = 0,
-    CPU_AMD64, // amd or intel x64
-    CPU_ARM,
-    CPU_ARM64,
-    CPU_IA64, // intel itanium 64
-    CPU_I86 // intel x86
-} CPU_TYPE;
+    return sqrtf(v);
+}
 
-typedef struct
+r32 PL_square(r32 v)
 {
-    CPU_TYPE cpu;
-    u32 cores;
-    ptr minAppAddress;
-    ptr maxAppAddress;
-} Win32_SystemInfo;
+    return v*v;
+}
 
-/*========== WIN32 STATE =============*/
+r32 PL_pow32(r32 v, r32 s)
+{
+    return powf(v,s);
+}
 
-typedef struct
+r64 PL_pi64(void)
 {
-    char errorString[1024];
-    b32 running;
-    u64 userMemorySize;
-    ptr userMemory;
-    
-    Win32_SystemInfo system;
-    Win32_Timer timer;
-    Win32_Window window;
-    Win32_XInput xinput;
-    Win32_XAudio xaudio;
-    
-    PL_Clock clock;
-    PL_Input input;
-    PL_Audio audio;
-} Win32_State;
-static Win32_State *win32_state;
+    return (r64)3.141592653589793238462643383279502884L;
+}
 
-void PL_SetErrorString(const cstr format, ...)
+r32 PL_pi32(void)
 {
-    PL_MemZero(win32_state->errorString, 1024);
-    va_list args;
-    va_start(args, format);
-    vsnprintf(win32_state->errorString, 1024, format, args);
-    va_end(args);
-    
-    PL_ErrorCallback();
+    return (r32)3.141592653589793238463;
 }
 
-void PL_Quit(void)
+r64 PL_tau64(void)
 {
-    win32_state->running = 0;
+    return (r64)6.283185307179586476925286766559L;
 }
 
-cstr PL_GetErrorString(void)
+r32 PL_tau32(void)
 {
-    return win32_state->errorString;
+    return (r32)6.2831853071795864769;
 }
 
-PL_Clock *PL_GetClock(void)
+r32 PL_sin(r32 a)
 {
-    return &win32_state->clock;
+    return sinf(a);
 }
 
-PL_Timer *PL_GetTimer(void)
+r32 PL_cos(r32 a)
 {
-    return &win32_state->timer.timer;
+    return cosf(a);
 }
 
-PL_Input* PL_GetInput(void)
+r32 PL_atan2(r32 y, r32 x)
 {
-    return &win32_state->input;
+    return atan2f(y,x);
 }
 
-PL_Mouse* PL_GetMouse(void)
+r32 PL_sinFast(r32 a)
 {
-    return &win32_state->input.mouse;
+    return PL_SinCosOne(a, 0);
 }
 
-PL_Gamepad* PL_GetGamepad(i32 id)
+r32 PL_cosFast(r32 a)
 {
-    if(id >= 0 && id <= GP_MAX_COUNT)
-        return &win32_state->input.gamepads[id];
-    
-    return 0;
+    return PL_SinCosOne(a, 1);
 }
 
-PL_ButtonState* PL_GetKeyState(PL_KEYCODE key)
+r32 PL_atan2Fast(r32 y, r32 x)
 {
-    if(key > 0 && key < K_MAX)
-        return &win32_state->input.keyboard[key];
-    
-    return 0;
+    return PL_Atan2One(y, x);
 }
 
-/*========= OPENGL LOADERS ==========*/
+void PL_SinArray(r32 *dst, const r32 *src, u64 n)
+{
+    pl_dispatch.sinCos(dst, src, n, 0);
+}
 
-#define WIN32_LOAD_WGLFN(name) {name = (pfn_##name)wglGetProcAddress( #name ); if(!name) return 0;}
-static b32 Win32_LoadWGL(void)
+void PL_CosArray(r32 *dst, const r32 *src, u64 n)
 {
-    WIN32_LOAD_WGLFN(wglChoosePixelFormatARB);
-    WIN32_LOAD_WGLFN(wglCreateContextAttribsARB);
-    WIN32_LOAD_WGLFN(wglSwapIntervalEXT);
-    
-    return 1;
+    pl_dispatch.sinCos(dst, src, n, 1);
 }
 
-#define WIN32_LOAD_GLFN(name) name = (pfn_##name)wglGetProcAddress( #name );\
-if(!name) {name = (pfn_##name)GetProcAddress(lib, #name );} if(!name) {return 0;}
-static b32 Win32_LoadOpenGL(r32 version)
+void PL_Atan2Array(r32 *dst, const r32 *ys, const r32 *xs, u64 n)
 {
-    HMODULE lib = LoadLibraryA("opengl32.dll");
-    
-    if(version >= 1.0)
-    {
-        WIN32_LOAD_GLFN(glCullFace);
-        WIN32_LOAD_GLFN(glFrontFace);
-        WIN32_LOAD_GLFN(glHint);
-        WIN32_LOAD_GLFN(glLineWidth);
-        WIN32_LOAD_GLFN(glPointSize);
-        WIN32_LOAD_GLFN(glPolygonMode);
-        WIN32_LOAD_GLFN(glScissor);
-        WIN32_LOAD_GLFN(glTexParameterf);
-        WIN32_LOAD_GLFN(glTexParameterfv);
-        WIN32_LOAD_GLFN(glTexParameteri);
-        WIN32_LOAD_GLFN(glTexParameteriv);
-        WIN32_LOAD_GLFN(glTexImage1D);
-        WIN32_LOAD_GLFN(glTexImage2D);
-        WIN32_LOAD_GLFN(glDrawBuffer);
-        WIN32_LOAD_GLFN(glClear);
-        WIN32_LOAD_GLFN(glClearColor);
-        WIN32_LOAD_GLFN(glClearStencil);
-        WIN32_LOAD_GLFN(glClearDepth);
-        WIN32_LOAD_GLFN(glStencilMask);
-        WIN32_LOAD_GLFN(glColorMask);
-        WIN32_LOAD_GLFN(glDepthMask);
-        WIN32_LOAD_GLFN(glDisable);
-        WIN32_LOAD_GLFN(glEnable);
-        WIN32_LOAD_GLFN(glFinish);
-        WIN32_LOAD_GLFN(glFlush);
-        WIN32_LOAD_GLFN(glBlendFunc);
-        WIN32_LOAD_GLFN(glLogicOp);
-        WIN32_LOAD_GLFN(glStencilFunc);
-        WIN32_LOAD_GLFN(glStencilOp);
-        WIN32_LOAD_GLFN(glDepthFunc);
-        WIN32_LOAD_GLFN(glPixelStoref);
-        WIN32_LOAD_GLFN(glPixelStorei);
-        WIN32_LOAD_GLFN(glReadBuffer);
-        WIN32_LOAD_GLFN(glReadPixels);
-        WIN32_LOAD_GLFN(glGetBooleanv);
-        WIN32_LOAD_GLFN(glGetDoublev);
-        WIN32_LOAD_GLFN(glGetError);
-        WIN32_LOAD_GLFN(glGetFloatv);
-        WIN32_LOAD_GLFN(glGetIntegerv);
-        WIN32_LOAD_GLFN(glGetString);
-        WIN32_LOAD_GLFN(glGetTexImage);
-        WIN32_LOAD_GLFN(glGetTexParameterfv);
-        WIN32_LOAD_GLFN(glGetTexParameteriv);
-        WIN32_LOAD_GLFN(glGetTexLevelParameterfv);
-        WIN32_LOAD_GLFN(glGetTexLevelParameteriv);
-        WIN32_LOAD_GLFN(glIsEnabled);
-        WIN32_LOAD_GLFN(glDepthRange);
-        WIN32_LOAD_GLFN(glViewport);
-    }
+    pl_dispatch.atan2(dst, ys, xs, n);
+}
+
+/*=========== VECTOR ARRAYS =============*/
+
+void PL_V2ArrayIntegrate(r32 *xs, r32 *ys, const r32 *vxs, const r32 *vys, u64 n, r32 dt)
+{
+    pl_dispatch.v2Integrate(xs, ys, vxs, vys, n, dt);
+}
+
+void PL_V2ArrayReflect(r32 *xs, r32 *ys, r32 *vxs, r32 *vys, u64 n, v2 min, v2 max)
+{
+    pl_dispatch.v2Reflect(xs, ys, vxs, vys, n, min, max);
+}
+
+void PL_V4ArrayTransform(v4 *dst, const v4 *src, u64 n, const m4 *m)
+{
+    pl_dispatch.v4Transform(dst, src, n, m);
+}
+
+u64 PL_V2ArrayOverlap(u64 *mask, const r32 *xs, const r32 *ys, const r32 *hws, const r32 *hhs, u64 n, v2 min, v2 max)
+{
+    pl_dispatch.v2Overlap(mask, xs, ys, hws, hhs, n, min, max);
     
-    if(version >= 1.1)
+    u64 count = 0;
+    for(u64 i = 0; i < (n + 63) / 64; i++)
     {
-        WIN32_LOAD_GLFN(glDrawArrays);
-        WIN32_LOAD_GLFN(glDrawElements);
-        WIN32_LOAD_GLFN(glPolygonOffset);
-        WIN32_LOAD_GLFN(glCopyTexImage1D);
-        WIN32_LOAD_GLFN(glCopyTexImage2D);
-        WIN32_LOAD_GLFN(glCopyTexSubImage1D);
-        WIN32_LOAD_GLFN(glCopyTexSubImage2D);
-        WIN32_LOAD_GLFN(glTexSubImage1D);
-        WIN32_LOAD_GLFN(glTexSubImage2D);
-        WIN32_LOAD_GLFN(glBindTexture);
-        WIN32_LOAD_GLFN(glDeleteTextures);
-        WIN32_LOAD_GLFN(glGenTextures);
-        WIN32_LOAD_GLFN(glIsTexture);
+        count += PL_POPCNT64(mask[i]);
     }
-    
-    if(version >= 1.2)
+    return count;
+}
+
+/*=========== MATRICES =============*/
+
+m4 m4translate(r32 x, r32 y, r32 z)
+{
+    m4 result = m4identity();
+    result.e[12] = x;
+    result.e[13] = y;
+    result.e[14] = z;
+    return result;
+}
+
+m4 m4scale(r32 x, r32 y, r32 z)
+{
+    m4 result = m4identity();
+    result.e[0] = x;
+    result.e[5] = y;
+    result.e[10] = z;
+    return result;
+}
+
+m4 m4rotateZ(r32 angle)
+{
+    r32 c = PL_cos(angle);
+    r32 s = PL_sin(angle);
+    m4 result = m4identity();
+    result.e[0] = c;
+    result.e[1] = s;
+    result.e[4] = -s;
+    result.e[5] = c;
+    return result;
+}
+
+m4 m4ortho(r32 left, r32 right, r32 bottom, r32 top, r32 zNear, r32 zFar)
+{
+    m4 result = {0};
+    result.e[0] = 2.0f / (right - left);
+    result.e[5] = 2.0f / (top - bottom);
+    result.e[10] = -2.0f / (zFar - zNear);
+    result.e[12] = -(right + left) / (right - left);
+    result.e[13] = -(top + bottom) / (top - bottom);
+    result.e[14] = -(zFar + zNear) / (zFar - zNear);
+    result.e[15] = 1.0f;
+    return result;
+}
+
+m4 m4perspective(r32 fovY, r32 aspect, r32 zNear, r32 zFar)
+{
+    r32 f = 1.0f / tanf(fovY * 0.5f);
+    m4 result = {0};
+    result.e[0] = f / aspect;
+    result.e[5] = f;
+    result.e[10] = (zFar + zNear) / (zNear - zFar);
+    result.e[11] = -1.0f;
+    result.e[14] = (2.0f * zFar * zNear) / (zNear - zFar);
+    return result;
+}
+
+// cofactors from 2x2 sub-determinants of the top and bottom row pairs (each shared by 2 cofactors)
+m4 m4inverse(m4 m)
+{
+    const r32 *a = m.e;
+    // a[col*4 + row], pairs of rows 0/1 and 2/3
+    r32 s0 = a[0]*a[5] - a[4]*a[1];
+    r32 s1 = a[0]*a[9] - a[8]*a[1];
+    r32 s2 = a[0]*a[13] - a[12]*a[1];
+    r32 s3 = a[4]*a[9] - a[8]*a[5];
+    r32 s4 = a[4]*a[13] - a[12]*a[5];
+    r32 s5 = a[8]*a[13] - a[12]*a[9];
+    r32 c5 = a[10]*a[15] - a[14]*a[11];
+    r32 c4 = a[6]*a[15] - a[14]*a[7];
+    r32 c3 = a[6]*a[11] - a[10]*a[7];
+    r32 c2 = a[2]*a[15] - a[14]*a[3];
+    r32 c1 = a[2]*a[11] - a[10]*a[3];
+    r32 c0 = a[2]*a[7] - a[6]*a[3];
+    
+    r32 det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+    m4 result = {0};
+    if(det == 0.0f)
     {
-        WIN32_LOAD_GLFN(glDrawRangeElements);
-        WIN32_LOAD_GLFN(glTexImage3D);
-        WIN32_LOAD_GLFN(glTexSubImage3D);
-        WIN32_LOAD_GLFN(glCopyTexSubImage3D);
+        return result;
     }
-    
-    if(version >= 1.3)
+    r32 inv = 1.0f / det;
+    
+    result.e[0] = (a[5]*c5 - a[9]*c4 + a[13]*c3) * inv;
+    result.e[4] = (-a[4]*c5 + a[8]*c4 - a[12]*c3) * inv;
+    result.e[8] = (a[7]*s5 - a[11]*s4 + a[15]*s3) * inv;
+    result.e[12] = (-a[6]*s5 + a[10]*s4 - a[14]*s3) * inv;
+    
+    result.e[1] = (-a[1]*c5 + a[9]*c2 - a[13]*c1) * inv;
+    result.e[5] = (a[0]*c5 - a[8]*c2 + a[12]*c1) * inv;
+    result.e[9] = (-a[3]*s5 + a[11]*s2 - a[15]*s1) * inv;
+    result.e[13] = (a[2]*s5 - a[10]*s2 + a[14]*s1) * inv;
+    
+    result.e[2] = (a[1]*c4 - a[5]*c2 + a[13]*c0) * inv;
+    result.e[6] = (-a[0]*c4 + a[4]*c2 - a[12]*c0) * inv;
+    result.e[10] = (a[3]*s4 - a[7]*s2 + a[15]*s0) * inv;
+    result.e[14] = (-a[2]*s4 + a[6]*s2 - a[14]*s0) * inv;
+    
+    result.e[3] = (-a[1]*c3 + a[5]*c1 - a[9]*c0) * inv;
+    result.e[7] = (a[0]*c3 - a[4]*c1 + a[8]*c0) * inv;
+    result.e[11] = (-a[3]*s3 + a[7]*s1 - a[11]*s0) * inv;
+    result.e[15] = (a[2]*s3 - a[6]*s1 + a[10]*s0) * inv;
+    return result;
+}
+
+/*=========== FIXED POINT =============*/
+
+// quarter sine wave, sin(i*pi/512) * 65536 (plus a repeat of the last entry so i+1 is always valid),
+// literal so every build has the same bits
+static const i32 pl_q16SinTable[258] =
+{
+    0, 402, 804, 1206, 1608, 2010, 2412, 2814, 3216, 3617, 4019, 4420, 4821, 5222, 5623, 6023,
+    6424, 6824, 7224, 7623, 8022, 8421, 8820, 9218, 9616, 10014, 10411, 10808, 11204, 11600, 11996, 12391,
+    12785, 13180, 13573, 13966, 14359, 14751, 15143, 15534, 15924, 16314, 16703, 17091, 17479, 17867, 18253, 18639,
+    19024, 19409, 19792, 20175, 20557, 20939, 21320, 21699, 22078, 22457, 22834, 23210, 23586, 23961, 24335, 24708,
+    25080, 25451, 25821, 26190, 26558, 26925, 27291, 27656, 28020, 28383, 28745, 29106, 29466, 29824, 30182, 30538,
+    30893, 31248, 31600, 31952, 32303, 32652, 33000, 33347, 33692, 34037, 34380, 34721, 35062, 35401, 35738, 36075,
+    36410, 36744, 37076, 37407, 37736, 38064, 38391, 38716, 39040, 39362, 39683, 40002, 40320, 40636, 40951, 41264,
+    41576, 41886, 42194, 42501, 42806, 43110, 43412, 43713, 44011, 44308, 44604, 44898, 45190, 45480, 45769, 46056,
+    46341, 46624, 46906, 47186, 47464, 47741, 48015, 48288, 48559, 48828, 49095, 49361, 49624, 49886, 50146, 50404,
+    50660, 50914, 51166, 51417, 51665, 51911, 52156, 52398, 52639, 52878, 53114, 53349, 53581, 53812, 54040, 54267,
+    54491, 54714, 54934, 55152, 55368, 55582, 55794, 56004, 56212, 56418, 56621, 56823, 57022, 57219, 57414, 57607,
+    57798, 57986, 58172, 58356, 58538, 58718, 58896, 59071, 59244, 59415, 59583, 59750, 59914, 60075, 60235, 60392,
+    60547, 60700, 60851, 60999, 61145, 61288, 61429, 61568, 61705, 61839, 61971, 62101, 62228, 62353, 62476, 62596,
+    62714, 62830, 62943, 63054, 63162, 63268, 63372, 63473, 63572, 63668, 63763, 63854, 63944, 64031, 64115, 64197,
+    64277, 64354, 64429, 64501, 64571, 64639, 64704, 64766, 64827, 64884, 64940, 64993, 65043, 65091, 65137, 65180,
+    65220, 65259, 65294, 65328, 65358, 65387, 65413, 65436, 65457, 65476, 65492, 65505, 65516, 65525, 65531, 65535,
+    65536, 65536
+};
+
+// atan(i/256) * 65536 over [0, 1] (plus a repeat of the last entry)
+static const i32 pl_q16AtanTable[258] =
+{
+    0, 256, 512, 768, 1024, 1280, 1536, 1792, 2047, 2303, 2559, 2814, 3070, 3325, 3580, 3836,
+    4091, 4346, 4600, 4855, 5110, 5364, 5618, 5872, 6126, 6380, 6633, 6887, 7140, 7392, 7645, 7898,
+    8150, 8402, 8653, 8905, 9156, 9407, 9657, 9908, 10158, 10408, 10657, 10906, 11155, 11403, 11652, 11899,
+    12147, 12394, 12641, 12887, 13133, 13379, 13624, 13869, 14114, 14358, 14601, 14845, 15088, 15330, 15572, 15814,
+    16055, 16296, 16536, 16776, 17015, 17254, 17492, 17730, 17968, 18205, 18441, 18677, 18913, 19148, 19382, 19616,
+    19850, 20083, 20315, 20547, 20779, 21009, 21240, 21469, 21699, 21927, 22156, 22383, 22610, 22836, 23062, 23288,
+    23512, 23737, 23960, 24183, 24406, 24627, 24849, 25069, 25289, 25509, 25727, 25946, 26163, 26380, 26597, 26813,
+    27028, 27242, 27456, 27670, 27882, 28094, 28306, 28517, 28727, 28936, 29145, 29354, 29561, 29768, 29975, 30180,
+    30386, 30590, 30794, 30997, 31200, 31402, 31603, 31803, 32003, 32203, 32401, 32600, 32797, 32994, 33190, 33385,
+    33580, 33774, 33968, 34160, 34353, 34544, 34735, 34925, 35115, 35304, 35492, 35680, 35867, 36053, 36239, 36424,
+    36608, 36792, 36975, 37158, 37340, 37521, 37701, 37881, 38060, 38239, 38417, 38594, 38771, 38947, 39123, 39297,
+    39472, 39645, 39818, 39990, 40162, 40333, 40503, 40673, 40842, 41010, 41178, 41346, 41512, 41678, 41844, 42008,
+    42172, 42336, 42499, 42661, 42823, 42984, 43145, 43304, 43464, 43622, 43780, 43938, 44095, 44251, 44407, 44562,
+    44716, 44870, 45024, 45176, 45328, 45480, 45631, 45781, 45931, 46080, 46229, 46377, 46525, 46672, 46818, 46964,
+    47109, 47254, 47398, 47542, 47685, 47827, 47969, 48111, 48251, 48392, 48531, 48671, 48809, 48947, 49085, 49222,
+    49359, 49495, 49630, 49765, 49899, 50033, 50167, 50299, 50432, 50563, 50695, 50826, 50956, 51086, 51215, 51344,
+    51472, 51472
+};
+
+// radians to 1/2^26 turns: (a * 2^34 / tau) >> 24
+#define PL_Q16_TURN_SCALE 2734261102LL
+
+// phase in 1/2^26 turns, 256 table steps per quarter with 16 bits of interpolation
+static q16 PL_FixedSinPhase(u32 phase)
+{
+    phase &= (1u << 26) - 1;
+    u32 quadrant = phase >> 24;
+    u32 p = phase & 0xffffff;
+    if(quadrant & 1) p = 0x1000000 - p;
+    
+    u32 index = p >> 16;
+    i64 frac = p & 0xffff;
+    i32 a = pl_q16SinTable[index];
+    i32 b = pl_q16SinTable[index + 1];
+    q16 result = a + (q16)(((b - a) * frac + 0x8000) >> 16);
+    return (quadrant & 2) ? -result : result;
+}
+
+static u32 PL_FixedPhase(q16 a)
+{
+    return (u32)(((i64)a * PL_Q16_TURN_SCALE) >> 24);
+}
+
+// atan2 on magnitudes scaled down to 39 bits so the ratio fits, result in Q16.16
+static q16 PL_FixedAtan2(i64 y, i64 x)
+{
+    u64 ax = (x < 0) ? 0 - (u64)x : (u64)x;
+    u64 ay = (y < 0) ? 0 - (u64)y : (u64)y;
+    u64 lo = (ax < ay) ? ax : ay;
+    u64 hi = (ax < ay) ? ay : ax;
+    if(!hi)
     {
-        WIN32_LOAD_GLFN(glActiveTexture);
-        WIN32_LOAD_GLFN(glSampleCoverage);
-        WIN32_LOAD_GLFN(glCompressedTexImage3D);
-        WIN32_LOAD_GLFN(glCompressedTexImage2D);
-        WIN32_LOAD_GLFN(glCompressedTexImage1D);
-        WIN32_LOAD_GLFN(glCompressedTexSubImage3D);
-        WIN32_LOAD_GLFN(glCompressedTexSubImage2D);
-        WIN32_LOAD_GLFN(glCompressedTexSubImage1D);
-        WIN32_LOAD_GLFN(glGetCompressedTexImage);
+        return 0;
     }
-    
-    if(version >= 1.4)
+    while(hi >> 39)
     {
-        WIN32_LOAD_GLFN(glBlendFuncSeparate);
-        WIN32_LOAD_GLFN(glMultiDrawArrays);
-        WIN32_LOAD_GLFN(glMultiDrawElements);
-        WIN32_LOAD_GLFN(glPointParameterf);
-        WIN32_LOAD_GLFN(glPointParameterfv);
-        WIN32_LOAD_GLFN(glPointParameteri);
-        WIN32_LOAD_GLFN(glPointParameteriv);
-        WIN32_LOAD_GLFN(glBlendColor);
-        WIN32_LOAD_GLFN(glBlendEquation);
+        hi >>= 1;
+        lo >>= 1;
     }
     
-    if(version >= 1.5)
-    {
-        WIN32_LOAD_GLFN(glGenQueries);
-        WIN32_LOAD_GLFN(glDeleteQueries);
-        WIN32_LOAD_GLFN(glIsQuery);
-        WIN32_LOAD_GLFN(glBeginQuery);
-        WIN32_LOAD_GLFN(glEndQuery);
-        WIN32_LOAD_GLFN(glGetQueryiv);
-        WIN32_LOAD_GLFN(glGetQueryObjectiv);
-        WIN32_LOAD_GLFN(glGetQueryObjectuiv);
-        WIN32_LOAD_GLFN(glBindBuffer);
-        WIN32_LOAD_GLFN(glDeleteBuffers);
-        WIN32_LOAD_GLFN(glGenBuffers);
-        WIN32_LOAD_GLFN(glIsBuffer);
-        WIN32_LOAD_GLFN(glBufferData);
-        WIN32_LOAD_GLFN(glBufferSubData);
-        WIN32_LOAD_GLFN(glGetBufferSubData);
-        WIN32_LOAD_GLFN(glMapBuffer);
-        WIN32_LOAD_GLFN(glUnmapBuffer);
-        WIN32_LOAD_GLFN(glGetBufferParameteriv);
-        WIN32_LOAD_GLFN(glGetBufferPointerv);
-    }
+    u64 t = (lo << 24) / hi; // [0, 1] in Q8.24
+    u32 index = (u32)(t >> 16);
+    i64 frac = t & 0xffff;
+    i32 a = pl_q16AtanTable[index];
+    i32 b = pl_q16AtanTable[index + 1];
+    q16 result = a + (q16)(((b - a) * frac + 0x8000) >> 16);
     
-    if(version >= 2.0)
-    {
-        WIN32_LOAD_GLFN(glBlendEquationSeparate);
-        WIN32_LOAD_GLFN(glDrawBuffers);
-        WIN32_LOAD_GLFN(glStencilOpSeparate);
-        WIN32_LOAD_GLFN(glStencilFuncSeparate);
-        WIN32_LOAD_GLFN(glStencilMaskSeparate);
-        WIN32_LOAD_GLFN(glAttachShader);
-        WIN32_LOAD_GLFN(glBindAttribLocation);
-        WIN32_LOAD_GLFN(glCompileShader);
-        WIN32_LOAD_GLFN(glCreateProgram);
-        WIN32_LOAD_GLFN(glCreateShader);
-        WIN32_LOAD_GLFN(glDeleteProgram);
-        WIN32_LOAD_GLFN(glDeleteShader);
-        WIN32_LOAD_GLFN(glDetachShader);
-        WIN32_LOAD_GLFN(glDisableVertexAttribArray);
-        WIN32_LOAD_GLFN(glEnableVertexAttribArray);
-        WIN32_LOAD_GLFN(glGetActiveAttrib);
-        WIN32_LOAD_GLFN(glGetActiveUniform);
-        WIN32_LOAD_GLFN(glGetAttachedShaders);
-        WIN32_LOAD_GLFN(glGetAttribLocation);
-        WIN32_LOAD_GLFN(glGetProgramiv);
-        WIN32_LOAD_GLFN(glGetProgramInfoLog);
-        WIN32_LOAD_GLFN(glGetShaderiv);
-        WIN32_LOAD_GLFN(glGetShaderInfoLog);
-        WIN32_LOAD_GLFN(glGetShaderSource);
-        WIN32_LOAD_GLFN(glGetUniformLocation);
-        WIN32_LOAD_GLFN(glGetUniformfv);
-        WIN32_LOAD_GLFN(glGetUniformiv);
-        WIN32_LOAD_GLFN(glGetVertexAttribdv);
-        WIN32_LOAD_GLFN(glGetVertexAttribfv);
-        WIN32_LOAD_GLFN(glGetVertexAttribiv);
-        WIN32_LOAD_GLFN(glGetVertexAttribPointerv);
-        WIN32_LOAD_GLFN(glIsProgram);
-        WIN32_LOAD_GLFN(glIsShader);
-        WIN32_LOAD_GLFN(glLinkProgram);
-        WIN32_LOAD_GLFN(glShaderSource);
-        WIN32_LOAD_GLFN(glUseProgram);
-        WIN32_LOAD_GLFN(glUniform1f);
-        WIN32_LOAD_GLFN(glUniform2f);
-        WIN32_LOAD_GLFN(glUniform3f);
-        WIN32_LOAD_GLFN(glUniform4f);
-        WIN32_LOAD_GLFN(glUniform1i);
-        WIN32_LOAD_GLFN(glUniform2i);
-        WIN32_LOAD_GLFN(glUniform3i);
-        WIN32_LOAD_GLFN(glUniform4i);
-        WIN32_LOAD_GLFN(glUniform1fv);
-        WIN32_LOAD_GLFN(glUniform2fv);
-        WIN32_LOAD_GLFN(glUniform3fv);
-        WIN32_LOAD_GLFN(glUniform4fv);
-        WIN32_LOAD_GLFN(glUniform1iv);
-        WIN32_LOAD_GLFN(glUniform2iv);
-        WIN32_LOAD_GLFN(glUniform3iv);
-        WIN32_LOAD_GLFN(glUniform4iv);
-        WIN32_LOAD_GLFN(glUniformMatrix2fv);
-        WIN32_LOAD_GLFN(glUniformMatrix3fv);
-        WIN32_LOAD_GLFN(glUniformMatrix4fv);
-        WIN32_LOAD_GLFN(glValidateProgram);
-        WIN32_LOAD_GLFN(glVertexAttrib1d);
-        WIN32_LOAD_GLFN(glVertexAttrib1dv);
-        WIN32_LOAD_GLFN(glVertexAttrib1f);
-        WIN32_LOAD_GLFN(glVertexAttrib1s);
-        WIN32_LOAD_GLFN(glVertexAttrib1sv);
-        WIN32_LOAD_GLFN(glVertexAttrib2d);
-        WIN32_LOAD_GLFN(glVertexAttrib2dv);
-        WIN32_LOAD_GLFN(glVertexAttrib2f);
-        WIN32_LOAD_GLFN(glVertexAttrib2fv);
-        WIN32_LOAD_GLFN(glVertexAttrib2s);
-        WIN32_LOAD_GLFN(glVertexAttrib2sv);
-        WIN32_LOAD_GLFN(glVertexAttrib3d);
-        WIN32_LOAD_GLFN(glVertexAttrib3dv);
-        WIN32_LOAD_GLFN(glVertexAttrib3f);
-        WIN32_LOAD_GLFN(glVertexAttrib3fv);
-        WIN32_LOAD_GLFN(glVertexAttrib3s);
-        WIN32_LOAD_GLFN(glVertexAttrib3sv);
-        WIN32_LOAD_GLFN(glVertexAttrib4Nbv);
-        WIN32_LOAD_GLFN(glVertexAttrib4Niv);
-        WIN32_LOAD_GLFN(glVertexAttrib4Nsv);
-        WIN32_LOAD_GLFN(glVertexAttrib4Nub);
-        WIN32_LOAD_GLFN(glVertexAttrib4Nubv);
-        WIN32_LOAD_GLFN(glVertexAttrib4Nuiv);
-        WIN32_LOAD_GLFN(glVertexAttrib4Nusv);
-        WIN32_LOAD_GLFN(glVertexAttrib4bv);
-        WIN32_LOAD_GLFN(glVertexAttrib4d);
-        WIN32_LOAD_GLFN(glVertexAttrib4dv);
-        WIN32_LOAD_GLFN(glVertexAttrib4f);
-        WIN32_LOAD_GLFN(glVertexAttrib4fv);
-        WIN32_LOAD_GLFN(glVertexAttrib4iv);
-        WIN32_LOAD_GLFN(glVertexAttrib4s);
-        WIN32_LOAD_GLFN(glVertexAttrib4sv);
-        WIN32_LOAD_GLFN(glVertexAttrib4ubv);
-        WIN32_LOAD_GLFN(glVertexAttrib4uiv);
-        WIN32_LOAD_GLFN(glVertexAttrib4usv);
-        WIN32_LOAD_GLFN(glVertexAttribPointer);
-    }
+    if(ay > ax) result = Q16_PI_2 - result;
+    if(x < 0) result = Q16_PI - result;
+    return (y < 0) ? -result : result;
+}
+
+// 64x64 -> 128 bit
+static inline void PL_MulU64(u64 a, u64 b, u64 *hi, u64 *lo)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 p = (unsigned __int128)a * b;
+    *hi = (u64)(p >> 64);
+    *lo = (u64)p;
+#elif defined(PL_WINDOWS_MSVC) && defined(_M_X64)
+    *lo = _umul128(a, b, hi);
+#else
+    u64 ll = (a & 0xffffffff) * (b & 0xffffffff);
+    u64 lh = (a & 0xffffffff) * (b >> 32);
+    u64 hl = (a >> 32) * (b & 0xffffffff);
+    u64 mid = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+    *lo = (mid << 32) | (ll & 0xffffffff);
+    *hi = (a >> 32) * (b >> 32) + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+}
+
+// floor(sqrt(a * 2^fracBits)) for fracBits 0, 16 or 32: a float estimate (within 1), then fixed up
+// with exact integer compares so the result can't depend on how the float rounded
+static u64 PL_FixedSqrt(u64 a, u32 fracBits)
+{
+    u64 nHi = fracBits ? a >> (64 - fracBits) : 0;
+    u64 nLo = a << fracBits;
+    u64 root = (u64)(sqrt((r64)a) * (r64)(1u << (fracBits / 2)));
+    u64 hi, lo;
     
-    if(version >= 2.1)
+    PL_MulU64(root, root, &hi, &lo);
+    while(hi > nHi || (hi == nHi && lo > nLo))
     {
-        WIN32_LOAD_GLFN(glUniformMatrix2x3fv);
-        WIN32_LOAD_GLFN(glUniformMatrix3x2fv);
-        WIN32_LOAD_GLFN(glUniformMatrix2x4fv);
-        WIN32_LOAD_GLFN(glUniformMatrix4x2fv);
-        WIN32_LOAD_GLFN(glUniformMatrix3x4fv);
-        WIN32_LOAD_GLFN(glUniformMatrix4x3fv);
+        root--;
+        PL_MulU64(root, root, &hi, &lo);
     }
-    
-    if(version >= 3.0)
+    PL_MulU64(root + 1, root + 1, &hi, &lo);
+    while(hi < nHi || (hi == nHi && lo <= nLo))
     {
-        WIN32_LOAD_GLFN(glColorMaski);
-        WIN32_LOAD_GLFN(glGetBooleani_v);
-        WIN32_LOAD_GLFN(glGetIntegeri_v);
-        WIN32_LOAD_GLFN(glEnablei);
-        WIN32_LOAD_GLFN(glDisablei);
-        WIN32_LOAD_GLFN(glIsEnabledi);
-        WIN32_LOAD_GLFN(glBeginTransformFeedback);
-        WIN32_LOAD_GLFN(glEndTransformFeedback);
-        WIN32_LOAD_GLFN(glBindBufferRange);
-        WIN32_LOAD_GLFN(glBindBufferBase);
-        WIN32_LOAD_GLFN(glTransformFeedbackVaryings);
-        WIN32_LOAD_GLFN(glGetTransformFeedbackVarying);
-        WIN32_LOAD_GLFN(glClampColor);
-        WIN32_LOAD_GLFN(glBeginConditionalRender);
-        WIN32_LOAD_GLFN(glEndConditionalRender);
-        WIN32_LOAD_GLFN(glVertexAttribIPointer);
-        WIN32_LOAD_GLFN(glGetVertexAttribIiv);
-        WIN32_LOAD_GLFN(glGetVertexAttribIuiv);
-        WIN32_LOAD_GLFN(glVertexAttribI1i);
-        WIN32_LOAD_GLFN(glVertexAttribI2i);
-        WIN32_LOAD_GLFN(glVertexAttribI3i);
-        WIN32_LOAD_GLFN(glVertexAttribI4i);
-        WIN32_LOAD_GLFN(glVertexAttribI1ui);
-        WIN32_LOAD_GLFN(glVertexAttribI2ui);
-        WIN32_LOAD_GLFN(glVertexAttribI3ui);
-        WIN32_LOAD_GLFN(glVertexAttribI4ui);
-        WIN32_LOAD_GLFN(glVertexAttribI1iv);
-        WIN32_LOAD_GLFN(glVertexAttribI2iv);
-        WIN32_LOAD_GLFN(glVertexAttribI3iv);
-        WIN32_LOAD_GLFN(glVertexAttribI4iv);
-        WIN32_LOAD_GLFN(glVertexAttribI1uiv);
-        WIN32_LOAD_GLFN(glVertexAttribI2uiv);
-        WIN32_LOAD_GLFN(glVertexAttribI3uiv);
-        WIN32_LOAD_GLFN(glVertexAttribI4uiv);
-        WIN32_LOAD_GLFN(glVertexAttribI4bv);
-        WIN32_LOAD_GLFN(glVertexAttribI4sv);
-        WIN32_LOAD_GLFN(glVertexAttribI4ubv);
-        WIN32_LOAD_GLFN(glVertexAttribI4usv);
-        WIN32_LOAD_GLFN(glGetUniformuiv);
-        WIN32_LOAD_GLFN(glBindFragDataLocation);
-        WIN32_LOAD_GLFN(glGetFragDataLocation);
-        WIN32_LOAD_GLFN(glUniform1ui);
-        WIN32_LOAD_GLFN(glUniform2ui);
-        WIN32_LOAD_GLFN(glUniform3ui);
-        WIN32_LOAD_GLFN(glUniform4ui);
-        WIN32_LOAD_GLFN(glUniform1uiv);
-        WIN32_LOAD_GLFN(glUniform2uiv);
-        WIN32_LOAD_GLFN(glUniform3uiv);
-        WIN32_LOAD_GLFN(glUniform4uiv);
-        WIN32_LOAD_GLFN(glTexParameterIiv);
-        WIN32_LOAD_GLFN(glTexParameterIuiv);
-        WIN32_LOAD_GLFN(glGetTexParameterIiv);
-        WIN32_LOAD_GLFN(glGetTexParameterIuiv);
-        WIN32_LOAD_GLFN(glClearBufferiv);
-        WIN32_LOAD_GLFN(glClearBufferuiv);
-        WIN32_LOAD_GLFN(glClearBufferfv);
-        WIN32_LOAD_GLFN(glClearBufferfi);
-        WIN32_LOAD_GLFN(glGetStringi);
-        WIN32_LOAD_GLFN(glIsRenderbuffer);
-        WIN32_LOAD_GLFN(glBindRenderbuffer);
-        WIN32_LOAD_GLFN(glDeleteRenderbuffers);
-        WIN32_LOAD_GLFN(glGenRenderbuffers);
-        WIN32_LOAD_GLFN(glRenderbufferStorage);
-        WIN32_LOAD_GLFN(glGetRenderbufferParameteriv);
-        WIN32_LOAD_GLFN(glIsFramebuffer);
-        WIN32_LOAD_GLFN(glBindFramebuffer);
-        WIN32_LOAD_GLFN(glDeleteFramebuffers);
-        WIN32_LOAD_GLFN(glGenFramebuffers);
-        WIN32_LOAD_GLFN(glCheckFramebufferStatus);
-        WIN32_LOAD_GLFN(glFramebufferTexture1D);
-        WIN32_LOAD_GLFN(glFramebufferTexture2D);
-        WIN32_LOAD_GLFN(glFramebufferTexture3D);
-        WIN32_LOAD_GLFN(glFramebufferRenderbuffer);
-        WIN32_LOAD_GLFN(glGetFramebufferAttachmentParameteriv);
-        WIN32_LOAD_GLFN(glGenerateMipmap);
-        WIN32_LOAD_GLFN(glBlitFramebuffer);
-        WIN32_LOAD_GLFN(glRenderbufferStorageMultisample);
-        WIN32_LOAD_GLFN(glFramebufferTextureLayer);
-        WIN32_LOAD_GLFN(glMapBufferRange);
-        WIN32_LOAD_GLFN(glFlushMappedBufferRange);
-        WIN32_LOAD_GLFN(glBindVertexArray);
-        WIN32_LOAD_GLFN(glDeleteVertexArrays);
-        WIN32_LOAD_GLFN(glGenVertexArrays);
-        WIN32_LOAD_GLFN(glIsVertexArray);
+        root++;
+        PL_MulU64(root + 1, root + 1, &hi, &lo);
     }
-    
-    if(version >= 3.1)
+    return root;
+}
+
+// (hi:lo) / d for hi < d
+static inline u64 PL_DivU128(u64 hi, u64 lo, u64 d)
+{
+#if defined(__SIZEOF_INT128__)
+    return (u64)((((unsigned __int128)hi << 64) | lo) / d);
+#else
+    u64 q = 0;
+    for(int i = 0; i < 64; i++)
     {
-        WIN32_LOAD_GLFN(glDrawArraysInstanced);
-        WIN32_LOAD_GLFN(glDrawElementsInstanced);
-        WIN32_LOAD_GLFN(glTexBuffer);
-        WIN32_LOAD_GLFN(glPrimitiveRestartIndex);
-        WIN32_LOAD_GLFN(glCopyBufferSubData);
-        WIN32_LOAD_GLFN(glGetUniformIndices);
-        WIN32_LOAD_GLFN(glGetActiveUniformsiv);
-        WIN32_LOAD_GLFN(glGetActiveUniformName);
-        WIN32_LOAD_GLFN(glGetUniformBlockIndex);
-        WIN32_LOAD_GLFN(glGetActiveUniformBlockiv);
-        WIN32_LOAD_GLFN(glGetActiveUniformBlockName);
-        WIN32_LOAD_GLFN(glUniformBlockBinding);
+        u64 top = hi >> 63;
+        hi = (hi << 1) | (lo >> 63);
+        lo <<= 1;
+        q <<= 1;
+        if(top || hi >= d)
+        {
+            hi -= d;
+            q |= 1;
+        }
     }
-    
-    if(version >= 3.2)
+    return q;
+#endif
+}
+
+q16 q16sqrt(q16 v)
+{
+    return (v > 0) ? (q16)PL_FixedSqrt((u64)v, 16) : 0;
+}
+
+q16 q16sin(q16 a)
+{
+    return PL_FixedSinPhase(PL_FixedPhase(a));
+}
+
+q16 q16cos(q16 a)
+{
+    return PL_FixedSinPhase(PL_FixedPhase(a) + (1u << 24));
+}
+
+q16 q16atan2(q16 y, q16 x)
+{
+    return PL_FixedAtan2(y, x);
+}
+
+q16 v2q16length(v2q16 a)
+{
+    // x^2 + y^2 is Q32.32 and its square root is Q16.16
+    u64 sq = (u64)((i64)a.x * a.x) + (u64)((i64)a.y * a.y);
+    u64 root = PL_FixedSqrt(sq, 0);
+    return (root > INT32_MAX) ? INT32_MAX : (q16)root;
+}
+
+q32 q32mul(q32 a, q32 b)
+{
+    u64 hi, lo;
+    PL_MulU64((u64)a, (u64)b, &hi, &lo);
+    // signed high half, then round and keep the middle 64 bits
+    if(a < 0) hi -= (u64)b;
+    if(b < 0) hi -= (u64)a;
+    u64 rounded = lo + 0x80000000u;
+    hi += (rounded < lo);
+    return (q32)((hi << 32) | (rounded >> 32));
+}
+
+q32 q32div(q32 a, q32 b)
+{
+    if(!b)
     {
-        WIN32_LOAD_GLFN(glDrawElementsBaseVertex);
-        WIN32_LOAD_GLFN(glDrawRangeElementsBaseVertex);
-        WIN32_LOAD_GLFN(glDrawElementsInstancedBaseVertex);
-        WIN32_LOAD_GLFN(glMultiDrawElementsBaseVertex);
-        WIN32_LOAD_GLFN(glProvokingVertex);
-        WIN32_LOAD_GLFN(glFenceSync);
-        WIN32_LOAD_GLFN(glIsSync);
-        WIN32_LOAD_GLFN(glDeleteSync);
-        WIN32_LOAD_GLFN(glClientWaitSync);
-        WIN32_LOAD_GLFN(glWaitSync);
-        WIN32_LOAD_GLFN(glGetInteger64v);
-        WIN32_LOAD_GLFN(glGetSynciv);
-        WIN32_LOAD_GLFN(glGetInteger64i_v);
-        WIN32_LOAD_GLFN(glGetBufferParameteri64v);
-        WIN32_LOAD_GLFN(glFramebufferTexture);
-        WIN32_LOAD_GLFN(glTexImage2DMultisample);
-        WIN32_LOAD_GLFN(glTexImage3DMultisample);
-        WIN32_LOAD_GLFN(glGetMultisamplefv);
-        WIN32_LOAD_GLFN(glSampleMaski);
+        return 0;
     }
     
-    if(version >= 3.3)
-    {
-        WIN32_LOAD_GLFN(glBindFragDataLocationIndexed);
-        WIN32_LOAD_GLFN(glGetFragDataIndex);
-        WIN32_LOAD_GLFN(glGenSamplers);
-        WIN32_LOAD_GLFN(glDeleteSamplers);
-        WIN32_LOAD_GLFN(glIsSampler);
-        WIN32_LOAD_GLFN(glBindSampler);
-        WIN32_LOAD_GLFN(glSamplerParameteri);
-        WIN32_LOAD_GLFN(glSamplerParameteriv);
-        WIN32_LOAD_GLFN(glSamplerParameterf);
-        WIN32_LOAD_GLFN(glSamplerParameterfv);
-        WIN32_LOAD_GLFN(glSamplerParameterIiv);
-        WIN32_LOAD_GLFN(glSamplerParameterIuiv);
-        WIN32_LOAD_GLFN(glGetSamplerParameteriv);
-        WIN32_LOAD_GLFN(glGetSamplerParameterIiv);
-        WIN32_LOAD_GLFN(glGetSamplerParameterfv);
-        WIN32_LOAD_GLFN(glGetSamplerParameterIuiv);
-        WIN32_LOAD_GLFN(glQueryCounter);
-        WIN32_LOAD_GLFN(glGetQueryObjecti64v);
-        WIN32_LOAD_GLFN(glGetQueryObjectui64v);
-        WIN32_LOAD_GLFN(glVertexAttribDivisor);
-        WIN32_LOAD_GLFN(glVertexAttribP1ui);
-        WIN32_LOAD_GLFN(glVertexAttribP1uiv);
-        WIN32_LOAD_GLFN(glVertexAttribP2ui);
-        WIN32_LOAD_GLFN(glVertexAttribP2uiv);
-        WIN32_LOAD_GLFN(glVertexAttribP3ui);
-        WIN32_LOAD_GLFN(glVertexAttribP3uiv);
-        WIN32_LOAD_GLFN(glVertexAttribP4ui);
-        WIN32_LOAD_GLFN(glVertexAttribP4uiv);
-        WIN32_LOAD_GLFN(glVertexP2ui);
-        WIN32_LOAD_GLFN(glVertexP2uiv);
-        WIN32_LOAD_GLFN(glVertexP3ui);
-        WIN32_LOAD_GLFN(glVertexP3uiv);
-        WIN32_LOAD_GLFN(glVertexP4ui);
-        WIN32_LOAD_GLFN(glVertexP4uiv);
-        WIN32_LOAD_GLFN(glTexCoordP1ui);
-        WIN32_LOAD_GLFN(glTexCoordP1uiv);
-        WIN32_LOAD_GLFN(glTexCoordP2ui);
-        WIN32_LOAD_GLFN(glTexCoordP2uiv);
-        WIN32_LOAD_GLFN(glTexCoordP3ui);
-        WIN32_LOAD_GLFN(glTexCoordP3uiv);
-        WIN32_LOAD_GLFN(glTexCoordP4ui);
-        WIN32_LOAD_GLFN(glTexCoordP4uiv);
-        WIN32_LOAD_GLFN(glMultiTexCoordP1ui);
-        WIN32_LOAD_GLFN(glMultiTexCoordP1uiv);
-        WIN32_LOAD_GLFN(glMultiTexCoordP2ui);
-        WIN32_LOAD_GLFN(glMultiTexCoordP2uiv);
-        WIN32_LOAD_GLFN(glMultiTexCoordP3ui);
-        WIN32_LOAD_GLFN(glMultiTexCoordP3uiv);
-        WIN32_LOAD_GLFN(glMultiTexCoordP4ui);
-        WIN32_LOAD_GLFN(glMultiTexCoordP4uiv);
-        WIN32_LOAD_GLFN(glNormalP3ui);
-        WIN32_LOAD_GLFN(glNormalP3uiv);
-        WIN32_LOAD_GLFN(glColorP3ui);
-        WIN32_LOAD_GLFN(glColorP3uiv);
-        WIN32_LOAD_GLFN(glColorP4ui);
-        WIN32_LOAD_GLFN(glColorP4uiv);
-        WIN32_LOAD_GLFN(glSecondaryColorP3ui);
-        WIN32_LOAD_GLFN(glSecondaryColorP3uiv);
-    }
+    b32 negative = (a < 0) != (b < 0);
+    u64 ua = (a < 0) ? 0 - (u64)a : (u64)a;
+    u64 ub = (b < 0) ? 0 - (u64)b : (u64)b;
+    u64 hi = ua >> 32;
+    u64 q = (hi < ub) ? PL_DivU128(hi, ua << 32, ub) : ~0ull;
     
-    if(version >= 4.0)
+    if(negative)
     {
-        WIN32_LOAD_GLFN(glMinSampleShading);
-        WIN32_LOAD_GLFN(glBlendEquationi);
-        WIN32_LOAD_GLFN(glBlendEquationSeparatei);
-        WIN32_LOAD_GLFN(glBlendFunci);
-        WIN32_LOAD_GLFN(glBlendFuncSeparatei);
-        WIN32_LOAD_GLFN(glDrawArraysIndirect);
-        WIN32_LOAD_GLFN(glDrawElementsIndirect);
-        WIN32_LOAD_GLFN(glUniform1d);
-        WIN32_LOAD_GLFN(glUniform2d);
-        WIN32_LOAD_GLFN(glUniform3d);
-        WIN32_LOAD_GLFN(glUniform4d);
-        WIN32_LOAD_GLFN(glUniform1dv);
-        WIN32_LOAD_GLFN(glUniform2dv);
-        WIN32_LOAD_GLFN(glUniform3dv);
-        WIN32_LOAD_GLFN(glUniform4dv);
-        WIN32_LOAD_GLFN(glUniformMatrix2dv);
-        WIN32_LOAD_GLFN(glUniformMatrix3dv);
-        WIN32_LOAD_GLFN(glUniformMatrix4dv);
-        WIN32_LOAD_GLFN(glUniformMatrix2x3dv);
-        WIN32_LOAD_GLFN(glUniformMatrix2x4dv);
-        WIN32_LOAD_GLFN(glUniformMatrix3x2dv);
-        WIN32_LOAD_GLFN(glUniformMatrix3x4dv);
-        WIN32_LOAD_GLFN(glUniformMatrix4x2dv);
-        WIN32_LOAD_GLFN(glUniformMatrix4x3dv);
-        WIN32_LOAD_GLFN(glGetUniformdv);
-        WIN32_LOAD_GLFN(glGetSubroutineUniformLocation);
-        WIN32_LOAD_GLFN(glGetSubroutineIndex);
-        WIN32_LOAD_GLFN(glGetActiveSubroutineUniformiv);
-        WIN32_LOAD_GLFN(glGetActiveSubroutineUniformName);
-        WIN32_LOAD_GLFN(glGetActiveSubroutineName);
-        WIN32_LOAD_GLFN(glUniformSubroutinesuiv);
-        WIN32_LOAD_GLFN(glGetUniformSubroutineuiv);
-        WIN32_LOAD_GLFN(glGetProgramStageiv);
-        WIN32_LOAD_GLFN(glPatchParameteri);
-        WIN32_LOAD_GLFN(glPatchParameterfv);
-        WIN32_LOAD_GLFN(glBindTransformFeedback);
-        WIN32_LOAD_GLFN(glDeleteTransformFeedbacks);
-        WIN32_LOAD_GLFN(glGenTransformFeedbacks);
-        WIN32_LOAD_GLFN(glIsTransformFeedback);
-        WIN32_LOAD_GLFN(glPauseTransformFeedback);
-        WIN32_LOAD_GLFN(glResumeTransformFeedback);
-        WIN32_LOAD_GLFN(glDrawTransformFeedback);
-        WIN32_LOAD_GLFN(glDrawTransformFeedbackStream);
-        WIN32_LOAD_GLFN(glBeginQueryIndexed);
-        WIN32_LOAD_GLFN(glEndQueryIndexed);
-        WIN32_LOAD_GLFN(glGetQueryIndexediv);
-    }
-    
-    if(version >= 4.1)
-    {
-        WIN32_LOAD_GLFN(glReleaseShaderCompiler);
-        WIN32_LOAD_GLFN(glShaderBinary);
-        WIN32_LOAD_GLFN(glGetShaderPrecisionFormat);
-        WIN32_LOAD_GLFN(glDepthRangef);
-        WIN32_LOAD_GLFN(glClearDepthf);
-        WIN32_LOAD_GLFN(glGetProgramBinary);
-        WIN32_LOAD_GLFN(glProgramBinary);
-        WIN32_LOAD_GLFN(glProgramParameteri);
-        WIN32_LOAD_GLFN(glUseProgramStages);
-        WIN32_LOAD_GLFN(glActiveShaderProgram);
-        WIN32_LOAD_GLFN(glCreateShaderProgramv);
-        WIN32_LOAD_GLFN(glBindProgramPipeline);
-        WIN32_LOAD_GLFN(glDeleteProgramPipelines);
-        WIN32_LOAD_GLFN(glGenProgramPipelines);
-        WIN32_LOAD_GLFN(glIsProgramPipeline);
-        WIN32_LOAD_GLFN(glGetProgramPipelineiv);
-        WIN32_LOAD_GLFN(glProgramUniform1i);
-        WIN32_LOAD_GLFN(glProgramUniform1iv);
-        WIN32_LOAD_GLFN(glProgramUniform1f);
-        WIN32_LOAD_GLFN(glProgramUniform1fv);
-        WIN32_LOAD_GLFN(glProgramUniform1d);
-        WIN32_LOAD_GLFN(glProgramUniform1dv);
-        WIN32_LOAD_GLFN(glProgramUniform1ui);
-        WIN32_LOAD_GLFN(glProgramUniform1uiv);
-        WIN32_LOAD_GLFN(glProgramUniform2i);
-        WIN32_LOAD_GLFN(glProgramUniform2iv);
-        WIN32_LOAD_GLFN(glProgramUniform2f);
-        WIN32_LOAD_GLFN(glProgramUniform2fv);
-        WIN32_LOAD_GLFN(glProgramUniform2d);
-        WIN32_LOAD_GLFN(glProgramUniform2dv);
-        WIN32_LOAD_GLFN(glProgramUniform2ui);
-        WIN32_LOAD_GLFN(glProgramUniform2uiv);
-        WIN32_LOAD_GLFN(glProgramUniform3i);
-        WIN32_LOAD_GLFN(glProgramUniform3iv);
-        WIN32_LOAD_GLFN(glProgramUniform3f);
-        WIN32_LOAD_GLFN(glProgramUniform3fv);
-        WIN32_LOAD_GLFN(glProgramUniform3d);
-        WIN32_LOAD_GLFN(glProgramUniform3dv);
-        WIN32_LOAD_GLFN(glProgramUniform3ui);
-        WIN32_LOAD_GLFN(glProgramUniform3uiv);
-        WIN32_LOAD_GLFN(glProgramUniform4i);
-        WIN32_LOAD_GLFN(glProgramUniform4iv);
-        WIN32_LOAD_GLFN(glProgramUniform4f);
-        WIN32_LOAD_GLFN(glProgramUniform4fv);
-        WIN32_LOAD_GLFN(glProgramUniform4d);
-        WIN32_LOAD_GLFN(glProgramUniform4dv);
-        WIN32_LOAD_GLFN(glProgramUniform4ui);
-        WIN32_LOAD_GLFN(glProgramUniform4uiv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix2fv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix3fv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix4fv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix2dv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix3dv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix4dv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix2x3fv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix3x2fv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix2x4fv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix4x2fv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix3x4fv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix4x3fv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix2x3dv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix3x2dv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix2x4dv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix4x2dv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix3x4dv);
-        WIN32_LOAD_GLFN(glProgramUniformMatrix4x3dv);
-        WIN32_LOAD_GLFN(glValidateProgramPipeline);
-        WIN32_LOAD_GLFN(glGetProgramPipelineInfoLog);
-        WIN32_LOAD_GLFN(glVertexAttribL1d);
-        WIN32_LOAD_GLFN(glVertexAttribL2d);
-        WIN32_LOAD_GLFN(glVertexAttribL3d);
-        WIN32_LOAD_GLFN(glVertexAttribL4d);
-        WIN32_LOAD_GLFN(glVertexAttribL1dv);
-        WIN32_LOAD_GLFN(glVertexAttribL2dv);
-        WIN32_LOAD_GLFN(glVertexAttribL3dv);
-        WIN32_LOAD_GLFN(glVertexAttribL4dv);
-        WIN32_LOAD_GLFN(glVertexAttribLPointer);
-        WIN32_LOAD_GLFN(glGetVertexAttribLdv);
-        WIN32_LOAD_GLFN(glViewportArrayv);
-        WIN32_LOAD_GLFN(glViewportIndexedf);
-        WIN32_LOAD_GLFN(glViewportIndexedfv);
-        WIN32_LOAD_GLFN(glScissorArrayv);
-        WIN32_LOAD_GLFN(glScissorIndexed);
-        WIN32_LOAD_GLFN(glScissorIndexedv);
-        WIN32_LOAD_GLFN(glDepthRangeArrayv);
-        WIN32_LOAD_GLFN(glDepthRangeIndexed);
-        WIN32_LOAD_GLFN(glGetFloati_v);
-        WIN32_LOAD_GLFN(glGetDoublei_v);
+        return (q > (u64)INT64_MAX) ? INT64_MIN : -(q32)q;
     }
+    return (q > (u64)INT64_MAX) ? INT64_MAX : (q32)q;
+}
+
+q32 q32sqrt(q32 v)
+{
+    return (v > 0) ? (q32)PL_FixedSqrt((u64)v, 32) : 0;
+}
+
+q32 q32sin(q32 a)
+{
+    return q32fromq16(q16sin((q16)((a % Q32_TAU) >> 16)));
+}
+
+q32 q32cos(q32 a)
+{
+    return q32fromq16(q16cos((q16)((a % Q32_TAU) >> 16)));
+}
+
+q32 q32atan2(q32 y, q32 x)
+{
+    return q32fromq16(PL_FixedAtan2(y, x));
+}
+
+/*=========== HASH =============*/
+
+// CREDIT: modified version from Paul Hsieh: www.azillionmonkeys.com/qed/hash.html
+// I won't pretend to understand the magic constants used here
+static inline u16 PL_Load16(const void *p) {u16 v; memcpy(&v, p, sizeof(v)); return v;}
+static inline u32 PL_Load32(const void *p) {u32 v; memcpy(&v, p, sizeof(v)); return v;}
+static inline u64 PL_Load64(const void *p) {u64 v; memcpy(&v, p, sizeof(v)); return v;}
+
+u32 PL_Hash32(ptr input, u64 inputSize)
+{
+    // the tail cases only read the bytes that are there, short input needs no padding copy
+    i8 *in = (i8*)input;
+    u32 result = (u32)inputSize;
+    u32 tmp;
+    u64 len = inputSize;
+    int rlen;
     
-    if(version >= 4.2)
+    rlen = len & 3;
+    len >>= 2;
+    
+    while(len > 0)
     {
-        WIN32_LOAD_GLFN(glDrawArraysInstancedBaseInstance);
-        WIN32_LOAD_GLFN(glDrawElementsInstancedBaseInstance);
-        WIN32_LOAD_GLFN(glDrawElementsInstancedBaseVertexBaseInstance);
-        WIN32_LOAD_GLFN(glGetInternalformativ);
-        WIN32_LOAD_GLFN(glGetActiveAtomicCounterBufferiv);
-        WIN32_LOAD_GLFN(glBindImageTexture);
-        WIN32_LOAD_GLFN(glMemoryBarrier);
-        WIN32_LOAD_GLFN(glTexStorage1D);
-        WIN32_LOAD_GLFN(glTexStorage2D);
-        WIN32_LOAD_GLFN(glTexStorage3D);
-        WIN32_LOAD_GLFN(glDrawTransformFeedbackInstanced);
-        WIN32_LOAD_GLFN(glDrawTransformFeedbackStreamInstanced);
+        result += PL_Load16(in);
+        tmp = (PL_Load16(in + 2) << 11) ^ result;
+        result = (result << 16) ^ tmp;
+        in += 2 * sizeof(u16);
+        result += result >> 11;
+        len--;
     }
     
-    if(version >= 4.3)
+    switch (rlen)
     {
-        WIN32_LOAD_GLFN(glClearBufferData);
-        WIN32_LOAD_GLFN(glClearBufferSubData);
-        WIN32_LOAD_GLFN(glDispatchCompute);
-        WIN32_LOAD_GLFN(glDispatchComputeIndirect);
-        WIN32_LOAD_GLFN(glCopyImageSubData);
-        WIN32_LOAD_GLFN(glFramebufferParameteri);
-        WIN32_LOAD_GLFN(glGetFramebufferParameteriv);
-        WIN32_LOAD_GLFN(glGetInternalformati64v);
-        WIN32_LOAD_GLFN(glInvalidateTexSubImage);
-        WIN32_LOAD_GLFN(glInvalidateTexImage);
-        WIN32_LOAD_GLFN(glInvalidateBufferSubData);
-        WIN32_LOAD_GLFN(glInvalidateBufferData);
-        WIN32_LOAD_GLFN(glInvalidateFramebuffer);
-        WIN32_LOAD_GLFN(glInvalidateSubFramebuffer);
-        WIN32_LOAD_GLFN(glMultiDrawArraysIndirect);
-        WIN32_LOAD_GLFN(glMultiDrawElementsIndirect);
-        WIN32_LOAD_GLFN(glGetProgramInterfaceiv);
-        WIN32_LOAD_GLFN(glGetProgramResourceIndex);
-        WIN32_LOAD_GLFN(glGetProgramResourceName);
-        WIN32_LOAD_GLFN(glGetProgramResourceiv);
-        WIN32_LOAD_GLFN(glGetProgramResourceLocation);
-        WIN32_LOAD_GLFN(glGetProgramResourceLocationIndex);
-        WIN32_LOAD_GLFN(glShaderStorageBlockBinding);
-        WIN32_LOAD_GLFN(glTexBufferRange);
-        WIN32_LOAD_GLFN(glTexStorage2DMultisample);
-        WIN32_LOAD_GLFN(glTexStorage3DMultisample);
-        WIN32_LOAD_GLFN(glTextureView);
-        WIN32_LOAD_GLFN(glBindVertexBuffer);
-        WIN32_LOAD_GLFN(glVertexAttribFormat);
-        WIN32_LOAD_GLFN(glVertexAttribIFormat);
-        WIN32_LOAD_GLFN(glVertexAttribLFormat);
-        WIN32_LOAD_GLFN(glVertexAttribBinding);
-        WIN32_LOAD_GLFN(glVertexBindingDivisor);
-        WIN32_LOAD_GLFN(glDebugMessageControl);
-        WIN32_LOAD_GLFN(glDebugMessageInsert);
-        WIN32_LOAD_GLFN(glDebugMessageCallback);
-        WIN32_LOAD_GLFN(glGetDebugMessageLog);
-        WIN32_LOAD_GLFN(glPushDebugGroup);
-        WIN32_LOAD_GLFN(glPopDebugGroup);
-        WIN32_LOAD_GLFN(glObjectLabel);
-        WIN32_LOAD_GLFN(glGetObjectLabel);
-        WIN32_LOAD_GLFN(glObjectPtrLabel);
-        WIN32_LOAD_GLFN(glGetObjectPtrLabel);
+        case 1:
+        {
+            result += *in;
+            result ^= result << 10;
+            result += result >> 1;
+        } break;
+        case 2:
+        {
+            result += PL_Load16(in);
+            result ^= result << 11;
+            result += result >> 17;
+        } break;
+        case 3:
+        {
+            result += PL_Load16(in);
+            result ^= result << 16;
+            result ^= (u32)(i32)in[sizeof(u16)] << 18;
+            result += result >> 11;
+        } break;
     }
     
-    if(version >= 4.4)
+    result ^= result << 3;
+    result += result >> 5;
+    result ^= result << 4;
+    result += result >> 17;
+    result ^= result << 25;
+    result += result >> 6;
+    
+    return result;
+}
+
+
+// XXH64 by Yann Collet: github.com/Cyan4973/xxHash, 4 independent 64 bit lanes over 32 byte stripes
+#define PL_XXH_P1 0x9E3779B185EBCA87ull
+#define PL_XXH_P2 0xC2B2AE3D27D4EB4Full
+#define PL_XXH_P3 0x165667B19E3779F9ull
+#define PL_XXH_P4 0x85EBCA77C2B2AE63ull
+#define PL_XXH_P5 0x27D4EB2F165667C5ull
+
+static inline u64 PL_XXHRound(u64 acc, u64 input)
+{
+    acc += input * PL_XXH_P2;
+    acc = PL_Rotl64(acc, 31);
+    return acc * PL_XXH_P1;
+}
+
+static inline u64 PL_XXHMerge(u64 hash, u64 acc)
+{
+    hash ^= PL_XXHRound(0, acc);
+    return hash * PL_XXH_P1 + PL_XXH_P4;
+}
+
+static inline void PL_XXHInitAcc(u64 *acc, u64 seed)
+{
+    acc[0] = seed + PL_XXH_P1 + PL_XXH_P2;
+    acc[1] = seed + PL_XXH_P2;
+    acc[2] = seed;
+    acc[3] = seed - PL_XXH_P1;
+}
+
+static const u8 *PL_XXHStripes(u64 *acc, const u8 *in, u64 stripes)
+{
+    u64 a0 = acc[0], a1 = acc[1], a2 = acc[2], a3 = acc[3];
+    for(u64 i = 0; i < stripes; i++)
+    {
+        a0 = PL_XXHRound(a0, PL_Load64(in + 0));
+        a1 = PL_XXHRound(a1, PL_Load64(in + 8));
+        a2 = PL_XXHRound(a2, PL_Load64(in + 16));
+        a3 = PL_XXHRound(a3, PL_Load64(in + 24));
+        in += 32;
+    }
+    acc[0] = a0; acc[1] = a1; acc[2] = a2; acc[3] = a3;
+    return in;
+}
+
+static u64 PL_XXHMergeAcc(const u64 *acc)
+{
+    u64 hash = PL_Rotl64(acc[0], 1) + PL_Rotl64(acc[1], 7) + PL_Rotl64(acc[2], 12) + PL_Rotl64(acc[3], 18);
+    for(int i = 0; i < 4; i++) hash = PL_XXHMerge(hash, acc[i]);
+    return hash;
+}
+
+// mixes in the last (< 32) bytes and avalanches
+static u64 PL_XXHFinish(u64 hash, const u8 *in, u64 size)
+{
+    for(; size >= 8; size -= 8, in += 8)
+    {
+        hash ^= PL_XXHRound(0, PL_Load64(in));
+        hash = PL_Rotl64(hash, 27) * PL_XXH_P1 + PL_XXH_P4;
+    }
+    if(size >= 4)
+    {
+        hash ^= (u64)PL_Load32(in) * PL_XXH_P1;
+        hash = PL_Rotl64(hash, 23) * PL_XXH_P2 + PL_XXH_P3;
+        in += 4;
+        size -= 4;
+    }
+    for(; size; size--, in++)
     {
-        WIN32_LOAD_GLFN(glBufferStorage);
-        WIN32_LOAD_GLFN(glClearTexImage);
-        WIN32_LOAD_GLFN(glClearTexSubImage);
-        WIN32_LOAD_GLFN(glBindBuffersBase);
-        WIN32_LOAD_GLFN(glBindBuffersRange);
-        WIN32_LOAD_GLFN(glBindTextures);
-        WIN32_LOAD_GLFN(glBindSamplers);
-        WIN32_LOAD_GLFN(glBindImageTextures);
-        WIN32_LOAD_GLFN(glBindVertexBuffers);
+        hash ^= (*in) * PL_XXH_P5;
+        hash = PL_Rotl64(hash, 11) * PL_XXH_P1;
     }
     
-    if(version >= 4.5)
+    hash ^= hash >> 33;
+    hash *= PL_XXH_P2;
+    hash ^= hash >> 29;
+    hash *= PL_XXH_P3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+u64 PL_Hash64(ptr input, u64 inputSize, u64 seed)
+{
+    const u8 *in = (const u8*)input;
+    u64 hash;
+    
+    if(inputSize >= 32)
+    {
+        u64 acc[4];
+        PL_XXHInitAcc(acc, seed);
+        in = PL_XXHStripes(acc, in, inputSize / 32);
+        hash = PL_XXHMergeAcc(acc);
+    }
+    else
     {
-        WIN32_LOAD_GLFN(glClipControl);
-        WIN32_LOAD_GLFN(glCreateTransformFeedbacks);
-        WIN32_LOAD_GLFN(glTransformFeedbackBufferBase);
-        WIN32_LOAD_GLFN(glTransformFeedbackBufferRange);
-        WIN32_LOAD_GLFN(glGetTransformFeedbackiv);
-        WIN32_LOAD_GLFN(glGetTransformFeedbacki_v);
-        WIN32_LOAD_GLFN(glGetTransformFeedbacki64_v);
-        WIN32_LOAD_GLFN(glCreateBuffers);
-        WIN32_LOAD_GLFN(glNamedBufferStorage);
-        WIN32_LOAD_GLFN(glNamedBufferData);
-        WIN32_LOAD_GLFN(glNamedBufferSubData);
-        WIN32_LOAD_GLFN(glCopyNamedBufferSubData);
-        WIN32_LOAD_GLFN(glClearNamedBufferData);
-        WIN32_LOAD_GLFN(glClearNamedBufferSubData);
-        WIN32_LOAD_GLFN(glMapNamedBuffer);
-        WIN32_LOAD_GLFN(glMapNamedBufferRange);
-        WIN32_LOAD_GLFN(glUnmapNamedBuffer);
-        WIN32_LOAD_GLFN(glFlushMappedNamedBufferRange);
-        WIN32_LOAD_GLFN(glGetNamedBufferParameteriv);
-        WIN32_LOAD_GLFN(glGetNamedBufferParameteri64v);
-        WIN32_LOAD_GLFN(glGetNamedBufferPointerv);
-        WIN32_LOAD_GLFN(glGetNamedBufferSubData);
-        WIN32_LOAD_GLFN(glCreateFramebuffers);
-        WIN32_LOAD_GLFN(glNamedFramebufferRenderbuffer);
-        WIN32_LOAD_GLFN(glNamedFramebufferParameteri);
-        WIN32_LOAD_GLFN(glNamedFramebufferTexture);
-        WIN32_LOAD_GLFN(glNamedFramebufferTextureLayer);
-        WIN32_LOAD_GLFN(glNamedFramebufferDrawBuffer);
-        WIN32_LOAD_GLFN(glNamedFramebufferDrawBuffers);
-        WIN32_LOAD_GLFN(glNamedFramebufferReadBuffer);
-        WIN32_LOAD_GLFN(glInvalidateNamedFramebufferData);
-        WIN32_LOAD_GLFN(glInvalidateNamedFramebufferSubData);
-        WIN32_LOAD_GLFN(glClearNamedFramebufferiv);
-        WIN32_LOAD_GLFN(glClearNamedFramebufferuiv);
-        WIN32_LOAD_GLFN(glClearNamedFramebufferfv);
-        WIN32_LOAD_GLFN(glClearNamedFramebufferfi);
-        WIN32_LOAD_GLFN(glBlitNamedFramebuffer);
-        WIN32_LOAD_GLFN(glCheckNamedFramebufferStatus);
-        WIN32_LOAD_GLFN(glGetNamedFramebufferParameteriv);
-        WIN32_LOAD_GLFN(glGetNamedFramebufferAttachmentParameteriv);
-        WIN32_LOAD_GLFN(glCreateRenderbuffers);
-        WIN32_LOAD_GLFN(glNamedRenderbufferStorage);
-        WIN32_LOAD_GLFN(glNamedRenderbufferStorageMultisample);
-        WIN32_LOAD_GLFN(glGetNamedRenderbufferParameteriv);
-        WIN32_LOAD_GLFN(glCreateTextures);
-        WIN32_LOAD_GLFN(glTextureBuffer);
-        WIN32_LOAD_GLFN(glTextureBufferRange);
-        WIN32_LOAD_GLFN(glTextureStorage1D);
-        WIN32_LOAD_GLFN(glTextureStorage2D);
-        WIN32_LOAD_GLFN(glTextureStorage3D);
-        WIN32_LOAD_GLFN(glTextureStorage2DMultisample);
-        WIN32_LOAD_GLFN(glTextureStorage3DMultisample);
-        WIN32_LOAD_GLFN(glTextureSubImage1D);
-        WIN32_LOAD_GLFN(glTextureSubImage2D);
-        WIN32_LOAD_GLFN(glTextureSubImage3D);
-        WIN32_LOAD_GLFN(glCompressedTextureSubImage1D);
-        WIN32_LOAD_GLFN(glCompressedTextureSubImage2D);
-        WIN32_LOAD_GLFN(glCompressedTextureSubImage3D);
-        WIN32_LOAD_GLFN(glCopyTextureSubImage1D);
-        WIN32_LOAD_GLFN(glCopyTextureSubImage2D);
-        WIN32_LOAD_GLFN(glCopyTextureSubImage3D);
-        WIN32_LOAD_GLFN(glTextureParameterf);
-        WIN32_LOAD_GLFN(glTextureParameterfv);
-        WIN32_LOAD_GLFN(glTextureParameteri);
-        WIN32_LOAD_GLFN(glTextureParameterIiv);
-        WIN32_LOAD_GLFN(glTextureParameterIuiv);
-        WIN32_LOAD_GLFN(glTextureParameteriv);
-        WIN32_LOAD_GLFN(glGenerateTextureMipmap);
-        WIN32_LOAD_GLFN(glBindTextureUnit);
-        WIN32_LOAD_GLFN(glGetTextureImage);
-        WIN32_LOAD_GLFN(glGetCompressedTextureImage);
-        WIN32_LOAD_GLFN(glGetTextureLevelParameterfv);
-        WIN32_LOAD_GLFN(glGetTextureLevelParameteriv);
-        WIN32_LOAD_GLFN(glGetTextureParameterfv);
-        WIN32_LOAD_GLFN(glGetTextureParameterIiv);
-        WIN32_LOAD_GLFN(glGetTextureParameterIuiv);
-        WIN32_LOAD_GLFN(glGetTextureParameteriv);
-        WIN32_LOAD_GLFN(glCreateVertexArrays);
-        WIN32_LOAD_GLFN(glDisableVertexArrayAttrib);
-        WIN32_LOAD_GLFN(glEnableVertexArrayAttrib);
-        WIN32_LOAD_GLFN(glVertexArrayElementBuffer);
-        WIN32_LOAD_GLFN(glVertexArrayVertexBuffer);
-        WIN32_LOAD_GLFN(glVertexArrayVertexBuffers);
-        WIN32_LOAD_GLFN(glVertexArrayAttribBinding);
-        WIN32_LOAD_GLFN(glVertexArrayAttribFormat);
-        WIN32_LOAD_GLFN(glVertexArrayAttribIFormat);
-        WIN32_LOAD_GLFN(glVertexArrayAttribLFormat);
-        WIN32_LOAD_GLFN(glVertexArrayBindingDivisor);
-        WIN32_LOAD_GLFN(glGetVertexArrayiv);
-        WIN32_LOAD_GLFN(glGetVertexArrayIndexediv);
-        WIN32_LOAD_GLFN(glGetVertexArrayIndexed64iv);
-        WIN32_LOAD_GLFN(glCreateSamplers);
-        WIN32_LOAD_GLFN(glCreateProgramPipelines);
-        WIN32_LOAD_GLFN(glCreateQueries);
-        WIN32_LOAD_GLFN(glGetQueryBufferObjecti64v);
-        WIN32_LOAD_GLFN(glGetQueryBufferObjectiv);
-        WIN32_LOAD_GLFN(glGetQueryBufferObjectui64v);
-        WIN32_LOAD_GLFN(glGetQueryBufferObjectuiv);
-        WIN32_LOAD_GLFN(glMemoryBarrierByRegion);
-        WIN32_LOAD_GLFN(glGetTextureSubImage);
-        WIN32_LOAD_GLFN(glGetCompressedTextureSubImage);
-        WIN32_LOAD_GLFN(glGetGraphicsResetStatus);
-        WIN32_LOAD_GLFN(glGetnCompressedTexImage);
-        WIN32_LOAD_GLFN(glGetnTexImage);
-        WIN32_LOAD_GLFN(glGetnUniformdv);
-        WIN32_LOAD_GLFN(glGetnUniformfv);
-        WIN32_LOAD_GLFN(glGetnUniformiv);
-        WIN32_LOAD_GLFN(glGetnUniformuiv);
-        WIN32_LOAD_GLFN(glReadnPixels);
-        WIN32_LOAD_GLFN(glGetnMapdv);
-        WIN32_LOAD_GLFN(glGetnMapfv);
-        WIN32_LOAD_GLFN(glGetnMapiv);
-        WIN32_LOAD_GLFN(glGetnPixelMapfv);
-        WIN32_LOAD_GLFN(glGetnPixelMapuiv);
-        WIN32_LOAD_GLFN(glGetnPixelMapusv);
-        WIN32_LOAD_GLFN(glGetnPolygonStipple);
-        WIN32_LOAD_GLFN(glGetnColorTable);
-        WIN32_LOAD_GLFN(glGetnConvolutionFilter);
-        WIN32_LOAD_GLFN(glGetnSeparableFilter);
-        WIN32_LOAD_GLFN(glGetnHistogram);
-        WIN32_LOAD_GLFN(glGetnMinmax);
-        WIN32_LOAD_GLFN(glTextureBarrier);
+        hash = seed + PL_XXH_P5;
     }
     
-    return 1;
+    hash += inputSize;
+    return PL_XXHFinish(hash, in, inputSize & 31);
 }
 
-static void Win32_LoadXInput(void)
+void PL_Hash64Init(PL_Hash64State *state, u64 seed)
 {
-    WIN32_XINPUT_LOADED_VERSION version = WIN32_XINPUT_NOT_LOADED;
-    HMODULE lib = 0;
+    PL_MemZero(state, sizeof(*state));
+    PL_XXHInitAcc(state->acc, seed);
+    state->seed = seed;
+}
+
+void PL_Hash64Update(PL_Hash64State *state, ptr input, u64 inputSize)
+{
+    const u8 *in = (const u8*)input;
+    state->totalSize += inputSize;
     
-    lib = LoadLibraryA("xinput1_4.dll");
+    // top up a partial stripe from the last update first
+    if(state->bufferSize)
+    {
+        u64 fill = PL_Min64(32 - state->bufferSize, inputSize);
+        PL_MemCpy((ptr)in, state->buffer + state->bufferSize, fill);
+        state->bufferSize += (u32)fill;
+        in += fill;
+        inputSize -= fill;
+        if(state->bufferSize < 32) return;
+        PL_XXHStripes(state->acc, state->buffer, 1);
+        state->bufferSize = 0;
+    }
     
-    if(lib)
+    in = PL_XXHStripes(state->acc, in, inputSize / 32);
+    inputSize &= 31;
+    if(inputSize)
     {
-        version = WIN32_XINPUT_1_4;
+        PL_MemCpy((ptr)in, state->buffer, inputSize);
+        state->bufferSize = (u32)inputSize;
+    }
+}
+
+u64 PL_Hash64Final(PL_Hash64State *state)
+{
+    u64 hash = (state->totalSize >= 32) ? PL_XXHMergeAcc(state->acc) : state->seed + PL_XXH_P5;
+    hash += state->totalSize;
+    return PL_XXHFinish(hash, state->buffer, state->bufferSize);
+}
+
+/*=========== RAND =================*/
+
+// xoshiro256** and splitmix64 seeding by David Blackman and Sebastiano Vigna: prng.di.unimi.it
+
+static u64 PL_SplitMix64(u64 *x)
+{
+    u64 z = (*x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+void PL_RandSeed(PL_RandState *state, u64 seed)
+{
+    // splitmix never gives 4 zero words, which is the one state xoshiro can't leave
+    for(int i = 0; i < 4; i++)
+    {
+        state->s[i] = PL_SplitMix64(&seed);
     }
+}
+
+u64 PL_RandU64(PL_RandState *state)
+{
+    u64 *s = state->s;
+    u64 result = PL_Rotl64(s[1] * 5, 7) * 9;
+    u64 t = s[1] << 17;
     
-    else
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = PL_Rotl64(s[3], 45);
+    
+    return result;
+}
+
+u32 PL_RandU32(PL_RandState *state)
+{
+    return (u32)(PL_RandU64(state) >> 32); // high bits are the strongest
+}
+
+u32 PL_RandRange(PL_RandState *state, u32 range)
+{
+    // Lemire's multiply-shift, rejects the few low products that would bias toward small values
+    u64 m = (u64)PL_RandU32(state) * range;
+    u32 low = (u32)m;
+    if(low < range)
     {
-        lib = LoadLibraryA("xinput9_1_0.dll");
-        
-        if(lib)
-        {
-            version = WIN32_XINPUT_9_1_0;
-        }
-        
-        else
+        u32 threshold = (0u - range) % range;
+        while(low < threshold)
         {
-            lib = LoadLibraryA("xinput1_3.dll");
-            
-            if(lib)
-            {
-                version = WIN32_XINPUT_1_3;
-            }
-            
-            else
-            {
-                //NOTE: if xinput failed to load, controllers will just appear to be disconnected.
-                PL_SetErrorString("Failed to load xinput DLL.");
-                win32_state->xinput.version = WIN32_XINPUT_NOT_LOADED;
-                win32_state->xinput.GetState = sfn_XInputGetState;
-                win32_state->xinput.SetState = sfn_XInputSetState;
-            }
+            m = (u64)PL_RandU32(state) * range;
+            low = (u32)m;
         }
     }
     
-    if(lib)
+    return (u32)(m >> 32);
+}
+
+i32 PL_RandBetween(PL_RandState *state, i32 min, i32 max)
+{
+    if(max < min)
     {
-        win32_state->xinput.version = version;
-        win32_state->xinput.GetState = (tfn_XInputGetState *)GetProcAddress(lib, "XInputGetState");
-        win32_state->xinput.SetState = (tfn_XInputSetState *)GetProcAddress(lib, "XInputSetState");
+        i32 tmp = min;
+        min = max;
+        max = tmp;
     }
+    
+    u32 span = (u32)max - (u32)min + 1; // 0 when [min, max] is the whole i32 range
+    u32 offset = span ? PL_RandRange(state, span) : PL_RandU32(state);
+    return (i32)((u32)min + offset);
 }
 
-static void Win32_LoadXAudio(void)
+r32 PL_RandR32(PL_RandState *state)
 {
-    WIN32_XAUDIO_LOADED_VERSION version = WIN32_XAUDIO_NOT_LOADED;
-    HMODULE lib = 0;
-    
-    lib = LoadLibraryA("xaudio2_9.dll");
-    
-    if(lib)
+    return (r32)(PL_RandU64(state) >> 40) * (1.0f / 16777216.0f); // 24 bits of mantissa
+}
+
+r64 PL_RandR64(PL_RandState *state)
+{
+    return (r64)(PL_RandU64(state) >> 11) * (1.0 / 9007199254740992.0); // 53 bits of mantissa
+}
+
+r32 PL_RandR32Range(PL_RandState *state, r32 min, r32 max)
+{
+    r32 result = min + (max - min) * PL_RandR32(state);
+    return (result < max) ? result : min; // rounding can land on max for wide ranges
+}
+
+void PL_RandJump(PL_RandState *state)
+{
+    static const u64 jump[4] =
     {
-        version = WIN32_XAUDIO_2_9;
-    }
+        0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull
+    };
     
-    else
+    u64 s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for(int i = 0; i < 4; i++)
     {
-        lib = LoadLibraryA("xaudio2_9d.dll");
-        
-        if(lib)
-        {
-            version = WIN32_XAUDIO_2_9D;
-        }
-        
-        else
+        for(int b = 0; b < 64; b++)
         {
-            lib = LoadLibraryA("xaudio2_8.dll");
-            
-            if(lib)
-            {
-                version = WIN32_XAUDIO_2_8;
-            }
-            
-            else
+            if(jump[i] & (1ull << b))
             {
-                lib = LoadLibraryA("xaudio2_7.dll");
-                
-                if(lib)
-                {
-                    version = WIN32_XAUDIO_2_7;
-                }
-                
-                else
-                {
-                    //NOTE: if xaudio doesnt load, audio just wont play
-                    PL_SetErrorString("Failed to load xaudio DLL.");
-                    win32_state->xaudio.version = WIN32_XAUDIO_NOT_LOADED;
-                    win32_state->xaudio.Create = sfn_XAudio2Create;
-                }
+                s0 ^= state->s[0];
+                s1 ^= state->s[1];
+                s2 ^= state->s[2];
+                s3 ^= state->s[3];
             }
+            PL_RandU64(state);
         }
     }
     
-    if(lib)
-    {
-        win32_state->xaudio.version = version;
-        win32_state->xaudio.Create = (tfn_XAudio2Create *)GetProcAddress(lib, "XAudio2Create");
-    }
+    state->s[0] = s0;
+    state->s[1] = s1;
+    state->s[2] = s2;
+    state->s[3] = s3;
 }
 
-static void Win32_AudioInit(void)
+PL_RandState PL_RandSplit(PL_RandState *state)
 {
-    if(win32_state->xaudio.version == WIN32_XAUDIO_NOT_LOADED)
+    PL_RandState result = *state;
+    PL_RandJump(state);
+    return result;
+}
+
+static PL_RandState pl_randState;
+static b8 pl_randIsInit;
+
+PL_RandState *PL_GetRandState(void)
+{
+    if(!pl_randIsInit)
     {
-        return;
+        PL_RandSeed(&pl_randState, (u64)time(0));
+        pl_randIsInit = 1;
     }
     
-    Win32_XAudio *xaudio = &win32_state->xaudio;
-    IXAudio2 *handle = xaudio->handle;
-    HRESULT ecode;
-    
-    ecode = XAudio2Create(&handle, 0, XAUDIO2_DEFAULT_PROCESSOR);
-    if(FAILED(ecode))
+    return &pl_randState;
+}
+
+r32 PL_Rand(void)
+{
+    return PL_RandR32(PL_GetRandState());
+}
+
+void PL_RandLanesInit(PL_RandLanes *lanes, PL_RandState *state)
+{
+    for(int lane = 0; lane < PL_RAND_LANES; lane++)
     {
-        PL_SetErrorString("Failed to create XAudio2 Handle. Code(%d)", ecode);
-        return;
+        PL_RandState split = PL_RandSplit(state);
+        for(int w = 0; w < 4; w++) lanes->s[w][lane] = split.s[w];
     }
     
-#if defined(__cplusplus)
-    ecode = handle->CreateMasteringVoice(&xaudio->masterVoice, 2, AUDIO_SAMPLE_RATE, 0,0,0,0);
-#else
-    ecode = IXAudio2_CreateMasteringVoice(handle, &xaudio->masterVoice, 2, AUDIO_SAMPLE_RATE, 0,0,0,0);
-#endif
-    if(FAILED(ecode))
+    lanes->spare = PL_RandSplit(state);
+}
+
+static PL_RandLanes pl_randLanes;
+static b8 pl_randLanesIsInit;
+
+PL_RandLanes *PL_GetRandLanes(void)
+{
+    if(!pl_randLanesIsInit)
     {
-        PL_SetErrorString("Failed to create XAudio2 Mastering Voice. Code(%d)", ecode);
-        return;
+        PL_RandLanesInit(&pl_randLanes, PL_GetRandState());
+        pl_randLanesIsInit = 1;
     }
     
-	WAVEFORMATEX *fmt = &xaudio->fmt;
-    fmt->wFormatTag = WAVE_FORMAT_PCM;
-    fmt->nChannels = 2;
-    fmt->nSamplesPerSec = AUDIO_SAMPLE_RATE;
-    fmt->wBitsPerSample = 16;
-    fmt->nBlockAlign = (fmt->nChannels * fmt->wBitsPerSample)/8;
-    fmt->nAvgBytesPerSec = fmt->nSamplesPerSec * fmt->nBlockAlign;
-    fmt->cbSize = 0;
+    return &pl_randLanes;
+}
+
+// u32s per lane step, and per chunk made on the stack so conversions run while it is in L1
+#define PL_RAND_STEP_U32 (PL_RAND_LANES * 2)
+#define PL_RAND_CHUNK_U32 (PL_RAND_STEP_U32 * 64)
+
+void PL_RandFillU32(PL_RandLanes *lanes, u32 *dst, u64 count)
+{
+    u64 steps = count / PL_RAND_STEP_U32;
+    pl_dispatch.randFill(lanes, (u8*)dst, steps);
     
-#if defined(__cplusplus)
-    ecode = handle->CreateSourceVoice(&xaudio->srcVoice, (WAVEFORMATEX*)fmt, 0, XAUDIO2_MAX_FREQ_RATIO, 0,0,0);
-#else
-    ecode = IXAudio2_CreateSourceVoice(handle, &xaudio->srcVoice, (WAVEFORMATEX*)fmt, 0, XAUDIO2_MAX_FREQ_RATIO, 0, 0, 0);
-#endif
-    if(FAILED(ecode))
+    u64 done = steps * PL_RAND_STEP_U32;
+    if(done < count)
     {
-        PL_SetErrorString("Failed to set XAudio2 audio format. Code(%d)", ecode);
-        return;
+        u32 last[PL_RAND_STEP_U32];
+        pl_dispatch.randFill(lanes, (u8*)last, 1);
+        PL_MemCpy(last, dst + done, (count - done) * sizeof(u32));
     }
+}
+
+void PL_RandFillR32(PL_RandLanes *lanes, r32 *dst, u64 count)
+{
+    u32 chunk[PL_RAND_CHUNK_U32];
     
-    XAUDIO2_BUFFER *buffer = &xaudio->bufferHeader;
-    buffer->Flags = 0; //XAUDIO2_END_OF_STREAM if buffer is empty
-    buffer->AudioBytes = AUDIO_BUFFER_SIZE;
-    buffer->pAudioData = (BYTE*)win32_state->audio.buffer; // ptr to buffer
-    buffer->PlayBegin = 0;
-    buffer->PlayLength = 0; // 0 = whole buffer
-    buffer->LoopBegin = 0;
-    buffer->LoopLength = 0;
-    buffer->LoopCount = XAUDIO2_LOOP_INFINITE;
-    buffer->pContext = 0; // callback context
-    
-#if defined(__cplusplus)
-    ecode = xaudio->srcVoice.SubmitSourceBuffer(buffer, 0);
-#else
-    ecode = IXAudio2SourceVoice_SubmitSourceBuffer(xaudio->srcVoice, buffer, 0);
-#endif
-    if(FAILED(ecode))
+    while(count)
     {
-        PL_SetErrorString("Failed to submit XAudio2 buffer. Code(%d)", ecode);
+        u64 n = PL_Min64(count, PL_RAND_CHUNK_U32);
+        pl_dispatch.randFill(lanes, (u8*)chunk, (n + PL_RAND_STEP_U32 - 1) / PL_RAND_STEP_U32);
+        pl_dispatch.randToR32(dst, chunk, n);
+        dst += n;
+        count -= n;
+    }
+}
+
+void PL_RandFillRange(PL_RandLanes *lanes, u32 *dst, u64 count, u32 range)
+{
+    if(!range)
+    {
+        PL_MemZero(dst, count * sizeof(u32));
         return;
     }
     
-#if defined(__cplusplus)
-    ecode = xaudio->srcVoice.Start(0, XAUDIO2_COMMIT_NOW);
-#else
-    ecode = IXAudio2SourceVoice_Start(xaudio->srcVoice, 0, XAUDIO2_COMMIT_NOW);
-#endif
-    if(FAILED(ecode))
+    u32 chunk[PL_RAND_CHUNK_U32];
+    
+    while(count)
     {
-        PL_SetErrorString("XAudio2 failed to play buffer. Code(%d)", ecode);
-        return;
+        u64 n = PL_Min64(count, PL_RAND_CHUNK_U32);
+        pl_dispatch.randFill(lanes, (u8*)chunk, (n + PL_RAND_STEP_U32 - 1) / PL_RAND_STEP_U32);
+        pl_dispatch.randToRange(dst, chunk, n, range, &lanes->spare);
+        dst += n;
+        count -= n;
     }
 }
 
-PL_Audio* PL_GetAudio(void)
+void PL_SeedRand(ptr value, u64 valueSize)
 {
-    return &win32_state->audio;
+    // fold the bytes into a u64 8 at a time, so every byte of the seed counts
+    u64 seed = valueSize;
+    u8 *bytes = (u8*)value;
+    while(valueSize)
+    {
+        u64 chunk = 0;
+        u64 count = PL_Min64(valueSize, sizeof(chunk));
+        PL_MemCpy(bytes, &chunk, count);
+        seed ^= chunk;
+        seed = PL_SplitMix64(&seed);
+        bytes += count;
+        valueSize -= count;
+    }
+    
+    PL_RandSeed(&pl_randState, seed);
+    pl_randIsInit = 1;
+    pl_randLanesIsInit = 0; // re-split the default lanes from the new seed
 }
 
-ptr PL_GetAudioBuffer(void)
+/*=========== HASH MAP =================*/
+
+#define PL_MAP_EMPTY 0x80
+#define PL_MAP_DELETED 0xfe // full slots hold 7 hash bits (high bit clear)
+
+// group scans return a mask with a bit per matching slot, 1 << (slot << PL_MAP_MASK_SHIFT)
+// (define PL_MAP_SWAR to use the 8 byte word groups everywhere)
+#if defined(PL_ARCH_X86) && (defined(__x86_64__) || defined(_M_X64)) && !defined(PL_MAP_SWAR) // sse2 is baseline on x64
+#define PL_MAP_GROUP 16
+#define PL_MAP_MASK_SHIFT 0
+typedef u32 PL_MapMask;
+
+static inline PL_MapMask PL_MapMatch(const u8 *group, u8 h2)
 {
-    return (ptr)&win32_state->audio.buffer[0];
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)h2)));
 }
 
-static void Win32_AudioFrame(void)
+static inline PL_MapMask PL_MapMatchEmpty(const u8 *group)
 {
-    XAUDIO2_VOICE_STATE state;
-#if defined(__cplusplus)
-    win32_state->xaudio.srcVoice.GetState(&state, 0);
+    return PL_MapMatch(group, PL_MAP_EMPTY);
+}
+
+// empty or deleted, the only control bytes with the high bit set
+static inline PL_MapMask PL_MapMatchFree(const u8 *group)
+{
+    return (u32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+}
+
+#elif defined(PL_ARCH_ARM64) && !defined(PL_MAP_SWAR)
+#define PL_MAP_GROUP 16
+#define PL_MAP_MASK_SHIFT 2 // narrowing gives 4 bits per slot, keep one of them
+typedef u64 PL_MapMask;
+
+static inline PL_MapMask PL_MapMaskNEON(uint8x16_t eq)
+{
+    uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull;
+}
+
+static inline PL_MapMask PL_MapMatch(const u8 *group, u8 h2)
+{
+    return PL_MapMaskNEON(vceqq_u8(vld1q_u8(group), vdupq_n_u8(h2)));
+}
+
+static inline PL_MapMask PL_MapMatchEmpty(const u8 *group)
+{
+    return PL_MapMatch(group, PL_MAP_EMPTY);
+}
+
+static inline PL_MapMask PL_MapMatchFree(const u8 *group)
+{
+    return PL_MapMaskNEON(vtstq_u8(vld1q_u8(group), vdupq_n_u8(0x80)));
+}
+
 #else
-    IXAudio2SourceVoice_GetState(win32_state->xaudio.srcVoice, &state, 0);
+#define PL_MAP_GROUP 8
+#define PL_MAP_MASK_SHIFT 3 // high bit of each byte
+typedef u64 PL_MapMask;
+
+static inline PL_MapMask PL_MapMatch(const u8 *group, u8 h2)
+{
+    // zero byte test, can also flag a byte just above a real match (the key compare sorts it out)
+    u64 x = PL_Load64(group) ^ (0x0101010101010101ull * h2);
+    return (x - 0x0101010101010101ull) & ~x & 0x8080808080808080ull;
+}
+
+static inline PL_MapMask PL_MapMatchEmpty(const u8 *group)
+{
+    // high bit set and bit 1 clear is only PL_MAP_EMPTY
+    u64 x = PL_Load64(group);
+    return x & ~(x << 6) & 0x8080808080808080ull;
+}
+
+static inline PL_MapMask PL_MapMatchFree(const u8 *group)
+{
+    return PL_Load64(group) & 0x8080808080808080ull;
+}
 #endif
+
+#define PL_MapMaskSlot(mask) (PL_CTZ64(mask) >> PL_MAP_MASK_SHIFT)
+
+static u64 PL_MapHash(PL_Map *map, u64 key)
+{
+    if(map->keyType == MAPKEY_STR)
+    {
+        cstr str = (cstr)(uintptr_t)key;
+        return PL_Hash64(str, PL_StrLen(str), 0);
+    }
     
-    PL_GetAudio()->playCursor = state.SamplesPlayed % AUDIO_BUFFER_SIZE;
+    // murmur3 finaliser, every key bit reaches both the control bits and the slot index
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ull;
+    key ^= key >> 33;
+    return key;
 }
 
-/*========= WIN32 TIMER =============*/
+static inline b32 PL_MapKeyEqual(PL_Map *map, u64 a, u64 b)
+{
+    if(a == b) return 1;
+    if(map->keyType == MAPKEY_STR) return strcmp((const char*)(uintptr_t)a, (const char*)(uintptr_t)b) == 0;
+    return 0;
+}
 
-static void Win32_UpdateClock(void)
+static inline void PL_MapSetCtrl(PL_Map *map, u64 index, u8 ctrl)
 {
-    PL_Clock *clock = &win32_state->clock;
-    SYSTEMTIME st = {0};
-    GetLocalTime(&st);
-    clock->year = st.wYear;
-    clock->month = st.wMonth;
-    clock->day = st.wDay;
-    clock->wday = ((st.wDayOfWeek) ? st.wDayOfWeek : 7);
-    clock->hr = st.wHour;
-    clock->min = st.wMinute;
-    clock->sec = st.wSecond;
-    clock->ms = st.wMilliseconds;
+    map->ctrl[index] = ctrl;
+    if(index < PL_MAP_GROUP) map->ctrl[map->capacity + index] = ctrl;
 }
 
-static void Win32_InitTimer(void)
+// smallest power of 2 slot count (min 16) that holds entries under the 7/8 load limit
+static u64 PL_MapSlotCount(u64 entries)
 {
-    LARGE_INTEGER freqResult;
-    QueryPerformanceFrequency(&freqResult);
-    win32_state->timer.perfFreq = (u64)freqResult.QuadPart;
+    u64 slots = 16;
+    while(slots - slots / 8 < entries) slots *= 2;
+    return slots;
 }
 
-static u64 Win32_GetPerfCount(void)
+static u64 PL_MapBytes(u64 slots)
 {
-    LARGE_INTEGER perf;
-    QueryPerformanceCounter(&perf);
-    return (u64)perf.QuadPart;
+    return slots * sizeof(PL_MapSlot) + slots + PL_MAP_GROUP;
 }
 
-r64 Win32_GetPerfDiff(u64 start, u64 end)
+static void PL_MapSetMemory(PL_Map *map, u8 *memory, u64 slots)
 {
-    r64 result = (((r64)end - (r64)start) / (r64)win32_state->timer.perfFreq);
-    return result;
+    map->slots = (PL_MapSlot*)memory;
+    map->ctrl = memory + slots * sizeof(PL_MapSlot);
+    map->capacity = slots;
+    PL_MapClear(map);
 }
 
-r64 Win32_GetPerfElapsed(u64 prev)
+static b32 PL_MapAllocate(PL_Map *map, u64 slots)
 {
-    r64 result = Win32_GetPerfDiff(prev, Win32_GetPerfCount());
-    return result;
+    u64 size = PL_MapBytes(slots);
+    u8 *memory = map->arena ? (u8*)PL_ArenaPushAligned(map->arena, size, 16) : (u8*)PL_Alloc(size);
+    if(!memory) return 0;
+    
+    PL_MapSetMemory(map, memory, slots);
+    return 1;
 }
 
-static void Win32_UpdateTimer(void)
+// probe groups in triangular steps, which visits every group once for a power of 2 group count
+static PL_MapSlot *PL_MapFind(PL_Map *map, u64 key, u64 hash)
 {
-    Win32_UpdateClock();
+    if(!map->capacity) return 0;
+    
+    u64 mask = map->capacity - 1;
+    u8 h2 = (u8)(hash & 0x7f);
+    u64 pos = (hash >> 7) & mask;
     
-    if(!win32_state->window.window.vsync)
+    for(u64 step = PL_MAP_GROUP;; step += PL_MAP_GROUP)
     {
-        u64 perf = Win32_GetPerfCount();
-        r64 elapsedSec = Win32_GetPerfDiff(win32_state->timer.lastFramePerf, perf);
-        r64 targetSecPerFrame = (1.0/(r64)win32_state->window.window.framerate);
-        
-        while(elapsedSec <= targetSecPerFrame)
+        const u8 *group = map->ctrl + pos;
+        for(PL_MapMask match = PL_MapMatch(group, h2); match; match &= match - 1)
         {
-            perf = Win32_GetPerfCount();
-            elapsedSec = Win32_GetPerfDiff(win32_state->timer.lastFramePerf, perf);
+            u64 index = (pos + PL_MapMaskSlot(match)) & mask;
+            if(PL_MapKeyEqual(map, map->slots[index].key, key)) return &map->slots[index];
         }
+        
+        // the key would have gone in the first free slot, an empty one ends the search
+        if(PL_MapMatchEmpty(group)) return 0;
+        pos = (pos + step) & mask;
+    }
+}
+
+// first empty or deleted slot on the probe sequence (the load limit guarantees one)
+static u64 PL_MapFindFree(PL_Map *map, u64 hash)
+{
+    u64 mask = map->capacity - 1;
+    u64 pos = (hash >> 7) & mask;
+    
+    for(u64 step = PL_MAP_GROUP;; step += PL_MAP_GROUP)
+    {
+        PL_MapMask free = PL_MapMatchFree(map->ctrl + pos);
+        if(free) return (pos + PL_MapMaskSlot(free)) & mask;
+        pos = (pos + step) & mask;
     }
+}
+
+static b32 PL_MapRehash(PL_Map *map, u64 slots)
+{
+    PL_Map old = *map;
+    if(!PL_MapAllocate(map, slots)) return 0;
     
-    if(win32_state->timer.timer.tLastFrame)
+    for(u64 i = 0; i < old.capacity; i++)
     {
-        win32_state->timer.timer.tAvgFrame += win32_state->timer.timer.tLastFrame;
-        win32_state->timer.timer.tAvgFrame /= 2.0f;
+        if(old.ctrl[i] & 0x80) continue;
+        
+        u64 hash = PL_MapHash(map, old.slots[i].key);
+        u64 index = PL_MapFindFree(map, hash);
+        PL_MapSetCtrl(map, index, (u8)(hash & 0x7f));
+        map->slots[index] = old.slots[i];
     }
     
-    win32_state->timer.timer.tLastFrame = Win32_GetPerfElapsed(win32_state->timer.lastFramePerf);
-    win32_state->timer.lastFramePerf = Win32_GetPerfCount();
-    win32_state->timer.timer.frames++;
+    map->count = old.count;
+    map->growthLeft -= old.count;
+    if(!old.arena) PL_Free(old.slots);
+    return 1;
 }
 
-u64 PL_TimerStart(void)
+static b32 PL_MapPutKey(PL_Map *map, u64 key, u64 value)
 {
-    return Win32_GetPerfCount();
+    u64 hash = PL_MapHash(map, key);
+    PL_MapSlot *slot = PL_MapFind(map, key, hash);
+    if(slot)
+    {
+        slot->value = value;
+        return 1;
+    }
+    
+    // a zeroed PL_Map starts out as a PL_Alloc map
+    if(!map->capacity && (map->fixed || !PL_MapAllocate(map, 16))) return 0;
+    
+    u64 index = PL_MapFindFree(map, hash);
+    if(!map->growthLeft && map->ctrl[index] == PL_MAP_EMPTY)
+    {
+        if(map->fixed) return 0;
+        
+        // out of room because of tombstones: rehash at the same size to drop them, otherwise double
+        u64 limit = map->capacity - map->capacity / 8;
+        u64 slots = (map->count < limit / 2) ? map->capacity : map->capacity * 2;
+        if(!PL_MapRehash(map, slots)) return 0;
+        index = PL_MapFindFree(map, hash);
+    }
+    
+    map->growthLeft -= (map->ctrl[index] == PL_MAP_EMPTY);
+    PL_MapSetCtrl(map, index, (u8)(hash & 0x7f));
+    map->slots[index].key = key;
+    map->slots[index].value = value;
+    map->count++;
+    return 1;
 }
 
-r64 PL_TimerElapsed(u64 timerperf)
+static b32 PL_MapRemoveKey(PL_Map *map, u64 key)
+{
+    PL_MapSlot *slot = PL_MapFind(map, key, PL_MapHash(map, key));
+    if(!slot) return 0;
+    
+    // probes stop at any group window holding an empty slot, if no window covering this
+    // slot is completely full then no probe ever passed it and it can go back to empty
+    u64 mask = map->capacity - 1;
+    u64 index = (u64)(slot - map->slots);
+    u64 before = 0, after = 0;
+    while(before < PL_MAP_GROUP && map->ctrl[(index - before - 1) & mask] != PL_MAP_EMPTY) before++;
+    while(after < PL_MAP_GROUP && map->ctrl[(index + after + 1) & mask] != PL_MAP_EMPTY) after++;
+    
+    if(before + after + 1 < PL_MAP_GROUP)
+    {
+        PL_MapSetCtrl(map, index, PL_MAP_EMPTY);
+        map->growthLeft++;
+    }
+    else
+    {
+        PL_MapSetCtrl(map, index, PL_MAP_DELETED);
+    }
+    
+    map->count--;
+    return 1;
+}
+
+b32 PL_MapInit(PL_Map *map, PL_MAPKEY keyType, u64 capacity, PL_Arena *arena)
 {
-    return Win32_GetPerfElapsed(timerperf);
+    PL_MemZero(map, sizeof(*map));
+    map->keyType = keyType;
+    map->arena = arena;
+    return PL_MapAllocate(map, PL_MapSlotCount(capacity));
 }
 
-/*========== SystemInfo ===============*/
+u64 PL_MapMemorySize(u64 capacity)
+{
+    return PL_MapBytes(PL_MapSlotCount(capacity)) + sizeof(u64) - 1; // room to align the slots
+}
 
-static void Win32_SetSystemInfo(void)
+b32 PL_MapInitFixed(PL_Map *map, PL_MAPKEY keyType, ptr memory, u64 memorySize)
 {
-    SYSTEM_INFO si = {0};
-    GetNativeSystemInfo(&si);
+    PL_MemZero(map, sizeof(*map));
+    map->keyType = keyType;
+    map->fixed = 1;
     
-    switch(si.wProcessorArchitecture)
+    u8 *base = (u8*)(((uintptr_t)memory + sizeof(u64) - 1) & ~(uintptr_t)(sizeof(u64) - 1));
+    u64 padding = (u64)(base - (u8*)memory);
+    if(!memory || memorySize < padding + PL_MapBytes(16)) return 0;
+    memorySize -= padding;
+    
+    u64 slots = 16;
+    while(PL_MapBytes(slots * 2) <= memorySize) slots *= 2;
+    PL_MapSetMemory(map, base, slots);
+    return 1;
+}
+
+void PL_MapFree(PL_Map *map)
+{
+    if(!map->arena && !map->fixed && map->slots)
     {
-        case PROCESSOR_ARCHITECTURE_AMD64:
-        {
-            win32_state->system.cpu = CPU_AMD64;
-        } break;
-        
-        case PROCESSOR_ARCHITECTURE_ARM:
-        {
-            win32_state->system.cpu = CPU_ARM;
-        } break;
-        
-        case PROCESSOR_ARCHITECTURE_ARM64:
-        {
-            win32_state->system.cpu = CPU_ARM64;
-        } break;
-        
-        case PROCESSOR_ARCHITECTURE_IA64:
-        {
-            win32_state->system.cpu = CPU_IA64;
-        } break;
-        
-        case PROCESSOR_ARCHITECTURE_INTEL:
-        {
-            win32_state->system.cpu = CPU_I86;
-        } break;
+        PL_Free(map->slots);
+    }
+    
+    PL_MAPKEY keyType = map->keyType;
+    PL_MemZero(map, sizeof(*map));
+    map->keyType = keyType;
+}
+
+void PL_MapClear(PL_Map *map)
+{
+    if(!map->capacity) return;
+    
+    PL_MemSet(map->ctrl, PL_MAP_EMPTY, map->capacity + PL_MAP_GROUP);
+    map->count = 0;
+    map->growthLeft = map->capacity - map->capacity / 8;
+}
+
+b32 PL_MapPut(PL_Map *map, u64 key, u64 value)
+{
+    return (map->keyType == MAPKEY_INT) ? PL_MapPutKey(map, key, value) : 0;
+}
+
+b32 PL_MapPutStr(PL_Map *map, const char *key, u64 value)
+{
+    return (map->keyType == MAPKEY_STR && key) ? PL_MapPutKey(map, (u64)(uintptr_t)key, value) : 0;
+}
+
+u64 *PL_MapGet(PL_Map *map, u64 key)
+{
+    if(map->keyType != MAPKEY_INT) return 0;
+    PL_MapSlot *slot = PL_MapFind(map, key, PL_MapHash(map, key));
+    return slot ? &slot->value : 0;
+}
+
+u64 *PL_MapGetStr(PL_Map *map, const char *key)
+{
+    if(map->keyType != MAPKEY_STR || !key) return 0;
+    u64 k = (u64)(uintptr_t)key;
+    PL_MapSlot *slot = PL_MapFind(map, k, PL_MapHash(map, k));
+    return slot ? &slot->value : 0;
+}
+
+b32 PL_MapRemove(PL_Map *map, u64 key)
+{
+    return (map->keyType == MAPKEY_INT) ? PL_MapRemoveKey(map, key) : 0;
+}
+
+b32 PL_MapRemoveStr(PL_Map *map, const char *key)
+{
+    return (map->keyType == MAPKEY_STR && key) ? PL_MapRemoveKey(map, (u64)(uintptr_t)key) : 0;
+}
+
+b32 PL_MapNext(PL_Map *map, u64 *iterator, u64 *key, u64 *value)
+{
+    for(u64 i = *iterator; i < map->capacity; i++)
+    {
+        if(map->ctrl[i] & 0x80) continue;
         
-        default:
-        {
-            win32_state->system.cpu = CPU_UNKNOWN;
-        }
+        if(key) *key = map->slots[i].key;
+        if(value) *value = map->slots[i].value;
+        *iterator = i + 1;
+        return 1;
     }
     
-    win32_state->system.minAppAddress = (ptr)si.lpMinimumApplicationAddress;
-    win32_state->system.maxAppAddress = (ptr)si.lpMaximumApplicationAddress;
-    win32_state->system.cores = (u32)si.dwNumberOfProcessors;
+    *iterator = map->capacity;
+    return 0;
 }
 
-/*============== WNDPROC ============*/
+/*=========== FRAME STATS =================*/
 
-LRESULT CALLBACK Win32_WndProc(HWND window,
-                               UINT msg,
-                               WPARAM wParam,
-                               LPARAM lParam)
+#define PL_FRAMEHIST_BUCKETS 1000 // last bucket also catches everything >= 100ms
+#define PL_FRAMEHIST_BUCKET_SEC 0.0001
+#define PL_FRAMEHIST_BUDGET_SLACK 1.1
+
+typedef struct
 {
-    LRESULT result = 0;
+    u32 buckets[PL_FRAMEHIST_BUCKETS];
+    u64 frames;
+    u64 overBudget;
+    r64 tMax;
+} PL_FrameHistogram;
+
+static void PL_FrameHistogramAdd(PL_FrameHistogram *hist, r64 tFrame, r64 tBudget)
+{
+    u64 bucket = (u64)(tFrame / PL_FRAMEHIST_BUCKET_SEC);
+    if(bucket >= PL_FRAMEHIST_BUCKETS) bucket = PL_FRAMEHIST_BUCKETS - 1;
     
-    Win32_Window *win32_window = &win32_state->window;
-    PL_Window *pl_window = &win32_window->window;
-    PL_Input *input = &win32_state->input;
-    if(!win32_window->init)
-        return DefWindowProcA(window, msg, wParam, lParam);
+    hist->buckets[bucket]++;
+    hist->frames++;
+    if(tFrame > hist->tMax) hist->tMax = tFrame;
+    if(tBudget > 0.0 && tFrame > tBudget * PL_FRAMEHIST_BUDGET_SLACK) hist->overBudget++;
+}
+
+// upper edge of the bucket holding the p-th frame, never more than the actual max
+static r64 PL_FrameHistogramPercentile(PL_FrameHistogram *hist, r64 p)
+{
+    u64 rank = (u64)ceil(p * (r64)hist->frames);
+    u64 count = 0;
+    if(!rank) rank = 1;
     
-    switch(msg)
+    for(u32 bucket = 0; bucket < PL_FRAMEHIST_BUCKETS - 1; bucket++)
     {
-        case WM_QUIT:
-        case WM_CLOSE:
-        case WM_DESTROY:
+        count += hist->buckets[bucket];
+        if(count >= rank)
         {
-            win32_state->running = 0;
-        } break;
-        
-        case WM_ACTIVATEAPP:
+            r64 result = (r64)(bucket + 1) * PL_FRAMEHIST_BUCKET_SEC;
+            return (result < hist->tMax) ? result : hist->tMax;
+        }
+    }
+    
+    return hist->tMax;
+}
+
+static PL_FrameStats PL_FrameHistogramStats(PL_FrameHistogram *hist)
+{
+    PL_FrameStats result = {0};
+    
+    if(hist->frames)
+    {
+        result.frames = hist->frames;
+        result.overBudget = hist->overBudget;
+        result.p50 = PL_FrameHistogramPercentile(hist, 0.50);
+        result.p95 = PL_FrameHistogramPercentile(hist, 0.95);
+        result.p99 = PL_FrameHistogramPercentile(hist, 0.99);
+        result.max = hist->tMax;
+    }
+    
+    return result;
+}
+
+/*=========== TICKS =================*/
+
+static inline u64 PL_ReadTSC(void)
+{
+#if defined(PL_ARCH_X86)
+    return __rdtsc();
+#elif defined(PL_ARCH_ARM64) && !defined(PL_WINDOWS_MSVC)
+    u64 result;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(result));
+    return result;
+#else
+    return PL_GetTicks();
+#endif
+}
+
+#define PL_TICKS_CALIBRATE_SEC 0.01
+
+typedef struct
+{
+    b32 tsc; // ticks come from PL_ReadTSC, otherwise from the OS counter
+    u64 freq; // ticks per second
+    u64 nsMul; // ns = (ticks * nsMul) >> nsShift
+    u32 nsShift;
+    r64 secPerTick;
+} PL_Ticks;
+
+static PL_Ticks pl_ticks;
+
+// picks the tick source, the timestamp counter rate is measured against the OS counter (osFreq per second)
+static void PL_InitTicks(b32 invariantTSC, u64 (*osCount)(void), u64 osFreq)
+{
+    pl_ticks.tsc = 0;
+    pl_ticks.freq = osFreq;
+    
+    if(invariantTSC)
+    {
+#if defined(PL_ARCH_ARM64) && !defined(PL_WINDOWS_MSVC)
+        u64 freq;
+        __asm__ volatile("mrs %0, cntfrq_el0" : "=r"(freq));
+#else
+        // the counter is read right after the OS counter at both ends, so the read latencies cancel
+        u64 osStart = osCount();
+        u64 tscStart = PL_ReadTSC();
+        u64 osTarget = osStart + (u64)(PL_TICKS_CALIBRATE_SEC * (r64)osFreq);
+        u64 osEnd;
+        do { osEnd = osCount(); } while(osEnd < osTarget);
+        u64 tscEnd = PL_ReadTSC();
+        u64 freq = (u64)(((r64)(tscEnd - tscStart) * (r64)osFreq) / (r64)(osEnd - osStart) + 0.5);
+#endif
+        if(freq)
         {
-            if(wParam == TRUE) pl_window->focus = 1;
-            if(wParam == FALSE) pl_window->focus = 0;
-        } break;
-        
-        case WM_MOVE:
+            pl_ticks.tsc = 1;
+            pl_ticks.freq = freq;
+        }
+    }
+    
+    // widest multiplier that fits 63 bits, exact for the 1GHz / 10MHz OS counters
+    r64 nsPerTick = 1000000000.0 / (r64)pl_ticks.freq;
+    u32 shift = 63;
+    while(shift && ldexp(nsPerTick, (int)shift) >= 9223372036854775808.0) shift--;
+    pl_ticks.nsShift = shift;
+    pl_ticks.nsMul = (u64)ldexp(nsPerTick, (int)shift);
+    pl_ticks.secPerTick = 1.0 / (r64)pl_ticks.freq;
+}
+
+u64 PL_GetTickFrequency(void)
+{
+    return pl_ticks.freq;
+}
+
+u64 PL_TicksToNs(u64 ticks)
+{
+    u64 hi, lo;
+    PL_MulU64(ticks, pl_ticks.nsMul, &hi, &lo);
+    return pl_ticks.nsShift ? ((hi << (64 - pl_ticks.nsShift)) | (lo >> pl_ticks.nsShift)) : lo;
+}
+
+u64 PL_TimerStart(void)
+{
+    return PL_GetTicks();
+}
+
+r64 PL_TimerElapsed(u64 timerperf)
+{
+    return (r64)(PL_GetTicks() - timerperf) * pl_ticks.secPerTick;
+}
+
+#define PL_WALLCLOCK_REFRESH_SEC 1
+
+// unix ns = PL_TicksToNs(ticks) + offsetNs, the offset is re-read from the OS clock every
+// PL_WALLCLOCK_REFRESH_SEC to follow clock adjustments
+typedef struct
+{
+    u64 (*osUnixNs)(void);
+    u64 offsetNs; // wraps when the tick counter is ahead of unix time
+    u64 refreshTicks;
+} PL_WallClock;
+
+static PL_WallClock pl_wallClock;
+
+static void PL_InitWallClock(u64 (*osUnixNs)(void))
+{
+    pl_wallClock.osUnixNs = osUnixNs;
+    pl_wallClock.refreshTicks = 0;
+}
+
+// both fields are single words, a racing refresh only redoes the work
+static u64 PL_TicksToUnixNs(u64 ticks)
+{
+    if(ticks >= pl_wallClock.refreshTicks && pl_wallClock.osUnixNs)
+    {
+        u64 now = PL_GetTicks();
+        pl_wallClock.offsetNs = pl_wallClock.osUnixNs() - PL_TicksToNs(now);
+        pl_wallClock.refreshTicks = now + PL_WALLCLOCK_REFRESH_SEC * pl_ticks.freq;
+    }
+    
+    return PL_TicksToNs(ticks) + pl_wallClock.offsetNs;
+}
+
+u64 PL_GetUnixTimeNs(void)
+{
+    return PL_TicksToUnixNs(PL_GetTicks());
+}
+
+/*=========== FIXED TIMESTEP =================*/
+
+#define PL_FIXEDSTEP_MAX_FRAME_SEC 0.25
+
+typedef struct
+{
+    void (*update)(r64 dt);
+    r64 dt;
+    u64 dtTicks;
+    u64 accTicks; // elapsed time not simulated yet
+    u64 lastTicks; // frame start the accumulator is up to, 0 until the first frame
+} PL_FixedStep;
+
+static PL_FixedStep pl_fixedStep;
+
+void PL_SetFixedUpdate(void (*update)(r64 dt), r64 dt)
+{
+    PL_FixedStep *step = &pl_fixedStep;
+    // changing update/dt while on only drops the partial step, the next frame still
+    // accumulates its elapsed time. turning on again starts clean on the next frame
+    u64 lastTicks = (step->update) ? step->lastTicks : 0;
+    PL_MemZero(step, sizeof(PL_FixedStep));
+    
+    if(update && dt > 0.0)
+    {
+        step->update = update;
+        step->dt = dt;
+        step->dtTicks = (u64)(dt * (r64)PL_GetTickFrequency() + 0.5);
+        if(!step->dtTicks) step->dtTicks = 1;
+        step->lastTicks = lastTicks;
+    }
+}
+
+// called by the main loop before PL_Frame, frameTicks: PL_GetTicks at the start of the frame
+static void PL_FixedStepFrame(PL_Timer *timer, u64 frameTicks)
+{
+    PL_FixedStep *step = &pl_fixedStep;
+    timer->updates = 0;
+    timer->alpha = 0.0;
+    if(!step->update) return;
+    
+    if(step->lastTicks)
+    {
+        u64 maxTicks = (u64)(PL_FIXEDSTEP_MAX_FRAME_SEC * (r64)PL_GetTickFrequency());
+        step->accTicks += PL_Min64(frameTicks - step->lastTicks, maxTicks);
+    }
+    step->lastTicks = frameTicks;
+    
+    PL_PROFILE_BEGIN("PL_Update");
+    // update may turn the mode off or change dt
+    while(step->update && step->accTicks >= step->dtTicks)
+    {
+        step->accTicks -= step->dtTicks;
+        timer->updates++;
+        step->update(step->dt);
+    }
+    PL_PROFILE_END();
+    
+    if(step->update) timer->alpha = (r64)step->accTicks / (r64)step->dtTicks;
+}
+
+/*=========== PROFILER =================*/
+
+#if defined(PL_WINDOWS_MSVC)
+#include <intrin.h>
+#define PL_THREADLOCAL __declspec(thread)
+#define PL_AtomicInc32(p) ((u32)_InterlockedIncrement((long volatile*)(p)) - 1)
+#else
+#define PL_THREADLOCAL __thread
+#define PL_AtomicInc32(p) __atomic_fetch_add((p), 1, __ATOMIC_RELAXED)
+#endif
+
+#define PL_PROFILE_RING_EVENTS (1 << 16) // per thread, power of 2
+#define PL_PROFILE_MAX_THREADS 64
+#define PL_PROFILE_MAX_DEPTH 64
+
+// name 0: end of the innermost open block
+typedef struct
+{
+    u64 tsc;
+    const char *name;
+} PL_ProfileEvent;
+
+typedef struct
+{
+    u64 head; // total events written, ring index is head & (PL_PROFILE_RING_EVENTS-1)
+    u32 threadID;
+    PL_ProfileEvent events[PL_PROFILE_RING_EVENTS];
+} PL_ProfileRing;
+
+static const char PL_PROFILE_FRAME_MARKER[] = "frame";
+
+static PL_THREADLOCAL PL_ProfileRing *pl_profileRing;
+static PL_ProfileRing *pl_profileRings[PL_PROFILE_MAX_THREADS];
+static u32 pl_profileRingCount;
+static u64 pl_profileStartTSC;
+static u64 pl_profileStartPerf;
+
+static PL_ProfileRing *PL_ProfileGetRing(void)
+{
+    if(!pl_profileRing)
+    {
+        if(!pl_profileStartTSC)
         {
-            pl_window->dim.x = (int)(short)LOWORD(lParam);
-            pl_window->dim.y = (int)(short)HIWORD(lParam);
-        } break;
-        
-        case WM_SIZE:
+            pl_profileStartPerf = PL_TimerStart();
+            pl_profileStartTSC = PL_ReadTSC();
+        }
+
+        u32 index = PL_AtomicInc32(&pl_profileRingCount);
+        if(index >= PL_PROFILE_MAX_THREADS) return 0;
+
+        PL_ProfileRing *ring = (PL_ProfileRing*)PL_Alloc0(sizeof(PL_ProfileRing));
+        if(!ring) return 0;
+        ring->threadID = index + 1;
+        pl_profileRings[index] = ring;
+        pl_profileRing = ring;
+    }
+
+    return pl_profileRing;
+}
+
+static inline void PL_ProfilePush(const char *name)
+{
+    PL_ProfileRing *ring = pl_profileRing ? pl_profileRing : PL_ProfileGetRing();
+    if(!ring) return;
+
+    PL_ProfileEvent *event = &ring->events[ring->head & (PL_PROFILE_RING_EVENTS-1)];
+    event->name = name;
+    event->tsc = PL_ReadTSC();
+    ring->head++;
+}
+
+void PL_ProfileBegin(const char *name)
+{
+    PL_ProfilePush(name);
+}
+
+void PL_ProfileEnd(void)
+{
+    PL_ProfilePush(0);
+}
+
+void PL_ProfileFrame(void)
+{
+    PL_ProfilePush(PL_PROFILE_FRAME_MARKER);
+}
+
+// timestamp counter rate, calibrated at startup or measured against the OS timer over the whole run so far
+static r64 PL_ProfileTicksPerSec(void)
+{
+    if(pl_ticks.tsc) return (r64)pl_ticks.freq;
+    
+    r64 elapsed = PL_TimerElapsed(pl_profileStartPerf);
+    u64 ticks = PL_ReadTSC() - pl_profileStartTSC;
+    return (elapsed > 0.0 && ticks) ? ((r64)ticks / elapsed) : 1.0;
+}
+
+u32 PL_ProfileGetFrameTree(PL_ProfileNode *nodes, u32 maxNodes)
+{
+    PL_ProfileRing *ring = pl_profileRing;
+    if(!ring || !nodes || !maxNodes) return 0;
+
+    // find the last two frame markers still in the ring
+    u64 oldest = (ring->head > PL_PROFILE_RING_EVENTS) ? (ring->head - PL_PROFILE_RING_EVENTS) : 0;
+    u64 frameEnd = 0;
+    u64 frameStart = 0;
+    b32 foundEnd = 0;
+    b32 foundStart = 0;
+    for(u64 i = ring->head; i > oldest; i--)
+    {
+        if(ring->events[(i-1) & (PL_PROFILE_RING_EVENTS-1)].name != PL_PROFILE_FRAME_MARKER) continue;
+        if(!foundEnd)
         {
-            pl_window->dim.w = (int)LOWORD(lParam);
-            pl_window->dim.h = (int)HIWORD(lParam);
-            glViewport(0, 0, LOWORD(lParam), HIWORD(lParam));
-        } break;
-        
-        case WM_KEYDOWN:
-        case WM_SYSKEYDOWN:
+            frameEnd = i-1;
+            foundEnd = 1;
+        }
+        else
         {
-            if((lParam & (1 << 29))) //an ALT key
+            frameStart = i-1;
+            foundStart = 1;
+            break;
+        }
+    }
+    if(!foundStart) return 0;
+
+    r64 secPerTick = 1.0 / PL_ProfileTicksPerSec();
+    u32 stack[PL_PROFILE_MAX_DEPTH];
+    u64 stackTSC[PL_PROFILE_MAX_DEPTH];
+    u32 depth = 0;
+    u32 count = 0;
+
+    for(u64 i = frameStart + 1; i < frameEnd; i++)
+    {
+        PL_ProfileEvent *event = &ring->events[i & (PL_PROFILE_RING_EVENTS-1)];
+
+        if(event->name)
+        {
+            if(depth == PL_PROFILE_MAX_DEPTH) return count;
+
+            u32 parent = depth ? stack[depth-1] : 0;
+            u32 node = count;
+            for(u32 n = 0; n < count; n++)
             {
-                if(lParam & (1 << 24)) //right ALT key
-                {
-                    win32_state->input.keyboard[K_RALT].isDown = 1;
-                }
-                
-                else // left ALT key
+                if(nodes[n].depth == depth &&
+                   (!depth || nodes[n].parent == parent) &&
+                   (nodes[n].name == event->name || !strcmp(nodes[n].name, event->name)))
                 {
-                    win32_state->input.keyboard[K_LALT].isDown = 1;
+                    node = n;
+                    break;
                 }
-                
-            }
-            
-            PL_KEYCODE key = Win32_WinKeyToPLKeycode((u32)wParam, lParam);
-            win32_state->input.keyboard[key].isDown = 1;
-            
-        } break;
-        
-        case WM_KEYUP:
-        case WM_SYSKEYUP:
-        {
-            //TODO: fix this. currently, if holding ALT, when another keyup
-            // happens, the game will treat this as ALT key up followed by
-            // another ALT keydown next frame, rather than ALT staying down.
-            if(input->keyboard[K_RALT].isDown)
-            {
-                input->keyboard[K_RALT].isDown = 0;
             }
-            
-            if(input->keyboard[K_LALT].isDown)
+
+            if(node == count)
             {
-                input->keyboard[K_LALT].isDown = 0;
+                if(count == maxNodes) return count;
+                PL_MemZero(&nodes[node], sizeof(PL_ProfileNode));
+                nodes[node].name = event->name;
+                nodes[node].parent = depth ? parent : node;
+                nodes[node].depth = depth;
+                count++;
             }
-            
-            PL_KEYCODE key = Win32_WinKeyToPLKeycode((u32)wParam, lParam);
-            input->keyboard[key].isDown = 0;
-        } break;
-        
-        case WM_MOUSEMOVE:
-        {
-            POINT cursor = {0};
-            GetCursorPos(&cursor);
-            ScreenToClient(win32_window->handle, &cursor);
-            input->mouse.px = cursor.x;
-            input->mouse.py = cursor.y;
-            input->mouse.rx = (PL_norm32((r32)cursor.x, 0.0f, (r32)pl_window->dim.w) * 2.0f) - 1.0f;
-            input->mouse.ry = (PL_norm32((r32)cursor.y, 0.0f, (r32)pl_window->dim.h) * 2.0f) - 1.0f;
-        } break;
-        
-        case WM_LBUTTONDOWN:
-        {
-            input->mouse.buttons[MB_LEFT].isDown = 1;
-        } break;
-        
-        case WM_MBUTTONDOWN:
-        {
-            input->mouse.buttons[MB_MIDDLE].isDown = 1;
-        } break;
-        
-        case WM_RBUTTONDOWN:
+
+            nodes[node].calls++;
+            stack[depth] = node;
+            stackTSC[depth] = event->tsc;
+            depth++;
+        }
+        else if(depth) // ends of blocks opened before this frame are skipped
         {
-            input->mouse.buttons[MB_RIGHT].isDown = 1;
-        } break;
-        
-        case WM_XBUTTONDOWN:
+            depth--;
+            r64 elapsed = (r64)(event->tsc - stackTSC[depth]) * secPerTick;
+            u32 node = stack[depth];
+            nodes[node].tInclusive += elapsed;
+            nodes[node].tExclusive += elapsed;
+            if(depth) nodes[nodes[node].parent].tExclusive -= elapsed;
+        }
+    }
+
+    return count;
+}
+
+static void PL_ProfileWriteName(FILE *file, const char *name)
+{
+    for(const char *c = name; *c; c++)
+    {
+        if(*c == '"' || *c == '\\') fputc('\\', file);
+        if((u8)*c >= 0x20) fputc(*c, file);
+    }
+}
+
+b32 PL_ProfileDump(const cstr path)
+{
+    FILE *file = 0;
+#if defined(PL_WINDOWS_MSVC)
+    if(fopen_s(&file, path, "wb")) file = 0;
+#else
+    file = fopen(path, "wb");
+#endif
+    if(!file) return 0;
+
+    r64 usPerTick = 1000000.0 / PL_ProfileTicksPerSec();
+    b32 first = 1;
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+
+    u32 ringCount = (pl_profileRingCount < PL_PROFILE_MAX_THREADS) ? pl_profileRingCount : PL_PROFILE_MAX_THREADS;
+    for(u32 r = 0; r < ringCount; r++)
+    {
+        PL_ProfileRing *ring = pl_profileRings[r];
+        if(!ring) continue;
+
+        // snapshot head, a live thread keeps writing while this runs
+        u64 head = ring->head;
+        u64 oldest = (head > PL_PROFILE_RING_EVENTS) ? (head - PL_PROFILE_RING_EVENTS) : 0;
+        u32 depth = 0;
+
+        for(u64 i = oldest; i < head; i++)
         {
-            if(wParam & MK_XBUTTON1)
+            PL_ProfileEvent *event = &ring->events[i & (PL_PROFILE_RING_EVENTS-1)];
+            r64 ts = (r64)(i64)(event->tsc - pl_profileStartTSC) * usPerTick;
+
+            if(!event->name)
             {
-                input->mouse.buttons[MB_X1].isDown = 1;
+                if(!depth) continue; // begin already overwritten
+                depth--;
+                fprintf(file, "%s{\"ph\":\"E\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                        first ? "" : ",\n", ring->threadID, ts);
             }
-            
-            if(wParam & MK_XBUTTON2)
+            else if(event->name == PL_PROFILE_FRAME_MARKER)
             {
-                input->mouse.buttons[MB_X2].isDown = 1;
+                fprintf(file, "%s{\"name\":\"frame\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                        first ? "" : ",\n", ring->threadID, ts);
             }
-            
-        } break;
-        
-        case WM_LBUTTONUP:
-        {
-            input->mouse.buttons[MB_LEFT].isDown = 0;
-        } break;
-        
-        case WM_MBUTTONUP:
+            else
+            {
+                depth++;
+                fprintf(file, "%s{\"name\":\"", first ? "" : ",\n");
+                PL_ProfileWriteName(file, event->name);
+                fprintf(file, "\",\"ph\":\"B\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}", ring->threadID, ts);
+            }
+            first = 0;
+        }
+    }
+
+    fputs("\n]}\n", file);
+    b32 result = !ferror(file);
+    fclose(file);
+    return result;
+}
+
+/*======== OpenGL Helpers ==============*/
+
+r32 PL_GetGLVersion(void)
+{
+    return ((r32)PL_OPENGL_MAJ + ((r32)PL_OPENGL_MIN/10.0f));
+}
+
+u32 PL_GLCreateProgram(cstr vertexShaderSrc, cstr fragmentShaderSrc)
+{
+    u32 vertexShaderID = glCreateShader(GL_VERTEX_SHADER);
+    u32 fragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
+    u32 result = 0;
+    
+    { // VertexShader compilation
+        glShaderSource(vertexShaderID, 1, (const GLchar *const *)&vertexShaderSrc, 0);
+        glCompileShader(vertexShaderID);
+        i32 success;
+        char infoLog[512] = {0};
+        glGetShaderiv(vertexShaderID, GL_COMPILE_STATUS, &success);
+        if(!success)
+        {
+            glGetShaderInfoLog(vertexShaderID, 512, 0, infoLog);
+            PL_SetErrorString("GLCreateProgram error: VertexShader failed to compile: %s", infoLog);
+            return 0;
+        }
+    }
+    
+    { // FragmentShader compilation
+        glShaderSource(fragmentShaderID, 1, (const GLchar *const *)&fragmentShaderSrc, 0);
+        glCompileShader(fragmentShaderID);
+        i32 success;
+        char infoLog[512] = {0};
+        glGetShaderiv(fragmentShaderID, GL_COMPILE_STATUS, &success);
+        if(!success)
+        {
+            glGetShaderInfoLog(fragmentShaderID, 512, 0, infoLog);
+            PL_SetErrorString("GLCreateProgram error: FragmentShader failed to compile: %s", infoLog);
+            return 0;
+        }
+    }
+    
+    result = glCreateProgram();
+    glAttachShader(result, vertexShaderID);
+    glAttachShader(result, fragmentShaderID);
+    glLinkProgram(result);
+    { // program compilation
+        i32 success;
+        char infoLog[512] = {0};
+        glGetProgramiv(result, GL_LINK_STATUS, &success);
+        if(!success)
+        {
+            glGetProgramInfoLog(result, 512, 0, infoLog);
+            PL_SetErrorString("GLCreateProgram error: Program failed to compile: %s", infoLog);
+        }
+    }
+    
+    glDeleteShader(vertexShaderID);
+    glDeleteShader(fragmentShaderID);
+    
+    return result;
+}
+
+#if !defined(PL_LINUX) || defined(PL_LINUX_X11)
+// each platform resolves GL function names (needs a current context)
+static ptr PL_GLGetProcAddress(const char *name);
+
+#define PL_LOAD_GLFN(name) name = (pfn_##name)PL_GLGetProcAddress( #name ); if(!name) {return 0;}
+static b32 PL_LoadOpenGL(r32 version)
+{
+    if(version >= 1.0)
+    {
+        PL_LOAD_GLFN(glCullFace);
+        PL_LOAD_GLFN(glFrontFace);
+        PL_LOAD_GLFN(glHint);
+        PL_LOAD_GLFN(glLineWidth);
+        PL_LOAD_GLFN(glPointSize);
+        PL_LOAD_GLFN(glPolygonMode);
+        PL_LOAD_GLFN(glScissor);
+        PL_LOAD_GLFN(glTexParameterf);
+        PL_LOAD_GLFN(glTexParameterfv);
+        PL_LOAD_GLFN(glTexParameteri);
+        PL_LOAD_GLFN(glTexParameteriv);
+        PL_LOAD_GLFN(glTexImage1D);
+        PL_LOAD_GLFN(glTexImage2D);
+        PL_LOAD_GLFN(glDrawBuffer);
+        PL_LOAD_GLFN(glClear);
+        PL_LOAD_GLFN(glClearColor);
+        PL_LOAD_GLFN(glClearStencil);
+        PL_LOAD_GLFN(glClearDepth);
+        PL_LOAD_GLFN(glStencilMask);
+        PL_LOAD_GLFN(glColorMask);
+        PL_LOAD_GLFN(glDepthMask);
+        PL_LOAD_GLFN(glDisable);
+        PL_LOAD_GLFN(glEnable);
+        PL_LOAD_GLFN(glFinish);
+        PL_LOAD_GLFN(glFlush);
+        PL_LOAD_GLFN(glBlendFunc);
+        PL_LOAD_GLFN(glLogicOp);
+        PL_LOAD_GLFN(glStencilFunc);
+        PL_LOAD_GLFN(glStencilOp);
+        PL_LOAD_GLFN(glDepthFunc);
+        PL_LOAD_GLFN(glPixelStoref);
+        PL_LOAD_GLFN(glPixelStorei);
+        PL_LOAD_GLFN(glReadBuffer);
+        PL_LOAD_GLFN(glReadPixels);
+        PL_LOAD_GLFN(glGetBooleanv);
+        PL_LOAD_GLFN(glGetDoublev);
+        PL_LOAD_GLFN(glGetError);
+        PL_LOAD_GLFN(glGetFloatv);
+        PL_LOAD_GLFN(glGetIntegerv);
+        PL_LOAD_GLFN(glGetString);
+        PL_LOAD_GLFN(glGetTexImage);
+        PL_LOAD_GLFN(glGetTexParameterfv);
+        PL_LOAD_GLFN(glGetTexParameteriv);
+        PL_LOAD_GLFN(glGetTexLevelParameterfv);
+        PL_LOAD_GLFN(glGetTexLevelParameteriv);
+        PL_LOAD_GLFN(glIsEnabled);
+        PL_LOAD_GLFN(glDepthRange);
+        PL_LOAD_GLFN(glViewport);
+    }
+    
+    if(version >= 1.1)
+    {
+        PL_LOAD_GLFN(glDrawArrays);
+        PL_LOAD_GLFN(glDrawElements);
+        PL_LOAD_GLFN(glPolygonOffset);
+        PL_LOAD_GLFN(glCopyTexImage1D);
+        PL_LOAD_GLFN(glCopyTexImage2D);
+        PL_LOAD_GLFN(glCopyTexSubImage1D);
+        PL_LOAD_GLFN(glCopyTexSubImage2D);
+        PL_LOAD_GLFN(glTexSubImage1D);
+        PL_LOAD_GLFN(glTexSubImage2D);
+        PL_LOAD_GLFN(glBindTexture);
+        PL_LOAD_GLFN(glDeleteTextures);
+        PL_LOAD_GLFN(glGenTextures);
+        PL_LOAD_GLFN(glIsTexture);
+    }
+    
+    if(version >= 1.2)
+    {
+        PL_LOAD_GLFN(glDrawRangeElements);
+        PL_LOAD_GLFN(glTexImage3D);
+        PL_LOAD_GLFN(glTexSubImage3D);
+        PL_LOAD_GLFN(glCopyTexSubImage3D);
+    }
+    
+    if(version >= 1.3)
+    {
+        PL_LOAD_GLFN(glActiveTexture);
+        PL_LOAD_GLFN(glSampleCoverage);
+        PL_LOAD_GLFN(glCompressedTexImage3D);
+        PL_LOAD_GLFN(glCompressedTexImage2D);
+        PL_LOAD_GLFN(glCompressedTexImage1D);
+        PL_LOAD_GLFN(glCompressedTexSubImage3D);
+        PL_LOAD_GLFN(glCompressedTexSubImage2D);
+        PL_LOAD_GLFN(glCompressedTexSubImage1D);
+        PL_LOAD_GLFN(glGetCompressedTexImage);
+    }
+    
+    if(version >= 1.4)
+    {
+        PL_LOAD_GLFN(glBlendFuncSeparate);
+        PL_LOAD_GLFN(glMultiDrawArrays);
+        PL_LOAD_GLFN(glMultiDrawElements);
+        PL_LOAD_GLFN(glPointParameterf);
+        PL_LOAD_GLFN(glPointParameterfv);
+        PL_LOAD_GLFN(glPointParameteri);
+        PL_LOAD_GLFN(glPointParameteriv);
+        PL_LOAD_GLFN(glBlendColor);
+        PL_LOAD_GLFN(glBlendEquation);
+    }
+    
+    if(version >= 1.5)
+    {
+        PL_LOAD_GLFN(glGenQueries);
+        PL_LOAD_GLFN(glDeleteQueries);
+        PL_LOAD_GLFN(glIsQuery);
+        PL_LOAD_GLFN(glBeginQuery);
+        PL_LOAD_GLFN(glEndQuery);
+        PL_LOAD_GLFN(glGetQueryiv);
+        PL_LOAD_GLFN(glGetQueryObjectiv);
+        PL_LOAD_GLFN(glGetQueryObjectuiv);
+        PL_LOAD_GLFN(glBindBuffer);
+        PL_LOAD_GLFN(glDeleteBuffers);
+        PL_LOAD_GLFN(glGenBuffers);
+        PL_LOAD_GLFN(glIsBuffer);
+        PL_LOAD_GLFN(glBufferData);
+        PL_LOAD_GLFN(glBufferSubData);
+        PL_LOAD_GLFN(glGetBufferSubData);
+        PL_LOAD_GLFN(glMapBuffer);
+        PL_LOAD_GLFN(glUnmapBuffer);
+        PL_LOAD_GLFN(glGetBufferParameteriv);
+        PL_LOAD_GLFN(glGetBufferPointerv);
+    }
+    
+    if(version >= 2.0)
+    {
+        PL_LOAD_GLFN(glBlendEquationSeparate);
+        PL_LOAD_GLFN(glDrawBuffers);
+        PL_LOAD_GLFN(glStencilOpSeparate);
+        PL_LOAD_GLFN(glStencilFuncSeparate);
+        PL_LOAD_GLFN(glStencilMaskSeparate);
+        PL_LOAD_GLFN(glAttachShader);
+        PL_LOAD_GLFN(glBindAttribLocation);
+        PL_LOAD_GLFN(glCompileShader);
+        PL_LOAD_GLFN(glCreateProgram);
+        PL_LOAD_GLFN(glCreateShader);
+        PL_LOAD_GLFN(glDeleteProgram);
+        PL_LOAD_GLFN(glDeleteShader);
+        PL_LOAD_GLFN(glDetachShader);
+        PL_LOAD_GLFN(glDisableVertexAttribArray);
+        PL_LOAD_GLFN(glEnableVertexAttribArray);
+        PL_LOAD_GLFN(glGetActiveAttrib);
+        PL_LOAD_GLFN(glGetActiveUniform);
+        PL_LOAD_GLFN(glGetAttachedShaders);
+        PL_LOAD_GLFN(glGetAttribLocation);
+        PL_LOAD_GLFN(glGetProgramiv);
+        PL_LOAD_GLFN(glGetProgramInfoLog);
+        PL_LOAD_GLFN(glGetShaderiv);
+        PL_LOAD_GLFN(glGetShaderInfoLog);
+        PL_LOAD_GLFN(glGetShaderSource);
+        PL_LOAD_GLFN(glGetUniformLocation);
+        PL_LOAD_GLFN(glGetUniformfv);
+        PL_LOAD_GLFN(glGetUniformiv);
+        PL_LOAD_GLFN(glGetVertexAttribdv);
+        PL_LOAD_GLFN(glGetVertexAttribfv);
+        PL_LOAD_GLFN(glGetVertexAttribiv);
+        PL_LOAD_GLFN(glGetVertexAttribPointerv);
+        PL_LOAD_GLFN(glIsProgram);
+        PL_LOAD_GLFN(glIsShader);
+        PL_LOAD_GLFN(glLinkProgram);
+        PL_LOAD_GLFN(glShaderSource);
+        PL_LOAD_GLFN(glUseProgram);
+        PL_LOAD_GLFN(glUniform1f);
+        PL_LOAD_GLFN(glUniform2f);
+        PL_LOAD_GLFN(glUniform3f);
+        PL_LOAD_GLFN(glUniform4f);
+        PL_LOAD_GLFN(glUniform1i);
+        PL_LOAD_GLFN(glUniform2i);
+        PL_LOAD_GLFN(glUniform3i);
+        PL_LOAD_GLFN(glUniform4i);
+        PL_LOAD_GLFN(glUniform1fv);
+        PL_LOAD_GLFN(glUniform2fv);
+        PL_LOAD_GLFN(glUniform3fv);
+        PL_LOAD_GLFN(glUniform4fv);
+        PL_LOAD_GLFN(glUniform1iv);
+        PL_LOAD_GLFN(glUniform2iv);
+        PL_LOAD_GLFN(glUniform3iv);
+        PL_LOAD_GLFN(glUniform4iv);
+        PL_LOAD_GLFN(glUniformMatrix2fv);
+        PL_LOAD_GLFN(glUniformMatrix3fv);
+        PL_LOAD_GLFN(glUniformMatrix4fv);
+        PL_LOAD_GLFN(glValidateProgram);
+        PL_LOAD_GLFN(glVertexAttrib1d);
+        PL_LOAD_GLFN(glVertexAttrib1dv);
+        PL_LOAD_GLFN(glVertexAttrib1f);
+        PL_LOAD_GLFN(glVertexAttrib1s);
+        PL_LOAD_GLFN(glVertexAttrib1sv);
+        PL_LOAD_GLFN(glVertexAttrib2d);
+        PL_LOAD_GLFN(glVertexAttrib2dv);
+        PL_LOAD_GLFN(glVertexAttrib2f);
+        PL_LOAD_GLFN(glVertexAttrib2fv);
+        PL_LOAD_GLFN(glVertexAttrib2s);
+        PL_LOAD_GLFN(glVertexAttrib2sv);
+        PL_LOAD_GLFN(glVertexAttrib3d);
+        PL_LOAD_GLFN(glVertexAttrib3dv);
+        PL_LOAD_GLFN(glVertexAttrib3f);
+        PL_LOAD_GLFN(glVertexAttrib3fv);
+        PL_LOAD_GLFN(glVertexAttrib3s);
+        PL_LOAD_GLFN(glVertexAttrib3sv);
+        PL_LOAD_GLFN(glVertexAttrib4Nbv);
+        PL_LOAD_GLFN(glVertexAttrib4Niv);
+        PL_LOAD_GLFN(glVertexAttrib4Nsv);
+        PL_LOAD_GLFN(glVertexAttrib4Nub);
+        PL_LOAD_GLFN(glVertexAttrib4Nubv);
+        PL_LOAD_GLFN(glVertexAttrib4Nuiv);
+        PL_LOAD_GLFN(glVertexAttrib4Nusv);
+        PL_LOAD_GLFN(glVertexAttrib4bv);
+        PL_LOAD_GLFN(glVertexAttrib4d);
+        PL_LOAD_GLFN(glVertexAttrib4dv);
+        PL_LOAD_GLFN(glVertexAttrib4f);
+        PL_LOAD_GLFN(glVertexAttrib4fv);
+        PL_LOAD_GLFN(glVertexAttrib4iv);
+        PL_LOAD_GLFN(glVertexAttrib4s);
+        PL_LOAD_GLFN(glVertexAttrib4sv);
+        PL_LOAD_GLFN(glVertexAttrib4ubv);
+        PL_LOAD_GLFN(glVertexAttrib4uiv);
+        PL_LOAD_GLFN(glVertexAttrib4usv);
+        PL_LOAD_GLFN(glVertexAttribPointer);
+    }
+    
+    if(version >= 2.1)
+    {
+        PL_LOAD_GLFN(glUniformMatrix2x3fv);
+        PL_LOAD_GLFN(glUniformMatrix3x2fv);
+        PL_LOAD_GLFN(glUniformMatrix2x4fv);
+        PL_LOAD_GLFN(glUniformMatrix4x2fv);
+        PL_LOAD_GLFN(glUniformMatrix3x4fv);
+        PL_LOAD_GLFN(glUniformMatrix4x3fv);
+    }
+    
+    if(version >= 3.0)
+    {
+        PL_LOAD_GLFN(glColorMaski);
+        PL_LOAD_GLFN(glGetBooleani_v);
+        PL_LOAD_GLFN(glGetIntegeri_v);
+        PL_LOAD_GLFN(glEnablei);
+        PL_LOAD_GLFN(glDisablei);
+        PL_LOAD_GLFN(glIsEnabledi);
+        PL_LOAD_GLFN(glBeginTransformFeedback);
+        PL_LOAD_GLFN(glEndTransformFeedback);
+        PL_LOAD_GLFN(glBindBufferRange);
+        PL_LOAD_GLFN(glBindBufferBase);
+        PL_LOAD_GLFN(glTransformFeedbackVaryings);
+        PL_LOAD_GLFN(glGetTransformFeedbackVarying);
+        PL_LOAD_GLFN(glClampColor);
+        PL_LOAD_GLFN(glBeginConditionalRender);
+        PL_LOAD_GLFN(glEndConditionalRender);
+        PL_LOAD_GLFN(glVertexAttribIPointer);
+        PL_LOAD_GLFN(glGetVertexAttribIiv);
+        PL_LOAD_GLFN(glGetVertexAttribIuiv);
+        PL_LOAD_GLFN(glVertexAttribI1i);
+        PL_LOAD_GLFN(glVertexAttribI2i);
+        PL_LOAD_GLFN(glVertexAttribI3i);
+        PL_LOAD_GLFN(glVertexAttribI4i);
+        PL_LOAD_GLFN(glVertexAttribI1ui);
+        PL_LOAD_GLFN(glVertexAttribI2ui);
+        PL_LOAD_GLFN(glVertexAttribI3ui);
+        PL_LOAD_GLFN(glVertexAttribI4ui);
+        PL_LOAD_GLFN(glVertexAttribI1iv);
+        PL_LOAD_GLFN(glVertexAttribI2iv);
+        PL_LOAD_GLFN(glVertexAttribI3iv);
+        PL_LOAD_GLFN(glVertexAttribI4iv);
+        PL_LOAD_GLFN(glVertexAttribI1uiv);
+        PL_LOAD_GLFN(glVertexAttribI2uiv);
+        PL_LOAD_GLFN(glVertexAttribI3uiv);
+        PL_LOAD_GLFN(glVertexAttribI4uiv);
+        PL_LOAD_GLFN(glVertexAttribI4bv);
+        PL_LOAD_GLFN(glVertexAttribI4sv);
+        PL_LOAD_GLFN(glVertexAttribI4ubv);
+        PL_LOAD_GLFN(glVertexAttribI4usv);
+        PL_LOAD_GLFN(glGetUniformuiv);
+        PL_LOAD_GLFN(glBindFragDataLocation);
+        PL_LOAD_GLFN(glGetFragDataLocation);
+        PL_LOAD_GLFN(glUniform1ui);
+        PL_LOAD_GLFN(glUniform2ui);
+        PL_LOAD_GLFN(glUniform3ui);
+        PL_LOAD_GLFN(glUniform4ui);
+        PL_LOAD_GLFN(glUniform1uiv);
+        PL_LOAD_GLFN(glUniform2uiv);
+        PL_LOAD_GLFN(glUniform3uiv);
+        PL_LOAD_GLFN(glUniform4uiv);
+        PL_LOAD_GLFN(glTexParameterIiv);
+        PL_LOAD_GLFN(glTexParameterIuiv);
+        PL_LOAD_GLFN(glGetTexParameterIiv);
+        PL_LOAD_GLFN(glGetTexParameterIuiv);
+        PL_LOAD_GLFN(glClearBufferiv);
+        PL_LOAD_GLFN(glClearBufferuiv);
+        PL_LOAD_GLFN(glClearBufferfv);
+        PL_LOAD_GLFN(glClearBufferfi);
+        PL_LOAD_GLFN(glGetStringi);
+        PL_LOAD_GLFN(glIsRenderbuffer);
+        PL_LOAD_GLFN(glBindRenderbuffer);
+        PL_LOAD_GLFN(glDeleteRenderbuffers);
+        PL_LOAD_GLFN(glGenRenderbuffers);
+        PL_LOAD_GLFN(glRenderbufferStorage);
+        PL_LOAD_GLFN(glGetRenderbufferParameteriv);
+        PL_LOAD_GLFN(glIsFramebuffer);
+        PL_LOAD_GLFN(glBindFramebuffer);
+        PL_LOAD_GLFN(glDeleteFramebuffers);
+        PL_LOAD_GLFN(glGenFramebuffers);
+        PL_LOAD_GLFN(glCheckFramebufferStatus);
+        PL_LOAD_GLFN(glFramebufferTexture1D);
+        PL_LOAD_GLFN(glFramebufferTexture2D);
+        PL_LOAD_GLFN(glFramebufferTexture3D);
+        PL_LOAD_GLFN(glFramebufferRenderbuffer);
+        PL_LOAD_GLFN(glGetFramebufferAttachmentParameteriv);
+        PL_LOAD_GLFN(glGenerateMipmap);
+        PL_LOAD_GLFN(glBlitFramebuffer);
+        PL_LOAD_GLFN(glRenderbufferStorageMultisample);
+        PL_LOAD_GLFN(glFramebufferTextureLayer);
+        PL_LOAD_GLFN(glMapBufferRange);
+        PL_LOAD_GLFN(glFlushMappedBufferRange);
+        PL_LOAD_GLFN(glBindVertexArray);
+        PL_LOAD_GLFN(glDeleteVertexArrays);
+        PL_LOAD_GLFN(glGenVertexArrays);
+        PL_LOAD_GLFN(glIsVertexArray);
+    }
+    
+    if(version >= 3.1)
+    {
+        PL_LOAD_GLFN(glDrawArraysInstanced);
+        PL_LOAD_GLFN(glDrawElementsInstanced);
+        PL_LOAD_GLFN(glTexBuffer);
+        PL_LOAD_GLFN(glPrimitiveRestartIndex);
+        PL_LOAD_GLFN(glCopyBufferSubData);
+        PL_LOAD_GLFN(glGetUniformIndices);
+        PL_LOAD_GLFN(glGetActiveUniformsiv);
+        PL_LOAD_GLFN(glGetActiveUniformName);
+        PL_LOAD_GLFN(glGetUniformBlockIndex);
+        PL_LOAD_GLFN(glGetActiveUniformBlockiv);
+        PL_LOAD_GLFN(glGetActiveUniformBlockName);
+        PL_LOAD_GLFN(glUniformBlockBinding);
+    }
+    
+    if(version >= 3.2)
+    {
+        PL_LOAD_GLFN(glDrawElementsBaseVertex);
+        PL_LOAD_GLFN(glDrawRangeElementsBaseVertex);
+        PL_LOAD_GLFN(glDrawElementsInstancedBaseVertex);
+        PL_LOAD_GLFN(glMultiDrawElementsBaseVertex);
+        PL_LOAD_GLFN(glProvokingVertex);
+        PL_LOAD_GLFN(glFenceSync);
+        PL_LOAD_GLFN(glIsSync);
+        PL_LOAD_GLFN(glDeleteSync);
+        PL_LOAD_GLFN(glClientWaitSync);
+        PL_LOAD_GLFN(glWaitSync);
+        PL_LOAD_GLFN(glGetInteger64v);
+        PL_LOAD_GLFN(glGetSynciv);
+        PL_LOAD_GLFN(glGetInteger64i_v);
+        PL_LOAD_GLFN(glGetBufferParameteri64v);
+        PL_LOAD_GLFN(glFramebufferTexture);
+        PL_LOAD_GLFN(glTexImage2DMultisample);
+        PL_LOAD_GLFN(glTexImage3DMultisample);
+        PL_LOAD_GLFN(glGetMultisamplefv);
+        PL_LOAD_GLFN(glSampleMaski);
+    }
+    
+    if(version >= 3.3)
+    {
+        PL_LOAD_GLFN(glBindFragDataLocationIndexed);
+        PL_LOAD_GLFN(glGetFragDataIndex);
+        PL_LOAD_GLFN(glGenSamplers);
+        PL_LOAD_GLFN(glDeleteSamplers);
+        PL_LOAD_GLFN(glIsSampler);
+        PL_LOAD_GLFN(glBindSampler);
+        PL_LOAD_GLFN(glSamplerParameteri);
+        PL_LOAD_GLFN(glSamplerParameteriv);
+        PL_LOAD_GLFN(glSamplerParameterf);
+        PL_LOAD_GLFN(glSamplerParameterfv);
+        PL_LOAD_GLFN(glSamplerParameterIiv);
+        PL_LOAD_GLFN(glSamplerParameterIuiv);
+        PL_LOAD_GLFN(glGetSamplerParameteriv);
+        PL_LOAD_GLFN(glGetSamplerParameterIiv);
+        PL_LOAD_GLFN(glGetSamplerParameterfv);
+        PL_LOAD_GLFN(glGetSamplerParameterIuiv);
+        PL_LOAD_GLFN(glQueryCounter);
+        PL_LOAD_GLFN(glGetQueryObjecti64v);
+        PL_LOAD_GLFN(glGetQueryObjectui64v);
+        PL_LOAD_GLFN(glVertexAttribDivisor);
+        PL_LOAD_GLFN(glVertexAttribP1ui);
+        PL_LOAD_GLFN(glVertexAttribP1uiv);
+        PL_LOAD_GLFN(glVertexAttribP2ui);
+        PL_LOAD_GLFN(glVertexAttribP2uiv);
+        PL_LOAD_GLFN(glVertexAttribP3ui);
+        PL_LOAD_GLFN(glVertexAttribP3uiv);
+        PL_LOAD_GLFN(glVertexAttribP4ui);
+        PL_LOAD_GLFN(glVertexAttribP4uiv);
+        PL_LOAD_GLFN(glVertexP2ui);
+        PL_LOAD_GLFN(glVertexP2uiv);
+        PL_LOAD_GLFN(glVertexP3ui);
+        PL_LOAD_GLFN(glVertexP3uiv);
+        PL_LOAD_GLFN(glVertexP4ui);
+        PL_LOAD_GLFN(glVertexP4uiv);
+        PL_LOAD_GLFN(glTexCoordP1ui);
+        PL_LOAD_GLFN(glTexCoordP1uiv);
+        PL_LOAD_GLFN(glTexCoordP2ui);
+        PL_LOAD_GLFN(glTexCoordP2uiv);
+        PL_LOAD_GLFN(glTexCoordP3ui);
+        PL_LOAD_GLFN(glTexCoordP3uiv);
+        PL_LOAD_GLFN(glTexCoordP4ui);
+        PL_LOAD_GLFN(glTexCoordP4uiv);
+        PL_LOAD_GLFN(glMultiTexCoordP1ui);
+        PL_LOAD_GLFN(glMultiTexCoordP1uiv);
+        PL_LOAD_GLFN(glMultiTexCoordP2ui);
+        PL_LOAD_GLFN(glMultiTexCoordP2uiv);
+        PL_LOAD_GLFN(glMultiTexCoordP3ui);
+        PL_LOAD_GLFN(glMultiTexCoordP3uiv);
+        PL_LOAD_GLFN(glMultiTexCoordP4ui);
+        PL_LOAD_GLFN(glMultiTexCoordP4uiv);
+        PL_LOAD_GLFN(glNormalP3ui);
+        PL_LOAD_GLFN(glNormalP3uiv);
+        PL_LOAD_GLFN(glColorP3ui);
+        PL_LOAD_GLFN(glColorP3uiv);
+        PL_LOAD_GLFN(glColorP4ui);
+        PL_LOAD_GLFN(glColorP4uiv);
+        PL_LOAD_GLFN(glSecondaryColorP3ui);
+        PL_LOAD_GLFN(glSecondaryColorP3uiv);
+    }
+    
+    if(version >= 4.0)
+    {
+        PL_LOAD_GLFN(glMinSampleShading);
+        PL_LOAD_GLFN(glBlendEquationi);
+        PL_LOAD_GLFN(glBlendEquationSeparatei);
+        PL_LOAD_GLFN(glBlendFunci);
+        PL_LOAD_GLFN(glBlendFuncSeparatei);
+        PL_LOAD_GLFN(glDrawArraysIndirect);
+        PL_LOAD_GLFN(glDrawElementsIndirect);
+        PL_LOAD_GLFN(glUniform1d);
+        PL_LOAD_GLFN(glUniform2d);
+        PL_LOAD_GLFN(glUniform3d);
+        PL_LOAD_GLFN(glUniform4d);
+        PL_LOAD_GLFN(glUniform1dv);
+        PL_LOAD_GLFN(glUniform2dv);
+        PL_LOAD_GLFN(glUniform3dv);
+        PL_LOAD_GLFN(glUniform4dv);
+        PL_LOAD_GLFN(glUniformMatrix2dv);
+        PL_LOAD_GLFN(glUniformMatrix3dv);
+        PL_LOAD_GLFN(glUniformMatrix4dv);
+        PL_LOAD_GLFN(glUniformMatrix2x3dv);
+        PL_LOAD_GLFN(glUniformMatrix2x4dv);
+        PL_LOAD_GLFN(glUniformMatrix3x2dv);
+        PL_LOAD_GLFN(glUniformMatrix3x4dv);
+        PL_LOAD_GLFN(glUniformMatrix4x2dv);
+        PL_LOAD_GLFN(glUniformMatrix4x3dv);
+        PL_LOAD_GLFN(glGetUniformdv);
+        PL_LOAD_GLFN(glGetSubroutineUniformLocation);
+        PL_LOAD_GLFN(glGetSubroutineIndex);
+        PL_LOAD_GLFN(glGetActiveSubroutineUniformiv);
+        PL_LOAD_GLFN(glGetActiveSubroutineUniformName);
+        PL_LOAD_GLFN(glGetActiveSubroutineName);
+        PL_LOAD_GLFN(glUniformSubroutinesuiv);
+        PL_LOAD_GLFN(glGetUniformSubroutineuiv);
+        PL_LOAD_GLFN(glGetProgramStageiv);
+        PL_LOAD_GLFN(glPatchParameteri);
+        PL_LOAD_GLFN(glPatchParameterfv);
+        PL_LOAD_GLFN(glBindTransformFeedback);
+        PL_LOAD_GLFN(glDeleteTransformFeedbacks);
+        PL_LOAD_GLFN(glGenTransformFeedbacks);
+        PL_LOAD_GLFN(glIsTransformFeedback);
+        PL_LOAD_GLFN(glPauseTransformFeedback);
+        PL_LOAD_GLFN(glResumeTransformFeedback);
+        PL_LOAD_GLFN(glDrawTransformFeedback);
+        PL_LOAD_GLFN(glDrawTransformFeedbackStream);
+        PL_LOAD_GLFN(glBeginQueryIndexed);
+        PL_LOAD_GLFN(glEndQueryIndexed);
+        PL_LOAD_GLFN(glGetQueryIndexediv);
+    }
+    
+    if(version >= 4.1)
+    {
+        PL_LOAD_GLFN(glReleaseShaderCompiler);
+        PL_LOAD_GLFN(glShaderBinary);
+        PL_LOAD_GLFN(glGetShaderPrecisionFormat);
+        PL_LOAD_GLFN(glDepthRangef);
+        PL_LOAD_GLFN(glClearDepthf);
+        PL_LOAD_GLFN(glGetProgramBinary);
+        PL_LOAD_GLFN(glProgramBinary);
+        PL_LOAD_GLFN(glProgramParameteri);
+        PL_LOAD_GLFN(glUseProgramStages);
+        PL_LOAD_GLFN(glActiveShaderProgram);
+        PL_LOAD_GLFN(glCreateShaderProgramv);
+        PL_LOAD_GLFN(glBindProgramPipeline);
+        PL_LOAD_GLFN(glDeleteProgramPipelines);
+        PL_LOAD_GLFN(glGenProgramPipelines);
+        PL_LOAD_GLFN(glIsProgramPipeline);
+        PL_LOAD_GLFN(glGetProgramPipelineiv);
+        PL_LOAD_GLFN(glProgramUniform1i);
+        PL_LOAD_GLFN(glProgramUniform1iv);
+        PL_LOAD_GLFN(glProgramUniform1f);
+        PL_LOAD_GLFN(glProgramUniform1fv);
+        PL_LOAD_GLFN(glProgramUniform1d);
+        PL_LOAD_GLFN(glProgramUniform1dv);
+        PL_LOAD_GLFN(glProgramUniform1ui);
+        PL_LOAD_GLFN(glProgramUniform1uiv);
+        PL_LOAD_GLFN(glProgramUniform2i);
+        PL_LOAD_GLFN(glProgramUniform2iv);
+        PL_LOAD_GLFN(glProgramUniform2f);
+        PL_LOAD_GLFN(glProgramUniform2fv);
+        PL_LOAD_GLFN(glProgramUniform2d);
+        PL_LOAD_GLFN(glProgramUniform2dv);
+        PL_LOAD_GLFN(glProgramUniform2ui);
+        PL_LOAD_GLFN(glProgramUniform2uiv);
+        PL_LOAD_GLFN(glProgramUniform3i);
+        PL_LOAD_GLFN(glProgramUniform3iv);
+        PL_LOAD_GLFN(glProgramUniform3f);
+        PL_LOAD_GLFN(glProgramUniform3fv);
+        PL_LOAD_GLFN(glProgramUniform3d);
+        PL_LOAD_GLFN(glProgramUniform3dv);
+        PL_LOAD_GLFN(glProgramUniform3ui);
+        PL_LOAD_GLFN(glProgramUniform3uiv);
+        PL_LOAD_GLFN(glProgramUniform4i);
+        PL_LOAD_GLFN(glProgramUniform4iv);
+        PL_LOAD_GLFN(glProgramUniform4f);
+        PL_LOAD_GLFN(glProgramUniform4fv);
+        PL_LOAD_GLFN(glProgramUniform4d);
+        PL_LOAD_GLFN(glProgramUniform4dv);
+        PL_LOAD_GLFN(glProgramUniform4ui);
+        PL_LOAD_GLFN(glProgramUniform4uiv);
+        PL_LOAD_GLFN(glProgramUniformMatrix2fv);
+        PL_LOAD_GLFN(glProgramUniformMatrix3fv);
+        PL_LOAD_GLFN(glProgramUniformMatrix4fv);
+        PL_LOAD_GLFN(glProgramUniformMatrix2dv);
+        PL_LOAD_GLFN(glProgramUniformMatrix3dv);
+        PL_LOAD_GLFN(glProgramUniformMatrix4dv);
+        PL_LOAD_GLFN(glProgramUniformMatrix2x3fv);
+        PL_LOAD_GLFN(glProgramUniformMatrix3x2fv);
+        PL_LOAD_GLFN(glProgramUniformMatrix2x4fv);
+        PL_LOAD_GLFN(glProgramUniformMatrix4x2fv);
+        PL_LOAD_GLFN(glProgramUniformMatrix3x4fv);
+        PL_LOAD_GLFN(glProgramUniformMatrix4x3fv);
+        PL_LOAD_GLFN(glProgramUniformMatrix2x3dv);
+        PL_LOAD_GLFN(glProgramUniformMatrix3x2dv);
+        PL_LOAD_GLFN(glProgramUniformMatrix2x4dv);
+        PL_LOAD_GLFN(glProgramUniformMatrix4x2dv);
+        PL_LOAD_GLFN(glProgramUniformMatrix3x4dv);
+        PL_LOAD_GLFN(glProgramUniformMatrix4x3dv);
+        PL_LOAD_GLFN(glValidateProgramPipeline);
+        PL_LOAD_GLFN(glGetProgramPipelineInfoLog);
+        PL_LOAD_GLFN(glVertexAttribL1d);
+        PL_LOAD_GLFN(glVertexAttribL2d);
+        PL_LOAD_GLFN(glVertexAttribL3d);
+        PL_LOAD_GLFN(glVertexAttribL4d);
+        PL_LOAD_GLFN(glVertexAttribL1dv);
+        PL_LOAD_GLFN(glVertexAttribL2dv);
+        PL_LOAD_GLFN(glVertexAttribL3dv);
+        PL_LOAD_GLFN(glVertexAttribL4dv);
+        PL_LOAD_GLFN(glVertexAttribLPointer);
+        PL_LOAD_GLFN(glGetVertexAttribLdv);
+        PL_LOAD_GLFN(glViewportArrayv);
+        PL_LOAD_GLFN(glViewportIndexedf);
+        PL_LOAD_GLFN(glViewportIndexedfv);
+        PL_LOAD_GLFN(glScissorArrayv);
+        PL_LOAD_GLFN(glScissorIndexed);
+        PL_LOAD_GLFN(glScissorIndexedv);
+        PL_LOAD_GLFN(glDepthRangeArrayv);
+        PL_LOAD_GLFN(glDepthRangeIndexed);
+        PL_LOAD_GLFN(glGetFloati_v);
+        PL_LOAD_GLFN(glGetDoublei_v);
+    }
+    
+    if(version >= 4.2)
+    {
+        PL_LOAD_GLFN(glDrawArraysInstancedBaseInstance);
+        PL_LOAD_GLFN(glDrawElementsInstancedBaseInstance);
+        PL_LOAD_GLFN(glDrawElementsInstancedBaseVertexBaseInstance);
+        PL_LOAD_GLFN(glGetInternalformativ);
+        PL_LOAD_GLFN(glGetActiveAtomicCounterBufferiv);
+        PL_LOAD_GLFN(glBindImageTexture);
+        PL_LOAD_GLFN(glMemoryBarrier);
+        PL_LOAD_GLFN(glTexStorage1D);
+        PL_LOAD_GLFN(glTexStorage2D);
+        PL_LOAD_GLFN(glTexStorage3D);
+        PL_LOAD_GLFN(glDrawTransformFeedbackInstanced);
+        PL_LOAD_GLFN(glDrawTransformFeedbackStreamInstanced);
+    }
+    
+    if(version >= 4.3)
+    {
+        PL_LOAD_GLFN(glClearBufferData);
+        PL_LOAD_GLFN(glClearBufferSubData);
+        PL_LOAD_GLFN(glDispatchCompute);
+        PL_LOAD_GLFN(glDispatchComputeIndirect);
+        PL_LOAD_GLFN(glCopyImageSubData);
+        PL_LOAD_GLFN(glFramebufferParameteri);
+        PL_LOAD_GLFN(glGetFramebufferParameteriv);
+        PL_LOAD_GLFN(glGetInternalformati64v);
+        PL_LOAD_GLFN(glInvalidateTexSubImage);
+        PL_LOAD_GLFN(glInvalidateTexImage);
+        PL_LOAD_GLFN(glInvalidateBufferSubData);
+        PL_LOAD_GLFN(glInvalidateBufferData);
+        PL_LOAD_GLFN(glInvalidateFramebuffer);
+        PL_LOAD_GLFN(glInvalidateSubFramebuffer);
+        PL_LOAD_GLFN(glMultiDrawArraysIndirect);
+        PL_LOAD_GLFN(glMultiDrawElementsIndirect);
+        PL_LOAD_GLFN(glGetProgramInterfaceiv);
+        PL_LOAD_GLFN(glGetProgramResourceIndex);
+        PL_LOAD_GLFN(glGetProgramResourceName);
+        PL_LOAD_GLFN(glGetProgramResourceiv);
+        PL_LOAD_GLFN(glGetProgramResourceLocation);
+        PL_LOAD_GLFN(glGetProgramResourceLocationIndex);
+        PL_LOAD_GLFN(glShaderStorageBlockBinding);
+        PL_LOAD_GLFN(glTexBufferRange);
+        PL_LOAD_GLFN(glTexStorage2DMultisample);
+        PL_LOAD_GLFN(glTexStorage3DMultisample);
+        PL_LOAD_GLFN(glTextureView);
+        PL_LOAD_GLFN(glBindVertexBuffer);
+        PL_LOAD_GLFN(glVertexAttribFormat);
+        PL_LOAD_GLFN(glVertexAttribIFormat);
+        PL_LOAD_GLFN(glVertexAttribLFormat);
+        PL_LOAD_GLFN(glVertexAttribBinding);
+        PL_LOAD_GLFN(glVertexBindingDivisor);
+        PL_LOAD_GLFN(glDebugMessageControl);
+        PL_LOAD_GLFN(glDebugMessageInsert);
+        PL_LOAD_GLFN(glDebugMessageCallback);
+        PL_LOAD_GLFN(glGetDebugMessageLog);
+        PL_LOAD_GLFN(glPushDebugGroup);
+        PL_LOAD_GLFN(glPopDebugGroup);
+        PL_LOAD_GLFN(glObjectLabel);
+        PL_LOAD_GLFN(glGetObjectLabel);
+        PL_LOAD_GLFN(glObjectPtrLabel);
+        PL_LOAD_GLFN(glGetObjectPtrLabel);
+    }
+    
+    if(version >= 4.4)
+    {
+        PL_LOAD_GLFN(glBufferStorage);
+        PL_LOAD_GLFN(glClearTexImage);
+        PL_LOAD_GLFN(glClearTexSubImage);
+        PL_LOAD_GLFN(glBindBuffersBase);
+        PL_LOAD_GLFN(glBindBuffersRange);
+        PL_LOAD_GLFN(glBindTextures);
+        PL_LOAD_GLFN(glBindSamplers);
+        PL_LOAD_GLFN(glBindImageTextures);
+        PL_LOAD_GLFN(glBindVertexBuffers);
+    }
+    
+    if(version >= 4.5)
+    {
+        PL_LOAD_GLFN(glClipControl);
+        PL_LOAD_GLFN(glCreateTransformFeedbacks);
+        PL_LOAD_GLFN(glTransformFeedbackBufferBase);
+        PL_LOAD_GLFN(glTransformFeedbackBufferRange);
+        PL_LOAD_GLFN(glGetTransformFeedbackiv);
+        PL_LOAD_GLFN(glGetTransformFeedbacki_v);
+        PL_LOAD_GLFN(glGetTransformFeedbacki64_v);
+        PL_LOAD_GLFN(glCreateBuffers);
+        PL_LOAD_GLFN(glNamedBufferStorage);
+        PL_LOAD_GLFN(glNamedBufferData);
+        PL_LOAD_GLFN(glNamedBufferSubData);
+        PL_LOAD_GLFN(glCopyNamedBufferSubData);
+        PL_LOAD_GLFN(glClearNamedBufferData);
+        PL_LOAD_GLFN(glClearNamedBufferSubData);
+        PL_LOAD_GLFN(glMapNamedBuffer);
+        PL_LOAD_GLFN(glMapNamedBufferRange);
+        PL_LOAD_GLFN(glUnmapNamedBuffer);
+        PL_LOAD_GLFN(glFlushMappedNamedBufferRange);
+        PL_LOAD_GLFN(glGetNamedBufferParameteriv);
+        PL_LOAD_GLFN(glGetNamedBufferParameteri64v);
+        PL_LOAD_GLFN(glGetNamedBufferPointerv);
+        PL_LOAD_GLFN(glGetNamedBufferSubData);
+        PL_LOAD_GLFN(glCreateFramebuffers);
+        PL_LOAD_GLFN(glNamedFramebufferRenderbuffer);
+        PL_LOAD_GLFN(glNamedFramebufferParameteri);
+        PL_LOAD_GLFN(glNamedFramebufferTexture);
+        PL_LOAD_GLFN(glNamedFramebufferTextureLayer);
+        PL_LOAD_GLFN(glNamedFramebufferDrawBuffer);
+        PL_LOAD_GLFN(glNamedFramebufferDrawBuffers);
+        PL_LOAD_GLFN(glNamedFramebufferReadBuffer);
+        PL_LOAD_GLFN(glInvalidateNamedFramebufferData);
+        PL_LOAD_GLFN(glInvalidateNamedFramebufferSubData);
+        PL_LOAD_GLFN(glClearNamedFramebufferiv);
+        PL_LOAD_GLFN(glClearNamedFramebufferuiv);
+        PL_LOAD_GLFN(glClearNamedFramebufferfv);
+        PL_LOAD_GLFN(glClearNamedFramebufferfi);
+        PL_LOAD_GLFN(glBlitNamedFramebuffer);
+        PL_LOAD_GLFN(glCheckNamedFramebufferStatus);
+        PL_LOAD_GLFN(glGetNamedFramebufferParameteriv);
+        PL_LOAD_GLFN(glGetNamedFramebufferAttachmentParameteriv);
+        PL_LOAD_GLFN(glCreateRenderbuffers);
+        PL_LOAD_GLFN(glNamedRenderbufferStorage);
+        PL_LOAD_GLFN(glNamedRenderbufferStorageMultisample);
+        PL_LOAD_GLFN(glGetNamedRenderbufferParameteriv);
+        PL_LOAD_GLFN(glCreateTextures);
+        PL_LOAD_GLFN(glTextureBuffer);
+        PL_LOAD_GLFN(glTextureBufferRange);
+        PL_LOAD_GLFN(glTextureStorage1D);
+        PL_LOAD_GLFN(glTextureStorage2D);
+        PL_LOAD_GLFN(glTextureStorage3D);
+        PL_LOAD_GLFN(glTextureStorage2DMultisample);
+        PL_LOAD_GLFN(glTextureStorage3DMultisample);
+        PL_LOAD_GLFN(glTextureSubImage1D);
+        PL_LOAD_GLFN(glTextureSubImage2D);
+        PL_LOAD_GLFN(glTextureSubImage3D);
+        PL_LOAD_GLFN(glCompressedTextureSubImage1D);
+        PL_LOAD_GLFN(glCompressedTextureSubImage2D);
+        PL_LOAD_GLFN(glCompressedTextureSubImage3D);
+        PL_LOAD_GLFN(glCopyTextureSubImage1D);
+        PL_LOAD_GLFN(glCopyTextureSubImage2D);
+        PL_LOAD_GLFN(glCopyTextureSubImage3D);
+        PL_LOAD_GLFN(glTextureParameterf);
+        PL_LOAD_GLFN(glTextureParameterfv);
+        PL_LOAD_GLFN(glTextureParameteri);
+        PL_LOAD_GLFN(glTextureParameterIiv);
+        PL_LOAD_GLFN(glTextureParameterIuiv);
+        PL_LOAD_GLFN(glTextureParameteriv);
+        PL_LOAD_GLFN(glGenerateTextureMipmap);
+        PL_LOAD_GLFN(glBindTextureUnit);
+        PL_LOAD_GLFN(glGetTextureImage);
+        PL_LOAD_GLFN(glGetCompressedTextureImage);
+        PL_LOAD_GLFN(glGetTextureLevelParameterfv);
+        PL_LOAD_GLFN(glGetTextureLevelParameteriv);
+        PL_LOAD_GLFN(glGetTextureParameterfv);
+        PL_LOAD_GLFN(glGetTextureParameterIiv);
+        PL_LOAD_GLFN(glGetTextureParameterIuiv);
+        PL_LOAD_GLFN(glGetTextureParameteriv);
+        PL_LOAD_GLFN(glCreateVertexArrays);
+        PL_LOAD_GLFN(glDisableVertexArrayAttrib);
+        PL_LOAD_GLFN(glEnableVertexArrayAttrib);
+        PL_LOAD_GLFN(glVertexArrayElementBuffer);
+        PL_LOAD_GLFN(glVertexArrayVertexBuffer);
+        PL_LOAD_GLFN(glVertexArrayVertexBuffers);
+        PL_LOAD_GLFN(glVertexArrayAttribBinding);
+        PL_LOAD_GLFN(glVertexArrayAttribFormat);
+        PL_LOAD_GLFN(glVertexArrayAttribIFormat);
+        PL_LOAD_GLFN(glVertexArrayAttribLFormat);
+        PL_LOAD_GLFN(glVertexArrayBindingDivisor);
+        PL_LOAD_GLFN(glGetVertexArrayiv);
+        PL_LOAD_GLFN(glGetVertexArrayIndexediv);
+        PL_LOAD_GLFN(glGetVertexArrayIndexed64iv);
+        PL_LOAD_GLFN(glCreateSamplers);
+        PL_LOAD_GLFN(glCreateProgramPipelines);
+        PL_LOAD_GLFN(glCreateQueries);
+        PL_LOAD_GLFN(glGetQueryBufferObjecti64v);
+        PL_LOAD_GLFN(glGetQueryBufferObjectiv);
+        PL_LOAD_GLFN(glGetQueryBufferObjectui64v);
+        PL_LOAD_GLFN(glGetQueryBufferObjectuiv);
+        PL_LOAD_GLFN(glMemoryBarrierByRegion);
+        PL_LOAD_GLFN(glGetTextureSubImage);
+        PL_LOAD_GLFN(glGetCompressedTextureSubImage);
+        PL_LOAD_GLFN(glGetGraphicsResetStatus);
+        PL_LOAD_GLFN(glGetnCompressedTexImage);
+        PL_LOAD_GLFN(glGetnTexImage);
+        PL_LOAD_GLFN(glGetnUniformdv);
+        PL_LOAD_GLFN(glGetnUniformfv);
+        PL_LOAD_GLFN(glGetnUniformiv);
+        PL_LOAD_GLFN(glGetnUniformuiv);
+        PL_LOAD_GLFN(glReadnPixels);
+        PL_LOAD_GLFN(glGetnMapdv);
+        PL_LOAD_GLFN(glGetnMapfv);
+        PL_LOAD_GLFN(glGetnMapiv);
+        PL_LOAD_GLFN(glGetnPixelMapfv);
+        PL_LOAD_GLFN(glGetnPixelMapuiv);
+        PL_LOAD_GLFN(glGetnPixelMapusv);
+        PL_LOAD_GLFN(glGetnPolygonStipple);
+        PL_LOAD_GLFN(glGetnColorTable);
+        PL_LOAD_GLFN(glGetnConvolutionFilter);
+        PL_LOAD_GLFN(glGetnSeparableFilter);
+        PL_LOAD_GLFN(glGetnHistogram);
+        PL_LOAD_GLFN(glGetnMinmax);
+        PL_LOAD_GLFN(glTextureBarrier);
+    }
+    
+    return 1;
+}
+#endif // !PL_LINUX || PL_LINUX_X11
+
+/*==============================
+      PHRAGLIB WIN32
+      Windows Specific
+===============================*/
+#if defined(PL_WINDOWS)
+#include <windows.h>
+#include <xinput.h>
+#include <xaudio2.h>
+
+/* ======= WIN32 LIB FUNCTIONS ======== */
+
+#define WIN32_LOAD_DLLFN(name) {name = (tfn_##name *)GetProcAddress(lib, #name ); if(!name) return 0;}
+
+/*============ USER32 ================*/
+
+typedef BOOL tfn_TranslateMessage(const MSG *lpMsg);
+tfn_TranslateMessage *pfn_TranslateMessage;
+#define TranslateMessage pfn_TranslateMessage
+
+typedef LRESULT tfn_DispatchMessageA(const MSG *lpMsg);
+tfn_DispatchMessageA *pfn_DispatchMessageA;
+#define DispatchMessageA pfn_DispatchMessageA
+
+typedef BOOL tfn_PeekMessageA(LPMSG lpMsg, HWND hWnd, UINT wMsgFilterMin, UINT wMsgFilterMax, UINT wRemoveMsg);
+tfn_PeekMessageA *pfn_PeekMessageA;
+#define PeekMessageA pfn_PeekMessageA
+
+typedef LRESULT tfn_DefWindowProcA(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam);
+tfn_DefWindowProcA *pfn_DefWindowProcA;
+#define DefWindowProcA pfn_DefWindowProcA
+
+typedef ATOM tfn_RegisterClassA(const WNDCLASSA *lpWndClass);
+tfn_RegisterClassA *pfn_RegisterClassA;
+#define RegisterClassA pfn_RegisterClassA
+
+typedef HWND tfn_CreateWindowExA(DWORD dwExStyle, LPCSTR lpClassName, LPCSTR lpWindowName, DWORD dwStyle,
+                                 int X, int Y, int nWidth, int nHeight,
+                                 HWND hWndParent, HMENU hMenu, HINSTANCE hInstance, LPVOID lpParam);
+tfn_CreateWindowExA *pfn_CreateWindowExA;
+#define CreateWindowExA pfn_CreateWindowExA
+
+typedef BOOL tfn_DestroyWindow(HWND hWnd);
+tfn_DestroyWindow *pfn_DestroyWindow;
+#define DestroyWindow pfn_DestroyWindow
+
+typedef BOOL tfn_MoveWindow(HWND hWnd, int X, int Y, int nWidth, int nHeight, BOOL bRepaint);
+tfn_MoveWindow *pfn_MoveWindow;
+#define MoveWindow pfn_MoveWindow
+
+typedef BOOL tfn_SetWindowPos(HWND hWnd, HWND hWndInsertAfter, int X, int Y, int cx, int cy, UINT uFlags);
+tfn_SetWindowPos *pfn_SetWindowPos;
+#define SetWindowPos pfn_SetWindowPos
+
+typedef BOOL tfn_GetWindowPlacement(HWND hWnd, WINDOWPLACEMENT *lpwndpl);
+tfn_GetWindowPlacement *pfn_GetWindowPlacement;
+#define GetWindowPlacement pfn_GetWindowPlacement
+
+typedef BOOL tfn_SetWindowPlacement(HWND hWnd, const WINDOWPLACEMENT *lpwndpl);
+tfn_SetWindowPlacement *pfn_SetWindowPlacement;
+#define SetWindowPlacement pfn_SetWindowPlacement
+
+typedef HDC tfn_GetDC(HWND hWnd);
+tfn_GetDC *pfn_GetDC;
+#define GetDC pfn_GetDC
+
+typedef int tfn_ReleaseDC(HWND hWnd, HDC  hDC);
+tfn_ReleaseDC *pfn_ReleaseDC;
+#define ReleaseDC pfn_ReleaseDC
+
+typedef BOOL tfn_SetWindowTextA(HWND hWnd, LPCSTR lpString);
+tfn_SetWindowTextA *pfn_SetWindowTextA;
+#define SetWindowTextA pfn_SetWindowTextA
+
+typedef int tfn_MessageBoxA(HWND hWnd, LPCSTR lpText, LPCSTR lpCaption, UINT uType);
+tfn_MessageBoxA *pfn_MessageBoxA;
+#define MessageBoxA pfn_MessageBoxA
+
+typedef BOOL tfn_GetCursorPos(LPPOINT lpPoint);
+tfn_GetCursorPos *pfn_GetCursorPos;
+#define GetCursorPos pfn_GetCursorPos
+
+typedef BOOL tfn_ScreenToClient(HWND hWnd, LPPOINT lpPoint);
+tfn_ScreenToClient *pfn_ScreenToClient;
+#define ScreenToClient pfn_ScreenToClient
+
+typedef LONG tfn_GetWindowLongA(HWND hWnd, int nIndex);
+tfn_GetWindowLongA *pfn_GetWindowLongA;
+#define GetWindowLongA pfn_GetWindowLongA
+
+typedef LONG tfn_SetWindowLongA(HWND hWnd, int nIndex, LONG dwNewLong);
+tfn_SetWindowLongA *pfn_SetWindowLongA;
+#define SetWindowLongA pfn_SetWindowLongA
+
+typedef HMONITOR tfn_MonitorFromWindow(HWND hwnd, DWORD dwFlags);
+tfn_MonitorFromWindow *pfn_MonitorFromWindow;
+#define MonitorFromWindow pfn_MonitorFromWindow
+
+typedef BOOL tfn_GetMonitorInfoA(HMONITOR hMonitor, LPMONITORINFO lpmi);
+tfn_GetMonitorInfoA *pfn_GetMonitorInfoA;
+#define GetMonitorInfoA pfn_GetMonitorInfoA
+
+typedef BOOL tfn_GetClientRect(HWND hWnd, LPRECT lpRect);
+tfn_GetClientRect *pfn_GetClientRect;
+#define GetClientRect pfn_GetClientRect
+
+typedef BOOL tfn_GetWindowRect(HWND hWnd, LPRECT lpRect);
+tfn_GetWindowRect *pfn_GetWindowRect;
+#define GetWindowRect pfn_GetWindowRect
+
+static b32 Win32_LoadUserLib()
+{
+    HMODULE lib = LoadLibraryA("user32.dll");
+    if(!lib) return 0;
+    
+    WIN32_LOAD_DLLFN(TranslateMessage);
+    WIN32_LOAD_DLLFN(DispatchMessageA);
+    WIN32_LOAD_DLLFN(PeekMessageA);
+    WIN32_LOAD_DLLFN(DefWindowProcA);
+    WIN32_LOAD_DLLFN(RegisterClassA);
+    WIN32_LOAD_DLLFN(CreateWindowExA);
+    WIN32_LOAD_DLLFN(DestroyWindow);
+    WIN32_LOAD_DLLFN(MoveWindow);
+    WIN32_LOAD_DLLFN(SetWindowPos);
+    WIN32_LOAD_DLLFN(GetWindowPlacement);
+    WIN32_LOAD_DLLFN(SetWindowPlacement);
+    WIN32_LOAD_DLLFN(GetDC);
+    WIN32_LOAD_DLLFN(ReleaseDC);
+    WIN32_LOAD_DLLFN(SetWindowTextA);
+    WIN32_LOAD_DLLFN(MessageBoxA);
+    WIN32_LOAD_DLLFN(GetCursorPos);
+    WIN32_LOAD_DLLFN(ScreenToClient);
+    WIN32_LOAD_DLLFN(GetWindowLongA);
+    WIN32_LOAD_DLLFN(SetWindowLongA);
+    WIN32_LOAD_DLLFN(MonitorFromWindow);
+    WIN32_LOAD_DLLFN(GetMonitorInfoA);
+    WIN32_LOAD_DLLFN(GetClientRect);
+    WIN32_LOAD_DLLFN(GetWindowRect);
+    
+    return 1;
+}
+
+/*========== GDI32 =============*/
+
+typedef int tfn_ChoosePixelFormat(HDC hdc, const PIXELFORMATDESCRIPTOR *ppfd);
+tfn_ChoosePixelFormat *pfn_ChoosePixelFormat;
+#define ChoosePixelFormat pfn_ChoosePixelFormat
+
+typedef int tfn_DescribePixelFormat(HDC hdc, int iPixelFormat, UINT nBytes, LPPIXELFORMATDESCRIPTOR ppfd);
+tfn_DescribePixelFormat *pfn_DescribePixelFormat;
+#define DescribePixelFormat pfn_DescribePixelFormat
+
+typedef BOOL tfn_SetPixelFormat(HDC hdc, int format, const PIXELFORMATDESCRIPTOR *ppfd);
+tfn_SetPixelFormat *pfn_SetPixelFormat;
+#define SetPixelFormat pfn_SetPixelFormat
+
+typedef BOOL tfn_SwapBuffers(HDC unnamedParam1);
+tfn_SwapBuffers *pfn_SwapBuffers;
+#define SwapBuffers pfn_SwapBuffers
+
+static b32 Win32_LoadGDILib()
+{
+    HMODULE lib = LoadLibraryA("gdi32.dll");
+    if(!lib) return 0;
+    
+    WIN32_LOAD_DLLFN(ChoosePixelFormat);
+    WIN32_LOAD_DLLFN(DescribePixelFormat);
+    WIN32_LOAD_DLLFN(SetPixelFormat);
+    WIN32_LOAD_DLLFN(SwapBuffers);
+    
+    return 1;
+}
+
+/*=========== WINMM ============*/
+
+typedef UINT tfn_timeBeginPeriod(UINT uPeriod);
+tfn_timeBeginPeriod *pfn_timeBeginPeriod;
+#define timeBeginPeriod pfn_timeBeginPeriod
+
+static b32 Win32_LoadWinMMLib(void)
+{
+    HMODULE lib = LoadLibraryA("winmm.dll");
+    if(!lib) return 0;
+    
+    WIN32_LOAD_DLLFN(timeBeginPeriod);
+    
+    return 1;
+}
+
+/*=========== ADVAPI32 ============*/
+
+typedef BOOL tfn_OpenProcessToken(HANDLE ProcessHandle, DWORD DesiredAccess, PHANDLE TokenHandle);
+tfn_OpenProcessToken *pfn_OpenProcessToken;
+#define OpenProcessToken pfn_OpenProcessToken
+
+typedef BOOL tfn_LookupPrivilegeValueA(LPCSTR lpSystemName, LPCSTR lpName, PLUID lpLuid);
+tfn_LookupPrivilegeValueA *pfn_LookupPrivilegeValueA;
+#define LookupPrivilegeValueA pfn_LookupPrivilegeValueA
+
+typedef BOOL tfn_AdjustTokenPrivileges(HANDLE TokenHandle, BOOL DisableAllPrivileges, PTOKEN_PRIVILEGES NewState,
+                                       DWORD BufferLength, PTOKEN_PRIVILEGES PreviousState, PDWORD ReturnLength);
+tfn_AdjustTokenPrivileges *pfn_AdjustTokenPrivileges;
+#define AdjustTokenPrivileges pfn_AdjustTokenPrivileges
+
+static b32 Win32_LoadAdvApiLib(void)
+{
+    HMODULE lib = LoadLibraryA("advapi32.dll");
+    if(!lib) return 0;
+    
+    WIN32_LOAD_DLLFN(OpenProcessToken);
+    WIN32_LOAD_DLLFN(LookupPrivilegeValueA);
+    WIN32_LOAD_DLLFN(AdjustTokenPrivileges);
+    
+    return 1;
+}
+
+/*=========== WGL ==============*/
+
+typedef HGLRC tfn_wglCreateContext(HDC unnamedParam1);
+tfn_wglCreateContext *pfn_wglCreateContext;
+#define wglCreateContext pfn_wglCreateContext
+
+typedef BOOL tfn_wglDeleteContext(HGLRC unnamedParam1);
+tfn_wglDeleteContext *pfn_wglDeleteContext;
+#define wglDeleteContext pfn_wglDeleteContext
+
+typedef PROC tfn_wglGetProcAddress(LPCSTR unnamedParam1);
+tfn_wglGetProcAddress *pfn_wglGetProcAddress;
+#define wglGetProcAddress pfn_wglGetProcAddress
+
+typedef BOOL tfn_wglMakeCurrent(HDC unnamedParam1, HGLRC unnamedParam2);
+tfn_wglMakeCurrent *pfn_wglMakeCurrent;
+#define wglMakeCurrent pfn_wglMakeCurrent
+
+static b32 Win32_LoadWGLLib(void)
+{
+    HMODULE lib = LoadLibraryA("opengl32.dll");
+    if(!lib) return 0;
+    
+    WIN32_LOAD_DLLFN(wglCreateContext);
+    WIN32_LOAD_DLLFN(wglDeleteContext);
+    WIN32_LOAD_DLLFN(wglGetProcAddress);
+    WIN32_LOAD_DLLFN(wglMakeCurrent);
+    
+    return 1;
+}
+
+/*========= XINPUT =============*/
+
+typedef DWORD WINAPI tfn_XInputGetState(DWORD dwUserIndex, XINPUT_STATE *pState);
+typedef DWORD WINAPI tfn_XInputSetState(DWORD dwUserIndex, XINPUT_VIBRATION *pVibration);
+DWORD WINAPI sfn_XInputGetState(DWORD dwUserIndex, XINPUT_STATE *pState)
+{return ERROR_DEVICE_NOT_CONNECTED;}
+DWORD WINAPI sfn_XInputSetState(DWORD dwUserIndex, XINPUT_VIBRATION *pVibration)
+{return ERROR_DEVICE_NOT_CONNECTED;}
+
+typedef enum
+{
+    WIN32_XINPUT_NOT_LOADED = 0,
+    WIN32_XINPUT_1_4,
+    WIN32_XINPUT_9_1_0,
+    WIN32_XINPUT_1_3
+} WIN32_XINPUT_LOADED_VERSION;
+
+typedef struct
+{
+    WIN32_XINPUT_LOADED_VERSION version;
+    tfn_XInputGetState *GetState;
+    tfn_XInputSetState *SetState;
+} Win32_XInput;
+
+/*============== XAUDIO2 ================*/
+
+typedef HRESULT tfn_XAudio2Create(IXAudio2 **ppXAudio2, UINT32 Flags, XAUDIO2_PROCESSOR XAudio2Processor);
+HRESULT sfn_XAudio2Create(IXAudio2 **ppXAudio2, UINT32 Flags, XAUDIO2_PROCESSOR XAudio2Processor)
+{return XAUDIO2_E_XAPO_CREATION_FAILED;}
+
+typedef enum
+{
+    WIN32_XAUDIO_NOT_LOADED = 0,
+    WIN32_XAUDIO_2_9,
+    WIN32_XAUDIO_2_9D,
+    WIN32_XAUDIO_2_8,
+    WIN32_XAUDIO_2_7
+} WIN32_XAUDIO_LOADED_VERSION;
+
+typedef struct
+{
+    WIN32_XAUDIO_LOADED_VERSION version;
+    
+    IXAudio2 *handle;
+    IXAudio2MasteringVoice *masterVoice;
+    IXAudio2SourceVoice *srcVoice;
+    WAVEFORMATEX fmt;
+    XAUDIO2_BUFFER bufferHeader;
+    
+    tfn_XAudio2Create *Create;
+} Win32_XAudio;
+
+
+/*====================
+// Windows GL
+====================*/
+// WGL DEFS
+#define WGL_SAMPLE_BUFFERS_ARB            0x2041
+#define WGL_SAMPLES_ARB                   0x2042
+#define WGL_DRAW_TO_WINDOW_ARB            0x2001
+#define WGL_SUPPORT_OPENGL_ARB            0x2010
+#define WGL_DOUBLE_BUFFER_ARB             0x2011
+#define WGL_PIXEL_TYPE_ARB                0x2013
+#define WGL_TYPE_RGBA_ARB                 0x202B
+#define WGL_ACCELERATION_ARB              0x2003
+#define WGL_FULL_ACCELERATION_ARB         0x2027
+#define WGL_COLOR_BITS_ARB                0x2014
+#define WGL_ALPHA_BITS_ARB                0x201B
+#define WGL_DEPTH_BITS_ARB                0x2022
+#define WGL_CONTEXT_MAJOR_VERSION_ARB     0x2091
+#define WGL_CONTEXT_MINOR_VERSION_ARB     0x2092
+#define WGL_CONTEXT_PROFILE_MASK_ARB      0x9126
+#define WGL_CONTEXT_CORE_PROFILE_BIT_ARB  0x00000001
+#define WGL_SWAP_EXCHANGE_ARB             0x2028
+#define WGL_SWAP_METHOD_ARB               0x2007
+#define WGL_SWAP_COPY_ARB                 0x2029
+
+typedef BOOL (WINAPI* pfn_wglChoosePixelFormatARB)(HDC hdc, const int *piAttribIList,
+                                                   const FLOAT *pfAttribFList,
+                                                   UINT nMaxFormats, int *piFormats,
+                                                   UINT *nNunFormats);
+typedef HGLRC (WINAPI* pfn_wglCreateContextAttribsARB)(HDC hDC, HGLRC hShareContext,
+                                                       const int *attribList);
+typedef BOOL (WINAPI* pfn_wglSwapIntervalEXT)(int interval);
+
+pfn_wglChoosePixelFormatARB wglChoosePixelFormatARB;
+pfn_wglCreateContextAttribsARB wglCreateContextAttribsARB;
+pfn_wglSwapIntervalEXT wglSwapIntervalEXT;
+
+//==============================
+// Memory Allocation Functions
+//==============================
+
+ptr PL_Alloc(u64 size)
+{
+    ptr result = 0;
+    result = (ptr)HeapAlloc(GetProcessHeap(), 0, size);
+    return result;
+}
+
+ptr PL_Alloc0(u64 size)
+{
+    ptr result = 0;
+    result = (ptr)HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, size);
+    return result;
+}
+
+ptr PL_ReAlloc(ptr oldMem, u64 newSize)
+{
+    ptr result = 0;
+    result = (ptr)HeapReAlloc(GetProcessHeap(), 0, oldMem, newSize);
+    return result;
+}
+
+ptr PL_ReAlloc0(ptr oldMem, u64 newSize)
+{
+    ptr result = 0;
+    result = (ptr)HeapReAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, oldMem, newSize);
+    return result;
+}
+
+b32 PL_Free(ptr mem)
+{
+    BOOL win32Result = HeapFree(GetProcessHeap(), 0, mem);
+    b32 result = (b32)((win32Result) ? 1 : 0);
+    return result;
+}
+
+//===================
+// Files
+//===================
+
+PL_File PL_FileOpen(const cstr path)
+{
+    PL_File result = {0};
+    FILE *file = 0;
+    
+    if(fopen_s(&file, path, "a+"))
+    {
+        return result;
+    }
+    
+    fseek(file, 0, SEEK_END);
+    i64 size = _ftelli64(file);
+    fseek(file, 0, SEEK_SET);
+    
+    result.handle = (ptr)file;
+    result.size = size;
+    
+    return result;
+}
+
+void PL_FileClose(PL_File *file)
+{
+    if(file && file->handle)
+    {
+        fclose((FILE*)file->handle);
+        file->handle = 0;
+        file->size = 0;
+    }
+}
+
+u64 PL_FileRead(PL_File *file, u64 offset, ptr dst, u64 size)
+{
+    u64 result = 0;
+    
+    if(file && file->handle && dst)
+    {
+        _fseeki64((FILE*)file->handle, (i64)offset, SEEK_SET);
+        
+        if(!size)
+        {
+            result = fread(dst, 1, (u64)file->size - offset, (FILE*)file->handle);
+        }
+        else
+        {
+            result = fread(dst, 1, size - offset, (FILE*)file->handle);
+        }
+        
+        fseek(file->handle, 0, SEEK_SET);
+    }
+    else
+    {
+        return 0;
+    }
+    
+    return result;
+}
+
+u64 PL_FileWrite(PL_File *file, u64 offset, ptr src, u64 size)
+{
+    u64 result = 0;
+    
+    if(file && file->handle && src && size)
+    {
+        _fseeki64((FILE*)file->handle, (i64)offset, SEEK_SET);
+        result = fwrite(src, 1, size, (FILE*)file->handle);
+        fseek((FILE*)file->handle, 0, SEEK_SET);
+    }
+    else
+    {
+        return 0;
+    }
+    
+    return result;
+}
+
+u64 PL_FileWriteAppend(PL_File *file, ptr src, u64 size)
+{
+    u64 result = 0;
+    
+    if(file && file->handle && src && size)
+    {
+        fseek((FILE*)file->handle, 0, SEEK_END);
+        result = fwrite(src, 1, size, (FILE*)file->handle);
+        fseek((FILE*)file->handle, 0, SEEK_SET);
+    }
+    else
+    {
+        return 0;
+    }
+    
+    return result;
+}
+
+void PL_PrintFile(PL_File *file, u64 offset, cstr format, ...)
+{
+    if(file && file->handle)
+    {
+        _fseeki64((FILE*)file->handle, (i64)offset, SEEK_SET);
+        va_list args;
+        va_start(args, format);
+        PL_PrintV((FILE*)file->handle, format, args);
+        va_end(args);
+        fseek((FILE*)file->handle, 0, SEEK_SET);
+    }
+}
+
+void PL_PrintFileAppend(PL_File *file, cstr format, ...)
+{
+    if(file && file->handle)
+    {
+        fseek((FILE*)file->handle, 0, SEEK_END);
+        va_list args;
+        va_start(args, format);
+        PL_PrintV((FILE*)file->handle, format, args);
+        va_end(args);
+        fseek((FILE*)file->handle, 0, SEEK_SET);
+    }
+}
+
+void PL_MsgBox(const cstr title, cstr format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    char msg[1024] = {0};
+    vsnprintf(msg, 1024, format, args);
+    va_end(args);
+    MessageBoxA(0, msg, title, MB_OK);
+}
+
+void  PL_MsgBoxInfo(const cstr title, cstr format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    char msg[1024] = {0};
+    vsnprintf(msg, 1024, format, args);
+    va_end(args);
+    MessageBoxA(0, msg, title, MB_OK | MB_ICONINFORMATION);
+}
+
+void PL_MsgBoxError(const cstr title, cstr format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    char msg[1024] = {0};
+    vsnprintf(msg, 1024, format, args);
+    va_end(args);
+    MessageBoxA(0, msg, title, MB_OK | MB_ICONSTOP);
+}
+
+/*====================
+  Input Processing
+====================*/
+
+static PL_KEYCODE Win32_WinKeyToPLKeycode(u32 key, LPARAM lParam)
+{
+    switch(key)
+    {
+        case VK_ESCAPE: return K_ESC;
+        case VK_PRINT: return K_PRTSC;
+        case VK_SCROLL: return K_SCRLK;
+        case VK_PAUSE: return K_PAUSE;
+        case VK_NUMLOCK: return K_NUM;
+        case VK_INSERT: return K_INS;
+        case VK_DELETE: return K_DEL;
+        case VK_HOME: return K_HOME;
+        case VK_END: return K_END;
+        case VK_PRIOR: return K_PGUP;
+        case VK_NEXT: return K_PGDN;
+        
+        case VK_F1: return K_F1;
+        case VK_F2: return K_F2;
+        case VK_F3: return K_F3;
+        case VK_F4: return K_F4;
+        case VK_F5: return K_F5;
+        case VK_F6: return K_F6;
+        case VK_F7: return K_F7;
+        case VK_F8: return K_F8;
+        case VK_F9: return K_F9;
+        case VK_F10: return K_F10;
+        case VK_F11: return K_F11;
+        case VK_F12: return K_F12;
+        
+        case VK_UP: return K_UP;
+        case VK_DOWN: return K_DOWN;
+        case VK_LEFT: return K_LEFT;
+        case VK_RIGHT: return K_RIGHT;
+        
+        case VK_CAPITAL: return K_CAPS;
+        case VK_BACK: return K_BACKSPACE;
+        case VK_LSHIFT: return K_LSHIFT;
+        case VK_RSHIFT: return K_RSHIFT;
+        case VK_LCONTROL: return K_LCTRL;
+        case VK_RCONTROL: return K_RCTRL;
+        case VK_LWIN: return K_LWIN;
+        case VK_RWIN: return K_RWIN;
+        case VK_APPS: return K_MENU;
+        
+        case VK_TAB: return K_TAB;
+        case VK_OEM_3: return K_TILDE;
+        case VK_OEM_MINUS: return K_MINUS;
+        case VK_OEM_PLUS: return K_EQUALS;
+        
+        case VK_RETURN:
+        {
+            if(!(lParam & (1<<24))) return K_RETURN;
+            else return KP_RETURN;
+        }
+        
+        case VK_SPACE: return K_SPACE;
+        case VK_OEM_4: return K_LBRACKET;
+        case VK_OEM_6: return K_RBRACKET;
+        case VK_OEM_1: return K_SEMICOLON;
+        case VK_OEM_7: return K_APOSTROPHE;
+        case VK_OEM_5: return K_BACKSLASH;
+        case VK_OEM_COMMA: return K_COMMA;
+        case VK_OEM_PERIOD: return K_PERIOD;
+        case VK_OEM_2: return K_SLASH;
+        
+        case 0x41: return K_A;
+        case 0x42: return K_B;
+        case 0x43: return K_C;
+        case 0x44: return K_D;
+        case 0x45: return K_E;
+        case 0x46: return K_F;
+        case 0x47: return K_G;
+        case 0x48: return K_H;
+        case 0x49: return K_I;
+        case 0x4a: return K_J;
+        case 0x4b: return K_K;
+        case 0x4c: return K_L;
+        case 0x4d: return K_M;
+        case 0x4e: return K_N;
+        case 0x4f: return K_O;
+        case 0x50: return K_P;
+        case 0x51: return K_Q;
+        case 0x52: return K_R;
+        case 0x53: return K_S;
+        case 0x54: return K_T;
+        case 0x55: return K_U;
+        case 0x56: return K_V;
+        case 0x57: return K_W;
+        case 0x58: return K_X;
+        case 0x59: return K_Y;
+        case 0x5a: return K_Z;
+        
+        case 0x31: return K_1;
+        case 0x32: return K_2;
+        case 0x33: return K_3;
+        case 0x34: return K_4;
+        case 0x35: return K_5;
+        case 0x36: return K_6;
+        case 0x37: return K_7;
+        case 0x38: return K_8;
+        case 0x39: return K_9;
+        case 0x30: return K_0;
+        
+        case VK_DIVIDE: return KP_SLASH;
+        case VK_MULTIPLY: return KP_MULTIPLY;
+        case VK_SUBTRACT: return KP_MINUS;
+        case VK_ADD: return KP_PLUS;
+        case VK_DECIMAL: return KP_PERIOD;
+        
+        case VK_NUMPAD0: return KP_0;
+        case VK_NUMPAD1: return KP_1;
+        case VK_NUMPAD2: return KP_2;
+        case VK_NUMPAD3: return KP_3;
+        case VK_NUMPAD4: return KP_4;
+        case VK_NUMPAD5: return KP_5;
+        case VK_NUMPAD6: return KP_6;
+        case VK_NUMPAD7: return KP_7;
+        case VK_NUMPAD8: return KP_8;
+        case VK_NUMPAD9: return KP_9;
+        
+        case VK_VOLUME_MUTE: return KM_MUTE;
+        case VK_VOLUME_DOWN: return KM_VOLDOWN;
+        case VK_VOLUME_UP: return KM_VOLUP;
+        case VK_MEDIA_PLAY_PAUSE: return KM_PLAYPAUSE;
+        case VK_MEDIA_STOP: return KM_STOP;
+        case VK_MEDIA_PREV_TRACK: return KM_PREV;
+        case VK_MEDIA_NEXT_TRACK: return KM_NEXT;
+        
+        default: return K_NONE;
+    }
+}
+
+/*======= State Components =========*/
+
+typedef struct
+{
+    PL_Window window;
+    
+    b32 init;
+    WNDCLASSA wndclass;
+    DWORD style;
+    WINDOWPLACEMENT wp;
+    HWND handle;
+    HDC dc;
+    HGLRC rc;
+} Win32_Window;
+
+typedef struct
+{
+    PL_Timer timer;
+    u64 perfFreq;
+    u64 lastFramePerf;
+    u64 frameTicks; // PL_GetTicks at the start of the frame
+    PL_PACINGMODE pacing;
+    r64 spinSec;
+    u64 pacedFrames;
+    PL_FrameHistogram histogram;
+} Win32_Timer;
+
+typedef struct
+{
+    PL_SystemInfo info;
+    ptr minAppAddress;
+    ptr maxAppAddress;
+} Win32_SystemInfo;
+
+/*========== WIN32 STATE =============*/
+
+typedef struct
+{
+    char errorString[1024];
+    b32 running;
+    u64 userMemorySize;
+    ptr userMemory;
+    u64 userMemoryCommitted; // userMemorySize rounded up to pages
+    u64 userMemoryReserved;
+    u64 userMemoryPageSize; // page size backing the block
+    b32 userMemoryHugePages; // huge/large pages requested
+    PL_Arena userArena;
+    PL_Arena frameArena; // reset after every PL_Frame
+    
+    Win32_SystemInfo system;
+    Win32_Timer timer;
+    Win32_Window window;
+    Win32_XInput xinput;
+    Win32_XAudio xaudio;
+    
+    PL_Clock clock;
+    u64 clockFrame; // frame the clock was computed for
+    u64 clockSec; // unix second of the cached date fields
+    PL_Input input;
+    PL_Audio audio;
+} Win32_State;
+static Win32_State *win32_state;
+
+void PL_SetErrorString(const cstr format, ...)
+{
+    PL_Str error = PL_StrBuffer(win32_state->errorString, sizeof(win32_state->errorString));
+    va_list args;
+    va_start(args, format);
+    PL_StrAppendV(&error, format, args);
+    va_end(args);
+    
+    PL_ErrorCallback();
+}
+
+void PL_Quit(void)
+{
+    win32_state->running = 0;
+}
+
+cstr PL_GetErrorString(void)
+{
+    return win32_state->errorString;
+}
+
+PL_Timer *PL_GetTimer(void)
+{
+    return &win32_state->timer.timer;
+}
+
+PL_Input* PL_GetInput(void)
+{
+    return &win32_state->input;
+}
+
+PL_Mouse* PL_GetMouse(void)
+{
+    return &win32_state->input.mouse;
+}
+
+PL_Gamepad* PL_GetGamepad(i32 id)
+{
+    if(id >= 0 && id <= GP_MAX_COUNT)
+        return &win32_state->input.gamepads[id];
+    
+    return 0;
+}
+
+PL_ButtonState* PL_GetKeyState(PL_KEYCODE key)
+{
+    if(key > 0 && key < K_MAX)
+        return &win32_state->input.keyboard[key];
+    
+    return 0;
+}
+
+/*========= OPENGL LOADERS ==========*/
+
+static ptr PL_GLGetProcAddress(const char *name)
+{
+    // wglGetProcAddress only knows extension/1.2+ functions, 1.1 comes from the dll
+    static HMODULE lib;
+    ptr result = (ptr)wglGetProcAddress(name);
+    if(!result)
+    {
+        if(!lib) lib = LoadLibraryA("opengl32.dll");
+        result = (ptr)GetProcAddress(lib, name);
+    }
+    return result;
+}
+
+#define WIN32_LOAD_WGLFN(name) {name = (pfn_##name)wglGetProcAddress( #name ); if(!name) return 0;}
+static b32 Win32_LoadWGL(void)
+{
+    WIN32_LOAD_WGLFN(wglChoosePixelFormatARB);
+    WIN32_LOAD_WGLFN(wglCreateContextAttribsARB);
+    WIN32_LOAD_WGLFN(wglSwapIntervalEXT);
+    
+    return 1;
+}
+
+static void Win32_LoadXInput(void)
+{
+    WIN32_XINPUT_LOADED_VERSION version = WIN32_XINPUT_NOT_LOADED;
+    HMODULE lib = 0;
+    
+    lib = LoadLibraryA("xinput1_4.dll");
+    
+    if(lib)
+    {
+        version = WIN32_XINPUT_1_4;
+    }
+    
+    else
+    {
+        lib = LoadLibraryA("xinput9_1_0.dll");
+        
+        if(lib)
+        {
+            version = WIN32_XINPUT_9_1_0;
+        }
+        
+        else
+        {
+            lib = LoadLibraryA("xinput1_3.dll");
+            
+            if(lib)
+            {
+                version = WIN32_XINPUT_1_3;
+            }
+            
+            else
+            {
+                //NOTE: if xinput failed to load, controllers will just appear to be disconnected.
+                PL_SetErrorString("Failed to load xinput DLL.");
+                win32_state->xinput.version = WIN32_XINPUT_NOT_LOADED;
+                win32_state->xinput.GetState = sfn_XInputGetState;
+                win32_state->xinput.SetState = sfn_XInputSetState;
+            }
+        }
+    }
+    
+    if(lib)
+    {
+        win32_state->xinput.version = version;
+        win32_state->xinput.GetState = (tfn_XInputGetState *)GetProcAddress(lib, "XInputGetState");
+        win32_state->xinput.SetState = (tfn_XInputSetState *)GetProcAddress(lib, "XInputSetState");
+    }
+}
+
+static void Win32_LoadXAudio(void)
+{
+    WIN32_XAUDIO_LOADED_VERSION version = WIN32_XAUDIO_NOT_LOADED;
+    HMODULE lib = 0;
+    
+    lib = LoadLibraryA("xaudio2_9.dll");
+    
+    if(lib)
+    {
+        version = WIN32_XAUDIO_2_9;
+    }
+    
+    else
+    {
+        lib = LoadLibraryA("xaudio2_9d.dll");
+        
+        if(lib)
+        {
+            version = WIN32_XAUDIO_2_9D;
+        }
+        
+        else
+        {
+            lib = LoadLibraryA("xaudio2_8.dll");
+            
+            if(lib)
+            {
+                version = WIN32_XAUDIO_2_8;
+            }
+            
+            else
+            {
+                lib = LoadLibraryA("xaudio2_7.dll");
+                
+                if(lib)
+                {
+                    version = WIN32_XAUDIO_2_7;
+                }
+                
+                else
+                {
+                    //NOTE: if xaudio doesnt load, audio just wont play
+                    PL_SetErrorString("Failed to load xaudio DLL.");
+                    win32_state->xaudio.version = WIN32_XAUDIO_NOT_LOADED;
+                    win32_state->xaudio.Create = sfn_XAudio2Create;
+                }
+            }
+        }
+    }
+    
+    if(lib)
+    {
+        win32_state->xaudio.version = version;
+        win32_state->xaudio.Create = (tfn_XAudio2Create *)GetProcAddress(lib, "XAudio2Create");
+    }
+}
+
+static void Win32_AudioInit(void)
+{
+    if(win32_state->xaudio.version == WIN32_XAUDIO_NOT_LOADED)
+    {
+        return;
+    }
+    
+    Win32_XAudio *xaudio = &win32_state->xaudio;
+    IXAudio2 *handle = xaudio->handle;
+    HRESULT ecode;
+    
+    ecode = XAudio2Create(&handle, 0, XAUDIO2_DEFAULT_PROCESSOR);
+    if(FAILED(ecode))
+    {
+        PL_SetErrorString("Failed to create XAudio2 Handle. Code(%d)", ecode);
+        return;
+    }
+    
+#if defined(__cplusplus)
+    ecode = handle->CreateMasteringVoice(&xaudio->masterVoice, 2, AUDIO_SAMPLE_RATE, 0,0,0,0);
+#else
+    ecode = IXAudio2_CreateMasteringVoice(handle, &xaudio->masterVoice, 2, AUDIO_SAMPLE_RATE, 0,0,0,0);
+#endif
+    if(FAILED(ecode))
+    {
+        PL_SetErrorString("Failed to create XAudio2 Mastering Voice. Code(%d)", ecode);
+        return;
+    }
+    
+	WAVEFORMATEX *fmt = &xaudio->fmt;
+    fmt->wFormatTag = WAVE_FORMAT_PCM;
+    fmt->nChannels = 2;
+    fmt->nSamplesPerSec = AUDIO_SAMPLE_RATE;
+    fmt->wBitsPerSample = 16;
+    fmt->nBlockAlign = (fmt->nChannels * fmt->wBitsPerSample)/8;
+    fmt->nAvgBytesPerSec = fmt->nSamplesPerSec * fmt->nBlockAlign;
+    fmt->cbSize = 0;
+    
+#if defined(__cplusplus)
+    ecode = handle->CreateSourceVoice(&xaudio->srcVoice, (WAVEFORMATEX*)fmt, 0, XAUDIO2_MAX_FREQ_RATIO, 0,0,0);
+#else
+    ecode = IXAudio2_CreateSourceVoice(handle, &xaudio->srcVoice, (WAVEFORMATEX*)fmt, 0, XAUDIO2_MAX_FREQ_RATIO, 0, 0, 0);
+#endif
+    if(FAILED(ecode))
+    {
+        PL_SetErrorString("Failed to set XAudio2 audio format. Code(%d)", ecode);
+        return;
+    }
+    
+    XAUDIO2_BUFFER *buffer = &xaudio->bufferHeader;
+    buffer->Flags = 0; //XAUDIO2_END_OF_STREAM if buffer is empty
+    buffer->AudioBytes = AUDIO_BUFFER_SIZE;
+    buffer->pAudioData = (BYTE*)win32_state->audio.buffer; // ptr to buffer
+    buffer->PlayBegin = 0;
+    buffer->PlayLength = 0; // 0 = whole buffer
+    buffer->LoopBegin = 0;
+    buffer->LoopLength = 0;
+    buffer->LoopCount = XAUDIO2_LOOP_INFINITE;
+    buffer->pContext = 0; // callback context
+    
+#if defined(__cplusplus)
+    ecode = xaudio->srcVoice.SubmitSourceBuffer(buffer, 0);
+#else
+    ecode = IXAudio2SourceVoice_SubmitSourceBuffer(xaudio->srcVoice, buffer, 0);
+#endif
+    if(FAILED(ecode))
+    {
+        PL_SetErrorString("Failed to submit XAudio2 buffer. Code(%d)", ecode);
+        return;
+    }
+    
+#if defined(__cplusplus)
+    ecode = xaudio->srcVoice.Start(0, XAUDIO2_COMMIT_NOW);
+#else
+    ecode = IXAudio2SourceVoice_Start(xaudio->srcVoice, 0, XAUDIO2_COMMIT_NOW);
+#endif
+    if(FAILED(ecode))
+    {
+        PL_SetErrorString("XAudio2 failed to play buffer. Code(%d)", ecode);
+        return;
+    }
+}
+
+PL_Audio* PL_GetAudio(void)
+{
+    return &win32_state->audio;
+}
+
+ptr PL_GetAudioBuffer(void)
+{
+    return (ptr)&win32_state->audio.buffer[0];
+}
+
+static void Win32_AudioFrame(void)
+{
+    PL_PROFILE_BEGIN("Win32_AudioFrame");
+    XAUDIO2_VOICE_STATE state;
+#if defined(__cplusplus)
+    win32_state->xaudio.srcVoice.GetState(&state, 0);
+#else
+    IXAudio2SourceVoice_GetState(win32_state->xaudio.srcVoice, &state, 0);
+#endif
+    
+    PL_GetAudio()->playCursor = state.SamplesPlayed % AUDIO_BUFFER_SIZE;
+    
+    PL_PROFILE_END();
+}
+
+/*========= WIN32 TIMER =============*/
+
+// FILETIME counts 100ns intervals since 1601
+#define WIN32_FILETIME_UNIX_EPOCH 116444736000000000ULL
+
+static u64 Win32_GetUnixTimeNs(void)
+{
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    u64 t = ((u64)ft.dwHighDateTime << 32) | (u64)ft.dwLowDateTime;
+    return (t - WIN32_FILETIME_UNIX_EPOCH) * 100;
+}
+
+// the timezone conversion only runs when the second changes
+static void Win32_UpdateClock(void)
+{
+    PL_Clock *clock = &win32_state->clock;
+    u64 unixNs = PL_TicksToUnixNs(win32_state->timer.frameTicks);
+    u64 sec = unixNs / 1000000000ULL;
+    
+    if(sec != win32_state->clockSec)
+    {
+        u64 t = (sec * 10000000ULL) + WIN32_FILETIME_UNIX_EPOCH;
+        FILETIME ft = {(DWORD)t, (DWORD)(t >> 32)};
+        SYSTEMTIME utc = {0};
+        SYSTEMTIME st = {0};
+        FileTimeToSystemTime(&ft, &utc);
+        SystemTimeToTzSpecificLocalTime(0, &utc, &st);
+        clock->year = st.wYear;
+        clock->month = st.wMonth;
+        clock->day = st.wDay;
+        clock->wday = ((st.wDayOfWeek) ? st.wDayOfWeek : 7);
+        clock->hr = st.wHour;
+        clock->min = st.wMinute;
+        clock->sec = st.wSecond;
+        win32_state->clockSec = sec;
+    }
+    
+    clock->ms = (u16)((unixNs / 1000000ULL) % 1000);
+}
+
+PL_Clock *PL_GetClock(void)
+{
+    if(win32_state->clockFrame != win32_state->timer.timer.frames)
+    {
+        Win32_UpdateClock();
+        win32_state->clockFrame = win32_state->timer.timer.frames;
+    }
+    
+    return &win32_state->clock;
+}
+
+static u64 Win32_GetPerfCount(void)
+{
+    LARGE_INTEGER perf;
+    QueryPerformanceCounter(&perf);
+    return (u64)perf.QuadPart;
+}
+
+static void Win32_InitTimer(void)
+{
+    LARGE_INTEGER freqResult;
+    QueryPerformanceFrequency(&freqResult);
+    win32_state->timer.perfFreq = (u64)freqResult.QuadPart;
+    PL_InitTicks(win32_state->system.info.invariantTSC, Win32_GetPerfCount, win32_state->timer.perfFreq);
+    PL_InitWallClock(Win32_GetUnixTimeNs);
+}
+
+r64 Win32_GetPerfDiff(u64 start, u64 end)
+{
+    r64 result = (((r64)end - (r64)start) / (r64)win32_state->timer.perfFreq);
+    return result;
+}
+
+r64 Win32_GetPerfElapsed(u64 prev)
+{
+    r64 result = Win32_GetPerfDiff(prev, Win32_GetPerfCount());
+    return result;
+}
+
+static void Win32_WaitForFrame(u64 targetPerf)
+{
+    Win32_Timer *timer = &win32_state->timer;
+    
+    if(timer->pacing == PACE_HYBRID)
+    {
+        // Sleep is only ms granular (with timeBeginPeriod(1)), so wake spinSec early
+        u64 spinPerf = (u64)(timer->spinSec * (r64)timer->perfFreq);
+        u64 perf = Win32_GetPerfCount();
+        
+        if(perf + spinPerf < targetPerf)
+        {
+            DWORD sleepMs = (DWORD)(((targetPerf - spinPerf - perf) * 1000) / timer->perfFreq);
+            if(sleepMs) Sleep(sleepMs);
+        }
+    }
+    
+    while(Win32_GetPerfCount() < targetPerf) {}
+}
+
+static void Win32_UpdateTimer(void)
+{
+    PL_PROFILE_BEGIN("Win32_UpdateTimer");
+    
+    Win32_Timer *timer = &win32_state->timer;
+    b32 paced = (!win32_state->window.window.vsync &&
+                 win32_state->window.window.framerate > 0);
+    r64 targetSecPerFrame = 0.0;
+    
+    if(paced)
+    {
+        targetSecPerFrame = (1.0/(r64)win32_state->window.window.framerate);
+        Win32_WaitForFrame(timer->lastFramePerf + (u64)(targetSecPerFrame * (r64)timer->perfFreq));
+    }
+    
+    if(timer->timer.tLastFrame)
+    {
+        timer->timer.tAvgFrame += timer->timer.tLastFrame;
+        timer->timer.tAvgFrame /= 2.0f;
+    }
+    
+    timer->timer.tLastFrame = Win32_GetPerfElapsed(timer->lastFramePerf);
+    timer->lastFramePerf = Win32_GetPerfCount();
+    timer->frameTicks = PL_GetTicks();
+    timer->timer.frames++;
+    
+    timer->timer.tJitter = 0.0;
+    if(paced && timer->timer.frames > 1)
+    {
+        timer->timer.tJitter = fabs(timer->timer.tLastFrame - targetSecPerFrame);
+        timer->pacedFrames++;
+        timer->timer.tAvgJitter += (timer->timer.tJitter - timer->timer.tAvgJitter) / (r64)timer->pacedFrames;
+    }
+    
+    // first update measures from 0, not a real frame
+    if(timer->timer.frames > 1)
+    {
+        i32 framerate = win32_state->window.window.framerate;
+        r64 tBudget = (framerate > 0) ? (1.0/(r64)framerate) : 0.0;
+        PL_FrameHistogramAdd(&timer->histogram, timer->timer.tLastFrame, tBudget);
+    }
+    
+    PL_PROFILE_END();
+}
+
+PL_FrameStats PL_GetFrameStats(void)
+{
+    return PL_FrameHistogramStats(&win32_state->timer.histogram);
+}
+
+void PL_ResetFrameStats(void)
+{
+    PL_MemZero(&win32_state->timer.histogram, sizeof(PL_FrameHistogram));
+}
+
+void PL_SetFramePacing(PL_PACINGMODE mode, r64 spinSec)
+{
+    win32_state->timer.pacing = mode;
+    if(spinSec >= 0.0) win32_state->timer.spinSec = spinSec;
+}
+
+u64 PL_GetTicks(void)
+{
+    return pl_ticks.tsc ? PL_ReadTSC() : Win32_GetPerfCount();
+}
+
+/*========== SystemInfo ===============*/
+
+static void Win32_SetSystemInfo(void)
+{
+    PL_SystemInfo *info = &win32_state->system.info;
+    PL_DetectCPUFeatures(info);
+    
+    SYSTEM_INFO si = {0};
+    GetNativeSystemInfo(&si);
+    
+    switch(si.wProcessorArchitecture)
+    {
+        case PROCESSOR_ARCHITECTURE_AMD64:
+        {
+            info->cpu = CPU_AMD64;
+        } break;
+        
+        case PROCESSOR_ARCHITECTURE_ARM:
+        {
+            info->cpu = CPU_ARM;
+        } break;
+        
+        case PROCESSOR_ARCHITECTURE_ARM64:
+        {
+            info->cpu = CPU_ARM64;
+        } break;
+        
+        case PROCESSOR_ARCHITECTURE_IA64:
+        {
+            info->cpu = CPU_IA64;
+        } break;
+        
+        case PROCESSOR_ARCHITECTURE_INTEL:
+        {
+            info->cpu = CPU_I86;
+        } break;
+        
+        default:
+        {
+            info->cpu = CPU_UNKNOWN;
+        }
+    }
+    
+    win32_state->system.minAppAddress = (ptr)si.lpMinimumApplicationAddress;
+    win32_state->system.maxAppAddress = (ptr)si.lpMaximumApplicationAddress;
+    info->logicalCores = (u32)si.dwNumberOfProcessors;
+    info->pageSize = (u64)si.dwPageSize;
+    info->largePageSize = (u64)GetLargePageMinimum();
+    
+    // one entry per core / cache instance, caches are reported per core so the first of each level is used
+    DWORD bufferSize = 0;
+    GetLogicalProcessorInformation(0, &bufferSize);
+    SYSTEM_LOGICAL_PROCESSOR_INFORMATION *procInfo = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION*)PL_Alloc(bufferSize);
+    
+    if(procInfo && GetLogicalProcessorInformation(procInfo, &bufferSize))
+    {
+        u32 count = bufferSize / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
+        for(u32 index = 0; index < count; index++)
+        {
+            if(procInfo[index].Relationship == RelationProcessorCore)
+            {
+                info->physicalCores++;
+            }
+            
+            else if(procInfo[index].Relationship == RelationCache)
+            {
+                CACHE_DESCRIPTOR *cache = &procInfo[index].Cache;
+                if(cache->Type != CacheData && cache->Type != CacheUnified) continue;
+                
+                if(cache->Level == 1 && !info->l1DataCache)
+                {
+                    info->l1DataCache = cache->Size;
+                    info->cacheLineSize = cache->LineSize;
+                }
+                else if(cache->Level == 2 && !info->l2Cache) info->l2Cache = cache->Size;
+                else if(cache->Level == 3 && !info->l3Cache) info->l3Cache = cache->Size;
+            }
+        }
+    }
+    
+    if(procInfo) PL_Free(procInfo);
+    if(!info->physicalCores) info->physicalCores = info->logicalCores;
+    
+    PL_InitDispatch(info);
+}
+
+PL_SystemInfo *PL_GetSystemInfo(void)
+{
+    return &win32_state->system.info;
+}
+
+
+/*========== USER MEMORY ===============*/
+
+// the user block is one reserved address range, pages are committed as it grows so it never moves
+// fresh and re-committed pages read as zero
+static b32 Win32_CommitUserMemory(u64 size)
+{
+    u64 pageSize = win32_state->userMemoryPageSize;
+    u64 committed = win32_state->userMemoryCommitted;
+    u64 newCommitted = (size + pageSize - 1) & ~(pageSize - 1);
+    
+    if(newCommitted > win32_state->userMemoryReserved)
+    {
+        return 0;
+    }
+    
+    // large pages are locked and committed up front, only the size changes
+    if(pageSize > win32_state->system.info.pageSize)
+    {
+        // nothing is decommitted, clear what was given up so growing back reads zero
+        if(size < win32_state->userMemorySize)
+        {
+            u64 oldCommitted = (win32_state->userMemorySize + pageSize - 1) & ~(pageSize - 1);
+            PL_MemZero((u8*)win32_state->userMemory + size, oldCommitted - size);
+        }
+        
+        win32_state->userMemorySize = size;
+        return 1;
+    }
+    
+    if(newCommitted > committed)
+    {
+        if(!VirtualAlloc((u8*)win32_state->userMemory + committed, newCommitted - committed,
+                         MEM_COMMIT, PAGE_READWRITE))
+        {
+            return 0;
+        }
+    }
+    
+    else if(newCommitted < committed)
+    {
+        VirtualFree((u8*)win32_state->userMemory + newCommitted, committed - newCommitted, MEM_DECOMMIT);
+    }
+    
+    // the tail of the last page stays committed, clear it so growing back reads zero
+    if(size < win32_state->userMemorySize)
+    {
+        PL_MemZero((u8*)win32_state->userMemory + size, newCommitted - size);
+    }
+    
+    win32_state->userMemoryCommitted = newCommitted;
+    win32_state->userMemorySize = size;
+    return 1;
+}
+
+// MEM_LARGE_PAGES needs SeLockMemoryPrivilege granted to the user ("Lock pages in memory" policy)
+static b32 Win32_EnableLockMemoryPrivilege(void)
+{
+    if(!Win32_LoadAdvApiLib()) return 0;
+    
+    HANDLE token = 0;
+    if(!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) return 0;
+    
+    TOKEN_PRIVILEGES privileges = {0};
+    privileges.PrivilegeCount = 1;
+    privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+    
+    b32 result = 0;
+    if(LookupPrivilegeValueA(0, "SeLockMemoryPrivilege", &privileges.Privileges[0].Luid) &&
+       AdjustTokenPrivileges(token, FALSE, &privileges, 0, 0, 0))
+    {
+        // succeeds without assigning when the user doesn't hold the privilege
+        result = (GetLastError() == ERROR_SUCCESS);
+    }
+    
+    CloseHandle(token);
+    return result;
+}
+
+// large pages can't be reserved and committed separately, so the block is committed
+// at its startup size (rounded up to the large page size) and can't grow past that
+static b32 Win32_InitLargePageUserMemory(u64 size)
+{
+    u64 largePageSize = (u64)GetLargePageMinimum();
+    if(!largePageSize || !Win32_EnableLockMemoryPrivilege()) return 0;
+    
+    u64 largeSize = (size + largePageSize - 1) & ~(largePageSize - 1);
+    ptr memory = VirtualAlloc(0, largeSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+    if(!memory) return 0;
+    
+    win32_state->userMemory = memory;
+    win32_state->userMemoryReserved = largeSize;
+    win32_state->userMemoryCommitted = largeSize;
+    win32_state->userMemoryPageSize = largePageSize;
+    win32_state->userMemorySize = size;
+    return 1;
+}
+
+static b32 Win32_InitUserMemory(u64 size)
+{
+    if(win32_state->userMemoryHugePages)
+    {
+        if(Win32_InitLargePageUserMemory(size))
+        {
+            return 1;
+        }
+        
+        PL_SetErrorString("large pages unavailable for user memory, using %llu byte pages",
+                          (unsigned long long)win32_state->system.info.pageSize);
+    }
+    
+    win32_state->userMemory = VirtualAlloc(0, PL_USER_MEMORY_RESERVE, MEM_RESERVE, PAGE_NOACCESS);
+    
+    if(!win32_state->userMemory)
+    {
+        return 0;
+    }
+    
+    win32_state->userMemoryReserved = PL_USER_MEMORY_RESERVE;
+    win32_state->userMemoryPageSize = win32_state->system.info.pageSize;
+    return Win32_CommitUserMemory(size);
+}
+
+/*============== WNDPROC ============*/
+
+LRESULT CALLBACK Win32_WndProc(HWND window,
+                               UINT msg,
+                               WPARAM wParam,
+                               LPARAM lParam)
+{
+    LRESULT result = 0;
+    
+    Win32_Window *win32_window = &win32_state->window;
+    PL_Window *pl_window = &win32_window->window;
+    PL_Input *input = &win32_state->input;
+    if(!win32_window->init)
+        return DefWindowProcA(window, msg, wParam, lParam);
+    
+    switch(msg)
+    {
+        case WM_QUIT:
+        case WM_CLOSE:
+        case WM_DESTROY:
+        {
+            win32_state->running = 0;
+        } break;
+        
+        case WM_ACTIVATEAPP:
+        {
+            if(wParam == TRUE) pl_window->focus = 1;
+            if(wParam == FALSE) pl_window->focus = 0;
+        } break;
+        
+        case WM_MOVE:
+        {
+            pl_window->dim.x = (int)(short)LOWORD(lParam);
+            pl_window->dim.y = (int)(short)HIWORD(lParam);
+        } break;
+        
+        case WM_SIZE:
+        {
+            pl_window->dim.w = (int)LOWORD(lParam);
+            pl_window->dim.h = (int)HIWORD(lParam);
+            glViewport(0, 0, LOWORD(lParam), HIWORD(lParam));
+        } break;
+        
+        case WM_KEYDOWN:
+        case WM_SYSKEYDOWN:
+        {
+            if((lParam & (1 << 29))) //an ALT key
+            {
+                if(lParam & (1 << 24)) //right ALT key
+                {
+                    win32_state->input.keyboard[K_RALT].isDown = 1;
+                }
+                
+                else // left ALT key
+                {
+                    win32_state->input.keyboard[K_LALT].isDown = 1;
+                }
+                
+            }
+            
+            PL_KEYCODE key = Win32_WinKeyToPLKeycode((u32)wParam, lParam);
+            win32_state->input.keyboard[key].isDown = 1;
+            
+        } break;
+        
+        case WM_KEYUP:
+        case WM_SYSKEYUP:
+        {
+            //TODO: fix this. currently, if holding ALT, when another keyup
+            // happens, the game will treat this as ALT key up followed by
+            // another ALT keydown next frame, rather than ALT staying down.
+            if(input->keyboard[K_RALT].isDown)
+            {
+                input->keyboard[K_RALT].isDown = 0;
+            }
+            
+            if(input->keyboard[K_LALT].isDown)
+            {
+                input->keyboard[K_LALT].isDown = 0;
+            }
+            
+            PL_KEYCODE key = Win32_WinKeyToPLKeycode((u32)wParam, lParam);
+            input->keyboard[key].isDown = 0;
+        } break;
+        
+        case WM_MOUSEMOVE:
+        {
+            POINT cursor = {0};
+            GetCursorPos(&cursor);
+            ScreenToClient(win32_window->handle, &cursor);
+            input->mouse.px = cursor.x;
+            input->mouse.py = cursor.y;
+            input->mouse.rx = (PL_norm32((r32)cursor.x, 0.0f, (r32)pl_window->dim.w) * 2.0f) - 1.0f;
+            input->mouse.ry = (PL_norm32((r32)cursor.y, 0.0f, (r32)pl_window->dim.h) * 2.0f) - 1.0f;
+        } break;
+        
+        case WM_LBUTTONDOWN:
+        {
+            input->mouse.buttons[MB_LEFT].isDown = 1;
+        } break;
+        
+        case WM_MBUTTONDOWN:
+        {
+            input->mouse.buttons[MB_MIDDLE].isDown = 1;
+        } break;
+        
+        case WM_RBUTTONDOWN:
+        {
+            input->mouse.buttons[MB_RIGHT].isDown = 1;
+        } break;
+        
+        case WM_XBUTTONDOWN:
+        {
+            if(wParam & MK_XBUTTON1)
+            {
+                input->mouse.buttons[MB_X1].isDown = 1;
+            }
+            
+            if(wParam & MK_XBUTTON2)
+            {
+                input->mouse.buttons[MB_X2].isDown = 1;
+            }
+            
+        } break;
+        
+        case WM_LBUTTONUP:
+        {
+            input->mouse.buttons[MB_LEFT].isDown = 0;
+        } break;
+        
+        case WM_MBUTTONUP:
+        {
+            input->mouse.buttons[MB_MIDDLE].isDown = 0;
+        } break;
+        
+        case WM_RBUTTONUP:
+        {
+            input->mouse.buttons[MB_RIGHT].isDown = 0;
+        } break;
+        
+        case WM_XBUTTONUP:
+        {
+            if(wParam & MK_XBUTTON1)
+            {
+                input->mouse.buttons[MB_X1].isDown = 0;
+            }
+            
+            if(wParam & MK_XBUTTON2)
+            {
+                input->mouse.buttons[MB_X2].isDown = 0;
+            }
+            
+        } break;
+        
+        case WM_MOUSEWHEEL:
+        {
+            if(GET_WHEEL_DELTA_WPARAM(wParam) < 0)
+            {
+                input->mouse.wheel--;
+            }
+            
+            if(GET_WHEEL_DELTA_WPARAM(wParam) > 0)
+            {
+                input->mouse.wheel++;
+            }
+            
+        } break;
+        
+        default:
+        {
+            result = DefWindowProcA(window, msg, wParam, lParam);
+        }
+    }
+    
+    return result;
+}
+
+/*================================
+   Window Functions
+================================*/
+
+// thanks Raymond Chen, the win32GOAT
+static void Win32_FullscreenToggle(void)
+{
+    DWORD style = GetWindowLong(win32_state->window.handle, GWL_STYLE);
+    if(style & WS_OVERLAPPEDWINDOW)
+    {
+        MONITORINFO monitorInfo = {sizeof(monitorInfo)};
+        if(GetWindowPlacement(win32_state->window.handle, &win32_state->window.wp) &&
+           GetMonitorInfo(MonitorFromWindow(win32_state->window.handle, MONITOR_DEFAULTTOPRIMARY), &monitorInfo))
+        {
+            SetWindowLong(win32_state->window.handle, GWL_STYLE, style & ~WS_OVERLAPPEDWINDOW);
+            SetWindowPos(win32_state->window.handle, HWND_TOP,
+                         monitorInfo.rcMonitor.left, monitorInfo.rcMonitor.top,
+                         monitorInfo.rcMonitor.right - monitorInfo.rcMonitor.left,
+                         monitorInfo.rcMonitor.bottom - monitorInfo.rcMonitor.top,
+                         SWP_NOOWNERZORDER | SWP_FRAMECHANGED);
+            win32_state->window.window.fullscreen = 1;
+        }
+    }
+    else
+    {
+        SetWindowLong(win32_state->window.handle, GWL_STYLE, style | WS_OVERLAPPEDWINDOW);
+        SetWindowPlacement(win32_state->window.handle, &win32_state->window.wp);
+        SetWindowPos(win32_state->window.handle, 0, 0, 0, 0, 0,
+                     SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER |
+                     SWP_NOOWNERZORDER | SWP_FRAMECHANGED);
+        win32_state->window.window.fullscreen = 0;
+    }
+}
+
+static void Win32_SetVSync(b32 vsync)
+{
+    if(vsync)
+    {
+        win32_state->window.window.vsync = 1;
+        wglSwapIntervalEXT(1);
+    }
+    else
+    {
+        win32_state->window.window.vsync = 0;
+        wglSwapIntervalEXT(0);
+    }
+}
+
+static void Win32_ProcessXInputButton(XINPUT_GAMEPAD *xpad, PL_Gamepad *gamepad,
+                                      WORD xbutton, PL_GAMEPADBTNCODE btnCode, r64 dT)
+{
+    if((xpad->wButtons & xbutton) != 0)
+    {
+        gamepad->buttons[btnCode].isDown = 1;
+        gamepad->buttons[btnCode].tDown += dT;
+    }
+    else
+    {
+        gamepad->buttons[btnCode].isDown = 0;
+    }
+}
+
+static void Win32_ProcessInput(r64 dT)
+{
+    PL_PROFILE_BEGIN("Win32_ProcessInput");
+    PL_ButtonState *keyboard = win32_state->input.keyboard;
+    for(int keyIndex = 0;
+        keyIndex < K_MAX;
+        keyIndex++)
+    {
+        if(keyboard[keyIndex].isDown)
+        {
+            if(!keyboard[keyIndex].wasDown)
+            {
+                keyboard[keyIndex].downTick = 1;
+            }
+            keyboard[keyIndex].tDown += dT;
+        }
+        else if(keyboard[keyIndex].wasDown)
+        {
+            keyboard[keyIndex].upTick = 1;
+        }
+    }
+    
+    PL_ButtonState *buttons = win32_state->input.mouse.buttons;
+    for(int mouseBtnIndex = 0;
+        mouseBtnIndex < MB_MAX;
+        mouseBtnIndex++)
+    {
+        if(buttons[mouseBtnIndex].isDown)
+        {
+            if(!buttons[mouseBtnIndex].wasDown)
+            {
+                buttons[mouseBtnIndex].downTick = 1;
+            }
+            buttons[mouseBtnIndex].tDown += dT;
+        }
+        else if(buttons[mouseBtnIndex].wasDown)
+        {
+            buttons[mouseBtnIndex].upTick = 1;
+        }
+    }
+    
+    PL_Gamepad *gamepads = win32_state->input.gamepads;
+    for(int gamepadIndex = 0;
+        gamepadIndex < XUSER_MAX_COUNT;
+        gamepadIndex++)
+    {
+        if(gamepads[gamepadIndex].isConnected)
+        {
+            for(int gamepadBtnIndex = 0;
+                gamepadBtnIndex < GP_MAX;
+                gamepadBtnIndex++)
+            {
+                if(gamepads[gamepadIndex].buttons[gamepadBtnIndex].isDown)
+                {
+                    if(!gamepads[gamepadIndex].buttons[gamepadBtnIndex].wasDown)
+                    {
+                        gamepads[gamepadIndex].buttons[gamepadBtnIndex].downTick = 1;
+                    }
+                    gamepads[gamepadIndex].buttons[gamepadBtnIndex].tDown += dT;
+                }
+                else if(gamepads[gamepadIndex].buttons[gamepadBtnIndex].wasDown)
+                {
+                    gamepads[gamepadIndex].buttons[gamepadBtnIndex].upTick = 1;
+                }
+            }
+        }
+    }
+    
+    for(int gamepadIndex = 0;
+        gamepadIndex < XUSER_MAX_COUNT;
+        gamepadIndex++)
+    {
+        XINPUT_STATE xpadState;
+        
+        if(win32_state->xinput.GetState((DWORD)gamepadIndex, &xpadState) == ERROR_SUCCESS)
+        {
+            XINPUT_GAMEPAD *xpad = &xpadState.Gamepad;
+            PL_Gamepad *gamepad = &gamepads[gamepadIndex];
+            
+            gamepad->isConnected = 1;
+            
+            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_A, GP_A, dT);
+            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_B, GP_B, dT);
+            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_X, GP_X, dT);
+            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_Y, GP_Y, dT);
+            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_START, GP_START, dT);
+            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_BACK, GP_BACK, dT);
+            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_LEFT_SHOULDER, GP_LEFTSHOULDER, dT);
+            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_RIGHT_SHOULDER, GP_RIGHTSHOULDER, dT);
+            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_DPAD_UP, GP_DPAD_UP, dT);
+            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_DPAD_DOWN, GP_DPAD_DOWN, dT);
+            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_DPAD_LEFT, GP_DPAD_LEFT, dT);
+            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_DPAD_RIGHT, GP_DPAD_RIGHT, dT);
+            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_LEFT_THUMB, GP_L3, dT);
+            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_RIGHT_THUMB, GP_R3, dT);
+            
+            gamepad->LT = ((r32)xpad->bLeftTrigger / 255.0f);
+            gamepad->RT = ((r32)xpad->bRightTrigger / 255.0f);
+            
+            if(xpad->sThumbLX < 0) gamepad->LS.x = PL_norm32(xpad->sThumbLX, 0, 32768);
+            else gamepad->LS.x = PL_norm32(xpad->sThumbLX, 0, 32767);
+            if(xpad->sThumbLY < 0) gamepad->LS.y = PL_norm32(xpad->sThumbLY, 0, 32768);
+            else gamepad->LS.y = PL_norm32(xpad->sThumbLY, 0, 32767);
+            if(xpad->sThumbRX < 0) gamepad->RS.x = PL_norm32(xpad->sThumbRX, 0, 32768);
+            else gamepad->RS.x = PL_norm32(xpad->sThumbRX, 0, 32767);
+            if(xpad->sThumbRY < 0) gamepad->RS.y = PL_norm32(xpad->sThumbRY, 0, 32768);
+            else gamepad->RS.y = PL_norm32(xpad->sThumbRY, 0, 32767);
+            
+            if(gamepad->LVib > 1.0f) gamepad->LVib = 1.0f;
+            else if(gamepad->LVib < 0.0f) gamepad->LVib = 0.0f;
+            if(gamepad->RVib > 1.0f) gamepad->RVib = 1.0f;
+            else if(gamepad->RVib < 0.0f) gamepad->RVib = 0.0f;
+            
+            XINPUT_VIBRATION vib;
+            vib.wLeftMotorSpeed = (WORD)(65535.0f * gamepad->LVib);
+            vib.wRightMotorSpeed = (WORD)(65535.0f * gamepad->RVib);
+            win32_state->xinput.SetState(gamepadIndex, &vib);
+        }
+        
+        else
+        {
+            if(gamepads[gamepadIndex].isConnected)
+            {
+                PL_MemZero(&gamepads[gamepadIndex], sizeof(PL_Gamepad));
+            }
+        }
+    }
+    
+    PL_PROFILE_END();
+}
+
+static void Win32_UpdateInput(void)
+{
+    PL_ButtonState *keyboard = win32_state->input.keyboard;
+    for(int keyIndex = 0;
+        keyIndex < K_MAX;
+        keyIndex++)
+    {
+        if(keyboard[keyIndex].isDown)
+        {
+            if(!keyboard[keyIndex].wasDown)
+            {
+                keyboard[keyIndex].wasDown = 1;
+            }
+            
+            keyboard[keyIndex].downTick = 0;
+        }
+        else if(keyboard[keyIndex].wasDown)
+        {
+            keyboard[keyIndex].wasDown = 0;
+        }
+        else
+        {
+            keyboard[keyIndex].tDown = 0.0f;
+        }
+        
+        keyboard[keyIndex].downTick = 0;
+        keyboard[keyIndex].upTick = 0;
+    }
+    
+    PL_ButtonState *buttons = win32_state->input.mouse.buttons;
+    for(int mouseBtnIndex = 0;
+        mouseBtnIndex < MB_MAX;
+        mouseBtnIndex++)
+    {
+        if(buttons[mouseBtnIndex].isDown)
+        {
+            if(!buttons[mouseBtnIndex].wasDown)
+            {
+                buttons[mouseBtnIndex].wasDown = 1;
+            }
+            
+            buttons[mouseBtnIndex].downTick = 0;
+        }
+        else if(buttons[mouseBtnIndex].wasDown)
+        {
+            buttons[mouseBtnIndex].wasDown = 0;
+        }
+        else
+        {
+            buttons[mouseBtnIndex].tDown = 0.0f;
+        }
+        
+        buttons[mouseBtnIndex].downTick = 0;
+        buttons[mouseBtnIndex].upTick = 0;
+    }
+    
+    win32_state->input.mouse.wheel = 0;
+    
+    PL_Gamepad *gamepads = win32_state->input.gamepads;
+    for(int gamepadIndex = 0;
+        gamepadIndex < XUSER_MAX_COUNT;
+        gamepadIndex++)
+    {
+        if(gamepads[gamepadIndex].isConnected)
+        {
+            for(int gamepadBtnIndex = 0;
+                gamepadBtnIndex < GP_MAX;
+                gamepadBtnIndex++)
+            {
+                if(gamepads[gamepadIndex].buttons[gamepadBtnIndex].isDown)
+                {
+                    if(!gamepads[gamepadIndex].buttons[gamepadBtnIndex].wasDown)
+                    {
+                        gamepads[gamepadIndex].buttons[gamepadBtnIndex].wasDown = 1;
+                    }
+                    
+                    gamepads[gamepadIndex].buttons[gamepadBtnIndex].downTick = 0;
+                }
+                else if(gamepads[gamepadIndex].buttons[gamepadBtnIndex].wasDown)
+                {
+                    gamepads[gamepadIndex].buttons[gamepadBtnIndex].wasDown = 0;
+                }
+                else
+                {
+                    gamepads[gamepadIndex].buttons[gamepadBtnIndex].tDown = 0.0f;
+                }
+                
+                gamepads[gamepadIndex].buttons[gamepadBtnIndex].downTick = 0;
+                gamepads[gamepadIndex].buttons[gamepadBtnIndex].upTick = 0;
+            }
+        }
+    }
+}
+
+static void Win32_UpdateWindow(void)
+{
+    PL_PROFILE_BEGIN("Win32_UpdateWindow");
+    RECT dim = {0};
+    GetClientRect(win32_state->window.handle, &dim);
+    win32_state->window.window.dim.w = dim.right;
+    win32_state->window.window.dim.h = dim.bottom;
+    GetWindowRect(win32_state->window.handle, &dim);
+    win32_state->window.window.dim.x = dim.left;
+    win32_state->window.window.dim.y = dim.top;
+    glViewport(0, 0, win32_state->window.window.dim.w, win32_state->window.window.dim.h);
+    SwapBuffers(win32_state->window.dc);
+    glClearColor(0,0,0,0);
+    glClear(GL_COLOR_BUFFER_BIT);
+    
+    PL_PROFILE_END();
+}
+
+static void Win32_MessageLoop(void)
+{
+    MSG msg;
+    while(PeekMessageA(&msg, win32_state->window.handle, 0, 0, PM_REMOVE))
+    {
+        TranslateMessage(&msg);
+        DispatchMessageA(&msg);
+    }
+    
+    r64 dT = Win32_GetPerfElapsed(win32_state->timer.lastFramePerf);
+    Win32_ProcessInput(dT);
+}
+
+static b32 Win32_CreateWindow(void)
+{
+    Win32_Window *win32_window = &win32_state->window;
+    PL_Window *pl_window = &win32_window->window;
+    WNDCLASSA *wndclass = &win32_window->wndclass;
+    
+    wndclass->style = CS_HREDRAW | CS_VREDRAW | CS_OWNDC;
+    wndclass->lpfnWndProc = Win32_WndProc;
+    wndclass->hInstance = GetModuleHandle(0);
+    wndclass->lpszClassName = "PLWINDOWCLASS";
+    
+    if(!RegisterClassA(wndclass))
+    {
+        PL_SetErrorString("Error registering WNDCLASS. Code(%u)", GetLastError());
+        PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
+        return 0;
+    }
+    
+    // temp window to get OpenGL context settings
+    HWND tmpWindow = CreateWindowA(wndclass->lpszClassName,
+                                   "tmpWindow", WS_OVERLAPPEDWINDOW,
+                                   0,0,1,1,0,0, wndclass->hInstance, 0);
+    
+    if(!tmpWindow)
+    {
+        PL_SetErrorString("Failed to create Window. Code(%u)", GetLastError());
+        PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
+        return 0;
+    }
+    
+    HDC tmpDC = GetDC(tmpWindow);
+    HGLRC tmpRC = 0;
+    int tmpPixelFormat = 0;
+    
+    { // tmpWindow Getting PixelFormat
+        PIXELFORMATDESCRIPTOR pixelFormatDesc = {0};
+        pixelFormatDesc.nSize = sizeof(PIXELFORMATDESCRIPTOR);
+        pixelFormatDesc.nVersion = 1;
+        pixelFormatDesc.dwFlags = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL;
+        pixelFormatDesc.iPixelType = PFD_TYPE_RGBA;
+        pixelFormatDesc.cColorBits = 32;
+        pixelFormatDesc.cAlphaBits = 8;
+        pixelFormatDesc.cDepthBits = 24;
+        tmpPixelFormat = ChoosePixelFormat(tmpDC, &pixelFormatDesc);
+        
+        if(tmpPixelFormat)
+        {
+            if(SetPixelFormat(tmpDC, tmpPixelFormat, &pixelFormatDesc))
+            {
+                tmpRC = wglCreateContext(tmpDC);
+            }
+        }
+        
+        else
+        {
+            PL_SetErrorString("Failed to get pixel format. Code(%u)", GetLastError());
+            PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
+            return 0;
+        }
+        
+        if(!tmpRC)
+        {
+            PL_SetErrorString("Failed to get WGL RenderContext. Code(%u)", GetLastError());
+            PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
+            return 0;
+        }
+    }
+    
+    win32_window->style = WS_VISIBLE | WS_OVERLAPPEDWINDOW;
+    win32_window->handle = CreateWindowExA(0, wndclass->lpszClassName,
+                                           "Window", win32_window->style,
+                                           CW_USEDEFAULT, CW_USEDEFAULT,
+                                           pl_window->dim.w, pl_window->dim.h, 0, 0,
+                                           wndclass->hInstance, 0);
+    
+    if(!win32_window->handle)
+    {
+        PL_SetErrorString("Failed to create Window. Code(%u)", GetLastError());
+        PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
+        return 0;
+    }
+    
+    win32_window->wp.length = sizeof(WINDOWPLACEMENT);
+    GetWindowPlacement(win32_window->handle, &win32_window->wp);
+    win32_window->dc = GetDC(win32_window->handle);
+    
+    if(!wglMakeCurrent(tmpDC, tmpRC))
+    {
+        PL_SetErrorString("Failed to set OpenGL RenderContext. Code(%u)", GetLastError());
+        PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
+        return 0;
+    }
+    
+    if(!Win32_LoadWGL())
+    {
+        PL_SetErrorString("Failed to load WGL functions.");
+        PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
+        return 0;
+    }
+    
+    int pixelFormat;
+    BOOL status;
+    UINT numFormats;
+    
+    const int pixelAttribs[] =
+    {
+        WGL_DRAW_TO_WINDOW_ARB, GL_TRUE,
+        WGL_SUPPORT_OPENGL_ARB, GL_TRUE,
+        WGL_DOUBLE_BUFFER_ARB, GL_TRUE,
+        WGL_SWAP_METHOD_ARB, WGL_SWAP_COPY_ARB,
+        WGL_PIXEL_TYPE_ARB, WGL_TYPE_RGBA_ARB,
+        WGL_ACCELERATION_ARB, WGL_FULL_ACCELERATION_ARB,
+        WGL_COLOR_BITS_ARB, 32,
+        WGL_ALPHA_BITS_ARB, 8,
+        WGL_DEPTH_BITS_ARB, 24,
+        0
+    };
+    
+    int contextAttributes[] =
+    {
+        WGL_CONTEXT_MAJOR_VERSION_ARB, PL_OPENGL_MAJ,
+        WGL_CONTEXT_MINOR_VERSION_ARB, PL_OPENGL_MIN,
+        WGL_CONTEXT_PROFILE_MASK_ARB, WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
+        0
+    };
+    
+    status = wglChoosePixelFormatARB(win32_window->dc, pixelAttribs, 0, 1,
+                                     &pixelFormat, &numFormats);
+    
+    if(!status || !numFormats)
+    {
+        PL_SetErrorString("Failed to get Windows OpenGL PixelFormat.");
+        PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
+        return 0;
+    }
+    
+    PIXELFORMATDESCRIPTOR pixelFormatDesc = {0};
+    DescribePixelFormat(win32_window->dc, pixelFormat, sizeof(PIXELFORMATDESCRIPTOR), &pixelFormatDesc);
+    if(!SetPixelFormat(win32_window->dc, pixelFormat, &pixelFormatDesc))
+    {
+        PL_SetErrorString("Failed to set Windows OpenGL PixelFormat");
+        PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
+        return 0;
+    }
+    
+    win32_window->rc = wglCreateContextAttribsARB(win32_window->dc, 0, contextAttributes);
+    if(!win32_window->rc)
+    {
+        PL_SetErrorString("Failed to create Windows OpenGL RenderContext. Code(%u)", GetLastError());
+        PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
+        return 0;
+    }
+    
+    // unset and clear up tmp
+    wglMakeCurrent(tmpDC, 0);
+    wglDeleteContext(tmpRC);
+    ReleaseDC(tmpWindow, tmpDC);
+    DestroyWindow(tmpWindow);
+    
+    if(!wglMakeCurrent(win32_window->dc, win32_window->rc))
+    {
+        PL_SetErrorString("Failed to set Windows OpenGL RenderContext. Code(%u)", GetLastError());
+        PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
+        return 0;
+    }
+    
+    if(!PL_LoadOpenGL((r32)PL_OPENGL_MAJ + ((r32)PL_OPENGL_MIN/10.0f)))
+    {
+        PL_SetErrorString("Failed to load OpenGL functions.");
+        PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
+        return 0;
+    }
+    
+    win32_window->init = 1;
+    Win32_SetVSync(pl_window->vsync);
+    
+    glViewport(0, 0, pl_window->dim.w, pl_window->dim.h);
+    glClearColor(0,0,0,0);
+    glClear(GL_COLOR_BUFFER_BIT);
+    SwapBuffers(win32_window->dc);
+    
+    return 1;
+}
+
+int CALLBACK WinMain(HINSTANCE instance,
+                     HINSTANCE prevInstance,
+                     LPSTR cmdLine,
+                     int showCode)
+{
+    win32_state = (Win32_State*)PL_Alloc0(sizeof(Win32_State));
+    
+    if(win32_state)
+    {
+        win32_state->running = 1;
+    }
+    else
+    {
+        return -1;
+    }
+    
+    win32_state->userMemorySize = MB(256);
+    win32_state->window.window.framerate = 60;
+    win32_state->window.window.dim.x = 0;
+    win32_state->window.window.dim.y = 0;
+    win32_state->window.window.dim.w = 960;
+    win32_state->window.window.dim.h = 540;
+    win32_state->window.window.vsync = 1;
+    win32_state->userMemoryHugePages = (PL_USER_MEMORY_HUGE_PAGES || (cmdLine && strstr(cmdLine, "-hugepages")));
+    Win32_SetSystemInfo();
+    
+    if(!Win32_InitUserMemory(win32_state->userMemorySize))
+    {
+        return -1;
+    }
+    
+    PL_ArenaInit(&win32_state->userArena, win32_state->userMemory, win32_state->userMemorySize);
+    PL_ArenaInit(&win32_state->frameArena, PL_Alloc(PL_FRAME_ARENA_SIZE), PL_FRAME_ARENA_SIZE);
+    
+    if(!win32_state->frameArena.base)
+    {
+        return -1;
+    }
+    
+    if(!Win32_LoadUserLib()) return -1;
+    if(!Win32_LoadGDILib()) return -1;
+    if(!Win32_LoadWGLLib()) return -1;
+    Win32_LoadXInput();
+    Win32_LoadXAudio();
+    
+    // 1ms scheduler resolution for hybrid frame pacing, spin only if unavailable
+    win32_state->timer.spinSec = 0.002;
+    if(Win32_LoadWinMMLib() && timeBeginPeriod(1) == 0)
+    {
+        win32_state->timer.pacing = PACE_HYBRID;
+    }
+    else
+    {
+        win32_state->timer.pacing = PACE_SPIN;
+    }
+    
+    if(!Win32_CreateWindow()) return -1;
+    Win32_AudioInit();
+    Win32_InitTimer();
+    Win32_UpdateTimer();
+    
+    PL_Startup();
+    
+    while(win32_state->running)
+    {
+        PL_PROFILE_FRAME();
+        Win32_MessageLoop();
+        Win32_UpdateTimer();
+        Win32_AudioFrame();
+        PL_FixedStepFrame(&win32_state->timer.timer, win32_state->timer.frameTicks);
+        PL_PROFILE_BEGIN("PL_Frame");
+        PL_Frame();
+        PL_PROFILE_END();
+        PL_ArenaReset(&win32_state->frameArena);
+        Win32_UpdateWindow();
+        Win32_UpdateInput();
+    }
+    
+    return 0;
+}
+
+// if subsystem:console is used
+int main()
+{
+    return WinMain(GetModuleHandle(0), 0, GetCommandLineA(), SW_SHOWNORMAL);
+}
+
+u64 PL_GetUserMemorySize(void)
+{
+    return win32_state->userMemorySize;
+}
+
+u64 PL_GetUserMemoryPageSize(void)
+{
+    return win32_state->userMemoryPageSize;
+}
+
+PL_Arena *PL_GetUserArena(void)
+{
+    return &win32_state->userArena;
+}
+
+PL_Arena *PL_GetFrameArena(void)
+{
+    return &win32_state->frameArena;
+}
+
+ptr PL_GetUserMemory(void)
+{
+    return win32_state->userMemory;
+}
+
+b32 PL_SetUserMemorySize(u64 size)
+{
+    if(size < MB(256)) size = MB(256);
+    
+    if(size < win32_state->userArena.used)
+    {
+        PL_SetErrorString("PL_SetUserMemorySize: %llu is smaller than the user arena in use (%llu)",
+                          (unsigned long long)size, (unsigned long long)win32_state->userArena.used);
+        return 0;
+    }
+    
+    if(size != win32_state->userMemorySize)
+    {
+        if(!Win32_CommitUserMemory(size))
         {
-            input->mouse.buttons[MB_MIDDLE].isDown = 0;
-        } break;
+            PL_SetErrorString("PL_SetUserMemorySize: failed to commit %llu bytes (%llu reserved)",
+                              (unsigned long long)size, (unsigned long long)win32_state->userMemoryReserved);
+            return 0;
+        }
+        
+        win32_state->userArena.size = size;
+    }
+    
+    return 1;
+}
+
+PL_Window *PL_GetWindow(void)
+{
+    return &win32_state->window.window;
+}
+
+void PL_SetWindowTitle(const cstr format, ...)
+{
+    char buffer[256];
+    PL_Str title = PL_StrBuffer(buffer, sizeof(buffer));
+    va_list args;
+    va_start(args, format);
+    PL_StrAppendV(&title, format, args);
+    va_end(args);
+    SetWindowTextA(win32_state->window.handle, title.data);
+}
+
+void PL_SetWindowPos(i32 x, i32 y, i32 w, i32 h)
+{
+    RECT dim = {0};
+    GetClientRect(win32_state->window.handle, &dim);
+    win32_state->window.window.dim.w = dim.right;
+    win32_state->window.window.dim.h = dim.bottom;
+    GetWindowRect(win32_state->window.handle, &dim);
+    win32_state->window.window.dim.x = dim.left;
+    win32_state->window.window.dim.y = dim.top;
+    
+    if(x == -1) x = dim.left;
+    if(y == -1) y = dim.top;
+    if(w == -1) w = dim.right;
+    if(h == -1) h = dim.bottom;
+    
+    MoveWindow(win32_state->window.handle, x,y,w,h, 0);
+}
+
+void PL_SetWindowFramerate(i32 framerate)
+{
+    win32_state->window.window.framerate = framerate;
+}
+
+void PL_SetWindowVSync(b32 vsync)
+{
+    Win32_SetVSync(vsync);
+}
+
+void PL_SetWindowFullscreen(b32 fullscreen)
+{
+    if(win32_state->window.window.fullscreen)
+    {
+        if(!fullscreen) Win32_FullscreenToggle();
+    }
+    else
+    {
+        if(fullscreen) Win32_FullscreenToggle();
+    }
+}
+
+b32 PL_ToggleWindowFullscreen(void)
+{
+    Win32_FullscreenToggle();
+    return win32_state->window.window.fullscreen;
+}
+
+/*==============================
+      PHRAGLIB MACOS
+      Mac Specific
+===============================*/
+#elif defined(PL_MACOS)
+
+//TODO
+
+int main(int argc, char **argv)
+{
+    
+    return 0;
+}
+
+
+
+/*==============================
+      PHRAGLIB LINUX
+      Linux Specific
+===============================*/
+#elif defined(PL_LINUX)
+#include <malloc.h>
+#include <unistd.h>
+#include <errno.h>
+#include <dlfcn.h>
+#include <sys/mman.h>
+#if defined(PL_LINUX_X11)
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/keysym.h>
+#include <X11/XF86keysym.h>
+#endif
+
+/* ======= LINUX LIB FUNCTIONS ======== */
+
+#define LINUX_LOAD_SOFN(name) {name = (tfn_##name *)dlsym(lib, #name ); if(!name) return 0;}
+
+#if defined(PL_LINUX_X11)
+/*============ X11 ================*/
+
+typedef Display *tfn_XOpenDisplay(const char *display_name);
+tfn_XOpenDisplay *pfn_XOpenDisplay;
+#define XOpenDisplay pfn_XOpenDisplay
+
+typedef int tfn_XCloseDisplay(Display *display);
+tfn_XCloseDisplay *pfn_XCloseDisplay;
+#define XCloseDisplay pfn_XCloseDisplay
+
+typedef Colormap tfn_XCreateColormap(Display *display, Window w, Visual *visual, int alloc);
+tfn_XCreateColormap *pfn_XCreateColormap;
+#define XCreateColormap pfn_XCreateColormap
+
+typedef Window tfn_XCreateWindow(Display *display, Window parent, int x, int y,
+                                 unsigned int width, unsigned int height, unsigned int border_width,
+                                 int depth, unsigned int class, Visual *visual,
+                                 unsigned long valuemask, XSetWindowAttributes *attributes);
+tfn_XCreateWindow *pfn_XCreateWindow;
+#define XCreateWindow pfn_XCreateWindow
+
+typedef int tfn_XMapWindow(Display *display, Window w);
+tfn_XMapWindow *pfn_XMapWindow;
+#define XMapWindow pfn_XMapWindow
+
+typedef int tfn_XStoreName(Display *display, Window w, const char *window_name);
+tfn_XStoreName *pfn_XStoreName;
+#define XStoreName pfn_XStoreName
+
+typedef Atom tfn_XInternAtom(Display *display, const char *atom_name, Bool only_if_exists);
+tfn_XInternAtom *pfn_XInternAtom;
+#define XInternAtom pfn_XInternAtom
+
+typedef Status tfn_XSetWMProtocols(Display *display, Window w, Atom *protocols, int count);
+tfn_XSetWMProtocols *pfn_XSetWMProtocols;
+#define XSetWMProtocols pfn_XSetWMProtocols
+
+typedef int tfn_XPending(Display *display);
+tfn_XPending *pfn_XPending;
+#define XPending pfn_XPending
+
+typedef int tfn_XEventsQueued(Display *display, int mode);
+tfn_XEventsQueued *pfn_XEventsQueued;
+#define XEventsQueued pfn_XEventsQueued
+
+typedef int tfn_XNextEvent(Display *display, XEvent *event_return);
+tfn_XNextEvent *pfn_XNextEvent;
+#define XNextEvent pfn_XNextEvent
+
+typedef int tfn_XPeekEvent(Display *display, XEvent *event_return);
+tfn_XPeekEvent *pfn_XPeekEvent;
+#define XPeekEvent pfn_XPeekEvent
+
+typedef KeySym tfn_XLookupKeysym(XKeyEvent *key_event, int index);
+tfn_XLookupKeysym *pfn_XLookupKeysym;
+#define XLookupKeysym pfn_XLookupKeysym
+
+typedef int tfn_XMoveResizeWindow(Display *display, Window w, int x, int y,
+                                  unsigned int width, unsigned int height);
+tfn_XMoveResizeWindow *pfn_XMoveResizeWindow;
+#define XMoveResizeWindow pfn_XMoveResizeWindow
+
+typedef Status tfn_XSendEvent(Display *display, Window w, Bool propagate,
+                              long event_mask, XEvent *event_send);
+tfn_XSendEvent *pfn_XSendEvent;
+#define XSendEvent pfn_XSendEvent
+
+typedef int tfn_XFree(void *data);
+tfn_XFree *pfn_XFree;
+#define XFree pfn_XFree
+
+typedef int tfn_XFlush(Display *display);
+tfn_XFlush *pfn_XFlush;
+#define XFlush pfn_XFlush
+
+typedef int tfn_XSync(Display *display, Bool discard);
+tfn_XSync *pfn_XSync;
+#define XSync pfn_XSync
+
+typedef XErrorHandler tfn_XSetErrorHandler(XErrorHandler handler);
+tfn_XSetErrorHandler *pfn_XSetErrorHandler;
+#define XSetErrorHandler pfn_XSetErrorHandler
+
+static b32 Linux_LoadX11Lib(void)
+{
+    void *lib = dlopen("libX11.so.6", RTLD_LAZY | RTLD_LOCAL);
+    if(!lib) lib = dlopen("libX11.so", RTLD_LAZY | RTLD_LOCAL);
+    if(!lib) return 0;
+    
+    LINUX_LOAD_SOFN(XOpenDisplay);
+    LINUX_LOAD_SOFN(XCloseDisplay);
+    LINUX_LOAD_SOFN(XCreateColormap);
+    LINUX_LOAD_SOFN(XCreateWindow);
+    LINUX_LOAD_SOFN(XMapWindow);
+    LINUX_LOAD_SOFN(XStoreName);
+    LINUX_LOAD_SOFN(XInternAtom);
+    LINUX_LOAD_SOFN(XSetWMProtocols);
+    LINUX_LOAD_SOFN(XPending);
+    LINUX_LOAD_SOFN(XEventsQueued);
+    LINUX_LOAD_SOFN(XNextEvent);
+    LINUX_LOAD_SOFN(XPeekEvent);
+    LINUX_LOAD_SOFN(XLookupKeysym);
+    LINUX_LOAD_SOFN(XMoveResizeWindow);
+    LINUX_LOAD_SOFN(XSendEvent);
+    LINUX_LOAD_SOFN(XFree);
+    LINUX_LOAD_SOFN(XFlush);
+    LINUX_LOAD_SOFN(XSync);
+    LINUX_LOAD_SOFN(XSetErrorHandler);
+    
+    return 1;
+}
+
+/*=========== GLX ==============*/
+// GLX DEFS (GL/glx.h would clash with the GL declarations in PL.h)
+#define GLX_DOUBLEBUFFER                  5
+#define GLX_RED_SIZE                      8
+#define GLX_GREEN_SIZE                    9
+#define GLX_BLUE_SIZE                     10
+#define GLX_ALPHA_SIZE                    11
+#define GLX_DEPTH_SIZE                    12
+#define GLX_X_VISUAL_TYPE                 0x22
+#define GLX_WINDOW_BIT                    0x00000001
+#define GLX_RGBA_BIT                      0x00000001
+#define GLX_TRUE_COLOR                    0x8002
+#define GLX_DRAWABLE_TYPE                 0x8010
+#define GLX_RENDER_TYPE                   0x8011
+#define GLX_X_RENDERABLE                  0x8012
+#define GLX_CONTEXT_MAJOR_VERSION_ARB     0x2091
+#define GLX_CONTEXT_MINOR_VERSION_ARB     0x2092
+#define GLX_CONTEXT_PROFILE_MASK_ARB      0x9126
+#define GLX_CONTEXT_CORE_PROFILE_BIT_ARB  0x00000001
+
+typedef struct __GLXcontextRec *GLXContext;
+typedef struct __GLXFBConfigRec *GLXFBConfig;
+typedef XID GLXDrawable;
+
+typedef void (*tfn_glXProc)(void);
+typedef tfn_glXProc tfn_glXGetProcAddressARB(const GLubyte *procName);
+tfn_glXGetProcAddressARB *pfn_glXGetProcAddressARB;
+#define glXGetProcAddressARB pfn_glXGetProcAddressARB
+
+typedef GLXFBConfig *tfn_glXChooseFBConfig(Display *dpy, int screen, const int *attribList, int *nitems);
+tfn_glXChooseFBConfig *pfn_glXChooseFBConfig;
+#define glXChooseFBConfig pfn_glXChooseFBConfig
+
+typedef XVisualInfo *tfn_glXGetVisualFromFBConfig(Display *dpy, GLXFBConfig config);
+tfn_glXGetVisualFromFBConfig *pfn_glXGetVisualFromFBConfig;
+#define glXGetVisualFromFBConfig pfn_glXGetVisualFromFBConfig
+
+typedef Bool tfn_glXMakeCurrent(Display *dpy, GLXDrawable drawable, GLXContext ctx);
+tfn_glXMakeCurrent *pfn_glXMakeCurrent;
+#define glXMakeCurrent pfn_glXMakeCurrent
+
+typedef void tfn_glXSwapBuffers(Display *dpy, GLXDrawable drawable);
+tfn_glXSwapBuffers *pfn_glXSwapBuffers;
+#define glXSwapBuffers pfn_glXSwapBuffers
+
+typedef const char *tfn_glXQueryExtensionsString(Display *dpy, int screen);
+tfn_glXQueryExtensionsString *pfn_glXQueryExtensionsString;
+#define glXQueryExtensionsString pfn_glXQueryExtensionsString
+
+static b32 Linux_LoadGLXLib(void)
+{
+    void *lib = dlopen("libGL.so.1", RTLD_LAZY | RTLD_LOCAL);
+    if(!lib) lib = dlopen("libGL.so", RTLD_LAZY | RTLD_LOCAL);
+    if(!lib) return 0;
+    
+    LINUX_LOAD_SOFN(glXGetProcAddressARB);
+    LINUX_LOAD_SOFN(glXChooseFBConfig);
+    LINUX_LOAD_SOFN(glXGetVisualFromFBConfig);
+    LINUX_LOAD_SOFN(glXMakeCurrent);
+    LINUX_LOAD_SOFN(glXSwapBuffers);
+    LINUX_LOAD_SOFN(glXQueryExtensionsString);
+    
+    return 1;
+}
+
+typedef GLXContext (*pfn_glXCreateContextAttribsARB)(Display *dpy, GLXFBConfig config,
+                                                     GLXContext shareContext, Bool direct,
+                                                     const int *attribList);
+typedef void (*pfn_glXSwapIntervalEXT)(Display *dpy, GLXDrawable drawable, int interval);
+typedef int (*pfn_glXSwapIntervalMESA)(unsigned int interval);
+typedef int (*pfn_glXSwapIntervalSGI)(int interval);
+
+pfn_glXCreateContextAttribsARB glXCreateContextAttribsARB;
+pfn_glXSwapIntervalEXT glXSwapIntervalEXT;
+pfn_glXSwapIntervalMESA glXSwapIntervalMESA;
+pfn_glXSwapIntervalSGI glXSwapIntervalSGI;
+#endif // PL_LINUX_X11
+
+//==============================
+// Memory Allocation Functions
+//==============================
+
+ptr PL_Alloc(u64 size)
+{
+    ptr result = 0;
+    result = (ptr)malloc(size);
+    return result;
+}
+
+ptr PL_Alloc0(u64 size)
+{
+    ptr result = 0;
+    result = (ptr)calloc(1, size);
+    return result;
+}
+
+ptr PL_ReAlloc(ptr oldMem, u64 newSize)
+{
+    ptr result = 0;
+    result = (ptr)realloc(oldMem, newSize);
+    return result;
+}
+
+ptr PL_ReAlloc0(ptr oldMem, u64 newSize)
+{
+    // zero the grown part like HeapReAlloc(HEAP_ZERO_MEMORY)
+    u64 oldSize = (oldMem) ? (u64)malloc_usable_size(oldMem) : 0;
+    ptr result = 0;
+    result = (ptr)realloc(oldMem, newSize);
+    
+    if(result && newSize > oldSize)
+    {
+        PL_MemZero((u8*)result + oldSize, newSize - oldSize);
+    }
+    
+    return result;
+}
+
+b32 PL_Free(ptr mem)
+{
+    if(!mem)
+    {
+        return 0;
+    }
+    
+    free(mem);
+    return 1;
+}
+
+//===================
+// Files
+//===================
+
+PL_File PL_FileOpen(const cstr path)
+{
+    PL_File result = {0};
+    FILE *file = fopen(path, "a+");
+    
+    if(!file)
+    {
+        return result;
+    }
+    
+    fseeko(file, 0, SEEK_END);
+    i64 size = (i64)ftello(file);
+    fseeko(file, 0, SEEK_SET);
+    
+    result.handle = (ptr)file;
+    result.size = size;
+    
+    return result;
+}
+
+void PL_FileClose(PL_File *file)
+{
+    if(file && file->handle)
+    {
+        fclose((FILE*)file->handle);
+        file->handle = 0;
+        file->size = 0;
+    }
+}
+
+u64 PL_FileRead(PL_File *file, u64 offset, ptr dst, u64 size)
+{
+    u64 result = 0;
+    
+    if(file && file->handle && dst)
+    {
+        fseeko((FILE*)file->handle, (off_t)offset, SEEK_SET);
         
-        case WM_RBUTTONUP:
+        if(!size)
         {
-            input->mouse.buttons[MB_RIGHT].isDown = 0;
-        } break;
-        
-        case WM_XBUTTONUP:
+            result = fread(dst, 1, (u64)file->size - offset, (FILE*)file->handle);
+        }
+        else
         {
-            if(wParam & MK_XBUTTON1)
-            {
-                input->mouse.buttons[MB_X1].isDown = 0;
-            }
-            
-            if(wParam & MK_XBUTTON2)
-            {
-                input->mouse.buttons[MB_X2].isDown = 0;
-            }
-            
-        } break;
+            result = fread(dst, 1, size - offset, (FILE*)file->handle);
+        }
         
-        case WM_MOUSEWHEEL:
-        {
-            if(GET_WHEEL_DELTA_WPARAM(wParam) < 0)
-            {
-                input->mouse.wheel--;
-            }
-            
-            if(GET_WHEEL_DELTA_WPARAM(wParam) > 0)
-            {
-                input->mouse.wheel++;
-            }
-            
-        } break;
+        fseeko((FILE*)file->handle, 0, SEEK_SET);
+    }
+    else
+    {
+        return 0;
+    }
+    
+    return result;
+}
+
+u64 PL_FileWrite(PL_File *file, u64 offset, ptr src, u64 size)
+{
+    u64 result = 0;
+    
+    if(file && file->handle && src && size)
+    {
+        fseeko((FILE*)file->handle, (off_t)offset, SEEK_SET);
+        result = fwrite(src, 1, size, (FILE*)file->handle);
+        fseeko((FILE*)file->handle, 0, SEEK_SET);
+    }
+    else
+    {
+        return 0;
+    }
+    
+    return result;
+}
+
+u64 PL_FileWriteAppend(PL_File *file, ptr src, u64 size)
+{
+    u64 result = 0;
+    
+    if(file && file->handle && src && size)
+    {
+        fseeko((FILE*)file->handle, 0, SEEK_END);
+        result = fwrite(src, 1, size, (FILE*)file->handle);
+        fseeko((FILE*)file->handle, 0, SEEK_SET);
+    }
+    else
+    {
+        return 0;
+    }
+    
+    return result;
+}
+
+void PL_PrintFile(PL_File *file, u64 offset, cstr format, ...)
+{
+    if(file && file->handle)
+    {
+        fseeko((FILE*)file->handle, (off_t)offset, SEEK_SET);
+        va_list args;
+        va_start(args, format);
+        PL_PrintV((FILE*)file->handle, format, args);
+        va_end(args);
+        fseeko((FILE*)file->handle, 0, SEEK_SET);
+    }
+}
+
+void PL_PrintFileAppend(PL_File *file, cstr format, ...)
+{
+    if(file && file->handle)
+    {
+        fseeko((FILE*)file->handle, 0, SEEK_END);
+        va_list args;
+        va_start(args, format);
+        PL_PrintV((FILE*)file->handle, format, args);
+        va_end(args);
+        fseeko((FILE*)file->handle, 0, SEEK_SET);
+    }
+}
+
+// no native message boxes on linux, they go to stderr instead
+static void Linux_MsgBox(const cstr type, const cstr title, cstr format, va_list args)
+{
+    char msg[1024] = {0};
+    vsnprintf(msg, 1024, format, args);
+    PL_PrintErr("[%s] %s: %s\n", type, title, msg);
+}
+
+void PL_MsgBox(const cstr title, cstr format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    Linux_MsgBox("MSG", title, format, args);
+    va_end(args);
+}
+
+void PL_MsgBoxInfo(const cstr title, cstr format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    Linux_MsgBox("INFO", title, format, args);
+    va_end(args);
+}
+
+void PL_MsgBoxError(const cstr title, cstr format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    Linux_MsgBox("ERROR", title, format, args);
+    va_end(args);
+}
+
+/*====================
+  Input Processing
+====================*/
+
+#if defined(PL_LINUX_X11)
+static PL_KEYCODE Linux_XKeyToPLKeycode(KeySym key)
+{
+    if(key >= XK_a && key <= XK_z) return (PL_KEYCODE)('a' + (key - XK_a));
+    if(key >= XK_0 && key <= XK_9) return (PL_KEYCODE)('0' + (key - XK_0));
+    if(key >= XK_KP_0 && key <= XK_KP_9) return (PL_KEYCODE)(KP_0 + (key - XK_KP_0));
+    if(key >= XK_F1 && key <= XK_F12) return (PL_KEYCODE)(K_F1 + (key - XK_F1));
+    
+    switch(key)
+    {
+        case XK_Escape: return K_ESC;
+        case XK_Print: return K_PRTSC;
+        case XK_Scroll_Lock: return K_SCRLK;
+        case XK_Pause: return K_PAUSE;
+        case XK_Num_Lock: return K_NUM;
+        case XK_Insert: return K_INS;
+        case XK_Delete: return K_DEL;
+        case XK_Home: return K_HOME;
+        case XK_End: return K_END;
+        case XK_Prior: return K_PGUP;
+        case XK_Next: return K_PGDN;
         
-        default:
-        {
-            result = DefWindowProcA(window, msg, wParam, lParam);
-        }
+        case XK_Up: return K_UP;
+        case XK_Down: return K_DOWN;
+        case XK_Left: return K_LEFT;
+        case XK_Right: return K_RIGHT;
+        
+        case XK_Caps_Lock: return K_CAPS;
+        case XK_BackSpace: return K_BACKSPACE;
+        case XK_Shift_L: return K_LSHIFT;
+        case XK_Shift_R: return K_RSHIFT;
+        case XK_Control_L: return K_LCTRL;
+        case XK_Control_R: return K_RCTRL;
+        case XK_Alt_L: return K_LALT;
+        case XK_Alt_R: return K_RALT;
+        case XK_ISO_Level3_Shift: return K_RALT; // AltGr
+        case XK_Super_L: return K_LWIN;
+        case XK_Super_R: return K_RWIN;
+        case XK_Menu: return K_MENU;
+        
+        case XK_Tab: return K_TAB;
+        case XK_grave: return K_TILDE;
+        case XK_minus: return K_MINUS;
+        case XK_equal: return K_EQUALS;
+        case XK_Return: return K_RETURN;
+        case XK_space: return K_SPACE;
+        case XK_bracketleft: return K_LBRACKET;
+        case XK_bracketright: return K_RBRACKET;
+        case XK_semicolon: return K_SEMICOLON;
+        case XK_apostrophe: return K_APOSTROPHE;
+        case XK_backslash: return K_BACKSLASH;
+        case XK_comma: return K_COMMA;
+        case XK_period: return K_PERIOD;
+        case XK_slash: return K_SLASH;
+        
+        case XK_KP_Divide: return KP_SLASH;
+        case XK_KP_Multiply: return KP_MULTIPLY;
+        case XK_KP_Subtract: return KP_MINUS;
+        case XK_KP_Add: return KP_PLUS;
+        case XK_KP_Enter: return KP_RETURN;
+        case XK_KP_Decimal: return KP_PERIOD;
+        
+        // keypad with numlock off (index 0 keysyms)
+        case XK_KP_Delete: return KP_PERIOD;
+        case XK_KP_Insert: return KP_0;
+        case XK_KP_End: return KP_1;
+        case XK_KP_Down: return KP_2;
+        case XK_KP_Next: return KP_3;
+        case XK_KP_Left: return KP_4;
+        case XK_KP_Begin: return KP_5;
+        case XK_KP_Right: return KP_6;
+        case XK_KP_Home: return KP_7;
+        case XK_KP_Up: return KP_8;
+        case XK_KP_Prior: return KP_9;
+        
+        case XF86XK_AudioMute: return KM_MUTE;
+        case XF86XK_AudioLowerVolume: return KM_VOLDOWN;
+        case XF86XK_AudioRaiseVolume: return KM_VOLUP;
+        case XF86XK_AudioPlay: return KM_PLAYPAUSE;
+        case XF86XK_AudioStop: return KM_STOP;
+        case XF86XK_AudioPrev: return KM_PREV;
+        case XF86XK_AudioNext: return KM_NEXT;
+        
+        default: return K_NONE;
+    }
+}
+#endif // PL_LINUX_X11
+
+/*======= State Components =========*/
+
+typedef struct
+{
+    PL_Window window;
+    
+    b32 init;
+    b32 headless;
+    char title[256];
+#if defined(PL_LINUX_X11)
+    Display *display;
+    Window handle;
+    Colormap colormap;
+    GLXContext rc;
+    Atom wmDeleteWindow;
+    Atom wmState;
+    Atom wmStateFullscreen;
+    int xerror; // last X error code caught by Linux_XErrorHandler
+#endif
+} Linux_Window;
+
+typedef struct
+{
+    PL_Timer timer;
+    u64 perfFreq;
+    u64 lastFramePerf;
+    u64 frameTicks; // PL_GetTicks at the start of the frame
+    PL_PACINGMODE pacing;
+    r64 spinSec;
+    u64 pacedFrames;
+    PL_FrameHistogram histogram;
+} Linux_Timer;
+
+typedef struct
+{
+    PL_SystemInfo info;
+} Linux_SystemInfo;
+
+/*========== LINUX STATE =============*/
+
+typedef struct
+{
+    char errorString[1024];
+    b32 running;
+    u64 userMemorySize;
+    ptr userMemory;
+    u64 userMemoryCommitted; // userMemorySize rounded up to pages
+    u64 userMemoryReserved;
+    u64 userMemoryPageSize; // page size backing the block
+    b32 userMemoryHugePages; // huge/large pages requested
+    PL_Arena userArena;
+    PL_Arena frameArena; // reset after every PL_Frame
+    u64 maxFrames; // quit after this many frames (0: run until PL_Quit)
+    cstr tracePath; // PL_ProfileDump here on exit (0: none)
+    
+    Linux_SystemInfo system;
+    Linux_Timer timer;
+    Linux_Window window;
+    
+    PL_Clock clock;
+    u64 clockFrame; // frame the clock was computed for
+    u64 clockSec; // unix second of the cached date fields
+    PL_Input input;
+    PL_Audio audio;
+} Linux_State;
+static Linux_State *linux_state;
+
+void PL_SetErrorString(const cstr format, ...)
+{
+    PL_Str error = PL_StrBuffer(linux_state->errorString, sizeof(linux_state->errorString));
+    va_list args;
+    va_start(args, format);
+    PL_StrAppendV(&error, format, args);
+    va_end(args);
+    
+    PL_ErrorCallback();
+}
+
+void PL_Quit(void)
+{
+    linux_state->running = 0;
+}
+
+cstr PL_GetErrorString(void)
+{
+    return linux_state->errorString;
+}
+
+PL_Timer *PL_GetTimer(void)
+{
+    return &linux_state->timer.timer;
+}
+
+PL_Input* PL_GetInput(void)
+{
+    return &linux_state->input;
+}
+
+PL_Mouse* PL_GetMouse(void)
+{
+    return &linux_state->input.mouse;
+}
+
+PL_Gamepad* PL_GetGamepad(i32 id)
+{
+    if(id >= 0 && id < GP_MAX_COUNT)
+        return &linux_state->input.gamepads[id];
+    
+    return 0;
+}
+
+PL_ButtonState* PL_GetKeyState(PL_KEYCODE key)
+{
+    if(key > 0 && key < K_MAX)
+        return &linux_state->input.keyboard[key];
+    
+    return 0;
+}
+
+/*========= LINUX AUDIO =============*/
+
+PL_Audio* PL_GetAudio(void)
+{
+    return &linux_state->audio;
+}
+
+ptr PL_GetAudioBuffer(void)
+{
+    return (ptr)&linux_state->audio.buffer[0];
+}
+
+// no audio device yet, the play cursor advances in real time so the
+// game's buffer filling behaves the same as it would with a device
+static void Linux_AudioFrame(void)
+{
+    PL_PROFILE_BEGIN("Linux_AudioFrame");
+    static r64 samplesPlayed;
+    samplesPlayed += linux_state->timer.timer.tLastFrame * (r64)AUDIO_SAMPLE_RATE;
+    PL_GetAudio()->playCursor = (u64)samplesPlayed % AUDIO_BUFFER_SIZE;
+    
+    PL_PROFILE_END();
+}
+
+/*========= LINUX TIMER =============*/
+
+static u64 Linux_GetUnixTimeNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return ((u64)ts.tv_sec * 1000000000ULL) + (u64)ts.tv_nsec;
+}
+
+// localtime_r (timezone lookup) only runs when the second changes
+static void Linux_UpdateClock(void)
+{
+    PL_Clock *clock = &linux_state->clock;
+    u64 unixNs = PL_TicksToUnixNs(linux_state->timer.frameTicks);
+    u64 sec = unixNs / 1000000000ULL;
+    
+    if(sec != linux_state->clockSec)
+    {
+        time_t t = (time_t)sec;
+        struct tm lt = {0};
+        localtime_r(&t, &lt);
+        clock->year = (u16)(lt.tm_year + 1900);
+        clock->month = (u16)(lt.tm_mon + 1);
+        clock->day = (u16)lt.tm_mday;
+        clock->wday = (u16)((lt.tm_wday) ? lt.tm_wday : 7);
+        clock->hr = (u16)lt.tm_hour;
+        clock->min = (u16)lt.tm_min;
+        clock->sec = (u16)lt.tm_sec;
+        linux_state->clockSec = sec;
+    }
+    
+    clock->ms = (u16)((unixNs / 1000000ULL) % 1000);
+}
+
+PL_Clock *PL_GetClock(void)
+{
+    if(linux_state->clockFrame != linux_state->timer.timer.frames)
+    {
+        Linux_UpdateClock();
+        linux_state->clockFrame = linux_state->timer.timer.frames;
     }
     
+    return &linux_state->clock;
+}
+
+static u64 Linux_GetPerfCount(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((u64)ts.tv_sec * 1000000000ULL) + (u64)ts.tv_nsec;
+}
+
+static void Linux_InitTimer(void)
+{
+    // CLOCK_MONOTONIC counts in nanoseconds
+    linux_state->timer.perfFreq = 1000000000ULL;
+    linux_state->timer.pacing = PACE_HYBRID;
+    linux_state->timer.spinSec = 0.0005;
+    PL_InitTicks(linux_state->system.info.invariantTSC, Linux_GetPerfCount, linux_state->timer.perfFreq);
+    PL_InitWallClock(Linux_GetUnixTimeNs);
+}
+
+static r64 Linux_GetPerfDiff(u64 start, u64 end)
+{
+    r64 result = (((r64)end - (r64)start) / (r64)linux_state->timer.perfFreq);
     return result;
 }
 
-/*================================
-   Window Functions
-================================*/
+static r64 Linux_GetPerfElapsed(u64 prev)
+{
+    r64 result = Linux_GetPerfDiff(prev, Linux_GetPerfCount());
+    return result;
+}
 
-// thanks Raymond Chen, the win32GOAT
-static void Win32_FullscreenToggle(void)
+static void Linux_WaitForFrame(u64 targetPerf)
 {
-    DWORD style = GetWindowLong(win32_state->window.handle, GWL_STYLE);
-    if(style & WS_OVERLAPPEDWINDOW)
+    Linux_Timer *timer = &linux_state->timer;
+    
+    if(timer->pacing == PACE_HYBRID)
     {
-        MONITORINFO monitorInfo = {sizeof(monitorInfo)};
-        if(GetWindowPlacement(win32_state->window.handle, &win32_state->window.wp) &&
-           GetMonitorInfo(MonitorFromWindow(win32_state->window.handle, MONITOR_DEFAULTTOPRIMARY), &monitorInfo))
+        // absolute deadline, so wakeup latency doesn't accumulate across frames
+        u64 spinPerf = (u64)(timer->spinSec * (r64)timer->perfFreq);
+        
+        if(Linux_GetPerfCount() + spinPerf < targetPerf)
         {
-            SetWindowLong(win32_state->window.handle, GWL_STYLE, style & ~WS_OVERLAPPEDWINDOW);
-            SetWindowPos(win32_state->window.handle, HWND_TOP,
-                         monitorInfo.rcMonitor.left, monitorInfo.rcMonitor.top,
-                         monitorInfo.rcMonitor.right - monitorInfo.rcMonitor.left,
-                         monitorInfo.rcMonitor.bottom - monitorInfo.rcMonitor.top,
-                         SWP_NOOWNERZORDER | SWP_FRAMECHANGED);
-            win32_state->window.window.fullscreen = 1;
+            u64 wakePerf = targetPerf - spinPerf;
+            struct timespec wake;
+            wake.tv_sec = (time_t)(wakePerf / 1000000000ULL);
+            wake.tv_nsec = (long)(wakePerf % 1000000000ULL);
+            while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, 0) == EINTR) {}
         }
     }
-    else
-    {
-        SetWindowLong(win32_state->window.handle, GWL_STYLE, style | WS_OVERLAPPEDWINDOW);
-        SetWindowPlacement(win32_state->window.handle, &win32_state->window.wp);
-        SetWindowPos(win32_state->window.handle, 0, 0, 0, 0, 0,
-                     SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER |
-                     SWP_NOOWNERZORDER | SWP_FRAMECHANGED);
-        win32_state->window.window.fullscreen = 0;
-    }
+    
+    while(Linux_GetPerfCount() < targetPerf) {}
 }
 
-static void Win32_SetVSync(b32 vsync)
+static void Linux_UpdateTimer(void)
 {
-    if(vsync)
+    PL_PROFILE_BEGIN("Linux_UpdateTimer");
+    
+    Linux_Timer *timer = &linux_state->timer;
+    b32 paced = (!linux_state->window.window.vsync &&
+                 linux_state->window.window.framerate > 0);
+    r64 targetSecPerFrame = 0.0;
+    
+    if(paced)
     {
-        win32_state->window.window.vsync = 1;
-        wglSwapIntervalEXT(1);
+        targetSecPerFrame = (1.0/(r64)linux_state->window.window.framerate);
+        Linux_WaitForFrame(timer->lastFramePerf + (u64)(targetSecPerFrame * (r64)timer->perfFreq));
     }
-    else
+    
+    if(timer->timer.tLastFrame)
     {
-        win32_state->window.window.vsync = 0;
-        wglSwapIntervalEXT(0);
+        timer->timer.tAvgFrame += timer->timer.tLastFrame;
+        timer->timer.tAvgFrame /= 2.0f;
+    }
+    
+    timer->timer.tLastFrame = Linux_GetPerfElapsed(timer->lastFramePerf);
+    timer->lastFramePerf = Linux_GetPerfCount();
+    timer->frameTicks = PL_GetTicks();
+    timer->timer.frames++;
+    
+    timer->timer.tJitter = 0.0;
+    if(paced && timer->timer.frames > 1)
+    {
+        timer->timer.tJitter = fabs(timer->timer.tLastFrame - targetSecPerFrame);
+        timer->pacedFrames++;
+        timer->timer.tAvgJitter += (timer->timer.tJitter - timer->timer.tAvgJitter) / (r64)timer->pacedFrames;
+    }
+    
+    // first update measures from 0, not a real frame
+    if(timer->timer.frames > 1)
+    {
+        i32 framerate = linux_state->window.window.framerate;
+        r64 tBudget = (framerate > 0) ? (1.0/(r64)framerate) : 0.0;
+        PL_FrameHistogramAdd(&timer->histogram, timer->timer.tLastFrame, tBudget);
     }
+    
+    PL_PROFILE_END();
 }
 
-static void Win32_ProcessXInputButton(XINPUT_GAMEPAD *xpad, PL_Gamepad *gamepad,
-                                      WORD xbutton, PL_GAMEPADBTNCODE btnCode, r64 dT)
+PL_FrameStats PL_GetFrameStats(void)
 {
-    if((xpad->wButtons & xbutton) != 0)
+    return PL_FrameHistogramStats(&linux_state->timer.histogram);
+}
+
+void PL_ResetFrameStats(void)
+{
+    PL_MemZero(&linux_state->timer.histogram, sizeof(PL_FrameHistogram));
+}
+
+void PL_SetFramePacing(PL_PACINGMODE mode, r64 spinSec)
+{
+    linux_state->timer.pacing = mode;
+    if(spinSec >= 0.0) linux_state->timer.spinSec = spinSec;
+}
+
+u64 PL_GetTicks(void)
+{
+    return pl_ticks.tsc ? PL_ReadTSC() : Linux_GetPerfCount();
+}
+
+/*========== SystemInfo ===============*/
+
+// reads a small text file (sysfs/procfs) into buffer, null terminated, returns success
+static b32 Linux_ReadTextFile(const char *path, char *buffer, u64 size)
+{
+    FILE *file = fopen(path, "r");
+    if(!file) return 0;
+    
+    u64 bytesRead = fread(buffer, 1, size - 1, file);
+    buffer[bytesRead] = 0;
+    fclose(file);
+    return (bytesRead > 0);
+}
+
+// transparent huge page size, 0 when THP is missing or disabled
+static u64 Linux_GetTHPSize(void)
+{
+    char text[128];
+    
+    if(!Linux_ReadTextFile("/sys/kernel/mm/transparent_hugepage/enabled", text, sizeof(text)) ||
+       strstr(text, "[never]"))
     {
-        gamepad->buttons[btnCode].isDown = 1;
-        gamepad->buttons[btnCode].tDown += dT;
+        return 0;
     }
-    else
+    
+    if(!Linux_ReadTextFile("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", text, sizeof(text)))
     {
-        gamepad->buttons[btnCode].isDown = 0;
+        return MB(2);
     }
+    
+    return strtoull(text, 0, 10);
 }
 
-static void Win32_ProcessInput(r64 dT)
+// sysfs cache sizes look like "48K" or "32M"
+static u64 Linux_ParseSize(const char *text)
 {
-    PL_ButtonState *keyboard = win32_state->input.keyboard;
-    for(int keyIndex = 0;
-        keyIndex < K_MAX;
-        keyIndex++)
+    char *suffix = 0;
+    u64 result = strtoull(text, &suffix, 10);
+    if(suffix && (*suffix == 'K' || *suffix == 'k')) result *= KB(1);
+    else if(suffix && (*suffix == 'M' || *suffix == 'm')) result *= MB(1);
+    else if(suffix && (*suffix == 'G' || *suffix == 'g')) result *= GB(1);
+    return result;
+}
+
+#define LINUX_MAX_CORE_IDS 1024
+
+static void Linux_SetSystemInfo(void)
+{
+    PL_SystemInfo *info = &linux_state->system.info;
+    PL_DetectCPUFeatures(info);
+    
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    long pageSize = sysconf(_SC_PAGESIZE);
+    info->logicalCores = (u32)((cores > 0) ? cores : 1);
+    info->pageSize = (u64)((pageSize > 0) ? pageSize : KB(4));
+    info->largePageSize = Linux_GetTHPSize();
+    
+    char path[128];
+    char text[64];
+    
+    // caches of cpu0, the others are the same or share them
+    for(int index = 0; index < 16; index++)
     {
-        if(keyboard[keyIndex].isDown)
-        {
-            if(!keyboard[keyIndex].wasDown)
-            {
-                keyboard[keyIndex].downTick = 1;
-            }
-            keyboard[keyIndex].tDown += dT;
-        }
-        else if(keyboard[keyIndex].wasDown)
+        PL_StrVar(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/type", index);
+        if(!Linux_ReadTextFile(path, text, sizeof(text))) break;
+        if(strncmp(text, "Data", 4) && strncmp(text, "Unified", 7)) continue;
+        
+        PL_StrVar(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/level", index);
+        if(!Linux_ReadTextFile(path, text, sizeof(text))) continue;
+        int level = atoi(text);
+        
+        PL_StrVar(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", index);
+        if(!Linux_ReadTextFile(path, text, sizeof(text))) continue;
+        u64 size = Linux_ParseSize(text);
+        
+        if(level == 1)
         {
-            keyboard[keyIndex].upTick = 1;
+            info->l1DataCache = size;
+            PL_StrVar(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/coherency_line_size", index);
+            if(Linux_ReadTextFile(path, text, sizeof(text)) && atoi(text) > 0) info->cacheLineSize = (u32)atoi(text);
         }
+        else if(level == 2) info->l2Cache = size;
+        else if(level == 3) info->l3Cache = size;
     }
     
-    PL_ButtonState *buttons = win32_state->input.mouse.buttons;
-    for(int mouseBtnIndex = 0;
-        mouseBtnIndex < MB_MAX;
-        mouseBtnIndex++)
+    // physical cores: distinct (package, core) pairs of the online cpus
+    u64 *coreIDs = (u64*)PL_Alloc(LINUX_MAX_CORE_IDS * sizeof(u64));
+    u32 coreCount = 0;
+    u32 cpusFound = 0;
+    for(u32 cpu = 0; coreIDs && cpu < LINUX_MAX_CORE_IDS && cpusFound < info->logicalCores; cpu++)
     {
-        if(buttons[mouseBtnIndex].isDown)
-        {
-            if(!buttons[mouseBtnIndex].wasDown)
-            {
-                buttons[mouseBtnIndex].downTick = 1;
-            }
-            buttons[mouseBtnIndex].tDown += dT;
-        }
-        else if(buttons[mouseBtnIndex].wasDown)
-        {
-            buttons[mouseBtnIndex].upTick = 1;
-        }
+        PL_StrVar(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/core_id", cpu);
+        if(!Linux_ReadTextFile(path, text, sizeof(text))) continue;
+        cpusFound++;
+        u64 coreID = strtoull(text, 0, 10);
+        
+        PL_StrVar(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", cpu);
+        u64 packageID = Linux_ReadTextFile(path, text, sizeof(text)) ? strtoull(text, 0, 10) : 0;
+        u64 id = (packageID << 32) | coreID;
+        
+        u32 index = 0;
+        while(index < coreCount && coreIDs[index] != id) index++;
+        if(index == coreCount) coreIDs[coreCount++] = id;
     }
     
-    PL_Gamepad *gamepads = win32_state->input.gamepads;
-    for(int gamepadIndex = 0;
-        gamepadIndex < XUSER_MAX_COUNT;
-        gamepadIndex++)
+    if(coreIDs) PL_Free(coreIDs);
+    info->physicalCores = coreCount ? coreCount : info->logicalCores;
+    
+    PL_InitDispatch(info);
+}
+
+PL_SystemInfo *PL_GetSystemInfo(void)
+{
+    return &linux_state->system.info;
+}
+
+/*========== USER MEMORY ===============*/
+
+// the user block is one reserved address range, pages are committed as it grows so it never moves
+// fresh and re-committed pages read as zero
+static b32 Linux_CommitUserMemory(u64 size)
+{
+    u64 pageSize = linux_state->userMemoryPageSize;
+    u64 committed = linux_state->userMemoryCommitted;
+    u64 newCommitted = (size + pageSize - 1) & ~(pageSize - 1);
+    
+    if(newCommitted > linux_state->userMemoryReserved)
     {
-        if(gamepads[gamepadIndex].isConnected)
-        {
-            for(int gamepadBtnIndex = 0;
-                gamepadBtnIndex < GP_MAX;
-                gamepadBtnIndex++)
-            {
-                if(gamepads[gamepadIndex].buttons[gamepadBtnIndex].isDown)
-                {
-                    if(!gamepads[gamepadIndex].buttons[gamepadBtnIndex].wasDown)
-                    {
-                        gamepads[gamepadIndex].buttons[gamepadBtnIndex].downTick = 1;
-                    }
-                    gamepads[gamepadIndex].buttons[gamepadBtnIndex].tDown += dT;
-                }
-                else if(gamepads[gamepadIndex].buttons[gamepadBtnIndex].wasDown)
-                {
-                    gamepads[gamepadIndex].buttons[gamepadBtnIndex].upTick = 1;
-                }
-            }
-        }
+        return 0;
     }
     
-    for(int gamepadIndex = 0;
-        gamepadIndex < XUSER_MAX_COUNT;
-        gamepadIndex++)
+    if(newCommitted > committed)
     {
-        XINPUT_STATE xpadState;
-        
-        if(win32_state->xinput.GetState((DWORD)gamepadIndex, &xpadState) == ERROR_SUCCESS)
+        if(mprotect((u8*)linux_state->userMemory + committed, newCommitted - committed,
+                    PROT_READ | PROT_WRITE))
         {
-            XINPUT_GAMEPAD *xpad = &xpadState.Gamepad;
-            PL_Gamepad *gamepad = &gamepads[gamepadIndex];
-            
-            gamepad->isConnected = 1;
-            
-            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_A, GP_A, dT);
-            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_B, GP_B, dT);
-            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_X, GP_X, dT);
-            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_Y, GP_Y, dT);
-            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_START, GP_START, dT);
-            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_BACK, GP_BACK, dT);
-            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_LEFT_SHOULDER, GP_LEFTSHOULDER, dT);
-            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_RIGHT_SHOULDER, GP_RIGHTSHOULDER, dT);
-            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_DPAD_UP, GP_DPAD_UP, dT);
-            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_DPAD_DOWN, GP_DPAD_DOWN, dT);
-            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_DPAD_LEFT, GP_DPAD_LEFT, dT);
-            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_DPAD_RIGHT, GP_DPAD_RIGHT, dT);
-            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_LEFT_THUMB, GP_L3, dT);
-            Win32_ProcessXInputButton(xpad, gamepad, XINPUT_GAMEPAD_RIGHT_THUMB, GP_R3, dT);
-            
-            gamepad->LT = ((r32)xpad->bLeftTrigger / 255.0f);
-            gamepad->RT = ((r32)xpad->bRightTrigger / 255.0f);
-            
-            if(xpad->sThumbLX < 0) gamepad->LS.x = PL_norm32(xpad->sThumbLX, 0, 32768);
-            else gamepad->LS.x = PL_norm32(xpad->sThumbLX, 0, 32767);
-            if(xpad->sThumbLY < 0) gamepad->LS.y = PL_norm32(xpad->sThumbLY, 0, 32768);
-            else gamepad->LS.y = PL_norm32(xpad->sThumbLY, 0, 32767);
-            if(xpad->sThumbRX < 0) gamepad->RS.x = PL_norm32(xpad->sThumbRX, 0, 32768);
-            else gamepad->RS.x = PL_norm32(xpad->sThumbRX, 0, 32767);
-            if(xpad->sThumbRY < 0) gamepad->RS.y = PL_norm32(xpad->sThumbRY, 0, 32768);
-            else gamepad->RS.y = PL_norm32(xpad->sThumbRY, 0, 32767);
-            
-            if(gamepad->LVib > 1.0f) gamepad->LVib = 1.0f;
-            else if(gamepad->LVib < 0.0f) gamepad->LVib = 0.0f;
-            if(gamepad->RVib > 1.0f) gamepad->RVib = 1.0f;
-            else if(gamepad->RVib < 0.0f) gamepad->RVib = 0.0f;
-            
-            XINPUT_VIBRATION vib;
-            vib.wLeftMotorSpeed = (WORD)(65535.0f * gamepad->LVib);
-            vib.wRightMotorSpeed = (WORD)(65535.0f * gamepad->RVib);
-            win32_state->xinput.SetState(gamepadIndex, &vib);
+            return 0;
         }
+    }
+    
+    else if(newCommitted < committed)
+    {
+        madvise((u8*)linux_state->userMemory + newCommitted, committed - newCommitted, MADV_DONTNEED);
+        mprotect((u8*)linux_state->userMemory + newCommitted, committed - newCommitted, PROT_NONE);
+    }
+    
+    // the tail of the last page stays committed, clear it so growing back reads zero
+    if(size < linux_state->userMemorySize)
+    {
+        PL_MemZero((u8*)linux_state->userMemory + size, newCommitted - size);
+    }
+    
+    linux_state->userMemoryCommitted = newCommitted;
+    linux_state->userMemorySize = size;
+    return 1;
+}
+
+// huge pages come from THP (madvise), explicit MAP_HUGETLB needs a preallocated pool and
+// faults with SIGBUS instead of failing when it runs dry, so it isn't used for a growable block
+static b32 Linux_InitUserMemory(u64 size)
+{
+    u64 hugePageSize = 0;
+#if defined(MADV_HUGEPAGE)
+    if(linux_state->userMemoryHugePages)
+    {
+        hugePageSize = Linux_GetTHPSize();
+    }
+#endif
+    
+    // over-reserve so the block can start on a huge page boundary
+    u64 reserve = PL_USER_MEMORY_RESERVE + hugePageSize;
+    u8 *memory = (u8*)mmap(0, reserve, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    
+    if(memory == MAP_FAILED)
+    {
+        return 0;
+    }
+    
+    linux_state->userMemoryPageSize = linux_state->system.info.pageSize;
+    
+    if(hugePageSize)
+    {
+        u8 *aligned = (u8*)(((uintptr_t)memory + hugePageSize - 1) & ~(uintptr_t)(hugePageSize - 1));
+        if(aligned > memory) munmap(memory, aligned - memory);
+        munmap(aligned + PL_USER_MEMORY_RESERVE, (memory + reserve) - (aligned + PL_USER_MEMORY_RESERVE));
+        memory = aligned;
         
-        else
+#if defined(MADV_HUGEPAGE)
+        if(!madvise(memory, PL_USER_MEMORY_RESERVE, MADV_HUGEPAGE))
         {
-            if(gamepads[gamepadIndex].isConnected)
-            {
-                PL_MemZero(&gamepads[gamepadIndex], sizeof(PL_Gamepad));
-            }
+            linux_state->userMemoryPageSize = hugePageSize;
         }
+#endif
+    }
+    
+    if(linux_state->userMemoryHugePages && linux_state->userMemoryPageSize == linux_state->system.info.pageSize)
+    {
+        PL_SetErrorString("huge pages unavailable for user memory, using %llu byte pages",
+                          (unsigned long long)linux_state->system.info.pageSize);
     }
+    
+    linux_state->userMemory = memory;
+    linux_state->userMemoryReserved = PL_USER_MEMORY_RESERVE;
+    return Linux_CommitUserMemory(size);
 }
 
-static void Win32_UpdateInput(void)
+/*========== Input ===============*/
+
+static void Linux_ProcessButton(PL_ButtonState *button, r64 dT)
 {
-    PL_ButtonState *keyboard = win32_state->input.keyboard;
-    for(int keyIndex = 0;
-        keyIndex < K_MAX;
-        keyIndex++)
+    if(button->isDown)
     {
-        if(keyboard[keyIndex].isDown)
-        {
-            if(!keyboard[keyIndex].wasDown)
-            {
-                keyboard[keyIndex].wasDown = 1;
-            }
-            
-            keyboard[keyIndex].downTick = 0;
-        }
-        else if(keyboard[keyIndex].wasDown)
-        {
-            keyboard[keyIndex].wasDown = 0;
-        }
-        else
+        if(!button->wasDown)
         {
-            keyboard[keyIndex].tDown = 0.0f;
+            button->downTick = 1;
         }
-        
-        keyboard[keyIndex].downTick = 0;
-        keyboard[keyIndex].upTick = 0;
+        button->tDown += dT;
+    }
+    else if(button->wasDown)
+    {
+        button->upTick = 1;
+    }
+}
+
+static void Linux_UpdateButton(PL_ButtonState *button)
+{
+    if(button->isDown)
+    {
+        button->wasDown = 1;
+    }
+    else if(button->wasDown)
+    {
+        button->wasDown = 0;
+    }
+    else
+    {
+        button->tDown = 0.0f;
     }
     
-    PL_ButtonState *buttons = win32_state->input.mouse.buttons;
-    for(int mouseBtnIndex = 0;
-        mouseBtnIndex < MB_MAX;
-        mouseBtnIndex++)
+    button->downTick = 0;
+    button->upTick = 0;
+}
+
+static void Linux_ProcessInput(r64 dT)
+{
+    PL_PROFILE_BEGIN("Linux_ProcessInput");
+    PL_Input *input = &linux_state->input;
+    
+    for(int keyIndex = 0; keyIndex < K_MAX; keyIndex++)
     {
-        if(buttons[mouseBtnIndex].isDown)
+        Linux_ProcessButton(&input->keyboard[keyIndex], dT);
+    }
+    
+    for(int mouseBtnIndex = 0; mouseBtnIndex < MB_MAX; mouseBtnIndex++)
+    {
+        Linux_ProcessButton(&input->mouse.buttons[mouseBtnIndex], dT);
+    }
+    
+    for(int gamepadIndex = 0; gamepadIndex < GP_MAX_COUNT; gamepadIndex++)
+    {
+        if(input->gamepads[gamepadIndex].isConnected)
         {
-            if(!buttons[mouseBtnIndex].wasDown)
+            for(int gamepadBtnIndex = 0; gamepadBtnIndex < GP_MAX; gamepadBtnIndex++)
             {
-                buttons[mouseBtnIndex].wasDown = 1;
+                Linux_ProcessButton(&input->gamepads[gamepadIndex].buttons[gamepadBtnIndex], dT);
             }
-            
-            buttons[mouseBtnIndex].downTick = 0;
-        }
-        else if(buttons[mouseBtnIndex].wasDown)
-        {
-            buttons[mouseBtnIndex].wasDown = 0;
-        }
-        else
-        {
-            buttons[mouseBtnIndex].tDown = 0.0f;
         }
-        
-        buttons[mouseBtnIndex].downTick = 0;
-        buttons[mouseBtnIndex].upTick = 0;
     }
     
-    win32_state->input.mouse.wheel = 0;
+    PL_PROFILE_END();
+}
+
+static void Linux_UpdateInput(void)
+{
+    PL_Input *input = &linux_state->input;
     
-    PL_Gamepad *gamepads = win32_state->input.gamepads;
-    for(int gamepadIndex = 0;
-        gamepadIndex < XUSER_MAX_COUNT;
-        gamepadIndex++)
+    for(int keyIndex = 0; keyIndex < K_MAX; keyIndex++)
     {
-        if(gamepads[gamepadIndex].isConnected)
+        Linux_UpdateButton(&input->keyboard[keyIndex]);
+    }
+    
+    for(int mouseBtnIndex = 0; mouseBtnIndex < MB_MAX; mouseBtnIndex++)
+    {
+        Linux_UpdateButton(&input->mouse.buttons[mouseBtnIndex]);
+    }
+    
+    input->mouse.wheel = 0;
+    
+    for(int gamepadIndex = 0; gamepadIndex < GP_MAX_COUNT; gamepadIndex++)
+    {
+        if(input->gamepads[gamepadIndex].isConnected)
         {
-            for(int gamepadBtnIndex = 0;
-                gamepadBtnIndex < GP_MAX;
-                gamepadBtnIndex++)
+            for(int gamepadBtnIndex = 0; gamepadBtnIndex < GP_MAX; gamepadBtnIndex++)
             {
-                if(gamepads[gamepadIndex].buttons[gamepadBtnIndex].isDown)
-                {
-                    if(!gamepads[gamepadIndex].buttons[gamepadBtnIndex].wasDown)
-                    {
-                        gamepads[gamepadIndex].buttons[gamepadBtnIndex].wasDown = 1;
-                    }
-                    
-                    gamepads[gamepadIndex].buttons[gamepadBtnIndex].downTick = 0;
-                }
-                else if(gamepads[gamepadIndex].buttons[gamepadBtnIndex].wasDown)
-                {
-                    gamepads[gamepadIndex].buttons[gamepadBtnIndex].wasDown = 0;
-                }
-                else
-                {
-                    gamepads[gamepadIndex].buttons[gamepadBtnIndex].tDown = 0.0f;
-                }
-                
-                gamepads[gamepadIndex].buttons[gamepadBtnIndex].downTick = 0;
-                gamepads[gamepadIndex].buttons[gamepadBtnIndex].upTick = 0;
+                Linux_UpdateButton(&input->gamepads[gamepadIndex].buttons[gamepadBtnIndex]);
             }
         }
     }
 }
 
-static void Win32_UpdateWindow(void)
+/*================================
+   Window Functions
+================================*/
+
+#if defined(PL_LINUX_X11)
+static int Linux_XErrorHandler(Display *display, XErrorEvent *event)
 {
-    RECT dim = {0};
-    GetClientRect(win32_state->window.handle, &dim);
-    win32_state->window.window.dim.w = dim.right;
-    win32_state->window.window.dim.h = dim.bottom;
-    GetWindowRect(win32_state->window.handle, &dim);
-    win32_state->window.window.dim.x = dim.left;
-    win32_state->window.window.dim.y = dim.top;
-    glViewport(0, 0, win32_state->window.window.dim.w, win32_state->window.window.dim.h);
-    SwapBuffers(win32_state->window.dc);
-    glClearColor(0,0,0,0);
-    glClear(GL_COLOR_BUFFER_BIT);
+    // default handler exits the process, just record it instead
+    linux_state->window.xerror = (int)event->error_code;
+    return 0;
 }
 
-static void Win32_MessageLoop(void)
+static void Linux_FullscreenToggle(void)
 {
-    MSG msg;
-    while(PeekMessageA(&msg, win32_state->window.handle, 0, 0, PM_REMOVE))
-    {
-        TranslateMessage(&msg);
-        DispatchMessageA(&msg);
-    }
+    Linux_Window *linux_window = &linux_state->window;
+    XEvent event = {0};
+    event.type = ClientMessage;
+    event.xclient.window = linux_window->handle;
+    event.xclient.message_type = linux_window->wmState;
+    event.xclient.format = 32;
+    event.xclient.data.l[0] = (linux_window->window.fullscreen) ? 0 : 1; // _NET_WM_STATE_REMOVE/ADD
+    event.xclient.data.l[1] = (long)linux_window->wmStateFullscreen;
+    event.xclient.data.l[2] = 0;
+    event.xclient.data.l[3] = 1; // source: normal application
     
-    r64 dT = Win32_GetPerfElapsed(win32_state->timer.lastFramePerf);
-    Win32_ProcessInput(dT);
+    XSendEvent(linux_window->display, DefaultRootWindow(linux_window->display), False,
+               SubstructureRedirectMask | SubstructureNotifyMask, &event);
+    XFlush(linux_window->display);
+    linux_window->window.fullscreen = !linux_window->window.fullscreen;
 }
 
-static b32 Win32_CreateWindow(void)
+#endif // PL_LINUX_X11
+
+static void Linux_SetVSync(b32 vsync)
 {
-    Win32_Window *win32_window = &win32_state->window;
-    PL_Window *pl_window = &win32_window->window;
-    WNDCLASSA *wndclass = &win32_window->wndclass;
-    
-    wndclass->style = CS_HREDRAW | CS_VREDRAW | CS_OWNDC;
-    wndclass->lpfnWndProc = Win32_WndProc;
-    wndclass->hInstance = GetModuleHandle(0);
-    wndclass->lpszClassName = "PLWINDOWCLASS";
+    Linux_Window *linux_window = &linux_state->window;
     
-    if(!RegisterClassA(wndclass))
+    if(linux_window->headless)
     {
-        PL_SetErrorString("Error registering WNDCLASS. Code(%u)", GetLastError());
-        PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
-        return 0;
+        // nothing to sync to without a display
+        linux_window->window.vsync = 0;
+        return;
     }
     
-    // temp window to get OpenGL context settings
-    HWND tmpWindow = CreateWindowA(wndclass->lpszClassName,
-                                   "tmpWindow", WS_OVERLAPPEDWINDOW,
-                                   0,0,1,1,0,0, wndclass->hInstance, 0);
+#if defined(PL_LINUX_X11)
+    int interval = (vsync) ? 1 : 0;
     
-    if(!tmpWindow)
+    if(glXSwapIntervalEXT)
     {
-        PL_SetErrorString("Failed to create Window. Code(%u)", GetLastError());
-        PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
-        return 0;
+        glXSwapIntervalEXT(linux_window->display, linux_window->handle, interval);
+    }
+    else if(glXSwapIntervalMESA)
+    {
+        glXSwapIntervalMESA((unsigned int)interval);
+    }
+    else if(glXSwapIntervalSGI && interval)
+    {
+        glXSwapIntervalSGI(interval); // SGI can't turn vsync off
+    }
+    else
+    {
+        interval = 0;
     }
     
-    HDC tmpDC = GetDC(tmpWindow);
-    HGLRC tmpRC = 0;
-    int tmpPixelFormat = 0;
+    linux_window->window.vsync = (interval) ? 1 : 0;
+#endif
+}
+
+#if defined(PL_LINUX_X11)
+// glXGetProcAddress returns non-null for any name, so GLX extension functions are only
+// loaded when the extension string lists them. whole names only: "GLX_ARB_create_context"
+// is also a prefix of "GLX_ARB_create_context_profile"
+static b32 Linux_HasGLXExtension(Display *display, const char *name)
+{
+    const char *extensions = glXQueryExtensionsString(display, DefaultScreen(display));
+    u64 len = strlen(name);
+    for(const char *found = extensions; found && (found = strstr(found, name)); found += len)
+    {
+        b32 start = (found == extensions) || (found[-1] == ' ');
+        b32 end = (found[len] == ' ') || (found[len] == 0);
+        if(start && end) return 1;
+    }
     
-    { // tmpWindow Getting PixelFormat
-        PIXELFORMATDESCRIPTOR pixelFormatDesc = {0};
-        pixelFormatDesc.nSize = sizeof(PIXELFORMATDESCRIPTOR);
-        pixelFormatDesc.nVersion = 1;
-        pixelFormatDesc.dwFlags = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL;
-        pixelFormatDesc.iPixelType = PFD_TYPE_RGBA;
-        pixelFormatDesc.cColorBits = 32;
-        pixelFormatDesc.cAlphaBits = 8;
-        pixelFormatDesc.cDepthBits = 24;
-        tmpPixelFormat = ChoosePixelFormat(tmpDC, &pixelFormatDesc);
+    return 0;
+}
+
+static void Linux_LoadSwapInterval(void)
+{
+    Display *display = linux_state->window.display;
+    if(Linux_HasGLXExtension(display, "GLX_EXT_swap_control"))
+    {
+        glXSwapIntervalEXT = (pfn_glXSwapIntervalEXT)glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalEXT");
+    }
+    if(Linux_HasGLXExtension(display, "GLX_MESA_swap_control"))
+    {
+        glXSwapIntervalMESA = (pfn_glXSwapIntervalMESA)glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalMESA");
+    }
+    if(Linux_HasGLXExtension(display, "GLX_SGI_swap_control"))
+    {
+        glXSwapIntervalSGI = (pfn_glXSwapIntervalSGI)glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalSGI");
+    }
+}
+
+static ptr PL_GLGetProcAddress(const char *name)
+{
+    return (ptr)glXGetProcAddressARB((const GLubyte*)name);
+}
+
+static void Linux_HandleEvent(XEvent *event)
+{
+    Linux_Window *linux_window = &linux_state->window;
+    PL_Window *pl_window = &linux_window->window;
+    PL_Input *input = &linux_state->input;
+    
+    switch(event->type)
+    {
+        case ClientMessage:
+        {
+            if((Atom)event->xclient.data.l[0] == linux_window->wmDeleteWindow)
+            {
+                linux_state->running = 0;
+            }
+        } break;
         
-        if(tmpPixelFormat)
+        case DestroyNotify:
         {
-            if(SetPixelFormat(tmpDC, tmpPixelFormat, &pixelFormatDesc))
+            linux_state->running = 0;
+        } break;
+        
+        case FocusIn:
+        {
+            pl_window->focus = 1;
+        } break;
+        
+        case FocusOut:
+        {
+            pl_window->focus = 0;
+        } break;
+        
+        case ConfigureNotify:
+        {
+            pl_window->dim.x = event->xconfigure.x;
+            pl_window->dim.y = event->xconfigure.y;
+            pl_window->dim.w = event->xconfigure.width;
+            pl_window->dim.h = event->xconfigure.height;
+            glViewport(0, 0, pl_window->dim.w, pl_window->dim.h);
+        } break;
+        
+        case KeyPress:
+        {
+            PL_KEYCODE key = Linux_XKeyToPLKeycode(XLookupKeysym(&event->xkey, 0));
+            input->keyboard[key].isDown = 1;
+        } break;
+        
+        case KeyRelease:
+        {
+            // key repeat arrives as a release immediately followed by a press,
+            // skip the release so the key stays down like it does on win32
+            if(XEventsQueued(linux_window->display, QueuedAfterReading))
             {
-                tmpRC = wglCreateContext(tmpDC);
+                XEvent next;
+                XPeekEvent(linux_window->display, &next);
+                if(next.type == KeyPress &&
+                   next.xkey.time == event->xkey.time &&
+                   next.xkey.keycode == event->xkey.keycode)
+                {
+                    break;
+                }
             }
-        }
+            
+            PL_KEYCODE key = Linux_XKeyToPLKeycode(XLookupKeysym(&event->xkey, 0));
+            input->keyboard[key].isDown = 0;
+        } break;
         
-        else
+        case MotionNotify:
         {
-            PL_SetErrorString("Failed to get pixel format. Code(%u)", GetLastError());
-            PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
-            return 0;
-        }
+            input->mouse.px = event->xmotion.x;
+            input->mouse.py = event->xmotion.y;
+            input->mouse.rx = (PL_norm32((r32)event->xmotion.x, 0.0f, (r32)pl_window->dim.w) * 2.0f) - 1.0f;
+            input->mouse.ry = (PL_norm32((r32)event->xmotion.y, 0.0f, (r32)pl_window->dim.h) * 2.0f) - 1.0f;
+        } break;
         
-        if(!tmpRC)
+        case ButtonPress:
+        case ButtonRelease:
+        {
+            b32 isDown = (event->type == ButtonPress);
+            
+            switch(event->xbutton.button)
+            {
+                case Button1: input->mouse.buttons[MB_LEFT].isDown = isDown; break;
+                case Button2: input->mouse.buttons[MB_MIDDLE].isDown = isDown; break;
+                case Button3: input->mouse.buttons[MB_RIGHT].isDown = isDown; break;
+                case Button4: if(isDown) input->mouse.wheel++; break;
+                case Button5: if(isDown) input->mouse.wheel--; break;
+                case 8: input->mouse.buttons[MB_X1].isDown = isDown; break;
+                case 9: input->mouse.buttons[MB_X2].isDown = isDown; break;
+            }
+        } break;
+    }
+}
+#endif // PL_LINUX_X11
+
+static void Linux_UpdateWindow(void)
+{
+    Linux_Window *linux_window = &linux_state->window;
+    
+    if(linux_window->headless)
+    {
+        return;
+    }
+    
+#if defined(PL_LINUX_X11)
+    PL_PROFILE_BEGIN("Linux_UpdateWindow");
+    glViewport(0, 0, linux_window->window.dim.w, linux_window->window.dim.h);
+    glXSwapBuffers(linux_window->display, linux_window->handle);
+    glClearColor(0,0,0,0);
+    glClear(GL_COLOR_BUFFER_BIT);
+    
+    PL_PROFILE_END();
+#endif
+}
+
+static void Linux_MessageLoop(void)
+{
+#if defined(PL_LINUX_X11)
+    Linux_Window *linux_window = &linux_state->window;
+    
+    if(!linux_window->headless)
+    {
+        while(XPending(linux_window->display))
         {
-            PL_SetErrorString("Failed to get WGL RenderContext. Code(%u)", GetLastError());
-            PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
-            return 0;
+            XEvent event;
+            XNextEvent(linux_window->display, &event);
+            Linux_HandleEvent(&event);
         }
     }
+#endif
     
-    win32_window->style = WS_VISIBLE | WS_OVERLAPPEDWINDOW;
-    win32_window->handle = CreateWindowExA(0, wndclass->lpszClassName,
-                                           "Window", win32_window->style,
-                                           CW_USEDEFAULT, CW_USEDEFAULT,
-                                           pl_window->dim.w, pl_window->dim.h, 0, 0,
-                                           wndclass->hInstance, 0);
+    r64 dT = Linux_GetPerfElapsed(linux_state->timer.lastFramePerf);
+    Linux_ProcessInput(dT);
+}
+
+#if defined(PL_LINUX_X11)
+static b32 Linux_CreateWindow(void)
+{
+    Linux_Window *linux_window = &linux_state->window;
+    PL_Window *pl_window = &linux_window->window;
+    Display *display = linux_window->display;
+    int screen = DefaultScreen(display);
     
-    if(!win32_window->handle)
+    XSetErrorHandler(Linux_XErrorHandler);
+    
+    const int fbAttribs[] =
     {
-        PL_SetErrorString("Failed to create Window. Code(%u)", GetLastError());
-        PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
-        return 0;
-    }
+        GLX_X_RENDERABLE, True,
+        GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT,
+        GLX_RENDER_TYPE, GLX_RGBA_BIT,
+        GLX_X_VISUAL_TYPE, GLX_TRUE_COLOR,
+        GLX_RED_SIZE, 8,
+        GLX_GREEN_SIZE, 8,
+        GLX_BLUE_SIZE, 8,
+        GLX_ALPHA_SIZE, 8,
+        GLX_DEPTH_SIZE, 24,
+        GLX_DOUBLEBUFFER, True,
+        None
+    };
     
-    win32_window->wp.length = sizeof(WINDOWPLACEMENT);
-    GetWindowPlacement(win32_window->handle, &win32_window->wp);
-    win32_window->dc = GetDC(win32_window->handle);
+    int contextAttributes[] =
+    {
+        GLX_CONTEXT_MAJOR_VERSION_ARB, PL_OPENGL_MAJ,
+        GLX_CONTEXT_MINOR_VERSION_ARB, PL_OPENGL_MIN,
+        GLX_CONTEXT_PROFILE_MASK_ARB, GLX_CONTEXT_CORE_PROFILE_BIT_ARB,
+        None
+    };
     
-    if(!wglMakeCurrent(tmpDC, tmpRC))
+    int numConfigs = 0;
+    GLXFBConfig *configs = glXChooseFBConfig(display, screen, fbAttribs, &numConfigs);
+    if(!configs || !numConfigs)
     {
-        PL_SetErrorString("Failed to set OpenGL RenderContext. Code(%u)", GetLastError());
+        PL_SetErrorString("Failed to get GLX FBConfig.");
         PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
         return 0;
     }
     
-    if(!Win32_LoadWGL())
+    GLXFBConfig config = configs[0];
+    XFree(configs);
+    
+    XVisualInfo *visual = glXGetVisualFromFBConfig(display, config);
+    if(!visual)
     {
-        PL_SetErrorString("Failed to load WGL functions.");
+        PL_SetErrorString("Failed to get X visual from GLX FBConfig.");
         PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
         return 0;
     }
     
-    int pixelFormat;
-    BOOL status;
-    UINT numFormats;
+    Window root = RootWindow(display, screen);
+    linux_window->colormap = XCreateColormap(display, root, visual->visual, AllocNone);
     
-    const int pixelAttribs[] =
-    {
-        WGL_DRAW_TO_WINDOW_ARB, GL_TRUE,
-        WGL_SUPPORT_OPENGL_ARB, GL_TRUE,
-        WGL_DOUBLE_BUFFER_ARB, GL_TRUE,
-        WGL_SWAP_METHOD_ARB, WGL_SWAP_COPY_ARB,
-        WGL_PIXEL_TYPE_ARB, WGL_TYPE_RGBA_ARB,
-        WGL_ACCELERATION_ARB, WGL_FULL_ACCELERATION_ARB,
-        WGL_COLOR_BITS_ARB, 32,
-        WGL_ALPHA_BITS_ARB, 8,
-        WGL_DEPTH_BITS_ARB, 24,
-        0
-    };
+    XSetWindowAttributes windowAttributes = {0};
+    windowAttributes.colormap = linux_window->colormap;
+    windowAttributes.event_mask = (KeyPressMask | KeyReleaseMask |
+                                   ButtonPressMask | ButtonReleaseMask | PointerMotionMask |
+                                   StructureNotifyMask | FocusChangeMask);
     
-    int contextAttributes[] =
+    linux_window->handle = XCreateWindow(display, root,
+                                         pl_window->dim.x, pl_window->dim.y,
+                                         (unsigned int)pl_window->dim.w, (unsigned int)pl_window->dim.h,
+                                         0, visual->depth, InputOutput, visual->visual,
+                                         CWColormap | CWEventMask, &windowAttributes);
+    XFree(visual);
+    
+    if(!linux_window->handle)
     {
-        WGL_CONTEXT_MAJOR_VERSION_ARB, PL_OPENGL_MAJ,
-        WGL_CONTEXT_MINOR_VERSION_ARB, PL_OPENGL_MIN,
-        WGL_CONTEXT_PROFILE_MASK_ARB, WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
-        0
-    };
+        PL_SetErrorString("Failed to create Window.");
+        PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
+        return 0;
+    }
     
-    status = wglChoosePixelFormatARB(win32_window->dc, pixelAttribs, 0, 1,
-                                     &pixelFormat, &numFormats);
+    linux_window->wmDeleteWindow = XInternAtom(display, "WM_DELETE_WINDOW", False);
+    linux_window->wmState = XInternAtom(display, "_NET_WM_STATE", False);
+    linux_window->wmStateFullscreen = XInternAtom(display, "_NET_WM_STATE_FULLSCREEN", False);
+    XSetWMProtocols(display, linux_window->handle, &linux_window->wmDeleteWindow, 1);
+    XStoreName(display, linux_window->handle, "Window");
+    XMapWindow(display, linux_window->handle);
     
-    if(!status || !numFormats)
+    // a 4.5 core context needs both, a missing function only shows up at the call
+    if(!Linux_HasGLXExtension(display, "GLX_ARB_create_context") ||
+       !Linux_HasGLXExtension(display, "GLX_ARB_create_context_profile"))
     {
-        PL_SetErrorString("Failed to get Windows OpenGL PixelFormat.");
+        PL_SetErrorString("GLX_ARB_create_context(_profile) not supported.");
         PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
         return 0;
     }
     
-    PIXELFORMATDESCRIPTOR pixelFormatDesc = {0};
-    DescribePixelFormat(win32_window->dc, pixelFormat, sizeof(PIXELFORMATDESCRIPTOR), &pixelFormatDesc);
-    if(!SetPixelFormat(win32_window->dc, pixelFormat, &pixelFormatDesc))
+    glXCreateContextAttribsARB = (pfn_glXCreateContextAttribsARB)
+        glXGetProcAddressARB((const GLubyte*)"glXCreateContextAttribsARB");
+    if(!glXCreateContextAttribsARB)
     {
-        PL_SetErrorString("Failed to set Windows OpenGL PixelFormat");
+        PL_SetErrorString("Failed to load glXCreateContextAttribsARB.");
         PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
         return 0;
     }
     
-    win32_window->rc = wglCreateContextAttribsARB(win32_window->dc, 0, contextAttributes);
-    if(!win32_window->rc)
+    linux_window->xerror = 0;
+    linux_window->rc = glXCreateContextAttribsARB(display, config, 0, True, contextAttributes);
+    XSync(display, False);
+    if(!linux_window->rc || linux_window->xerror)
     {
-        PL_SetErrorString("Failed to create Windows OpenGL RenderContext. Code(%u)", GetLastError());
+        PL_SetErrorString("Failed to create GLX OpenGL %d.%d core RenderContext. Code(%d)",
+                          PL_OPENGL_MAJ, PL_OPENGL_MIN, linux_window->xerror);
         PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
         return 0;
     }
     
-    // unset and clear up tmp
-    wglMakeCurrent(tmpDC, 0);
-    wglDeleteContext(tmpRC);
-    ReleaseDC(tmpWindow, tmpDC);
-    DestroyWindow(tmpWindow);
-    
-    if(!wglMakeCurrent(win32_window->dc, win32_window->rc))
+    if(!glXMakeCurrent(display, linux_window->handle, linux_window->rc))
     {
-        PL_SetErrorString("Failed to set Windows OpenGL RenderContext. Code(%u)", GetLastError());
+        PL_SetErrorString("Failed to set GLX OpenGL RenderContext.");
         PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
         return 0;
     }
     
-    if(!Win32_LoadOpenGL((r32)PL_OPENGL_MAJ + ((r32)PL_OPENGL_MIN/10.0f)))
+    if(!PL_LoadOpenGL((r32)PL_OPENGL_MAJ + ((r32)PL_OPENGL_MIN/10.0f)))
     {
         PL_SetErrorString("Failed to load OpenGL functions.");
         PL_MsgBoxError("Fatal", "%s", PL_GetErrorString());
         return 0;
     }
     
-    win32_window->init = 1;
-    Win32_SetVSync(pl_window->vsync);
+    Linux_LoadSwapInterval();
+    linux_window->init = 1;
+    Linux_SetVSync(pl_window->vsync);
     
     glViewport(0, 0, pl_window->dim.w, pl_window->dim.h);
     glClearColor(0,0,0,0);
     glClear(GL_COLOR_BUFFER_BIT);
-    SwapBuffers(win32_window->dc);
+    glXSwapBuffers(display, linux_window->handle);
     
     return 1;
 }
 
-int CALLBACK WinMain(HINSTANCE instance,
-                     HINSTANCE prevInstance,
-                     LPSTR cmdLine,
-                     int showCode)
+#endif // PL_LINUX_X11
+
+static void Linux_ParseArgs(int argc, char **argv)
 {
-    win32_state = (Win32_State*)PL_Alloc0(sizeof(Win32_State));
+    for(int argIndex = 1; argIndex < argc; argIndex++)
+    {
+        cstr arg = argv[argIndex];
+        cstr value = (argIndex + 1 < argc) ? argv[argIndex + 1] : 0;
+        
+        if(!strcmp(arg, "-headless"))
+        {
+            linux_state->window.headless = 1;
+        }
+        
+        else if(!strcmp(arg, "-hugepages"))
+        {
+            linux_state->userMemoryHugePages = 1;
+        }
+        
+        else if(!strcmp(arg, "-fps") && value)
+        {
+            linux_state->window.window.framerate = atoi(value);
+            argIndex++;
+        }
+        
+        else if(!strcmp(arg, "-frames") && value)
+        {
+            linux_state->maxFrames = strtoull(value, 0, 10);
+            argIndex++;
+        }
+        
+        else if(!strcmp(arg, "-trace") && value)
+        {
+            linux_state->tracePath = value;
+            argIndex++;
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    linux_state = (Linux_State*)PL_Alloc0(sizeof(Linux_State));
     
-    if(win32_state)
+    if(linux_state)
     {
-        win32_state->running = 1;
+        linux_state->running = 1;
     }
     else
     {
         return -1;
     }
     
-    win32_state->userMemorySize = MB(256);
-    win32_state->window.window.framerate = 60;
-    win32_state->window.window.dim.x = 0;
-    win32_state->window.window.dim.y = 0;
-    win32_state->window.window.dim.w = 960;
-    win32_state->window.window.dim.h = 540;
-    win32_state->window.window.vsync = 1;
-    win32_state->userMemory = PL_Alloc0(win32_state->userMemorySize);
+    linux_state->userMemorySize = MB(256);
+    linux_state->window.window.framerate = 60;
+    linux_state->window.window.dim.x = 0;
+    linux_state->window.window.dim.y = 0;
+    linux_state->window.window.dim.w = 960;
+    linux_state->window.window.dim.h = 540;
+    linux_state->window.window.vsync = 1;
+    linux_state->userMemoryHugePages = PL_USER_MEMORY_HUGE_PAGES;
+    Linux_ParseArgs(argc, argv);
+    Linux_SetSystemInfo();
+    
+    if(!Linux_InitUserMemory(linux_state->userMemorySize))
+    {
+        return -1;
+    }
     
-    if(!win32_state->userMemory)
+    PL_ArenaInit(&linux_state->userArena, linux_state->userMemory, linux_state->userMemorySize);
+    PL_ArenaInit(&linux_state->frameArena, PL_Alloc(PL_FRAME_ARENA_SIZE), PL_FRAME_ARENA_SIZE);
+    
+    if(!linux_state->frameArena.base)
     {
         return -1;
     }
     
-    Win32_SetSystemInfo();
-    if(!Win32_LoadUserLib()) return -1;
-    if(!Win32_LoadGDILib()) return -1;
-    if(!Win32_LoadWGLLib()) return -1;
-    Win32_LoadXInput();
-    Win32_LoadXAudio();
     
-    if(!Win32_CreateWindow()) return -1;
-    Win32_AudioInit();
-    Win32_InitTimer();
-    Win32_UpdateTimer();
+#if defined(PL_LINUX_X11)
+    if(!linux_state->window.headless)
+    {
+        if(Linux_LoadX11Lib() && Linux_LoadGLXLib() &&
+           (linux_state->window.display = XOpenDisplay(0)))
+        {
+            if(!Linux_CreateWindow()) return -1;
+        }
+        else
+        {
+            PL_SetErrorString("No X display or GLX available, running headless.");
+            linux_state->window.headless = 1;
+        }
+    }
+#else
+    linux_state->window.headless = 1;
+#endif
+    
+    if(linux_state->window.headless)
+    {
+        linux_state->window.window.vsync = 0;
+        linux_state->window.init = 1;
+    }
+    
+    Linux_InitTimer();
+    Linux_UpdateTimer();
     
     PL_Startup();
     
-    while(win32_state->running)
+    while(linux_state->running)
     {
-        Win32_MessageLoop();
-        Win32_UpdateTimer();
-        Win32_AudioFrame();
+        PL_PROFILE_FRAME();
+        Linux_MessageLoop();
+        Linux_UpdateTimer();
+        Linux_AudioFrame();
+        PL_FixedStepFrame(&linux_state->timer.timer, linux_state->timer.frameTicks);
+        PL_PROFILE_BEGIN("PL_Frame");
         PL_Frame();
-        Win32_UpdateWindow();
-        Win32_UpdateInput();
+        PL_PROFILE_END();
+        PL_ArenaReset(&linux_state->frameArena);
+        Linux_UpdateWindow();
+        Linux_UpdateInput();
+        
+        if(linux_state->maxFrames &&
+           linux_state->timer.timer.frames > linux_state->maxFrames)
+        {
+            linux_state->running = 0;
+        }
+    }
+    
+    if(linux_state->tracePath && !PL_ProfileDump(linux_state->tracePath))
+    {
+        PL_SetErrorString("failed to write trace file");
     }
     
     return 0;
 }
 
-// if subsystem:console is used
-int main()
+u64 PL_GetUserMemorySize(void)
 {
-    return WinMain(GetModuleHandle(0), 0, GetCommandLineA(), SW_SHOWNORMAL);
+    return linux_state->userMemorySize;
 }
 
-u64 PL_GetUserMemorySize(void)
+u64 PL_GetUserMemoryPageSize(void)
 {
-    return win32_state->userMemorySize;
+    return linux_state->userMemoryPageSize;
+}
+
+PL_Arena *PL_GetUserArena(void)
+{
+    return &linux_state->userArena;
+}
+
+PL_Arena *PL_GetFrameArena(void)
+{
+    return &linux_state->frameArena;
 }
 
 ptr PL_GetUserMemory(void)
 {
-    return win32_state->userMemory;
+    return linux_state->userMemory;
 }
 
 b32 PL_SetUserMemorySize(u64 size)
 {
-    if(size > MB(256) &&
-       size != win32_state->userMemorySize)
+    if(size < MB(256)) size = MB(256);
+    
+    if(size < linux_state->userArena.used)
     {
-        win32_state->userMemorySize = size;
-        PL_ReAlloc0(win32_state->userMemory, win32_state->userMemorySize);
+        PL_SetErrorString("PL_SetUserMemorySize: %llu is smaller than the user arena in use (%llu)",
+                          (unsigned long long)size, (unsigned long long)linux_state->userArena.used);
+        return 0;
     }
     
-    if(win32_state->userMemory)
-        return 1;
-    return 0;
+    if(size != linux_state->userMemorySize)
+    {
+        if(!Linux_CommitUserMemory(size))
+        {
+            PL_SetErrorString("PL_SetUserMemorySize: failed to commit %llu bytes (%llu reserved)",
+                              (unsigned long long)size, (unsigned long long)linux_state->userMemoryReserved);
+            return 0;
+        }
+        
+        linux_state->userArena.size = size;
+    }
+    
+    return 1;
 }
 
 PL_Window *PL_GetWindow(void)
 {
-    return &win32_state->window.window;
+    return &linux_state->window.window;
 }
 
 void PL_SetWindowTitle(const cstr format, ...)
 {
-    char title[256] = {0};
+    Linux_Window *linux_window = &linux_state->window;
+    PL_Str title = PL_StrBuffer(linux_window->title, sizeof(linux_window->title));
     va_list args;
     va_start(args, format);
-    vsnprintf(title, 256, format, args);
+    PL_StrAppendV(&title, format, args);
     va_end(args);
-    SetWindowTextA(win32_state->window.handle, title);
+    
+#if defined(PL_LINUX_X11)
+    if(!linux_window->headless)
+    {
+        XStoreName(linux_window->display, linux_window->handle, linux_window->title);
+    }
+#endif
 }
 
 void PL_SetWindowPos(i32 x, i32 y, i32 w, i32 h)
 {
-    RECT dim = {0};
-    GetClientRect(win32_state->window.handle, &dim);
-    win32_state->window.window.dim.w = dim.right;
-    win32_state->window.window.dim.h = dim.bottom;
-    GetWindowRect(win32_state->window.handle, &dim);
-    win32_state->window.window.dim.x = dim.left;
-    win32_state->window.window.dim.y = dim.top;
+    Linux_Window *linux_window = &linux_state->window;
+    PL_Rect *dim = &linux_window->window.dim;
     
-    if(x == -1) x = dim.left;
-    if(y == -1) y = dim.top;
-    if(w == -1) w = dim.right;
-    if(h == -1) h = dim.bottom;
+    if(x == -1) x = dim->x;
+    if(y == -1) y = dim->y;
+    if(w == -1) w = dim->w;
+    if(h == -1) h = dim->h;
     
-    MoveWindow(win32_state->window.handle, x,y,w,h, 0);
+#if defined(PL_LINUX_X11)
+    if(!linux_window->headless)
+    {
+        // dim gets updated by ConfigureNotify
+        XMoveResizeWindow(linux_window->display, linux_window->handle,
+                          x, y, (unsigned int)w, (unsigned int)h);
+        return;
+    }
+#endif
+    
+    dim->x = x;
+    dim->y = y;
+    dim->w = w;
+    dim->h = h;
 }
 
 void PL_SetWindowFramerate(i32 framerate)
 {
-    win32_state->window.window.framerate = framerate;
+    linux_state->window.window.framerate = framerate;
 }
 
 void PL_SetWindowVSync(b32 vsync)
 {
-    Win32_SetVSync(vsync);
+    Linux_SetVSync(vsync);
 }
 
 void PL_SetWindowFullscreen(b32 fullscreen)
 {
-    if(win32_state->window.window.fullscreen)
+    if(linux_state->window.window.fullscreen)
     {
-        if(!fullscreen) Win32_FullscreenToggle();
+        if(!fullscreen) PL_ToggleWindowFullscreen();
     }
     else
     {
-        if(fullscreen) Win32_FullscreenToggle();
+        if(fullscreen) PL_ToggleWindowFullscreen();
     }
 }
 
 b32 PL_ToggleWindowFullscreen(void)
 {
-    Win32_FullscreenToggle();
-    return win32_state->window.window.fullscreen;
-}
-
-/*==============================
-      PHRAGLIB MACOS
-      Mac Specific
-===============================*/
-#elif defined(PL_MACOS)
-
-//TODO
-
-int main(int argc, char **argv)
-{
+#if defined(PL_LINUX_X11)
+    if(!linux_state->window.headless)
+    {
+        Linux_FullscreenToggle();
+        return linux_state->window.window.fullscreen;
+    }
+#endif
     
-    return 0;
-}
-
-
-
-/*==============================
-      PHRAGLIB LINUX
-      Linux Specific
-===============================*/
-#elif defined(PL_LINUX)
-
-//TODO
-
-int main(int argc, char **argv)
-{
+    linux_state->window.window.fullscreen = !linux_state->window.window.fullscreen;
     
-    return 0;
+    return linux_state->window.window.fullscreen;
 }
 
-
-
-
-
-
 /*==============================
      END OF PLATFORM CODE
 ===============================*/
@@ -18,7 +18,15 @@ extern "C" {
     - PL_ErrorCallback is called when an error occurs.
     - PL_Startup is called once before main loop.
     - PL_Frame is called every frame after input/event handling, before window update.
+    - optional fixed timestep: PL_SetFixedUpdate registers an update(dt) that runs at a fixed rate before PL_Frame,
+      PL_Frame then interpolates its rendering with PL_GetTimer()->alpha
     - PL_Quit() closes the window and quits
+    - Linux: X11/GLX window (libX11/libGL loaded at runtime), command line options:
+        -headless  no window or GL context (also used when there is no X display)
+        -fps N     target framerate when vsync is off, 0 runs uncapped (default 60)
+        -frames N  quit after N frames (default 0: run until PL_Quit)
+        -hugepages back the user memory block with transparent huge pages (see PL_GetUserMemoryPageSize)
+        -trace F   write the profiler ring buffers to F as chrome trace json on exit (build with PL_PROFILE)
     */
 
     /*=======================
@@ -45,6 +53,7 @@ defined(_WIN64)
 #define PL_MACOS
 #elif defined(__linux__)
 #define PL_LINUX
+#define GP_MAX_COUNT 4
 #else
 #error "Unsupported Compiler"
 #endif
@@ -77,6 +86,7 @@ defined(DEBUG) || \
     typedef i32 b32;
 
 #include <float.h>
+#include <stdarg.h>
     typedef float r32;
     typedef double r64;
 
@@ -104,6 +114,12 @@ defined(DEBUG) || \
 #define PL_SwapPtr(type, a, b) {type *tmp=b; b=a; a=tmp;}
     // re-interpret data bits(v) as new type(t)
 #define PL_Reinterpret(t,v) (*((const t*)(v)))
+    // small hot functions defined in this header so they inline into the caller
+#if defined(_MSC_VER) && !defined(__cplusplus)
+#define PL_INLINE static __inline
+#else
+#define PL_INLINE static inline
+#endif
 
     typedef struct
     {
@@ -125,8 +141,19 @@ defined(DEBUG) || \
     =============================*/
     // get handle to user mem block
     ptr PL_GetUserMemory(void);
-    // set user mem size, default 256MB (min 256mb)
+    // set user mem size, default 256MB (min 256mb, max PL_USER_MEMORY_RESERVE)
+    // resizes in place: the block never moves, grown memory reads as zero, shrinking releases pages
     b32 PL_SetUserMemorySize(u64 size);
+#ifndef PL_USER_MEMORY_RESERVE
+#define PL_USER_MEMORY_RESERVE ((sizeof(ptr) == 8) ? GB(64) : MB(1024)) // address space only, no memory used
+#endif
+    // page size backing the user mem block, larger than the system page size when huge pages were obtained
+    // (build with -DPL_USER_MEMORY_HUGE_PAGES=1 or run with -hugepages to request them)
+    // windows large pages need the "Lock pages in memory" privilege and can't grow past the startup size
+    u64 PL_GetUserMemoryPageSize(void);
+#ifndef PL_USER_MEMORY_HUGE_PAGES
+#define PL_USER_MEMORY_HUGE_PAGES 0
+#endif
     // returns current size of user mem block
     u64 PL_GetUserMemorySize(void);
     // closes window and quits running
@@ -136,6 +163,39 @@ defined(DEBUG) || \
     // sets error string (1024 max length, overwrites any existing error, will call ErrorCallback)
     void PL_SetErrorString(const cstr format, ...);
 
+    /*============================
+       System Info
+    =============================*/
+    typedef enum
+    {
+        CPU_UNKNOWN = 0,
+        CPU_AMD64, // amd or intel x64
+        CPU_ARM,
+        CPU_ARM64,
+        CPU_IA64, // intel itanium 64
+        CPU_I86 // intel x86
+    } CPU_TYPE;
+
+    typedef struct
+    {
+        CPU_TYPE cpu;
+        u32 logicalCores; // hardware threads
+        u32 physicalCores;
+        u32 cacheLineSize; // bytes
+        u64 l1DataCache; // bytes, per core
+        u64 l2Cache; // bytes, per core (or core cluster)
+        u64 l3Cache; // bytes, shared (0 when there is none)
+        u64 pageSize;
+        u64 largePageSize; // huge/large page size the OS offers, 0 when unavailable
+        // instruction set extensions usable by this process (supported by cpu and enabled by the OS)
+        b8 sse2, sse42, avx, avx2, fma, avx512f;
+        b8 neon;
+        b8 invariantTSC; // cpu timestamp counter ticks at a constant rate through frequency and sleep states
+    } PL_SystemInfo;
+
+    // filled once at startup, PL picks its SIMD kernels from this
+    PL_SystemInfo *PL_GetSystemInfo(void);
+
     /*============================
        Memory Management
     =============================*/
@@ -150,24 +210,114 @@ defined(DEBUG) || \
     // free previously allocated block, returns success
     b32 PL_Free(ptr mem);
 
+    /*============================
+       Arenas
+    =============================*/
+    // bump allocator over a fixed block, everything pushed is freed at once by reset/temp end
+    typedef struct
+    {
+        u8 *base;
+        u64 size; // bytes available
+        u64 used; // bytes pushed (including alignment padding)
+        u32 tempCount; // open temp markers
+    } PL_Arena;
+
+    // saved arena position, PL_ArenaEndTemp pops everything pushed after PL_ArenaBeginTemp
+    typedef struct
+    {
+        PL_Arena *arena;
+        u64 used;
+    } PL_ArenaTemp;
+
+#define PL_ARENA_DEFAULT_ALIGN 16
+
+    // arena over the whole user memory block, starts empty (used 0) at offset 0 of PL_GetUserMemory
+    // resized by PL_SetUserMemorySize
+    PL_Arena *PL_GetUserArena(void);
+    // scratch arena for memory that only lives until the end of the current frame
+    // the main loop resets it after PL_Frame returns (temp markers must be ended by then)
+    PL_Arena *PL_GetFrameArena(void);
+#ifndef PL_FRAME_ARENA_SIZE
+#define PL_FRAME_ARENA_SIZE MB(16) // allocated once at startup, build with -DPL_FRAME_ARENA_SIZE=... to change
+#endif
+    // use any memory block as an arena
+    void PL_ArenaInit(PL_Arena *arena, ptr base, u64 size);
+    // push size bytes aligned to PL_ARENA_DEFAULT_ALIGN, returns 0 (and sets error string) when full
+    ptr PL_ArenaPush(PL_Arena *arena, u64 size);
+    // push and zero (arena memory is not cleared on reset/temp end)
+    ptr PL_ArenaPushZero(PL_Arena *arena, u64 size);
+    // push with power of 2 alignment
+    ptr PL_ArenaPushAligned(PL_Arena *arena, u64 size, u64 align);
+    // carve a child arena of size bytes out of arena, size 0 on failure
+    PL_Arena PL_ArenaPushSub(PL_Arena *arena, u64 size);
+    // free everything in the arena
+    void PL_ArenaReset(PL_Arena *arena);
+    // bytes left (before alignment padding)
+    u64 PL_ArenaRemaining(PL_Arena *arena);
+    // temp markers nest, end them in reverse order
+    PL_ArenaTemp PL_ArenaBeginTemp(PL_Arena *arena);
+    void PL_ArenaEndTemp(PL_ArenaTemp temp);
+    // eg: State *state = PL_ArenaPushStruct(PL_GetUserArena(), State);
+#define PL_ArenaPushStruct(arena, type) ((type*)PL_ArenaPushZero((arena), sizeof(type)))
+#define PL_ArenaPushArray(arena, type, count) ((type*)PL_ArenaPushZero((arena), sizeof(type)*(count)))
+
     /*============================
        String & Byte Helpers
     =============================*/
+    // Mem/Str functions run SSE2/AVX2/NEON kernels picked for the cpu at startup,
+    // Mem sizes past the L3 size (min 8MB) use non-temporal stores (result is not left in cache)
     // writes 0s at mem block
     void PL_MemZero(ptr dst, u64 size);
     // writes value at memblock, returns ptr to last byte written + 1 (for further operations)
     ptr PL_MemSet(ptr dst, u8 value, u64 size);
-    // copy size bytes from src to dst, returns num bytes copied
+    // copy size bytes from src to dst (must not overlap), returns num bytes copied
     u64 PL_MemCpy(ptr src, ptr dst, u64 size);
     // returns length of null terminated c string
     u64 PL_StrLen(cstr str);
+    // returns length of str, reading no further than max chars
+    u64 PL_StrNLen(cstr str, u64 max);
     // copy str for len or src reads 0, null terminates dst, returns num bytes copied
     u64 PL_StrCpy(cstr src, cstr dst, u64 len);
     // adds src to end of dst, null terminates, returns new dst length
+    // (rescans dst every call, use PL_Str to build strings up)
     u64 PL_StrCat(cstr src, cstr dst, u64 len);
     // print variables to string
     void PL_StrVar(cstr dst, u64 maxlen, const cstr format, ...);
 
+    // string builder over a fixed buffer, carries its length so appends never rescan
+    typedef struct
+    {
+        cstr data; // always null terminated
+        u64 len; // chars, not counting the terminator
+        u64 cap; // buffer size in bytes, including the terminator
+    } PL_Str;
+
+    // wrap buffer (size bytes) as an empty string
+    PL_Str PL_StrBuffer(cstr buffer, u64 size);
+    // wrap an existing null terminated string in buffer (size bytes) to append to it
+    PL_Str PL_StrBufferAt(cstr buffer, u64 size);
+    // empty the string (keeps the buffer)
+    void PL_StrClear(PL_Str *str);
+    // appends cut off at cap-1 chars, keep data null terminated and return 0 when something didn't fit
+    b32 PL_StrAppend(PL_Str *str, const char *src);
+    b32 PL_StrAppendN(PL_Str *str, const char *src, u64 len);
+    b32 PL_StrAppendChar(PL_Str *str, char c);
+    b32 PL_StrAppendF(PL_Str *str, const cstr format, ...);
+    b32 PL_StrAppendV(PL_Str *str, const cstr format, va_list args);
+    // string of size bytes pushed on arena, data 0 when the arena is full
+    PL_Str PL_StrArena(PL_Arena *arena, u64 size);
+
+    // number appends, no format string, no locale, no allocation (cheap enough to run every frame)
+    // eg: PL_StrAppend(&s, "score "); PL_StrAppendU64(&s, score); PL_StrAppend(&s, " ms "); PL_StrAppendR32(&s, ms, 2);
+    b32 PL_StrAppendU64(PL_Str *str, u64 value);
+    b32 PL_StrAppendI64(PL_Str *str, i64 value);
+    // lowercase hex, no 0x, zero padded to at least minDigits (max 16)
+    b32 PL_StrAppendHex(PL_Str *str, u64 value, u32 minDigits);
+    // fixed point like %.*f for decimals 0-9, rounded from the exact binary value like glibc's printf
+    // (ties to even), nan/inf and magnitudes of 1e18 or more go through vsnprintf
+    b32 PL_StrAppendR64(PL_Str *str, r64 value, u32 decimals);
+    b32 PL_StrAppendR32(PL_Str *str, r32 value, u32 decimals);
+
     /*============================
             File IO
     =============================*/
@@ -238,8 +388,50 @@ defined(DEBUG) || \
     r32 PL_sin(r32 a);
     r32 PL_cos(r32 a);
     r32 PL_atan2(r32 y, r32 x);
+    // polynomial versions without libm, max absolute error against the exact result:
+    // sin/cos 7.8e-8 for |a| <= 8192 and 1e-6 by 1e5, past 2^16*pi/2 (~1e5) the range reduction
+    // loses bits (about |a| * 3e-8, 0.03 by 1e6), past 2^22*pi/2 (~6.5e6) the result is meaningless
+    // and inf/nan give nan, so keep long running phases wrapped;
+    // atan2 2.7e-7 radians, (+-inf, +-inf) gives the diagonal like atan2f
+    r32 PL_sinFast(r32 a);
+    r32 PL_cosFast(r32 a);
+    r32 PL_atan2Fast(r32 y, r32 x);
+    // the same over arrays, 8 at a time (AVX2, 2x4 on SSE2/NEON), same results as the scalar ones,
+    // dst can be the input (eg: audio synthesis, bulk geometry)
+    void PL_SinArray(r32 *dst, const r32 *src, u64 n);
+    void PL_CosArray(r32 *dst, const r32 *src, u64 n);
+    void PL_Atan2Array(r32 *dst, const r32 *ys, const r32 *xs, u64 n);
 
     /*======== Vectors ==========*/
+    // Thanks: Casey Muratori (Handmade Hero) for showing how to do vectors properly!
+    // all inline, v4 runs on SSE/NEON (v3 stays 3 floats so it can sit in vertex data, the compiler
+    // vectorises it where it can), C++ operators go through the same functions
+
+#ifdef __cplusplus
+}
+#endif
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PL_VEC_SSE
+#include <xmmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64) // vdivq/vsqrtq and friends are A64 only
+#define PL_VEC_NEON
+#include <arm_neon.h>
+#endif
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    // square root for the vector lengths (no errno path, inlines to one instruction)
+    PL_INLINE r32 PL_VecSqrt(r32 v)
+    {
+#if defined(PL_VEC_SSE)
+        return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(v)));
+#elif defined(PL_VEC_NEON)
+        return vget_lane_f32(vsqrt_f32(vdup_n_f32(v)), 0);
+#else
+        return PL_sqrt(v);
+#endif
+    }
 
     // ------ v2 ------ //
 
@@ -252,33 +444,38 @@ defined(DEBUG) || \
     } v2;
 
     // constructors
-    v2 v2i(i32 a, i32 b);
-    v2 v2u(u32 a, u32 b);
-    v2 v2r(r32 a, r32 b);
+    PL_INLINE v2 v2i(i32 a, i32 b) {v2 result = {{(r32)a, (r32)b}}; return result;}
+    PL_INLINE v2 v2u(u32 a, u32 b) {v2 result = {{(r32)a, (r32)b}}; return result;}
+    PL_INLINE v2 v2r(r32 a, r32 b) {v2 result = {{a, b}}; return result;}
 
     // operators
-    v2 v2add(v2 a, v2 b);
-    v2 v2sub(v2 a, v2 b);
-    v2 v2mul(v2 a, r32 v);
-    v2 v2div(v2 a, r32 v);
+    PL_INLINE v2 v2add(v2 a, v2 b) {v2 result = {{a.i[0]+b.i[0], a.i[1]+b.i[1]}}; return result;}
+    PL_INLINE v2 v2sub(v2 a, v2 b) {v2 result = {{a.i[0]-b.i[0], a.i[1]-b.i[1]}}; return result;}
+    PL_INLINE v2 v2mul(v2 a, r32 v) {v2 result = {{a.i[0]*v, a.i[1]*v}}; return result;}
+    PL_INLINE v2 v2div(v2 a, r32 v) {v2 result = {{a.i[0]/v, a.i[1]/v}}; return result;}
 
-    v2 v2perp(v2 a); // get perpendicular vector
-    v2 v2hadamard(v2 a, v2 b); // hadamard product
-    r32 v2dot(v2 a, v2 b); // dot/inner product
-    r32 v2lengthsq(v2 a); // a^2
-    r32 v2length(v2 a); // sqrt(a^2)
+    // get perpendicular vector
+    PL_INLINE v2 v2perp(v2 a) {v2 result = {{-a.y, a.x}}; return result;}
+    // hadamard product
+    PL_INLINE v2 v2hadamard(v2 a, v2 b) {v2 result = {{a.i[0]*b.i[0], a.i[1]*b.i[1]}}; return result;}
+    // dot/inner product
+    PL_INLINE r32 v2dot(v2 a, v2 b) {return (a.i[0]*b.i[0]) + (a.i[1]*b.i[1]);}
+    // a^2
+    PL_INLINE r32 v2lengthsq(v2 a) {return v2dot(a,a);}
+    // sqrt(a^2)
+    PL_INLINE r32 v2length(v2 a) {return PL_VecSqrt(v2lengthsq(a));}
 
 #ifdef __cplusplus
 }
-inline v2 operator+(v2 a, v2 b) {return {a.i[0]+b.i[0], a.i[1]+b.i[1]};}
+inline v2 operator+(v2 a, v2 b) {return v2add(a, b);}
 inline v2 &operator+=(v2 &a, v2 b) {a = a+b; return a;}
 inline v2 operator-(v2 a) {return {-a.i[0], -a.i[1]};}
-inline v2 operator-(v2 a, v2 b) {return {a.i[0]-b.i[0], a.i[1]-b.i[1]};}
+inline v2 operator-(v2 a, v2 b) {return v2sub(a, b);}
 inline v2 &operator-=(v2 &a, v2 b) {a = a-b; return a;}
-inline v2 operator*(r32 a, v2 b) {return {b.i[0]*a, b.i[1]*a};}
-inline v2 operator*(v2 b, r32 a) {v2 result = a*b; return result;}
+inline v2 operator*(r32 a, v2 b) {return v2mul(b, a);}
+inline v2 operator*(v2 b, r32 a) {return v2mul(b, a);}
 inline v2 &operator*=(v2 &b, r32 a) {b = b*a; return b;}
-inline v2 operator/(v2 b, r32 a) {return {b.i[0]/a, b.i[1]/a};}
+inline v2 operator/(v2 b, r32 a) {return v2div(b, a);}
 inline v2 &operator/=(v2 &b, r32 a) {b = b/a; return b;}
 extern "C" {
 #endif
@@ -288,39 +485,44 @@ extern "C" {
     typedef union
     {
         r32 i[3];
-        union {struct{r32 x,y;}; v2 xy; r32 z;};
-        struct {r32 PAD0; v2 yz;};
+        struct {r32 x,y,z;};
         struct {r32 u,v,w;};
         struct {r32 r,g,b;};
+        struct {v2 xy; r32 PAD0;};
+        struct {r32 PAD1; v2 yz;};
     } v3;
 
     // constructors
-    v3 v3i(i32 a, i32 b, i32 c);
-    v3 v3u(u32 a, u32 b, u32 c);
-    v3 v3r(r32 a, r32 b, r32 c);
+    PL_INLINE v3 v3i(i32 a, i32 b, i32 c) {v3 result = {{(r32)a, (r32)b, (r32)c}}; return result;}
+    PL_INLINE v3 v3u(u32 a, u32 b, u32 c) {v3 result = {{(r32)a, (r32)b, (r32)c}}; return result;}
+    PL_INLINE v3 v3r(r32 a, r32 b, r32 c) {v3 result = {{a, b, c}}; return result;}
 
     // operators
-    v3 v3add(v3 a, v3 b);
-    v3 v3sub(v3 a, v3 b);
-    v3 v3mul(v3 a, r32 v);
-    v3 v3div(v3 a, r32 v);
+    PL_INLINE v3 v3add(v3 a, v3 b) {v3 result = {{a.i[0]+b.i[0], a.i[1]+b.i[1], a.i[2]+b.i[2]}}; return result;}
+    PL_INLINE v3 v3sub(v3 a, v3 b) {v3 result = {{a.i[0]-b.i[0], a.i[1]-b.i[1], a.i[2]-b.i[2]}}; return result;}
+    PL_INLINE v3 v3mul(v3 a, r32 v) {v3 result = {{a.i[0]*v, a.i[1]*v, a.i[2]*v}}; return result;}
+    PL_INLINE v3 v3div(v3 a, r32 v) {v3 result = {{a.i[0]/v, a.i[1]/v, a.i[2]/v}}; return result;}
 
-    v3 v3hadamard(v3 a, v3 b); // hadamard product
-    r32 v3dot(v3 a, v3 b); // dot/inner product
-	r32 v3lengthsq(v3 a); // a^2
-    r32 v3length(v3 a); // sqrt(a^2)
+    // hadamard product
+    PL_INLINE v3 v3hadamard(v3 a, v3 b) {v3 result = {{a.i[0]*b.i[0], a.i[1]*b.i[1], a.i[2]*b.i[2]}}; return result;}
+    // dot/inner product
+    PL_INLINE r32 v3dot(v3 a, v3 b) {return (a.i[0]*b.i[0]) + (a.i[1]*b.i[1]) + (a.i[2]*b.i[2]);}
+    // a^2
+    PL_INLINE r32 v3lengthsq(v3 a) {return v3dot(a,a);}
+    // sqrt(a^2)
+    PL_INLINE r32 v3length(v3 a) {return PL_VecSqrt(v3lengthsq(a));}
 
 #ifdef __cplusplus
 }
-inline v3 operator+(v3 a, v3 b) {return {a.i[0]+b.i[0], a.i[1]+b.i[1], a.i[2]+b.i[2]};}
+inline v3 operator+(v3 a, v3 b) {return v3add(a, b);}
 inline v3 &operator+=(v3 &a, v3 b) {a = a+b; return a;}
 inline v3 operator-(v3 a) {return {-a.i[0], -a.i[1], -a.i[2]};}
-inline v3 operator-(v3 a, v3 b) {return {a.i[0]-b.i[0], a.i[1]-b.i[1], a.i[2]-b.i[2]};}
+inline v3 operator-(v3 a, v3 b) {return v3sub(a, b);}
 inline v3 &operator-=(v3 &a, v3 b) {a = a-b; return a;}
-inline v3 operator*(r32 a, v3 b) {return {b.i[0]*a, b.i[1]*a, b.i[2]*a};}
-inline v3 operator*(v3 b, r32 a) {v3 result = a*b; return result;}
+inline v3 operator*(r32 a, v3 b) {return v3mul(b, a);}
+inline v3 operator*(v3 b, r32 a) {return v3mul(b, a);}
 inline v3 &operator*=(v3 &b, r32 a) {b = b*a; return b;}
-inline v3 operator/(v3 b, r32 a) {return {b.i[0]/a, b.i[1]/a, b.i[2]/a};}
+inline v3 operator/(v3 b, r32 a) {return v3div(b, a);}
 inline v3 &operator/=(v3 &b, r32 a) {b = b/a; return b;}
 extern "C" {
 #endif
@@ -330,41 +532,301 @@ extern "C" {
     typedef union
     {
         r32 i[4];
-        union {struct {r32 x,y,z;}; v3 xyz; r32 w;};
-        union {struct {r32 r,g,b;}; v3 rgb; r32 a;};
+        struct {union {struct {r32 x,y,z;}; v3 xyz;}; r32 w;};
+        struct {union {struct {r32 r,g,b;}; v3 rgb;}; r32 a;};
         struct {r32 u,v,s,t;};
     } v4;
 
     // constructors
-    v4 v4i(i32 a, i32 b, i32 c, i32 d);
-    v4 v4u(u32 a, u32 b, u32 c, u32 d);
-    v4 v4r(r32 a, r32 b, r32 c, r32 d);
-
-    // operators
-    v4 v4add(v4 a, v4 b);
-    v4 v4sub(v4 a, v4 b);
-    v4 v4mul(v4 a, r32 v);
-    v4 v4div(v4 a, r32 v);
+    PL_INLINE v4 v4i(i32 a, i32 b, i32 c, i32 d) {v4 result = {{(r32)a, (r32)b, (r32)c, (r32)d}}; return result;}
+    PL_INLINE v4 v4u(u32 a, u32 b, u32 c, u32 d) {v4 result = {{(r32)a, (r32)b, (r32)c, (r32)d}}; return result;}
+    PL_INLINE v4 v4r(r32 a, r32 b, r32 c, r32 d) {v4 result = {{a, b, c, d}}; return result;}
 
-    v4 v4hadamard(v4 a, v4 b); // hadamard product
-    r32 v4dot(v4 a, v4 b); // dot/inner product
-	r32 v4lengthsq(v4 a); // a^2
-    r32 v4length(v4 a); // sqrt(a^2)
+    // v4 is only 4 byte aligned, unaligned loads/stores cost the same and vanish when the values stay in registers
+#if defined(PL_VEC_SSE)
+#define PL_V4_OP(a, b, op) v4 result; _mm_storeu_ps(result.i, op(_mm_loadu_ps((a).i), (b))); return result;
+    PL_INLINE v4 v4add(v4 a, v4 b) {PL_V4_OP(a, _mm_loadu_ps(b.i), _mm_add_ps)}
+    PL_INLINE v4 v4sub(v4 a, v4 b) {PL_V4_OP(a, _mm_loadu_ps(b.i), _mm_sub_ps)}
+    PL_INLINE v4 v4mul(v4 a, r32 v) {PL_V4_OP(a, _mm_set1_ps(v), _mm_mul_ps)}
+    PL_INLINE v4 v4div(v4 a, r32 v) {PL_V4_OP(a, _mm_set1_ps(v), _mm_div_ps)}
+    PL_INLINE v4 v4hadamard(v4 a, v4 b) {PL_V4_OP(a, _mm_loadu_ps(b.i), _mm_mul_ps)}
+    PL_INLINE r32 v4dot(v4 a, v4 b)
+    {
+        __m128 m = _mm_mul_ps(_mm_loadu_ps(a.i), _mm_loadu_ps(b.i));
+        m = _mm_add_ps(m, _mm_movehl_ps(m, m)); // x+z, y+w
+        m = _mm_add_ss(m, _mm_shuffle_ps(m, m, 1));
+        return _mm_cvtss_f32(m);
+    }
+#undef PL_V4_OP
+#elif defined(PL_VEC_NEON)
+#define PL_V4_OP(a, b, op) v4 result; vst1q_f32(result.i, op(vld1q_f32((a).i), (b))); return result;
+    PL_INLINE v4 v4add(v4 a, v4 b) {PL_V4_OP(a, vld1q_f32(b.i), vaddq_f32)}
+    PL_INLINE v4 v4sub(v4 a, v4 b) {PL_V4_OP(a, vld1q_f32(b.i), vsubq_f32)}
+    PL_INLINE v4 v4mul(v4 a, r32 v) {PL_V4_OP(a, vdupq_n_f32(v), vmulq_f32)}
+    PL_INLINE v4 v4div(v4 a, r32 v) {PL_V4_OP(a, vdupq_n_f32(v), vdivq_f32)}
+    PL_INLINE v4 v4hadamard(v4 a, v4 b) {PL_V4_OP(a, vld1q_f32(b.i), vmulq_f32)}
+    PL_INLINE r32 v4dot(v4 a, v4 b) {return vaddvq_f32(vmulq_f32(vld1q_f32(a.i), vld1q_f32(b.i)));}
+#undef PL_V4_OP
+#else
+    PL_INLINE v4 v4add(v4 a, v4 b) {v4 result = {{a.i[0]+b.i[0], a.i[1]+b.i[1], a.i[2]+b.i[2], a.i[3]+b.i[3]}}; return result;}
+    PL_INLINE v4 v4sub(v4 a, v4 b) {v4 result = {{a.i[0]-b.i[0], a.i[1]-b.i[1], a.i[2]-b.i[2], a.i[3]-b.i[3]}}; return result;}
+    PL_INLINE v4 v4mul(v4 a, r32 v) {v4 result = {{a.i[0]*v, a.i[1]*v, a.i[2]*v, a.i[3]*v}}; return result;}
+    PL_INLINE v4 v4div(v4 a, r32 v) {v4 result = {{a.i[0]/v, a.i[1]/v, a.i[2]/v, a.i[3]/v}}; return result;}
+    PL_INLINE v4 v4hadamard(v4 a, v4 b) {v4 result = {{a.i[0]*b.i[0], a.i[1]*b.i[1], a.i[2]*b.i[2], a.i[3]*b.i[3]}}; return result;}
+    PL_INLINE r32 v4dot(v4 a, v4 b) {return (a.i[0]*b.i[0]) + (a.i[1]*b.i[1]) + (a.i[2]*b.i[2]) + (a.i[3]*b.i[3]);}
+#endif
+    // a^2
+    PL_INLINE r32 v4lengthsq(v4 a) {return v4dot(a,a);}
+    // sqrt(a^2)
+    PL_INLINE r32 v4length(v4 a) {return PL_VecSqrt(v4lengthsq(a));}
 
     // C++ operators
 #ifdef __cplusplus
 }
-inline v4 operator+(v4 a, v4 b) {return {a.i[0]+b.i[0], a.i[1]+b.i[1], a.i[2]+b.i[2], a.i[3]+b.i[3]};}
+inline v4 operator+(v4 a, v4 b) {return v4add(a, b);}
 inline v4 &operator+=(v4 &a, v4 b) {a = a+b; return a;}
-inline v4 operator-(v4 a) {return {-a.i[0], -a.i[1], -a.i[2], -a.i[3]};}
-inline v4 operator-(v4 a, v4 b) {return {a.i[0]-b.i[0], a.i[1]-b.i[1], a.i[2]-b.i[2], a.i[3]-b.i[3]};}
+inline v4 operator-(v4 a) {return v4mul(a, -1.0f);}
+inline v4 operator-(v4 a, v4 b) {return v4sub(a, b);}
 inline v4 &operator-=(v4 &a, v4 b) {a = a-b; return a;}
-inline v4 operator*(r32 a, v4 b) {return {b.i[0]*a, b.i[1]*a, b.i[2]*a, b.i[3]*a};}
-inline v4 operator*(v4 b, r32 a) {v4 result = a*b; return result;}
+inline v4 operator*(r32 a, v4 b) {return v4mul(b, a);}
+inline v4 operator*(v4 b, r32 a) {return v4mul(b, a);}
 inline v4 &operator*=(v4 &b, r32 a) {b = b*a; return b;}
-inline v4 operator/(v4 b, r32 a) {return {b.i[0]/a, b.i[1]/a, b.i[2]/a, b.i[3]/a};}
+inline v4 operator/(v4 b, r32 a) {return v4div(b, a);}
 inline v4 &operator/=(v4 &b, r32 a) {b = b/a; return b;}
 extern "C" {
+#endif
+
+    // ------ m4 ------ //
+    // 4x4 matrix, column major like GL so e goes straight to glUniformMatrix4fv(loc, 1, GL_FALSE, m.e),
+    // c[i] is column i, transforms apply right to left (m4mul(projection, model) does model first)
+
+    typedef union
+    {
+        r32 e[16];
+        v4 c[4];
+    } m4;
+
+    PL_INLINE m4 m4identity(void)
+    {
+        m4 result = {{1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1}};
+        return result;
+    }
+
+    // a*b, column j of the result is a times column j of b (multiply then add, no fma, so every
+    // path rounds the same)
+#if defined(PL_VEC_SSE)
+    PL_INLINE m4 m4mul(m4 a, m4 b)
+    {
+        m4 result;
+        __m128 c0 = _mm_loadu_ps(a.e), c1 = _mm_loadu_ps(a.e + 4);
+        __m128 c2 = _mm_loadu_ps(a.e + 8), c3 = _mm_loadu_ps(a.e + 12);
+        for(int j = 0; j < 4; j++)
+        {
+            __m128 r = _mm_mul_ps(c0, _mm_set1_ps(b.e[j*4 + 0]));
+            r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(b.e[j*4 + 1])));
+            r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(b.e[j*4 + 2])));
+            r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(b.e[j*4 + 3])));
+            _mm_storeu_ps(result.e + j*4, r);
+        }
+        return result;
+    }
+    PL_INLINE v4 m4mulv4(m4 m, v4 v)
+    {
+        v4 result;
+        __m128 r = _mm_mul_ps(_mm_loadu_ps(m.e), _mm_set1_ps(v.i[0]));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m.e + 4), _mm_set1_ps(v.i[1])));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m.e + 8), _mm_set1_ps(v.i[2])));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m.e + 12), _mm_set1_ps(v.i[3])));
+        _mm_storeu_ps(result.i, r);
+        return result;
+    }
+#elif defined(PL_VEC_NEON)
+    PL_INLINE m4 m4mul(m4 a, m4 b)
+    {
+        m4 result;
+        float32x4_t c0 = vld1q_f32(a.e), c1 = vld1q_f32(a.e + 4);
+        float32x4_t c2 = vld1q_f32(a.e + 8), c3 = vld1q_f32(a.e + 12);
+        for(int j = 0; j < 4; j++)
+        {
+            float32x4_t col = vld1q_f32(b.e + j*4);
+            float32x4_t r = vmulq_laneq_f32(c0, col, 0);
+            r = vmlaq_laneq_f32(r, c1, col, 1);
+            r = vmlaq_laneq_f32(r, c2, col, 2);
+            r = vmlaq_laneq_f32(r, c3, col, 3);
+            vst1q_f32(result.e + j*4, r);
+        }
+        return result;
+    }
+    PL_INLINE v4 m4mulv4(m4 m, v4 v)
+    {
+        v4 result;
+        float32x4_t x = vld1q_f32(v.i);
+        float32x4_t r = vmulq_laneq_f32(vld1q_f32(m.e), x, 0);
+        r = vmlaq_laneq_f32(r, vld1q_f32(m.e + 4), x, 1);
+        r = vmlaq_laneq_f32(r, vld1q_f32(m.e + 8), x, 2);
+        r = vmlaq_laneq_f32(r, vld1q_f32(m.e + 12), x, 3);
+        vst1q_f32(result.i, r);
+        return result;
+    }
+#else
+    PL_INLINE v4 m4mulv4(m4 m, v4 v)
+    {
+        v4 result;
+        for(int i = 0; i < 4; i++)
+        {
+            result.i[i] = m.e[i]*v.i[0] + m.e[4 + i]*v.i[1] + m.e[8 + i]*v.i[2] + m.e[12 + i]*v.i[3];
+        }
+        return result;
+    }
+    PL_INLINE m4 m4mul(m4 a, m4 b)
+    {
+        m4 result;
+        for(int j = 0; j < 4; j++) result.c[j] = m4mulv4(a, b.c[j]);
+        return result;
+    }
+#endif
+    PL_INLINE m4 m4transpose(m4 m)
+    {
+        m4 result;
+        for(int j = 0; j < 4; j++)
+        {
+            for(int i = 0; i < 4; i++) result.e[j*4 + i] = m.e[i*4 + j];
+        }
+        return result;
+    }
+
+    // builders
+    m4 m4translate(r32 x, r32 y, r32 z);
+    m4 m4scale(r32 x, r32 y, r32 z);
+    m4 m4rotateZ(r32 angle); // radians, counter clockwise looking down -z (the 2D rotation)
+    // maps the box to GL clip space (-1 to 1 on all axes), eg: m4ortho(0, width, 0, height, -1, 1)
+    m4 m4ortho(r32 left, r32 right, r32 bottom, r32 top, r32 zNear, r32 zFar);
+    // right handed looking down -z like gluPerspective, fovY in radians
+    m4 m4perspective(r32 fovY, r32 aspect, r32 zNear, r32 zFar);
+    // general inverse, all zeros when m is singular (like PL_div)
+    m4 m4inverse(m4 m);
+    // dst[i] = m * src[i] for n v4s (dst can be src), SSE/AVX/NEON, eg: all HUD/entity quad corners at once
+    void PL_V4ArrayTransform(v4 *dst, const v4 *src, u64 n, const m4 *m);
+
+    // C++ operators
+#ifdef __cplusplus
+}
+inline m4 operator*(m4 a, m4 b) {return m4mul(a, b);}
+inline m4 &operator*=(m4 &a, m4 b) {a = a*b; return a;}
+inline v4 operator*(m4 a, v4 b) {return m4mulv4(a, b);}
+extern "C" {
+#endif
+
+    // ------ v2 arrays ------ //
+    // structure of arrays batches for lots of entities (particles, multi-ball), one array per
+    // component, eg: xs[i], ys[i] is the position of entity i. Runs on AVX2/NEON, any n or alignment
+
+    // xs += vxs*dt, ys += vys*dt
+    void PL_V2ArrayIntegrate(r32 *xs, r32 *ys, const r32 *vxs, const r32 *vys, u64 n, r32 dt);
+    // positions outside [min, max] are mirrored back inside and that velocity component
+    // is pointed inwards (one bounce, so a step shouldn't overshoot by more than the bounds size)
+    void PL_V2ArrayReflect(r32 *xs, r32 *ys, r32 *vxs, r32 *vys, u64 n, v2 min, v2 max);
+    // bit i%64 of mask[i/64] is set if box i (centre xs/ys, half width/height hws/hhs) overlaps
+    // [min, max] (touching counts), mask needs (n+63)/64 u64s, returns the number of overlaps
+    // eg: for(u64 w = 0; w < (n+63)/64; w++) for(u64 b = mask[w]; b; b &= b-1) hit(w*64 + ctz(b));
+    u64 PL_V2ArrayOverlap(u64 *mask, const r32 *xs, const r32 *ys, const r32 *hws, const r32 *hhs, u64 n, v2 min, v2 max);
+
+    /*======== Fixed Point ==========*/
+    // deterministic maths for simulation state that has to match bit for bit across compilers and
+    // cpus (replays, lockstep), integer only so float rounding, fma contraction and libm can't differ.
+    // q16 is Q16.16 (+-32768 in 1/65536 steps), q32 is Q32.32 for big worlds and accumulators.
+    // add/sub/compare with the normal operators, products round to nearest and wrap when out of
+    // range, division truncates and saturates, division by 0 returns 0 like PL_div.
+    // the float conversions are for setup and rendering, keep them out of the simulation step
+    typedef i32 q16;
+    typedef i64 q32;
+
+#define Q16_ONE ((q16)0x10000)
+#define Q16_HALF ((q16)0x8000)
+#define Q16_PI ((q16)205887)
+#define Q16_PI_2 ((q16)102944)
+#define Q16_TAU ((q16)411775)
+#define Q32_ONE ((q32)0x100000000LL)
+#define Q32_HALF ((q32)0x80000000LL)
+#define Q32_PI ((q32)13493037705LL)
+#define Q32_PI_2 ((q32)6746518852LL)
+#define Q32_TAU ((q32)26986075409LL)
+
+    PL_INLINE q16 q16i(i32 v) {return (q16)((u32)v << 16);}
+    PL_INLINE q16 q16r(r32 v) {return (q16)(v * 65536.0f + ((v < 0.0f) ? -0.5f : 0.5f));}
+    PL_INLINE r32 q16tor32(q16 v) {return (r32)v * (1.0f / 65536.0f);}
+    PL_INLINE i32 q16floor(q16 v) {return v >> 16;}
+    PL_INLINE q16 q16mul(q16 a, q16 b) {return (q16)(((i64)a * b + 0x8000) >> 16);}
+    PL_INLINE q16 q16div(q16 a, q16 b)
+    {
+        if(!b) return 0;
+        i64 result = ((i64)a * 65536) / b;
+        return (q16)((result > INT32_MAX) ? INT32_MAX : (result < INT32_MIN) ? INT32_MIN : result);
+    }
+    PL_INLINE q16 q16abs(q16 v) {return (v < 0) ? -v : v;}
+    PL_INLINE q16 q16lerp(q16 a, q16 b, q16 t) {return a + q16mul(b - a, t);}
+    q16 q16sqrt(q16 v); // exact (floor), 0 for v <= 0
+    // lookup tables with linear interpolation, angles in radians, max error 2.0e-5 (sin/cos)
+    // and 2.7e-5 (atan2), under 2 steps of 1/65536
+    q16 q16sin(q16 a);
+    q16 q16cos(q16 a);
+    q16 q16atan2(q16 y, q16 x);
+
+    PL_INLINE q32 q32i(i32 v) {return (q32)((u64)(i64)v << 32);}
+    PL_INLINE q32 q32r(r64 v) {return (q32)(v * 4294967296.0 + ((v < 0.0) ? -0.5 : 0.5));}
+    PL_INLINE r64 q32tor64(q32 v) {return (r64)v * (1.0 / 4294967296.0);}
+    PL_INLINE q32 q32fromq16(q16 v) {return (q32)((u64)(i64)v << 16);}
+    PL_INLINE q16 q32toq16(q32 v) {return (q16)((v + 0x8000) >> 16);}
+    PL_INLINE i64 q32floor(q32 v) {return v >> 32;}
+    q32 q32mul(q32 a, q32 b);
+    q32 q32div(q32 a, q32 b);
+    q32 q32sqrt(q32 v);
+    // same tables and error as q16, angles are reduced by Q32_TAU whose rounding drifts
+    // 1.2e-10 radians per turn (3e-5 at 2^18 radians)
+    q32 q32sin(q32 a);
+    q32 q32cos(q32 a);
+    q32 q32atan2(q32 y, q32 x);
+
+    // ------ fixed point v2 ------ //
+
+    typedef struct {q16 x, y;} v2q16;
+    typedef struct {q32 x, y;} v2q32;
+
+    PL_INLINE v2q16 v2q16i(i32 x, i32 y) {v2q16 result = {q16i(x), q16i(y)}; return result;}
+    PL_INLINE v2q16 v2q16r(r32 x, r32 y) {v2q16 result = {q16r(x), q16r(y)}; return result;}
+    PL_INLINE v2 v2q16tov2(v2q16 a) {return v2r(q16tor32(a.x), q16tor32(a.y));}
+    PL_INLINE v2q16 v2q16add(v2q16 a, v2q16 b) {v2q16 result = {a.x + b.x, a.y + b.y}; return result;}
+    PL_INLINE v2q16 v2q16sub(v2q16 a, v2q16 b) {v2q16 result = {a.x - b.x, a.y - b.y}; return result;}
+    PL_INLINE v2q16 v2q16mul(v2q16 a, q16 v) {v2q16 result = {q16mul(a.x, v), q16mul(a.y, v)}; return result;}
+    // one rounding for the sum instead of one per product
+    PL_INLINE q16 v2q16dot(v2q16 a, v2q16 b) {return (q16)(((i64)a.x * b.x + (i64)a.y * b.y + 0x8000) >> 16);}
+    PL_INLINE q16 v2q16lengthsq(v2q16 a) {return v2q16dot(a, a);}
+    q16 v2q16length(v2q16 a); // exact (floor), the square is kept at 64 bits so it can't overflow
+
+    PL_INLINE v2q32 v2q32i(i32 x, i32 y) {v2q32 result = {q32i(x), q32i(y)}; return result;}
+    PL_INLINE v2q32 v2q32r(r64 x, r64 y) {v2q32 result = {q32r(x), q32r(y)}; return result;}
+    PL_INLINE v2 v2q32tov2(v2q32 a) {return v2r((r32)q32tor64(a.x), (r32)q32tor64(a.y));}
+    PL_INLINE v2q32 v2q32add(v2q32 a, v2q32 b) {v2q32 result = {a.x + b.x, a.y + b.y}; return result;}
+    PL_INLINE v2q32 v2q32sub(v2q32 a, v2q32 b) {v2q32 result = {a.x - b.x, a.y - b.y}; return result;}
+    PL_INLINE v2q32 v2q32mul(v2q32 a, q32 v) {v2q32 result = {q32mul(a.x, v), q32mul(a.y, v)}; return result;}
+    PL_INLINE q32 v2q32dot(v2q32 a, v2q32 b) {return q32mul(a.x, b.x) + q32mul(a.y, b.y);}
+    PL_INLINE q32 v2q32lengthsq(v2q32 a) {return v2q32dot(a, a);}
+    PL_INLINE q32 v2q32length(v2q32 a) {return q32sqrt(v2q32lengthsq(a));}
+
+    // C++ operators (not for the scalars, q16 * q16 would be an integer multiply)
+#ifdef __cplusplus
+}
+inline v2q16 operator+(v2q16 a, v2q16 b) {return v2q16add(a, b);}
+inline v2q16 &operator+=(v2q16 &a, v2q16 b) {a = a+b; return a;}
+inline v2q16 operator-(v2q16 a, v2q16 b) {return v2q16sub(a, b);}
+inline v2q16 &operator-=(v2q16 &a, v2q16 b) {a = a-b; return a;}
+inline v2q16 operator*(v2q16 a, q16 v) {return v2q16mul(a, v);}
+inline v2q32 operator+(v2q32 a, v2q32 b) {return v2q32add(a, b);}
+inline v2q32 &operator+=(v2q32 &a, v2q32 b) {a = a+b; return a;}
+inline v2q32 operator-(v2q32 a, v2q32 b) {return v2q32sub(a, b);}
+inline v2q32 &operator-=(v2q32 &a, v2q32 b) {a = a-b; return a;}
+inline v2q32 operator*(v2q32 a, q32 v) {return v2q32mul(a, v);}
+extern "C" {
 #endif
 
     /*===== RNG and Hashing =========*/
@@ -372,19 +834,135 @@ extern "C" {
     u32 PL_Hash32(ptr input, u64 inputSize);
     // auto sizeof macro (just pass address of var, no cast)
 #define PL_HASH32(v) PL_Hash32((ptr)v, sizeof *(v))
-    // get psuedo random normalized number (0.0 to 1.0)
+    // get hashed u64 from input (XXH64), much faster than PL_Hash32 on anything over a few bytes
+    u64 PL_Hash64(ptr input, u64 inputSize, u64 seed);
+#define PL_HASH64(v) PL_Hash64((ptr)v, sizeof *(v), 0)
+    // hash input that arrives in pieces (eg: a state snapshot a chunk at a time),
+    // Final gives the same result as PL_Hash64 over all the pieces back to back
+    typedef struct
+    {
+        u64 acc[4];
+        u64 seed;
+        u64 totalSize;
+        u8 buffer[32]; // partial stripe left over from the last update
+        u32 bufferSize;
+    } PL_Hash64State;
+
+    void PL_Hash64Init(PL_Hash64State *state, u64 seed);
+    void PL_Hash64Update(PL_Hash64State *state, ptr input, u64 inputSize);
+    u64 PL_Hash64Final(PL_Hash64State *state);
+    // xoshiro256** generator with explicit state, give each system its own stream
+    // so its sequence doesn't depend on who else draws numbers (not thread safe, use one per thread)
+    typedef struct
+    {
+        u64 s[4];
+    } PL_RandState;
+
+    // any seed is fine (0 included), same seed = same sequence on every platform
+    void PL_RandSeed(PL_RandState *state, u64 seed);
+    u64 PL_RandU64(PL_RandState *state);
+    u32 PL_RandU32(PL_RandState *state);
+    // unbiased in [0, range), range 0 returns 0
+    u32 PL_RandRange(PL_RandState *state, u32 range);
+    // unbiased in [min, max] inclusive
+    i32 PL_RandBetween(PL_RandState *state, i32 min, i32 max);
+    // uniform in [0.0, 1.0)
+    r32 PL_RandR32(PL_RandState *state);
+    r64 PL_RandR64(PL_RandState *state);
+    // uniform in [min, max)
+    r32 PL_RandR32Range(PL_RandState *state, r32 min, r32 max);
+    // advance state by 2^128 draws
+    void PL_RandJump(PL_RandState *state);
+    // returns a stream that won't overlap state (for 2^128 draws), and jumps state past it
+    // eg: PL_RandState particles = PL_RandSplit(&worldRand);
+    PL_RandState PL_RandSplit(PL_RandState *state);
+    // default stream used by PL_Rand and the PL_RAND macros
+    PL_RandState *PL_GetRandState(void);
+
+    // PL_RAND_LANES xoshiro256** streams stepped together in SIMD registers for bulk fills,
+    // the output is the same on every cpu path (lane order, 2 u32 per u64 low half first)
+#define PL_RAND_LANES 8
+    typedef struct
+    {
+        u64 s[4][PL_RAND_LANES]; // word-major so a word of every lane loads as one vector
+        PL_RandState spare; // redraws for PL_RandFillRange
+    } PL_RandLanes;
+
+    // split the lanes off state (9 jumps, do it once at startup not per fill)
+    void PL_RandLanesInit(PL_RandLanes *lanes, PL_RandState *state);
+    // default lanes, split off the default stream on first use and again after PL_SeedRand
+    PL_RandLanes *PL_GetRandLanes(void);
+    // fill dst with count numbers, every call starts on a fresh step (up to 15 numbers of the last step are dropped)
+    void PL_RandFillU32(PL_RandLanes *lanes, u32 *dst, u64 count);
+    // uniform in [0.0, 1.0)
+    void PL_RandFillR32(PL_RandLanes *lanes, r32 *dst, u64 count);
+    // unbiased in [0, range), range 0 fills 0s
+    void PL_RandFillRange(PL_RandLanes *lanes, u32 *dst, u64 count, u32 range);
+
+    // get psuedo random normalized number (0.0 to 1.0, excluding 1.0) from the default stream
     r32 PL_Rand(void);
-    // OPTIONAL: seed PL_Rand using any sized type (PL_Rand will otherwise seed using time 0)
+    // OPTIONAL: seed the default stream using any sized type (it will otherwise seed using time 0)
     void PL_SeedRand(ptr value, u64 valueSize); // eg: int seed = 1234; PL_SeedRand(&seed, sizeof(int));
     // auto sizeof macro (just pass address of var, no cast)
 #define PL_SEEDRAND(v) PL_SeedRand((ptr)v, sizeof *(v))
-    // Rand macro helpers to cast to PL int types 8-32
-#define PL_RANDI8 ((i8)PL_round_i32(((PL_Rand()*(r32)UINT8_MAX)-((r32)UINT8_MAX/2))))
-#define PL_RANDU8 ((u8)PL_round_u32((PL_Rand()*(r32)UINT8_MAX)))
-#define PL_RANDI16 ((i16)PL_round_i32(((PL_Rand()*UINT16_MAX)-((r32)UINT16_MAX/2))))
-#define PL_RANDU16 ((u16)PL_round_u32((PL_Rand()*(r32)UINT16_MAX)))
-#define PL_RANDI32 (PL_round_i32(((PL_Rand()*UINT32_MAX)-((r32)UINT32_MAX/2))))
-#define PL_RANDU32 (PL_round_u32((PL_Rand()*(r32)UINT32_MAX)))
+    // Rand macro helpers for PL int types 8-32, uniform over the whole type
+#define PL_RANDI8 ((i8)(PL_RandU32(PL_GetRandState()) >> 24))
+#define PL_RANDU8 ((u8)(PL_RandU32(PL_GetRandState()) >> 24))
+#define PL_RANDI16 ((i16)(PL_RandU32(PL_GetRandState()) >> 16))
+#define PL_RANDU16 ((u16)(PL_RandU32(PL_GetRandState()) >> 16))
+#define PL_RANDI32 ((i32)PL_RandU32(PL_GetRandState()))
+#define PL_RANDU32 (PL_RandU32(PL_GetRandState()))
+
+    /*============================
+       Hash Map
+    =============================*/
+    // open addressing map (SwissTable style: a control byte per slot holding 7 bits of the hash,
+    // a group of 16 control bytes is checked at once with SSE2/NEON), u64 values (an index or a cast ptr)
+    typedef enum
+    {
+        MAPKEY_INT = 0, // u32 or u64 keys, widened to u64
+        MAPKEY_STR // null terminated strings, not copied (the string must live as long as its entry)
+    } PL_MAPKEY;
+
+    typedef struct
+    {
+        u64 key; // int key or the cstr
+        u64 value;
+    } PL_MapSlot;
+
+    typedef struct
+    {
+        u8 *ctrl; // capacity control bytes + a mirror of the first group, so any group loads unwrapped
+        PL_MapSlot *slots;
+        u64 capacity; // slots, power of 2, kept under 7/8 full
+        u64 count;
+        u64 growthLeft; // inserts into empty slots before a rehash
+        PL_Arena *arena; // grows into here, 0: PL_Alloc
+        PL_MAPKEY keyType;
+        b8 fixed; // never allocates, puts fail when full
+    } PL_Map;
+
+    // capacity is rounded up to a power of 2 and grown as needed,
+    // arena 0 uses PL_Alloc (release with PL_MapFree), old arena blocks are only freed by resetting the arena
+    b32 PL_MapInit(PL_Map *map, PL_MAPKEY keyType, u64 capacity, PL_Arena *arena);
+    // no-alloc map living in memory (eg: from the frame arena or the stack), PL_MapMemorySize gives the size for a capacity
+    b32 PL_MapInitFixed(PL_Map *map, PL_MAPKEY keyType, ptr memory, u64 memorySize);
+    u64 PL_MapMemorySize(u64 capacity);
+    // frees PL_Alloc memory, leaves the map empty
+    void PL_MapFree(PL_Map *map);
+    // remove everything, keeps the memory
+    void PL_MapClear(PL_Map *map);
+    // insert or overwrite, returns 0 when a fixed map is full or allocation failed
+    b32 PL_MapPut(PL_Map *map, u64 key, u64 value);
+    b32 PL_MapPutStr(PL_Map *map, const char *key, u64 value);
+    // pointer to the value to read/update in place, 0 when missing (valid until the next put)
+    u64 *PL_MapGet(PL_Map *map, u64 key);
+    u64 *PL_MapGetStr(PL_Map *map, const char *key);
+    // returns 0 when missing
+    b32 PL_MapRemove(PL_Map *map, u64 key);
+    b32 PL_MapRemoveStr(PL_Map *map, const char *key);
+    // walk every entry, eg: u64 k, v; for(u64 it = 0; PL_MapNext(&map, &it, &k, &v);) {...}
+    b32 PL_MapNext(PL_Map *map, u64 *iterator, u64 *key, u64 *value);
 
     /*================
       Timing
@@ -401,23 +979,104 @@ extern "C" {
         u16 ms; // 0-999
     } PL_Clock;
 
-    // Clock updated every frame
+    // local time at the start of the frame, computed on the first call each frame
     PL_Clock *PL_GetClock(void);
+    // nanoseconds since the unix epoch (UTC), from the tick counter plus an offset re-read from the OS every second
+    u64 PL_GetUnixTimeNs(void);
 
     typedef struct
     {
         u64 frames; // total frames since startup
         r64 tLastFrame; // seconds elapsed last frame
         r64 tAvgFrame; // average seconds elapsed per frame since start
+        r64 tJitter; // seconds last frame missed the framerate target by (0 when not paced)
+        r64 tAvgJitter; // average jitter of paced frames since start
+        u32 updates; // fixed timestep updates run before this frame
+        r64 alpha; // fixed timestep: fraction of a step accumulated but not simulated yet [0,1), render at lerp(prev, current, alpha)
     } PL_Timer;
 
     // Timer updated every frame
     PL_Timer *PL_GetTimer(void);
-    // returns timerperf value, pass this value to PL_TimerElapsed
+
+    typedef enum
+    {
+        PACE_SPIN = 0, // busy-wait the whole remaining frame (most precise, 100% cpu)
+        PACE_HYBRID // sleep, then busy-wait only the last spinSec of the frame (default)
+    } PL_PACINGMODE;
+
+    // how frames are held to the framerate when vsync is off
+    // spinSec: busy-wait window before the deadline for PACE_HYBRID (< 0 keeps current)
+    void PL_SetFramePacing(PL_PACINGMODE mode, r64 spinSec);
+    typedef struct
+    {
+        u64 frames; // frames recorded since startup (or PL_ResetFrameStats)
+        u64 overBudget; // frames more than 10% over 1/framerate (0 when uncapped)
+        r64 p50, p95, p99; // frame time percentiles in seconds (0.1ms resolution)
+        r64 max; // longest frame in seconds
+    } PL_FrameStats;
+
+    // fixed timestep mode: update(dt) runs before each PL_Frame once per whole dt of time elapsed (0 to turn off)
+    // time is accumulated in ticks, frames longer than 0.25s are clamped so a stall can't queue up a burst of updates
+    void PL_SetFixedUpdate(void (*update)(r64 dt), r64 dt);
+
+    // frame time distribution, fed every frame from a fixed-bucket histogram
+    PL_FrameStats PL_GetFrameStats(void);
+    // clear the frame time histogram (eg: after loading a level)
+    void PL_ResetFrameStats(void);
+    // returns timerperf value (ticks), pass this value to PL_TimerElapsed
     u64 PL_TimerStart(void);
     // time in seconds since TimerStart
     r64 PL_TimerElapsed(u64 timerperf);
 
+    // monotonic ticks, from the cpu timestamp counter when it is invariant (calibrated at startup)
+    // otherwise from the OS counter (QueryPerformanceCounter / CLOCK_MONOTONIC)
+    u64 PL_GetTicks(void);
+    // ticks per second
+    u64 PL_GetTickFrequency(void);
+    // tick count or difference in nanoseconds, integer multiply and shift (no divide)
+    u64 PL_TicksToNs(u64 ticks);
+
+    /*================
+      Profiling
+    ================*/
+    // PL_PROFILE_* macros compile to nothing unless PL_PROFILE is defined (for both PL.c and the app)
+    // blocks are timed with the cpu timestamp counter into a per-thread ring buffer and may nest
+    // name must stay valid until the profile is dumped (use string literals)
+    void PL_ProfileBegin(const char *name);
+    void PL_ProfileEnd(void);
+    // frame boundary marker, called by the PL main loop
+    void PL_ProfileFrame(void);
+
+    typedef struct
+    {
+        const char *name;
+        u32 parent; // index into the node array, root nodes point to themselves
+        u32 depth; // 0 for root nodes
+        u32 calls; // times the block was entered this frame
+        r64 tInclusive; // seconds including child blocks
+        r64 tExclusive; // seconds excluding child blocks
+    } PL_ProfileNode;
+
+    // call tree of the last complete frame on the calling thread, blocks with the same
+    // name under the same parent are merged. nodes are in first-entered order, returns node count
+    u32 PL_ProfileGetFrameTree(PL_ProfileNode *nodes, u32 maxNodes);
+    // write everything left in the ring buffers as chrome trace_event json
+    // (open in ui.perfetto.dev or chrome://tracing)
+    b32 PL_ProfileDump(const cstr path);
+
+#if defined(PL_PROFILE)
+#define PL_PROFILE_BEGIN(name) PL_ProfileBegin(name)
+#define PL_PROFILE_END() PL_ProfileEnd()
+#define PL_PROFILE_FRAME() PL_ProfileFrame()
+    // times the following statement/block, eg: PL_PROFILE_BLOCK("Update") { ... } (no return/break inside)
+#define PL_PROFILE_BLOCK(name) for(int _plProfOnce = (PL_ProfileBegin(name), 0); !_plProfOnce; _plProfOnce = 1, PL_ProfileEnd())
+#else
+#define PL_PROFILE_BEGIN(name)
+#define PL_PROFILE_END()
+#define PL_PROFILE_FRAME()
+#define PL_PROFILE_BLOCK(name)
+#endif
+
     /*======================
       Input Definitions
     ======================*/
@@ -425,7 +1084,8 @@ extern "C" {
     {
         K_NONE = 0,
 
-        K_ESC, // escape
+        // non-printing keys sit above ascii so they can't collide with the character keys below
+        K_ESC = 0x80, // escape
         K_PRTSC, // print screen
         K_SCRLK, // scroll lock
         K_PAUSE, // pause
@@ -521,7 +1181,7 @@ extern "C" {
         K_9 = '9',
         K_0 = '0',
 
-        KP_SLASH, // keypad /
+        KP_SLASH = K_MENU + 1, // keypad /
         KP_MULTIPLY,  // keypad *
         KP_MINUS, // keypad -
         KP_PLUS, // keypad +
@@ -664,7 +1324,7 @@ extern "C" {
     void PL_SetWindowTitle(const cstr format, ...);
     // set window screen pos (any param set to -1 will be unchanged)
     void PL_SetWindowPos(i32 x, i32 y, i32 w, i32 h);
-    // set desired framerate (no effect if vsync is enabled)
+    // set desired framerate (no effect if vsync is enabled, <= 0 runs uncapped)
     void PL_SetWindowFramerate(i32 framerate);
     // enable vsync true/false
     void PL_SetWindowVSync(b32 vsync);
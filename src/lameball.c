@@ -8,11 +8,22 @@
 #define VER_MAJ 0
 #define VER_MIN 4
 
+// the game plays on a fixed 1280x720 field (pixels), scaled to the window when drawn
+#define FIELD_W 1280
+#define FIELD_H 720
+#define BORDER 6
+#define GOAL_W 10
+#define TICK_HZ 60 // game speeds are in pixels per tick
+#define PADDLE_SPEED 8
+#define TONE_VOLUME 1000
+#define AUDIO_LATENCY (AUDIO_SAMPLE_RATE/15) // samples written ahead of the play cursor
+#define TAU32 6.28318531f
+
 typedef struct
 {
     r32 w,h;
     r32 speed;
-    v2 pos;
+    v2 pos; // top left
     v2 dir;
 } Entity;
 
@@ -21,536 +32,330 @@ typedef struct
     int verMaj, verMin;
     Entity paddle;
     Entity ball;
+    v2 ballPrev; // ball pos at the previous tick, for interpolation
+
+    int speed; // ball speed, also the score
+    int highScore;
+    b32 playerHit; // ball overlapping the paddle
+    b32 disableMouse;
+
+    // what happened since the last frame was drawn
+    b32 hitTop, hitBot, hitRight, hitGoal;
+    PL_Rect intersect;
+
+    r32 tSine;
+    int toneFreq;
+    u32 toneSamples; // samples of tone left to write
+    u32 audioWrite; // next sample written to the audio buffer
 } State;
 
+static const b8 SevenSegLayout[10][7] = {
+    {1,1,1,0,1,1,1}, //0
+    {0,0,0,0,0,1,1}, //1
+    {0,1,1,1,1,1,0}, //2
+    {0,0,1,1,1,1,1}, //3
+    {1,0,0,1,0,1,1}, //4
+    {1,0,1,1,1,0,1}, //5
+    {1,1,1,1,1,0,1}, //6
+    {0,0,1,0,0,1,1}, //7
+    {1,1,1,1,1,1,1}, //8
+    {1,0,1,1,0,1,1}}; //9
+
+static b32 Keydown(PL_KEYCODE key)
+{
+    return PL_GetKeyState(key)->isDown;
+}
+
+static b32 Overlap(PL_Rect a, PL_Rect b, PL_Rect *result)
+{
+    i32 x0 = (a.x > b.x) ? a.x : b.x;
+    i32 y0 = (a.y > b.y) ? a.y : b.y;
+    i32 x1 = (a.x+a.w < b.x+b.w) ? a.x+a.w : b.x+b.w;
+    i32 y1 = (a.y+a.h < b.y+b.h) ? a.y+a.h : b.y+b.h;
+    if(x1 <= x0 || y1 <= y0) return 0;
+    *result = (PL_Rect){x0, y0, x1-x0, y1-y0};
+    return 1;
+}
+
+static PL_Rect EntityRect(Entity *e)
+{
+    return (PL_Rect){(i32)e->pos.x, (i32)e->pos.y, (i32)e->w, (i32)e->h};
+}
+
+static void PlayTone(State *state, int freq, int div)
+{
+    state->toneFreq = freq;
+    state->toneSamples = AUDIO_SAMPLE_RATE/div;
+}
+
 void PL_ErrorCallback(void)
 {
     PL_PrintErr("%s", PL_GetErrorString());
 }
 
-void PL_Startup(void)
+static void Update(r64 dt)
 {
-    PL_SetUserMemorySize(sizeof(State));
     State *state = (State*)PL_GetUserMemory();
-    state->verMaj = VER_MAJ;
-    state->verMin = VER_MIN;
-    
-    PL_SetWindowTitle("LameBall v%d.%d", state->verMaj, state->verMin);
-    PL_SetWindowPos(-1, -1, 1280, 720);
-    
-    state->paddle.pos.x = 0.15f;
-    state->paddle.pos.y = 0.15f;
-    state->paddle.w = 0.02f;
-    state->paddle.h = 0.15f;
-    state->paddle.speed = 0.1f;
-    
-    state->ball.pos.x = 0.5f;
-    state->ball.pos.y = 0.5f;
-    state->ball.w = 0.02f;
-    state->ball.h = 0.02f;
-    state->ball.speed = 0.1f;
-    
-    bool BounceRectDown = 0;
-    bool BounceRectRight = 0;
-    int BounceRectSpeed = 1;
-    int HighScore = 1;
-    bool BounceBounced = 0;
-    bool BounceBouncedPlayer = 0;
-    bool BounceBouncedGoal = 0;
-    
-    SDL_Rect BoundaryTop = {0,0, Application.Dimension.w, 6};
-    SDL_Rect BoundaryBot = {0, Application.Dimension.h-6, Application.Dimension.w, 6};
-    SDL_Rect BoundaryRight = {Application.Dimension.w-6, 0, 6, Application.Dimension.h};
-    SDL_Rect GoalLine = {0, 0, 10, Application.Dimension.h};
-    
-    SDL_Rect SevenSegU[7];
+    Entity *paddle = &state->paddle;
+    Entity *ball = &state->ball;
+    PL_Mouse *mouse = PL_GetMouse();
+    PL_Gamepad *gamepad = PL_GetGamepad(0);
+
+    // Controller
+    if(gamepad && gamepad->isConnected)
     {
-        int x = (Application.Dimension.w/2)+200;
-        int y = Application.Dimension.h/2;
-        SevenSegU[0] = (SDL_Rect){(x-10)-60,(y-50)-60,20,100};
-        SevenSegU[1] = (SDL_Rect){(x-10)-60,(y-50)+60,20,100};
-        SevenSegU[2] = (SDL_Rect){x-50,(y-10)-120,100,20};
-        SevenSegU[3] = (SDL_Rect){x-50,y-10,100,20};
-        SevenSegU[4] = (SDL_Rect){x-50,(y-10)+120,100,20};
-        SevenSegU[5] = (SDL_Rect){(x-10)+60,(y-50)-60,20,100};
-        SevenSegU[6] = (SDL_Rect){(x-10)+60,(y-50)+60,20,100};
+        if(gamepad->buttons[GP_DPAD_UP].isDown) paddle->pos.y -= paddle->speed;
+        if(gamepad->buttons[GP_DPAD_DOWN].isDown) paddle->pos.y += paddle->speed;
     }
-    
-    SDL_Rect SevenSegT[7];
+
+    // Keyboard
+    r32 keySpeed = paddle->speed;
+    if(Keydown(K_LSHIFT) || Keydown(K_RSHIFT)) keySpeed *= 2.0f;
+    else if(Keydown(K_LCTRL) || Keydown(K_RCTRL)) keySpeed *= 0.5f;
+    if(Keydown(K_W) || Keydown(K_UP)) paddle->pos.y -= keySpeed;
+    if(Keydown(K_S) || Keydown(K_DOWN)) paddle->pos.y += keySpeed;
+
+    // Mouse, the paddle centre follows the pointer
+    PL_Window *window = PL_GetWindow();
+    if(!state->disableMouse && window->focus && window->dim.h > 0)
     {
-        int x = Application.Dimension.w/2;
-        int y = Application.Dimension.h/2;
-        SevenSegT[0] = (SDL_Rect){(x-10)-60,(y-50)-60,20,100};
-        SevenSegT[1] = (SDL_Rect){(x-10)-60,(y-50)+60,20,100};
-        SevenSegT[2] = (SDL_Rect){x-50,(y-10)-120,100,20};
-        SevenSegT[3] = (SDL_Rect){x-50,y-10,100,20};
-        SevenSegT[4] = (SDL_Rect){x-50,(y-10)+120,100,20};
-        SevenSegT[5] = (SDL_Rect){(x-10)+60,(y-50)-60,20,100};
-        SevenSegT[6] = (SDL_Rect){(x-10)+60,(y-50)+60,20,100};
+        r32 mouseY = (r32)mouse->py * ((r32)FIELD_H / (r32)window->dim.h);
+        r32 mouseSpeed = paddle->speed * 0.5f;
+        if(mouse->buttons[MB_LEFT].isDown) mouseSpeed *= 2.0f;
+        else if(mouse->buttons[MB_RIGHT].isDown) mouseSpeed *= 0.5f;
+
+        r32 centre = paddle->pos.y + (paddle->h * 0.5f);
+        if(mouseY > centre + mouseSpeed) paddle->pos.y += mouseSpeed;
+        else if(mouseY < centre - mouseSpeed) paddle->pos.y -= mouseSpeed;
     }
-    
-    SDL_Rect SevenSegH[7];
+
+    // player boundary
+    if(paddle->pos.y < 0) paddle->pos.y = 0;
+    if(paddle->pos.y + paddle->h > FIELD_H) paddle->pos.y = FIELD_H - paddle->h;
+
+    // ball motion, slightly slower vertically
+    r32 speed = (r32)state->speed;
+    state->ballPrev = ball->pos;
+    ball->pos.x += ball->dir.x * speed;
+    ball->pos.y += ball->dir.y * (speed - (r32)(state->speed/50));
+
+    b32 bounced = 0;
+    if(ball->pos.x + ball->w >= FIELD_W - BORDER)
     {
-        int x = (Application.Dimension.w/2)-200;
-        int y = Application.Dimension.h/2;
-        SevenSegH[0] = (SDL_Rect){(x-10)-60,(y-50)-60,20,100};
-        SevenSegH[1] = (SDL_Rect){(x-10)-60,(y-50)+60,20,100};
-        SevenSegH[2] = (SDL_Rect){x-50,(y-10)-120,100,20};
-        SevenSegH[3] = (SDL_Rect){x-50,y-10,100,20};
-        SevenSegH[4] = (SDL_Rect){x-50,(y-10)+120,100,20};
-        SevenSegH[5] = (SDL_Rect){(x-10)+60,(y-50)-60,20,100};
-        SevenSegH[6] = (SDL_Rect){(x-10)+60,(y-50)+60,20,100};
+        state->hitRight = 1;
+        bounced = 1;
+        ball->dir.x = -1.0f;
     }
-    
-    //TEST: High Score 7-seg display (Units, Tens, Hundreds)
-    SDL_Rect SevenSegHSU[7];
+
+    if(ball->pos.x <= 0)
     {
-        int x = (Application.Dimension.w/2)+100;
-        int y = Application.Dimension.h - (Application.Dimension.h/8);
-        SevenSegHSU[0] = (SDL_Rect){(x-5)-30,(y-25)-30,10,50};
-        SevenSegHSU[1] = (SDL_Rect){(x-5)-30,(y-25)+30,10,50};
-        SevenSegHSU[2] = (SDL_Rect){x-25,(y-5)-60,50,10};
-        SevenSegHSU[3] = (SDL_Rect){x-25,y-5,50,10};
-        SevenSegHSU[4] = (SDL_Rect){x-25,(y-5)+60,50,10};
-        SevenSegHSU[5] = (SDL_Rect){(x-5)+30,(y-25)-30,10,50};
-        SevenSegHSU[6] = (SDL_Rect){(x-5)+30,(y-25)+30,10,50};
+        if(!(ball->pos.y >= paddle->pos.y && ball->pos.y <= paddle->pos.y + paddle->h))
+        {
+            state->hitGoal = 1;
+            if(state->speed%10 != 0) state->speed--;
+            if(!state->speed) state->speed = 1;
+            PlayTone(state, 220, 6);
+        }
+
+        ball->dir.x = 1.0f;
     }
-    
-    SDL_Rect SevenSegHST[7];
+
+    if(ball->pos.y + ball->h >= FIELD_H - BORDER)
     {
-        int x = Application.Dimension.w/2;
-        int y = Application.Dimension.h - (Application.Dimension.h/8);
-        SevenSegHST[0] = (SDL_Rect){(x-5)-30,(y-25)-30,10,50};
-        SevenSegHST[1] = (SDL_Rect){(x-5)-30,(y-25)+30,10,50};
-        SevenSegHST[2] = (SDL_Rect){x-25,(y-5)-60,50,10};
-        SevenSegHST[3] = (SDL_Rect){x-25,y-5,50,10};
-        SevenSegHST[4] = (SDL_Rect){x-25,(y-5)+60,50,10};
-        SevenSegHST[5] = (SDL_Rect){(x-5)+30,(y-25)-30,10,50};
-        SevenSegHST[6] = (SDL_Rect){(x-5)+30,(y-25)+30,10,50};
+        state->hitBot = 1;
+        bounced = 1;
+        ball->dir.y = -1.0f;
     }
-    
-    SDL_Rect SevenSegHSH[7];
+
+    if(ball->pos.y <= BORDER)
     {
-        int x = (Application.Dimension.w/2)-100;
-        int y = Application.Dimension.h - (Application.Dimension.h/8);
-        SevenSegHSH[0] = (SDL_Rect){(x-5)-30,(y-25)-30,10,50};
-        SevenSegHSH[1] = (SDL_Rect){(x-5)-30,(y-25)+30,10,50};
-        SevenSegHSH[2] = (SDL_Rect){x-25,(y-5)-60,50,10};
-        SevenSegHSH[3] = (SDL_Rect){x-25,y-5,50,10};
-        SevenSegHSH[4] = (SDL_Rect){x-25,(y-5)+60,50,10};
-        SevenSegHSH[5] = (SDL_Rect){(x-5)+30,(y-25)-30,10,50};
-        SevenSegHSH[6] = (SDL_Rect){(x-5)+30,(y-25)+30,10,50};
+        state->hitTop = 1;
+        bounced = 1;
+        ball->dir.y = 1.0f;
     }
-    
-    bool SevenSegLayout[10][7] = {
-        {1,1,1,0,1,1,1}, //0
-        {0,0,0,0,0,1,1}, //1
-        {0,1,1,1,1,1,0}, //2
-        {0,0,1,1,1,1,1}, //3
-        {1,0,0,1,0,1,1}, //4
-        {1,0,1,1,1,0,1}, //5
-        {1,1,1,1,1,0,1}, //6
-        {0,0,1,0,0,1,1}, //7
-        {1,1,1,1,1,1,1}, //8
-        {1,0,1,1,0,1,1}}; //9
-    
-    //TEST: audio
-    SDL_AudioDeviceID AudioDevice;
-    SDL_memset(&AudioDevice, 0, sizeof(SDL_AudioDeviceID));
-    SDL_AudioSpec AudioSpec;
-    SDL_memset(&AudioSpec, 0, sizeof(SDL_AudioSpec));
-    AudioSpec.freq = 48000;
-    AudioSpec.format = AUDIO_S16SYS;
-    AudioSpec.channels = 2;
-    AudioSpec.samples = 512;
-    AudioDevice = SDL_OpenAudioDevice(0, 0, &AudioSpec, 0, 0);
-    SDL_PauseAudioDevice(AudioDevice, 0);
-    real32 tSine = 0;
-    int ToneFreq = 500;
-    
-    //NOTE: FrameTiming
-    uint32 Timer_TotalFrameTicks = 0;
-    uint32 Timer_TotalFrames = 0;
-    uint32 Timer_StartTicks = SDL_GetTicks();
-    uint32 Timer_10SecTotalFrameTicks = 0;
-    uint32 Timer_10SecTotalFrames = 0;
-    uint32 Timer_10SecStartTicks = SDL_GetTicks();
-}
 
-void PL_Frame(void)
-{
-        Timer_10SecTotalFrames++;
-        Timer_TotalFrames++;
-        
-        uint32 Cap_StartTicks = SDL_GetTicks();
-        uint64 Timer_StartPerf = SDL_GetPerformanceCounter();
-        
-        LAM_HandleEvents();
-        
-        //NOTE: Reset Controller if disconnected & reconnected
-        if(!SDL_GameControllerGetAttached(Controller))
-        {
-            SDL_GameControllerClose(Controller);
-            Controller = 0;
-        }
-        
-        if(!Controller)
-        {
-            for(int iJoystick = 0; iJoystick < SDL_NumJoysticks(); ++iJoystick)
-            {
-                if(SDL_IsGameController(iJoystick))
-                {
-                    Controller = SDL_GameControllerOpen(iJoystick);
-                    if(!Controller)
-                    {
-                        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR,
-                                                 "Failed to open Controller",
-                                                 SDL_GetError(), 0);
-                    }
-                }
-            }
-        }
-        
-        //NOTE: Controller
-        if(SDL_GameControllerGetButton(Controller, SDL_CONTROLLER_BUTTON_DPAD_UP))
-            PlayerRect.y-=PlayerRectSpeed;
-        if(SDL_GameControllerGetButton(Controller, SDL_CONTROLLER_BUTTON_DPAD_DOWN))
-            PlayerRect.y+=PlayerRectSpeed;
-        
-        //NOTE: Keyboard
-        if(LAM_Keydown('w') || LAM_Keydown(SDLK_UP))
-        {
-            if(LAM_Keydown(SDLK_LSHIFT) || LAM_Keydown(SDLK_RSHIFT))
-                PlayerRect.y -= PlayerRectSpeed*2;
-            
-            else if(LAM_Keydown(SDLK_LCTRL) || LAM_Keydown(SDLK_RCTRL))
-                PlayerRect.y -= PlayerRectSpeed/2;
-            
-            else PlayerRect.y -= PlayerRectSpeed;
-        }
-        
-        if(LAM_Keydown('s') || LAM_Keydown(SDLK_DOWN))
-        {
-            if(LAM_Keydown(SDLK_LSHIFT) || LAM_Keydown(SDLK_RSHIFT))
-                PlayerRect.y += PlayerRectSpeed*2;
-            
-            else if(LAM_Keydown(SDLK_LCTRL) || LAM_Keydown(SDLK_RCTRL))
-                PlayerRect.y += PlayerRectSpeed/2;
-            
-            else PlayerRect.y += PlayerRectSpeed;
-        }
-        
-        if(LAM_Keydown(SDLK_F11))
-        {
-            if(Application.Fullscreen)
-            {
-                SDL_SetWindowFullscreen(Application.Window, 0);
-                Application.Fullscreen = 0;
-            }
-            
-            else
-            {
-                SDL_SetWindowFullscreen(Application.Window, 1);
-                Application.Fullscreen = 1;
-            }
-        }
-        
-        if(LAM_Keydown(SDLK_LCTRL) && LAM_Keydown(SDLK_LSHIFT) &&
-           LAM_KeySingle(SDLK_F12))
-        {
-            int X = BounceRectSpeed%10;
-            int Y = 10 - X;
-            BounceRectSpeed += Y;
-        }
-        
-        if(LAM_KeySingle(SDLK_F1))
-        {
-            Application.DisableMouse = !Application.DisableMouse;
-        }
-        
-        //NOTE: Mouse
-        if(!Application.DisableMouse && Application.MouseInWindow)
-        {
-            int MouseSpeed = PlayerRectSpeed/2;
-            
-            if(Application.MouseY > (PlayerRect.y + (PlayerRect.h/2)))
-            {
-                if(Application.MouseLeft)
-                    PlayerRect.y += MouseSpeed*2;
-                
-                else if(Application.MouseRight)
-                    PlayerRect.y += MouseSpeed/2;
-                
-                else
-                    PlayerRect.y += MouseSpeed;
-                
-            }
-            
-            if(Application.MouseY < (PlayerRect.y + (PlayerRect.h/2)))
-            {
-                if(Application.MouseLeft)
-                    PlayerRect.y -= MouseSpeed*2;
-                
-                else if(Application.MouseRight)
-                    PlayerRect.y -= MouseSpeed/2;
-                
-                else
-                    PlayerRect.y -= MouseSpeed;
-            }
-        }
-        
-        // TEST: player boundary
-        if(PlayerRect.y <= 0)
-            PlayerRect.y = 0;
-        if(PlayerRect.y + PlayerRect.h >= Application.Dimension.h)
-            PlayerRect.y = Application.Dimension.h - PlayerRect.h;
-        if(PlayerRect.x <= 0)
-            PlayerRect.x = 0;
-        if(PlayerRect.x + PlayerRect.w >= Application.Dimension.w)
-            PlayerRect.x = Application.Dimension.w - PlayerRect.w;
-        
-        //TEST: Bounce Rect motion
-        if(BounceRectDown) BounceRect.y += (BounceRectSpeed - (BounceRectSpeed/50));
-        else BounceRect.y -= (BounceRectSpeed - (BounceRectSpeed/50));
-        if(BounceRectRight) BounceRect.x += BounceRectSpeed;
-        else BounceRect.x -= BounceRectSpeed;
-        
-        //TEST: bounce rect boundary
-        bool BounceTopBoundary = 0;
-        bool BounceBotBoundary = 0;
-        bool BounceRightBoundary = 0;
-        
-        if(BounceRect.x + BounceRect.w >= Application.Dimension.w)
-        {
-            BounceRightBoundary = 1;
-            BounceBounced = 1;
-            BounceRectRight = 0;
-        }
-        
-        if(BounceRect.x <= 0)
-        {
-            if(!(BounceRect.y >= PlayerRect.y &&
-                 BounceRect.y <= PlayerRect.y + PlayerRect.h))
-            {
-                BounceBouncedGoal = 1;
-            }
-            
-            BounceRectRight = 1;
-        }
-        
-        if(BounceRect.y + BounceRect.h >= Application.Dimension.h)
-        {
-            BounceBotBoundary = 1;
-            BounceBounced = 1;
-            BounceRectDown = 0;
-        }
-        
-        if(BounceRect.y <= 0)
-        {
-            BounceTopBoundary = 1;
-            BounceBounced = 1;
-            BounceRectDown = 1;
-        }
-        
-        SDL_Rect Intersect;
-        SDL_memset(&Intersect, 0, sizeof(SDL_Rect));
-        //TEST: BounceRect intersect PlayerRect
-        if(SDL_IntersectRect(&PlayerRect, &BounceRect, &Intersect))
+    if(bounced) PlayTone(state, 440, 25);
+
+    // ball intersect paddle
+    PL_Rect paddleRect = EntityRect(paddle);
+    PL_Rect ballRect = EntityRect(ball);
+    PL_Rect intersect = {0};
+    if(Overlap(paddleRect, ballRect, &intersect))
+    {
+        ball->dir.x = 1.0f;
+        if(!state->playerHit) PlayTone(state, 880, 25);
+        state->playerHit = 1;
+        state->intersect = intersect;
+
+        if(intersect.h > intersect.w)
         {
-            BounceRectRight = 1;
-            BouncePlayerHit = 1;
-            
-            if(Intersect.h > Intersect.w)
-            {
-                if(Intersect.x == BounceRect.x) // players right
-                {
-                    PlayerRect.x -= Intersect.w;
-                }
-            }
-            
-            else
-            {
-                if(Intersect.y == BounceRect.y) // players bot
-                {
-                    BounceRectDown = 1;
-                    PlayerRect.y -= Intersect.h;
-                }
-                if(Intersect.y == PlayerRect.y) // players top
-                {
-                    BounceRectDown = 0;
-                    PlayerRect.y += Intersect.h;
-                }
-            }
+            if(intersect.x == ballRect.x) paddle->pos.x -= (r32)intersect.w; // players right
         }
-        
         else
         {
-            SDL_memset(&Intersect, 0, sizeof(SDL_Rect));
-            if(BouncePlayerHit) BounceRectSpeed++;
-            if(BouncePlayerHit) BounceBouncedPlayer = 1;
-            BouncePlayerHit = 0;
-        }
-        
-        if(HighScore < BounceRectSpeed) HighScore = BounceRectSpeed;
-        
-        
-        //TEST: Audio sinewave
-        if(BounceBounced || BounceBouncedPlayer ||
-           BounceBouncedGoal || BouncePlayerHit)
-        {
-            int Div = 25;
-            
-            if(BounceBouncedPlayer || BouncePlayerHit)
-            {
-                ToneFreq = 880;
-                BounceBouncedPlayer = 0;
-            }
-            
-            if(BounceBounced)
-            {
-                ToneFreq = 440;
-                BounceBounced = 0;
-            }
-            
-            if(BounceBouncedGoal)
+            if(intersect.y == ballRect.y) // players bot
             {
-                ToneFreq = 220;
-                Div = 6;
+                ball->dir.y = 1.0f;
+                paddle->pos.y -= (r32)intersect.h;
             }
-            
-            int16 Volume = 1000;
-            int WavePeriod = AudioSpec.freq/ToneFreq;
-            for(int i = 0; i < (AudioSpec.freq/Div); i++)
+            if(intersect.y == paddleRect.y) // players top
             {
-                real32 SineValue = sinf(tSine);
-                int16 SampleValue = (int16)(SineValue*Volume);
-                int16 Samples[2];
-                Samples[0] = SampleValue;
-                Samples[1] = SampleValue;
-                tSine += ((real32)M_PI * 2.0f) * (1.0f / (real32)WavePeriod);
-                if(SDL_GetQueuedAudioSize(AudioDevice) < 1024*256)
-                    SDL_QueueAudio(AudioDevice, &Samples[0], sizeof(int16)*2);
+                ball->dir.y = -1.0f;
+                paddle->pos.y += (r32)intersect.h;
             }
         }
-        
-        //TEST: draw to texture
-        SDL_SetRenderTarget(Application.Renderer, Texture);
-        
-        // Goal Indicator
-        if(BounceBouncedGoal)
-        {
-            SDL_SetRenderDrawColor(Application.Renderer, 0xaa,0x11,0x11,0xff);
-            SDL_RenderClear(Application.Renderer);
-            BounceBouncedGoal = 0;
-            if(BounceRectSpeed%10 != 0)BounceRectSpeed--;
-            if(!BounceRectSpeed) BounceRectSpeed = 1;
-        }
-        
-        else
-        {
-            SDL_SetRenderDrawColor(Application.Renderer, 0,0,0,0);
-            SDL_RenderClear(Application.Renderer);                        
-        }
-        
-        //TEST: Draw 7-seg display for BounceRectSpeed
-        for(int iSeg = 0; iSeg < 7; iSeg++)
-        {
-            int Unit = BounceRectSpeed%10;
-            uint8 Color = ((SevenSegLayout[Unit][iSeg])?0x30:0x05);
-            SDL_RenderDrawRect(Application.Renderer, &SevenSegU[iSeg]);
-            SDL_SetRenderDrawColor(Application.Renderer,Color,Color,Color,0xff);
-            SDL_RenderFillRect(Application.Renderer, &SevenSegU[iSeg]);
-        }
-        
-        for(int iSeg = 0; iSeg < 7; iSeg++)
-        {
-            int Unit = (BounceRectSpeed/10)%10;
-            uint8 Color = ((SevenSegLayout[Unit][iSeg])?0x30:0x05);
-            SDL_RenderDrawRect(Application.Renderer, &SevenSegT[iSeg]);
-            SDL_SetRenderDrawColor(Application.Renderer,Color,Color,Color,0xff);
-            SDL_RenderFillRect(Application.Renderer, &SevenSegT[iSeg]);
-        }
-        
-        for(int iSeg = 0; iSeg < 7; iSeg++)
-        {
-            int Unit = (BounceRectSpeed/100)%10;
-            uint8 Color = ((SevenSegLayout[Unit][iSeg])?0x30:0x05);
-            SDL_RenderDrawRect(Application.Renderer, &SevenSegH[iSeg]);
-            SDL_SetRenderDrawColor(Application.Renderer,Color,Color,Color,0xff);
-            SDL_RenderFillRect(Application.Renderer, &SevenSegH[iSeg]);
-        }
-        
-        //TEST: Draw 7-seg display for HighScore
-        for(int iSeg = 0; iSeg < 7; iSeg++)
-        {
-            int Unit = HighScore%10;
-            uint8 Color = ((SevenSegLayout[Unit][iSeg])?0x30:0x05);
-            uint8 High = ((SevenSegLayout[Unit][iSeg])?0x60:0x05);
-            SDL_RenderDrawRect(Application.Renderer, &SevenSegHSU[iSeg]);
-            SDL_SetRenderDrawColor(Application.Renderer,Color,High,Color,0xff);
-            SDL_RenderFillRect(Application.Renderer, &SevenSegHSU[iSeg]);
-        }
-        
-        for(int iSeg = 0; iSeg < 7; iSeg++)
-        {
-            int Unit = (HighScore/10)%10;
-            uint8 Color = ((SevenSegLayout[Unit][iSeg])?0x30:0x05);
-            uint8 High = ((SevenSegLayout[Unit][iSeg])?0x60:0x05);
-            SDL_RenderDrawRect(Application.Renderer, &SevenSegHST[iSeg]);
-            SDL_SetRenderDrawColor(Application.Renderer,Color,High,Color,0xff);
-            SDL_RenderFillRect(Application.Renderer, &SevenSegHST[iSeg]);
-        }
-        
-        for(int iSeg = 0; iSeg < 7; iSeg++)
+    }
+    else
+    {
+        // point scored once the ball leaves the paddle
+        if(state->playerHit) state->speed++;
+        state->playerHit = 0;
+    }
+
+    if(state->highScore < state->speed) state->highScore = state->speed;
+}
+
+void PL_Startup(void)
+{
+    PL_SetUserMemorySize(sizeof(State));
+    State *state = (State*)PL_GetUserMemory();
+    state->verMaj = VER_MAJ;
+    state->verMin = VER_MIN;
+
+    PL_SetWindowTitle("LameBall v%d.%d", state->verMaj, state->verMin);
+    PL_SetWindowPos(-1, -1, FIELD_W, FIELD_H);
+
+    state->paddle.pos.x = 40.0f;
+    state->paddle.pos.y = (FIELD_H/2) - 60.0f;
+    state->paddle.w = 20.0f;
+    state->paddle.h = 120.0f;
+    state->paddle.speed = PADDLE_SPEED;
+
+    state->ball.pos.x = FIELD_W/2;
+    state->ball.pos.y = FIELD_H/2;
+    state->ball.w = 20.0f;
+    state->ball.h = 20.0f;
+    state->ball.dir = v2r(-1.0f, -1.0f);
+    state->ballPrev = state->ball.pos;
+
+    state->speed = 1;
+    state->highScore = 1;
+
+    // the game speeds are per tick, so the sim runs at a fixed rate whatever the display does
+    PL_SetFixedUpdate(Update, 1.0/(r64)TICK_HZ);
+}
+
+// rects are in field pixels (0,0 top left), drawn as scissored clears
+static void DrawRect(PL_Rect rect, u8 r, u8 g, u8 b)
+{
+    PL_Window *window = PL_GetWindow();
+    r32 sx = (r32)window->dim.w / (r32)FIELD_W;
+    r32 sy = (r32)window->dim.h / (r32)FIELD_H;
+
+    glScissor((GLint)((r32)rect.x*sx), (GLint)((r32)(FIELD_H - rect.y - rect.h)*sy),
+              (GLsizei)((r32)rect.w*sx + 0.5f), (GLsizei)((r32)rect.h*sy + 0.5f));
+    glClearColor((r32)r/255.0f, (r32)g/255.0f, (r32)b/255.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+// seven segment digit centred on x,y, size 2: score, 1: high score
+static void DrawDigit(int digit, int x, int y, int size, u8 on, u8 onGreen)
+{
+    int t = 10*size; // segment thickness
+    int l = 50*size; // segment length
+    int o = 30*size; // segment offset from centre
+    PL_Rect segs[7] = {
+        {(x-t/2)-o, (y-l/2)-o, t, l},
+        {(x-t/2)-o, (y-l/2)+o, t, l},
+        {x-l/2, (y-t/2)-2*o, l, t},
+        {x-l/2, y-t/2, l, t},
+        {x-l/2, (y-t/2)+2*o, l, t},
+        {(x-t/2)+o, (y-l/2)-o, t, l},
+        {(x-t/2)+o, (y-l/2)+o, t, l}};
+
+    for(int seg = 0; seg < 7; seg++)
+    {
+        b32 lit = SevenSegLayout[digit][seg];
+        DrawRect(segs[seg], lit ? on : 0x05, lit ? onGreen : 0x05, lit ? on : 0x05);
+    }
+}
+
+static void DrawNumber(int value, int y, int size, int spacing, u8 on, u8 onGreen)
+{
+    DrawDigit((value/100)%10, (FIELD_W/2) - spacing, y, size, on, onGreen);
+    DrawDigit((value/10)%10, FIELD_W/2, y, size, on, onGreen);
+    DrawDigit(value%10, (FIELD_W/2) + spacing, y, size, on, onGreen);
+}
+
+// keeps the audio buffer filled AUDIO_LATENCY samples ahead of the play cursor with tone or silence
+static void FillAudio(State *state)
+{
+    PL_Audio *audio = PL_GetAudio();
+    i16 *samples = (i16*)PL_GetAudioBuffer();
+    u32 target = (u32)((audio->playCursor + AUDIO_LATENCY) % AUDIO_SAMPLE_RATE);
+    r32 step = TAU32 * ((r32)state->toneFreq / (r32)AUDIO_SAMPLE_RATE);
+
+    while(state->audioWrite != target)
+    {
+        i16 value = 0;
+        if(state->toneSamples)
         {
-            int Unit = (HighScore/100)%10;
-            uint8 Color = ((SevenSegLayout[Unit][iSeg])?0x30:0x05);
-            uint8 High = ((SevenSegLayout[Unit][iSeg])?0x60:0x05);
-            SDL_RenderDrawRect(Application.Renderer, &SevenSegHSH[iSeg]);
-            SDL_SetRenderDrawColor(Application.Renderer,Color,High,Color,0xff);
-            SDL_RenderFillRect(Application.Renderer, &SevenSegHSH[iSeg]);
+            value = (i16)(PL_sinFast(state->tSine) * TONE_VOLUME);
+            state->tSine += step;
+            if(state->tSine > TAU32) state->tSine -= TAU32;
+            state->toneSamples--;
         }
-        
-        //BoundaryTop
-        uint8 BndClr = ((BounceTopBoundary)?0xcc:0x40);
-        SDL_RenderDrawRect(Application.Renderer, &BoundaryTop);
-        SDL_SetRenderDrawColor(Application.Renderer,BndClr,BndClr,BndClr,0xff);
-        SDL_RenderFillRect(Application.Renderer, &BoundaryTop);
-        
-        //BoundaryBot
-        BndClr = ((BounceBotBoundary)?0xcc:0x40);
-        SDL_RenderDrawRect(Application.Renderer, &BoundaryBot);
-        SDL_SetRenderDrawColor(Application.Renderer,BndClr,BndClr,BndClr,0xff);
-        SDL_RenderFillRect(Application.Renderer, &BoundaryBot);
-        
-        //BoundaryRight
-        BndClr = ((BounceRightBoundary)?0xcc:0x40);
-        SDL_RenderDrawRect(Application.Renderer, &BoundaryRight);
-        SDL_SetRenderDrawColor(Application.Renderer,BndClr,BndClr,BndClr,0xff);
-        SDL_RenderFillRect(Application.Renderer, &BoundaryRight);
-        
-        //GoalLine
-        SDL_RenderDrawRect(Application.Renderer, &GoalLine);
-        SDL_SetRenderDrawColor(Application.Renderer, 0x50,0x10,0x10,0xff);
-        SDL_RenderFillRect(Application.Renderer, &GoalLine);
-        
-        // Player
-        SDL_RenderDrawRect(Application.Renderer, &PlayerRect);
-        SDL_SetRenderDrawColor(Application.Renderer, 0x15,0xf0,0xff,0xff);
-        SDL_RenderFillRect(Application.Renderer, &PlayerRect);
-        
-        // Ball
-        SDL_RenderDrawRect(Application.Renderer, &BounceRect);
-        SDL_SetRenderDrawColor(Application.Renderer, 0xff,0,0,0xff);
-        SDL_RenderFillRect(Application.Renderer, &BounceRect);
-        
-        // PlayerHit Indicator
-        SDL_RenderDrawRect(Application.Renderer, &Intersect);
-        SDL_SetRenderDrawColor(Application.Renderer, 0,0xff,0,0xff);
-        SDL_RenderFillRect(Application.Renderer, &Intersect);
-        
-        SDL_SetRenderTarget(Application.Renderer, 0);
-        SDL_RenderCopy(Application.Renderer, Texture, 0,0);
-        SDL_RenderPresent(Application.Renderer);
-        
+
+        samples[state->audioWrite*2] = value;
+        samples[state->audioWrite*2 + 1] = value;
+        state->audioWrite = (state->audioWrite + 1) % AUDIO_SAMPLE_RATE;
+    }
+}
+
+void PL_Frame(void)
+{
+    State *state = (State*)PL_GetUserMemory();
+
+    if(PL_GetKeyState(K_F11)->downTick) PL_ToggleWindowFullscreen();
+    if(PL_GetKeyState(K_F1)->downTick) state->disableMouse = !state->disableMouse;
+    if(Keydown(K_LCTRL) && Keydown(K_LSHIFT) && PL_GetKeyState(K_F12)->downTick)
+    {
+        state->speed += 10 - (state->speed%10); // skip to the next checkpoint
+    }
+
+    FillAudio(state);
+
+    // no GL when running headless
+    if(glClear)
+    {
+        glEnable(GL_SCISSOR_TEST);
+
+        // Goal Indicator
+        if(state->hitGoal) DrawRect((PL_Rect){0, 0, FIELD_W, FIELD_H}, 0xaa, 0x11, 0x11);
+        else DrawRect((PL_Rect){0, 0, FIELD_W, FIELD_H}, 0, 0, 0);
+
+        DrawNumber(state->speed, FIELD_H/2, 2, 200, 0x30, 0x30);
+        DrawNumber(state->highScore, FIELD_H - (FIELD_H/8), 1, 100, 0x30, 0x60);
+
+        u8 clr = state->hitTop ? 0xcc : 0x40;
+        DrawRect((PL_Rect){0, 0, FIELD_W, BORDER}, clr, clr, clr);
+        clr = state->hitBot ? 0xcc : 0x40;
+        DrawRect((PL_Rect){0, FIELD_H - BORDER, FIELD_W, BORDER}, clr, clr, clr);
+        clr = state->hitRight ? 0xcc : 0x40;
+        DrawRect((PL_Rect){FIELD_W - BORDER, 0, BORDER, FIELD_H}, clr, clr, clr);
+        DrawRect((PL_Rect){0, 0, GOAL_W, FIELD_H}, 0x50, 0x10, 0x10);
+
+        DrawRect(EntityRect(&state->paddle), 0x15, 0xf0, 0xff);
+
+        // ball drawn between the last two ticks
+        Entity ball = state->ball;
+        r32 alpha = (r32)PL_GetTimer()->alpha;
+        ball.pos.x = PL_lerp(state->ballPrev.x, state->ball.pos.x, alpha);
+        ball.pos.y = PL_lerp(state->ballPrev.y, state->ball.pos.y, alpha);
+        DrawRect(EntityRect(&ball), 0xff, 0, 0);
+
+        if(state->playerHit) DrawRect(state->intersect, 0, 0xff, 0);
+    }
+
+    state->hitTop = state->hitBot = state->hitRight = state->hitGoal = 0;
 }